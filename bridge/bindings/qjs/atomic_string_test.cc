@@ -11,6 +11,7 @@
 #include <codecvt>
 #include <iterator>
 #include "event_type_names.h"
+#include "foundation/ui_command_buffer.h"
 #include "gtest/gtest.h"
 #include "native_string_utils.h"
 #include "webf_test_env.h"
@@ -51,7 +52,7 @@ TEST(AtomicString, CreateFromJSValue) {
   auto env = TEST_init();
   JSContext* ctx = env->page()->executingContext()->ctx();
   JSValue string = JS_NewString(ctx, "helloworld");
-  std::shared_ptr<StringImpl> value =
+  scoped_refptr<StringImpl> value =
       env->page()->dartIsolateContext()->stringCache()->GetStringFromJSAtom(ctx, JS_ValueToAtom(ctx, string));
   EXPECT_EQ(*value, "helloworld");
   JS_FreeValue(ctx, string);
@@ -81,6 +82,37 @@ TEST(AtomicString, ToNativeString) {
   }
 }
 
+TEST(AtomicString, ToNativeStringWidens8BitStrings) {
+  TEST_init();
+  // Long enough to cover both the vector loop and its scalar tail.
+  const char ascii[] = "abcdefghijklmnopqrstuvwxyz0123456789!";
+  AtomicString value = AtomicString::CreateFromUTF8(ascii);
+  auto native_string = value.ToNativeString();
+  EXPECT_FALSE(native_string->Is8Bit());
+  ASSERT_EQ(native_string->length(), 37);
+  for (int i = 0; i < native_string->length(); i++) {
+    EXPECT_EQ(native_string->string()[i], static_cast<uint8_t>(ascii[i]));
+  }
+}
+
+TEST(AtomicString, ToCompactNativeString) {
+  TEST_init();
+  AtomicString value = AtomicString::CreateFromUTF8("helloworld");
+  auto native_string = value.ToCompactNativeString();
+  EXPECT_TRUE(native_string->Is8Bit());
+  ASSERT_EQ(native_string->length(), 10);
+  EXPECT_EQ(memcmp(native_string->characters8(), "helloworld", 10), 0);
+
+  UICommandItem item(0, native_string.get(), nullptr, nullptr);
+  EXPECT_EQ(item.args_01_length, 10 | UICommandItem::kArgs01Latin1Flag);
+
+  // 16-bit strings still cross as UTF-16.
+  auto utf16_string = AtomicString(u"Native 字符串").ToCompactNativeString();
+  EXPECT_FALSE(utf16_string->Is8Bit());
+  ASSERT_EQ(utf16_string->length(), 10);
+  EXPECT_EQ(utf16_string->string()[7], u'字');
+}
+
 TEST(AtomicString, CopyAssignment) {
   TEST_init();
   AtomicString str = AtomicString::CreateFromUTF8("helloworld");
@@ -108,6 +140,37 @@ TEST(AtomicString, CopyToRightReference) {
   EXPECT_EQ(str.ToUTF8String(), "helloworld");
 }
 
+TEST(AtomicString, CopiesShareOneRefCountedImpl) {
+  TEST_init();
+  scoped_refptr<StringImpl> impl = StringImpl::CreateFromUTF8("refcount-probe", 14);
+  EXPECT_TRUE(impl->HasOneRef());
+  {
+    scoped_refptr<StringImpl> copy = impl;
+    EXPECT_EQ(copy.get(), impl.get());
+    EXPECT_FALSE(impl->HasOneRef());
+  }
+  EXPECT_TRUE(impl->HasOneRef());
+}
+
+TEST(AtomicString, GeneratedNamesAreStatic) {
+  TEST_init();
+  EXPECT_TRUE(event_type_names::kclick.Impl()->IsStatic());
+  EXPECT_EQ(AtomicString::CreateFromUTF8("click"), event_type_names::kclick);
+  EXPECT_EQ(AtomicString::CreateStatic("click"), event_type_names::kclick);
+  EXPECT_FALSE(AtomicString::CreateFromUTF8("not-a-generated-name").Impl()->IsStatic());
+}
+
+TEST(AtomicString, CreateStaticAfterDynamicAtomizationIsStatic) {
+  TEST_init();
+  AtomicString dynamic = AtomicString::CreateFromUTF8("seen-by-script-first");
+  EXPECT_FALSE(dynamic.Impl()->IsStatic());
+
+  AtomicString name = AtomicString::CreateStatic("seen-by-script-first");
+  EXPECT_TRUE(name.Impl()->IsStatic());
+  EXPECT_EQ(name, dynamic);
+  EXPECT_EQ(AtomicString::CreateFromUTF8("seen-by-script-first"), name);
+}
+
 TEST(AtomicString, UTF16StringCreation) {
   TEST_init();
   // Test creating AtomicString from UTF-16 literal
@@ -164,7 +227,7 @@ TEST(AtomicString, UTF16StringCache) {
   
   // Retrieve it back from cache
   JSAtom atom = JS_ValueToAtom(ctx, qjs_value);
-  std::shared_ptr<StringImpl> cached_str = env->page()->dartIsolateContext()->stringCache()->GetStringFromJSAtom(ctx, atom);
+  scoped_refptr<StringImpl> cached_str = env->page()->dartIsolateContext()->stringCache()->GetStringFromJSAtom(ctx, atom);
   
   // Verify it's the same string
   EXPECT_FALSE(cached_str->Is8Bit());
@@ -18,6 +18,7 @@
 #include <quickjs/quickjs.h>
 #include <vector>
 #include "bindings/qjs/converter_impl.h"
+#include "core/binding_name_table.h"
 #include "core/binding_object.h"
 #include "core/dart_binding_object.h"
 #include "core/executing_context.h"
@@ -69,6 +70,9 @@ static JSValue FromNativeValue(ExecutingContext* context,
     case NativeTag::TAG_UNDEFINED: {
       return JS_UNDEFINED;
     }
+    case NativeTag::TAG_BINDING_NAME: {
+      return BindingNameTable::FromNativeValue(native_value).ToQuickJS(context->ctx());
+    }
     case NativeTag::TAG_UINT8_BYTES: {
       auto free_func = [](JSRuntime* rt, void* opaque, void* ptr) {
 #if defined(_WIN32)
@@ -10,15 +10,23 @@
 #include "value_cache.h"
 #include <cassert>
 #include "../../foundation/string/atomic_string_table.h"
+#include "core/dart_isolate_context.h"
+#include "foundation/metrics_registry.h"
 
 namespace webf {
 
-JSValue StringCache::GetJSValueFromString(JSContext* ctx, std::shared_ptr<StringImpl> string_impl) {
+static void CountStringCacheLookup(MetricsEnum metric) {
+  if (auto* isolate = GetCurrentDartIsolateContext()) {
+    isolate->metrics()->Increment(metric);
+  }
+}
+
+JSValue StringCache::GetJSValueFromString(JSContext* ctx, scoped_refptr<StringImpl> string_impl) {
   JSAtom atom = GetJSAtomFromString(ctx, std::move(string_impl));
   return JS_AtomToValue(ctx, atom);
 }
 
-JSAtom StringCache::GetJSAtomFromString(JSContext* ctx, std::shared_ptr<StringImpl> string_impl) {
+JSAtom StringCache::GetJSAtomFromString(JSContext* ctx, scoped_refptr<StringImpl> string_impl) {
   DCHECK(string_impl);
   if (!string_impl->length()) {
     return JS_ATOM_NULL;
@@ -27,13 +35,15 @@ JSAtom StringCache::GetJSAtomFromString(JSContext* ctx, std::shared_ptr<StringIm
   auto cached_qjs_string = string_cache_.find(string_impl);
 
   if (cached_qjs_string != string_cache_.end()) {
+    CountStringCacheLookup(MetricsEnum::kStringCacheHit);
     return cached_qjs_string->second;
   }
 
+  CountStringCacheLookup(MetricsEnum::kStringCacheMiss);
   return CreateStringAndInsertIntoCache(ctx, string_impl);
 }
 
-JSAtom StringCache::CreateStringAndInsertIntoCache(JSContext* ctx, std::shared_ptr<StringImpl> string_impl) {
+JSAtom StringCache::CreateStringAndInsertIntoCache(JSContext* ctx, scoped_refptr<StringImpl> string_impl) {
   DCHECK(string_impl);
   DCHECK(!string_cache_.contains(string_impl));
   DCHECK(string_impl->length());
@@ -65,7 +75,7 @@ JSAtom StringCache::CreateStringAndInsertIntoCache(JSContext* ctx, std::shared_p
   return new_string_atom;
 }
 
-std::shared_ptr<StringImpl> StringCache::GetStringFromJSAtom(JSContext* ctx, JSAtom atom) {
+scoped_refptr<StringImpl> StringCache::GetStringFromJSAtom(JSContext* ctx, JSAtom atom) {
   auto it = atom_to_string_cache.find(atom);
   if (it != atom_to_string_cache.end()) {
     return it->second;
@@ -73,7 +83,7 @@ std::shared_ptr<StringImpl> StringCache::GetStringFromJSAtom(JSContext* ctx, JSA
   
   // Atom not in cache, create StringImpl and cache it
   bool is_wide_char = !JS_AtomIsTaggedInt(atom) && JS_IsAtomWideChar(JS_GetRuntime(ctx), atom);
-  std::shared_ptr<StringImpl> string_impl;
+  scoped_refptr<StringImpl> string_impl;
   
   if (LIKELY(!is_wide_char)) {
     uint32_t slen;
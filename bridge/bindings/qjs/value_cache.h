@@ -17,7 +17,7 @@
 
 namespace webf {
 
-// String cache helps convert WebF strings (std::shared_ptr<StringImpl>) into QJS strings by
+// String cache helps convert WebF strings (scoped_refptr<StringImpl>) into QJS strings by
 // only creating a QuickJS string for a particular std::shared_ptr<std::string> once and caching it
 // for future use.
 class StringCache {
@@ -29,18 +29,18 @@ class StringCache {
   StringCache() = delete;
   StringCache& operator=(const StringCache&) = delete;
 
-  JSValue GetJSValueFromString(JSContext* ctx, std::shared_ptr<StringImpl> string_impl);
-  JSAtom GetJSAtomFromString(JSContext* ctx, std::shared_ptr<StringImpl> string_impl);
-  std::shared_ptr<StringImpl> GetStringFromJSAtom(JSContext* ctx, JSAtom atom);
+  JSValue GetJSValueFromString(JSContext* ctx, scoped_refptr<StringImpl> string_impl);
+  JSAtom GetJSAtomFromString(JSContext* ctx, scoped_refptr<StringImpl> string_impl);
+  scoped_refptr<StringImpl> GetStringFromJSAtom(JSContext* ctx, JSAtom atom);
 
   void Dispose();
 
  private:
-  JSAtom CreateStringAndInsertIntoCache(JSContext* ctx, std::shared_ptr<StringImpl>);
+  JSAtom CreateStringAndInsertIntoCache(JSContext* ctx, scoped_refptr<StringImpl>);
 
   JSRuntime* runtime_;
-  std::unordered_map<std::shared_ptr<StringImpl>, JSAtom> string_cache_;
-  std::unordered_map<JSAtom, std::shared_ptr<StringImpl>> atom_to_string_cache;
+  std::unordered_map<scoped_refptr<StringImpl>, JSAtom> string_cache_;
+  std::unordered_map<JSAtom, scoped_refptr<StringImpl>> atom_to_string_cache;
 };
 
 }  // namespace webf
@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <iosfwd>
 #include <type_traits>
 #include <utility>
@@ -268,6 +269,15 @@ void swap(scoped_refptr<T>& lhs, scoped_refptr<T>& rhs) noexcept {
 
 }  // namespace webf
 
+namespace std {
+
+template <typename T>
+struct hash<webf::scoped_refptr<T>> {
+  size_t operator()(const webf::scoped_refptr<T>& ptr) const { return hash<T*>()(ptr.get()); }
+};
+
+}  // namespace std
+
 // Temporary alias for migration
 template <class T>
 using scoped_refptr = webf::scoped_refptr<T>;
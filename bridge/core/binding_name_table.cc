@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "binding_name_table.h"
+
+#include <cassert>
+#include <unordered_map>
+#include <vector>
+#include "binding_call_methods.h"
+#include "defined_properties.h"
+
+namespace webf {
+
+namespace {
+
+thread_local std::unordered_map<const StringImpl*, int32_t> name_ids;
+
+}  // namespace
+
+void BindingNameTable::Init() {
+  name_ids.clear();
+  name_ids.reserve(Count());
+  for (int32_t id = 0; id < Count(); id++) {
+    name_ids.emplace(NameOf(id).Impl().get(), id);
+  }
+}
+
+void BindingNameTable::Dispose() {
+  name_ids.clear();
+}
+
+int32_t BindingNameTable::Count() {
+  return binding_call_methods::kNamesCount + defined_properties::kNamesCount;
+}
+
+const char* const* BindingNameTable::Strings() {
+  static const std::vector<const char*> strings = [] {
+    std::vector<const char*> result;
+    result.reserve(Count());
+    for (unsigned i = 0; i < binding_call_methods::kNamesCount; i++) {
+      result.push_back(binding_call_methods::NameStringAt(i));
+    }
+    for (unsigned i = 0; i < defined_properties::kNamesCount; i++) {
+      result.push_back(defined_properties::NameStringAt(i));
+    }
+    return result;
+  }();
+  return strings.data();
+}
+
+int32_t BindingNameTable::IdOf(const AtomicString& name) {
+  if (name.IsNull()) {
+    return kNotFound;
+  }
+  auto it = name_ids.find(name.Impl().get());
+  return it != name_ids.end() ? it->second : kNotFound;
+}
+
+const AtomicString& BindingNameTable::NameOf(int32_t id) {
+  assert(id >= 0 && id < Count());
+  if (id < static_cast<int32_t>(binding_call_methods::kNamesCount)) {
+    return binding_call_methods::NameAt(id);
+  }
+  return defined_properties::NameAt(id - binding_call_methods::kNamesCount);
+}
+
+NativeValue BindingNameTable::ToNativeValue(const AtomicString& name) {
+  int32_t id = IdOf(name);
+  if (id != kNotFound) {
+    return Native_NewBindingName(id);
+  }
+  return Native_NewString(name.ToNativeString().release());
+}
+
+AtomicString BindingNameTable::FromNativeValue(const NativeValue& value) {
+  if (value.tag == NativeTag::TAG_BINDING_NAME) {
+    int32_t id = static_cast<int32_t>(value.u.int64);
+    return id >= 0 && id < Count() ? NameOf(id) : AtomicString::Empty();
+  }
+  if (value.tag == NativeTag::TAG_STRING && value.u.ptr != nullptr) {
+    return AtomicString(std::unique_ptr<AutoFreeNativeString>(static_cast<AutoFreeNativeString*>(value.u.ptr)));
+  }
+  return AtomicString::Empty();
+}
+
+}  // namespace webf
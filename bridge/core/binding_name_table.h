@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_BINDING_NAME_TABLE_H_
+#define WEBF_CORE_BINDING_NAME_TABLE_H_
+
+#include <cstdint>
+#include "foundation/native_value.h"
+#include "foundation/string/atomic_string.h"
+
+namespace webf {
+
+// Integer ids for the property and method names listed in
+// binding_call_methods.json5 and defined_properties.json5, agreed with Dart
+// once per isolate through getBindingNameTable(). Binding calls send a
+// registered name as a TAG_BINDING_NAME NativeValue instead of allocating a
+// native string on one side and an AtomicString or Dart String on the other.
+// Names outside the table, e.g. expando properties, still travel as strings.
+//
+// Ids are binding_call_methods in declaration order followed by
+// defined_properties. A name listed twice keeps its first id.
+class BindingNameTable {
+ public:
+  static constexpr int32_t kNotFound = -1;
+
+  // Per JS thread, after names_installer::Init().
+  static void Init();
+  static void Dispose();
+
+  static int32_t Count();
+  // UTF-8 spelling of every id, indexed by id. Static storage, any thread.
+  static const char* const* Strings();
+
+  static int32_t IdOf(const AtomicString& name);
+  static const AtomicString& NameOf(int32_t id);
+
+  // |name| as a binding name if it is registered, otherwise as a string the
+  // receiver frees.
+  static NativeValue ToNativeValue(const AtomicString& name);
+  // Reads a method or property name sent by Dart, taking ownership of string
+  // values.
+  static AtomicString FromNativeValue(const NativeValue& value);
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_BINDING_NAME_TABLE_H_
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "binding_name_table.h"
+
+#include <cstring>
+#include "binding_call_methods.h"
+#include "defined_properties.h"
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+namespace webf {
+
+TEST(BindingNameTable, RegisteredNamesTravelAsIds) {
+  auto env = TEST_init();
+
+  int32_t id = BindingNameTable::IdOf(binding_call_methods::koffsetTop);
+  ASSERT_NE(id, BindingNameTable::kNotFound);
+  EXPECT_EQ(BindingNameTable::NameOf(id), binding_call_methods::koffsetTop);
+  EXPECT_STREQ(BindingNameTable::Strings()[id], "offsetTop");
+
+  NativeValue value = BindingNameTable::ToNativeValue(AtomicString::CreateFromUTF8("offsetTop"));
+  EXPECT_EQ(value.tag, NativeTag::TAG_BINDING_NAME);
+  EXPECT_EQ(value.u.int64, id);
+  EXPECT_EQ(BindingNameTable::FromNativeValue(value), binding_call_methods::koffsetTop);
+
+  // Listed in both files; the binding_call_methods id wins.
+  int32_t property_id = BindingNameTable::IdOf(defined_properties::kgetPropertyValue);
+  EXPECT_EQ(property_id, BindingNameTable::IdOf(binding_call_methods::kgetPropertyValue));
+  EXPECT_LT(property_id, static_cast<int32_t>(binding_call_methods::kNamesCount));
+}
+
+TEST(BindingNameTable, DynamicNamesTravelAsStrings) {
+  auto env = TEST_init();
+
+  AtomicString name = AtomicString::CreateFromUTF8("__notARegisteredBindingName");
+  EXPECT_EQ(BindingNameTable::IdOf(name), BindingNameTable::kNotFound);
+
+  NativeValue value = BindingNameTable::ToNativeValue(name);
+  ASSERT_EQ(value.tag, NativeTag::TAG_STRING);
+  EXPECT_EQ(BindingNameTable::FromNativeValue(value), name);
+}
+
+}  // namespace webf
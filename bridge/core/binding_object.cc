@@ -13,6 +13,7 @@
 #include "core/css/style_recalc_change.h"
 #include "core/dom/qualified_name.h"
 #include "binding_call_methods.h"
+#include "binding_name_table.h"
 #include "bindings/qjs/exception_state.h"
 #include "bindings/qjs/script_promise_resolver.h"
 #include "core/dom/container_node.h"
@@ -22,6 +23,8 @@
 #include "core/dom/mutation_observer_interest_group.h"
 #include "core/executing_context.h"
 #include "core/html/canvas/canvas_rendering_context_2d.h"
+#include "html_element_type_helper.h"
+#include "foundation/metrics_registry.h"
 #include "foundation/native_string.h"
 #include "foundation/native_value_converter.h"
 #include "logging.h"
@@ -35,10 +38,58 @@ static bool ShouldUpdateStyleForThisDocumentForDOMGeometry(const AtomicString& p
          prop == binding_call_methods::kclientWidth || prop == binding_call_methods::kclientHeight;
 }
 
+static double BoxMetricOf(const BoxMetrics& metrics, const AtomicString& prop) {
+  if (prop == binding_call_methods::koffsetLeft)
+    return metrics.offset_left;
+  if (prop == binding_call_methods::koffsetTop)
+    return metrics.offset_top;
+  if (prop == binding_call_methods::koffsetWidth)
+    return metrics.offset_width;
+  if (prop == binding_call_methods::koffsetHeight)
+    return metrics.offset_height;
+  if (prop == binding_call_methods::kclientLeft)
+    return metrics.client_left;
+  if (prop == binding_call_methods::kclientTop)
+    return metrics.client_top;
+  if (prop == binding_call_methods::kclientWidth)
+    return metrics.client_width;
+  return metrics.client_height;
+}
+
 static bool ShouldUpdateStyleForThisDocumentForDOMGeometryMethod(const AtomicString& method) {
   return method == binding_call_methods::kgetBoundingClientRect || method == binding_call_methods::kgetClientRects;
 }
 
+// Counts a synchronous call into Dart under the strongest dependency its flush
+// reason carries.
+static void CountSyncDartRoundTrip(MetricsRegistry* metrics, uint32_t reason) {
+  if (reason & kDependentsAll) {
+    metrics->Increment(MetricsEnum::kSyncDartRoundTripDependentsAll);
+  } else if (reason & kDependentsOnLayout) {
+    metrics->Increment(MetricsEnum::kSyncDartRoundTripDependentsOnLayout);
+  } else if (reason & kDependentsOnElement) {
+    metrics->Increment(MetricsEnum::kSyncDartRoundTripDependentsOnElement);
+  } else {
+    metrics->Increment(MetricsEnum::kSyncDartRoundTripStandard);
+  }
+}
+
+// Each 2D context holds its recorded calls until it submits them. A sync call
+// that reads another canvas (createPattern(canvas), toDataURL()) must see
+// that canvas's pending calls first.
+static void FlushCanvasesReadBy(const BindingObject* self, const std::vector<NativeBindingObject*>& deps) {
+  if (auto* canvas = DynamicTo<HTMLCanvasElement>(self)) {
+    canvas->FlushRenderingContexts();
+  }
+  for (NativeBindingObject* dep : deps) {
+    if (dep && dep->binding_target_) {
+      if (auto* canvas = DynamicTo<HTMLCanvasElement>(dep->binding_target_)) {
+        canvas->FlushRenderingContexts();
+      }
+    }
+  }
+}
+
 static void UpdateStyleForThisDocumentIfBlinkEnabled(ExecutingContext* context) {
   if (!context || !context->isBlinkEnabled()) {
     return;
@@ -121,7 +172,7 @@ void NativeBindingObject::HandleCallFromDartSide(const DartIsolateContext* dart_
     return;
 
   const AtomicString method =
-    native_method != nullptr ? AtomicString(std::unique_ptr<AutoFreeNativeString>(static_cast<AutoFreeNativeString*>(native_method->u.ptr))) : AtomicString::Empty();
+      native_method != nullptr ? BindingNameTable::FromNativeValue(*native_method) : AtomicString::Empty();
   const NativeValue result = binding_object->binding_target_->HandleCallFromDartSide(method, argc, argv, dart_object);
 
   auto* return_value = new NativeValue();
@@ -181,18 +232,28 @@ NativeValue BindingObject::InvokeBindingMethod(const AtomicString& method,
   auto* context = GetExecutingContext();
 
   if (auto* canvas_context = DynamicTo<CanvasRenderingContext2D>(this)) {
+    canvas_context->FlushDisplayList();
     canvas_context->requestPaint();
   }
 
+  // Methods such as scroll() or focus() change layout without a UICommand.
+  if (!ShouldUpdateStyleForThisDocumentForDOMGeometryMethod(method)) {
+    context->layoutGeometrySnapshot()->Invalidate();
+  }
+
   std::vector<NativeBindingObject*> invoke_elements_deps;
   // Collect all DOM elements in arguments.
   CollectElementDepsOnArgs(invoke_elements_deps, argc, argv);
+  FlushCanvasesReadBy(this, invoke_elements_deps);
   // Make sure all these elements are ready in dart.
   context->FlushUICommand(this, reason, invoke_elements_deps);
 
   NativeValue return_value = Native_NewNull();
-  NativeValue native_method =
-      NativeValueConverter<NativeTypeString>::ToNativeValue(GetExecutingContext()->ctx(), method);
+  NativeValue native_method = BindingNameTable::ToNativeValue(method);
+
+  MetricsRegistry* metrics = context->dartIsolateContext()->metrics();
+  CountSyncDartRoundTrip(metrics, reason);
+  ScopedMetricsTimer round_trip_timer(metrics, MetricsHistogram::kSyncDartRoundTripNanos);
 
 #if ENABLE_LOG
   WEBF_LOG(INFO) << "[Dispatcher]: PostToDartSync method: InvokeBindingMethod; Call Begin";
@@ -236,7 +297,7 @@ ScriptPromise BindingObject::InvokeBindingMethodAsync(const webf::AtomicString&
   if (ShouldUpdateStyleForThisDocumentForDOMGeometryMethod(method)) {
     UpdateStyleForThisDocumentIfBlinkEnabled(GetExecutingContext());
   }
-  NativeValue method_on_stack = NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), method);
+  NativeValue method_on_stack = BindingNameTable::ToNativeValue(method);
   return InvokeBindingMethodAsyncInternal(method_on_stack, argc, args, exception_state);
 }
 
@@ -277,6 +338,7 @@ ScriptPromise BindingObject::InvokeBindingMethodAsyncInternal(NativeValue method
   auto* context = GetExecutingContext();
 
   if (auto* canvas_context = DynamicTo<CanvasRenderingContext2D>(this)) {
+    canvas_context->FlushDisplayList();
     canvas_context->requestPaint();
   }
 
@@ -321,7 +383,7 @@ ScriptPromise BindingObject::GetBindingPropertyAsync(const webf::AtomicString& p
     UpdateStyleForThisDocumentIfBlinkEnabled(GetExecutingContext());
   }
 
-  const NativeValue argv[] = {Native_NewString(prop.ToNativeString().release())};
+  const NativeValue argv[] = {BindingNameTable::ToNativeValue(prop)};
   return InvokeBindingMethodAsync(BindingMethodCallOperations::kGetProperty, 1, argv, exception_state);
 }
 
@@ -329,6 +391,7 @@ void BindingObject::SetBindingPropertyAsync(const webf::AtomicString& prop,
                                             NativeValue value,
                                             webf::ExceptionState& exception_state) {
   if (auto* canvas_context = DynamicTo<CanvasRenderingContext2D>(this)) {
+    canvas_context->FlushDisplayList();
     canvas_context->requestPaint();
   }
 
@@ -336,10 +399,10 @@ void BindingObject::SetBindingPropertyAsync(const webf::AtomicString& prop,
     AtomicString old_value = element->attributes()->getAttribute(prop, exception_state);
     AtomicString new_value = AtomicString::Null();
 
-    static const AtomicString kChecked = AtomicString::CreateFromUTF8("checked");
-    static const AtomicString kSelected = AtomicString::CreateFromUTF8("selected");
-    static const AtomicString kDisabled = AtomicString::CreateFromUTF8("disabled");
-    static const AtomicString kRequired = AtomicString::CreateFromUTF8("required");
+    static const AtomicString kChecked = AtomicString::CreateStatic("checked");
+    static const AtomicString kSelected = AtomicString::CreateStatic("selected");
+    static const AtomicString kDisabled = AtomicString::CreateStatic("disabled");
+    static const AtomicString kRequired = AtomicString::CreateStatic("required");
 
     const bool is_boolean_attribute =
         prop == kChecked || prop == kSelected || prop == kDisabled || prop == kRequired;
@@ -373,7 +436,7 @@ void BindingObject::SetBindingPropertyAsync(const webf::AtomicString& prop,
     }
   }
 
-  std::unique_ptr<SharedNativeString> args_01 = prop.ToNativeString();
+  std::unique_ptr<SharedNativeString> args_01 = prop.ToCompactNativeString();
 
   auto* args_02 = (NativeValue*)dart_malloc(sizeof(NativeValue));
   memcpy((void*)args_02, &value, sizeof(NativeValue));
@@ -389,17 +452,23 @@ NativeValue BindingObject::InvokeBindingMethod(BindingMethodCallOperations bindi
                                                ExceptionState& exception_state) const {
   auto* context = GetExecutingContext();
   if (auto* canvas_context = DynamicTo<CanvasRenderingContext2D>(this)) {
+    canvas_context->FlushDisplayList();
     canvas_context->requestPaint();
   }
 
   std::vector<NativeBindingObject*> invoke_elements_deps;
   // Collect all DOM elements in arguments.
   CollectElementDepsOnArgs(invoke_elements_deps, argc, argv);
+  FlushCanvasesReadBy(this, invoke_elements_deps);
   // Make sure all these elements are ready in dart.
   context->FlushUICommand(this, reason, invoke_elements_deps);
 
   NativeValue return_value = Native_NewNull();
 
+  MetricsRegistry* metrics = context->dartIsolateContext()->metrics();
+  CountSyncDartRoundTrip(metrics, reason);
+  ScopedMetricsTimer round_trip_timer(metrics, MetricsHistogram::kSyncDartRoundTripNanos);
+
 #if ENABLE_LOG
   WEBF_LOG(INFO) << "[Dispatcher]: PostToDartSync method: InvokeBindingMethod; Call Begin";
 #endif
@@ -447,14 +516,106 @@ NativeValue BindingObject::GetBindingProperty(const AtomicString& prop,
 
   if (ShouldUpdateStyleForThisDocumentForDOMGeometry(prop)) {
     UpdateStyleForThisDocumentIfBlinkEnabled(GetExecutingContext());
+    if (const NativeLayoutGeometry* geometry =
+            GetExecutingContext()->layoutGeometrySnapshot()->Find(binding_object_)) {
+      if (prop == binding_call_methods::koffsetLeft)
+        return Native_NewFloat64(geometry->offset_left);
+      if (prop == binding_call_methods::koffsetTop)
+        return Native_NewFloat64(geometry->offset_top);
+      if (prop == binding_call_methods::koffsetWidth)
+        return Native_NewFloat64(geometry->offset_width);
+      if (prop == binding_call_methods::koffsetHeight)
+        return Native_NewFloat64(geometry->offset_height);
+    }
+    if (const BoxMetrics* metrics = BoxMetricsFromDart(reason, exception_state)) {
+      return Native_NewFloat64(BoxMetricOf(*metrics, prop));
+    }
   }
 
-  const NativeValue argv[] = {Native_NewString(prop.ToNativeString().release())};
+  const NativeValue argv[] = {BindingNameTable::ToNativeValue(prop)};
   NativeValue result = InvokeBindingMethod(BindingMethodCallOperations::kGetProperty, 1, argv, reason, exception_state);
 
   return result;
 }
 
+bool BindingObject::GetBindingProperties(const AtomicString* props,
+                                         int32_t count,
+                                         NativeValue* results,
+                                         uint32_t reason,
+                                         ExceptionState& exception_state) const {
+  for (int32_t i = 0; i < count; i++) {
+    results[i] = Native_NewNull();
+  }
+
+  if (UNLIKELY(binding_object_->disposed_)) {
+    exception_state.ThrowException(
+        ctx(), ErrorType::InternalError,
+        "Can not get binding property on BindingObject, dart binding object had been disposed");
+    return false;
+  }
+
+  std::vector<NativeValue> argv;
+  argv.reserve(count);
+  for (int32_t i = 0; i < count; i++) {
+    argv.emplace_back(BindingNameTable::ToNativeValue(props[i]));
+  }
+  NativeValue result =
+      InvokeBindingMethod(BindingMethodCallOperations::kGetProperties, count, argv.data(), reason, exception_state);
+  if (result.tag != NativeTag::TAG_LIST) {
+    return false;
+  }
+
+  auto* values = static_cast<NativeValue*>(result.u.ptr);
+  bool complete = result.uint32 == static_cast<uint32_t>(count);
+  if (complete) {
+    memcpy(results, values, sizeof(NativeValue) * count);
+  }
+  if (values != nullptr) {
+    dart_free(values);
+  }
+  return complete;
+}
+
+// Layout queries tend to come in runs (offsetWidth then offsetHeight, a
+// scroller's clientHeight then its child's offsetTop), and each synchronous
+// read parks the JS thread until Dart answers. The first box metric JS reads
+// from an element fetches all eight in one hop; the rest are answered from
+// the snapshot until layout may have changed.
+const BoxMetrics* BindingObject::BoxMetricsFromDart(uint32_t reason, ExceptionState& exception_state) const {
+  LayoutGeometrySnapshot* snapshot = GetExecutingContext()->layoutGeometrySnapshot();
+  if (const BoxMetrics* metrics = snapshot->FindBoxMetrics(binding_object_)) {
+    return metrics;
+  }
+
+  constexpr int32_t kCount = 8;
+  const AtomicString props[kCount] = {
+      binding_call_methods::koffsetLeft,   binding_call_methods::koffsetTop,  binding_call_methods::koffsetWidth,
+      binding_call_methods::koffsetHeight, binding_call_methods::kclientLeft, binding_call_methods::kclientTop,
+      binding_call_methods::kclientWidth,  binding_call_methods::kclientHeight,
+  };
+  NativeValue values[kCount];
+  if (!GetBindingProperties(props, kCount, values, reason, exception_state)) {
+    return nullptr;
+  }
+
+  double numbers[kCount];
+  for (int32_t i = 0; i < kCount; i++) {
+    if (values[i].tag == NativeTag::TAG_FLOAT64) {
+      numbers[i] = values[i].u.float64;
+    } else if (values[i].tag == NativeTag::TAG_INT) {
+      numbers[i] = static_cast<double>(values[i].u.int64);
+    } else {
+      // Not a plain box metric; let the caller fall back to a single read.
+      return nullptr;
+    }
+  }
+
+  snapshot->RememberBoxMetrics(binding_object_,
+                               BoxMetrics{numbers[0], numbers[1], numbers[2], numbers[3], numbers[4], numbers[5],
+                                          numbers[6], numbers[7]});
+  return snapshot->FindBoxMetrics(binding_object_);
+}
+
 NativeValue BindingObject::SetBindingProperty(const AtomicString& prop,
                                               NativeValue value,
                                               ExceptionState& exception_state) const {
@@ -486,10 +647,10 @@ NativeValue BindingObject::SetBindingProperty(const AtomicString& prop,
 
     AtomicString new_value = AtomicString::Null();
 
-    static const AtomicString kChecked = AtomicString::CreateFromUTF8("checked");
-    static const AtomicString kSelected = AtomicString::CreateFromUTF8("selected");
-    static const AtomicString kDisabled = AtomicString::CreateFromUTF8("disabled");
-    static const AtomicString kRequired = AtomicString::CreateFromUTF8("required");
+    static const AtomicString kChecked = AtomicString::CreateStatic("checked");
+    static const AtomicString kSelected = AtomicString::CreateStatic("selected");
+    static const AtomicString kDisabled = AtomicString::CreateStatic("disabled");
+    static const AtomicString kRequired = AtomicString::CreateStatic("required");
 
     const bool is_boolean_attribute =
         prop == kChecked || prop == kSelected || prop == kDisabled || prop == kRequired;
@@ -524,7 +685,7 @@ NativeValue BindingObject::SetBindingProperty(const AtomicString& prop,
     }
   }
 
-  const NativeValue argv[] = {Native_NewString(prop.ToNativeString().release()), value};
+  const NativeValue argv[] = {BindingNameTable::ToNativeValue(prop), value};
   InvokeBindingMethodAsync(BindingMethodCallOperations::kSetProperty, 2, argv, exception_state);
   return Native_NewNull();
 }
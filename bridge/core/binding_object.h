@@ -23,6 +23,7 @@ namespace webf {
 
 class BindingObject;
 struct NativeBindingObject;
+struct BoxMetrics;
 class ExceptionState;
 class GCVisitor;
 class ScriptPromiseResolver;
@@ -73,6 +74,8 @@ enum BindingMethodCallOperations {
   kHasProperty,
   // 0 = none, 1 = sync, 2 = async
   kGetMethodType,
+  // Reads every property named in argv, returned as a list in argv order.
+  kGetProperties,
 };
 
 enum CreateBindingObjectType {
@@ -124,6 +127,13 @@ class BindingObject : public ScriptWrappable {
                                          const NativeValue* args,
                                          ExceptionState& exception_state) const;
   NativeValue GetBindingProperty(const AtomicString& prop, uint32_t reason, ExceptionState& exception_state) const;
+  // Reads |count| properties in one synchronous call into Dart. Returns false
+  // and leaves |results| null if Dart did not answer with one value per name.
+  bool GetBindingProperties(const AtomicString* props,
+                            int32_t count,
+                            NativeValue* results,
+                            uint32_t reason,
+                            ExceptionState& exception_state) const;
   NativeValue SetBindingProperty(const AtomicString& prop, NativeValue value, ExceptionState& exception_state) const;
 
   ScriptPromise GetBindingPropertyAsync(const AtomicString& prop, ExceptionState& exception_state);
@@ -172,6 +182,9 @@ class BindingObject : public ScriptWrappable {
   explicit BindingObject(JSContext* ctx, NativeBindingObject* native_binding_object);
 
  private:
+  // Box metrics of this element, read from Dart in one hop if not cached yet.
+  const BoxMetrics* BoxMetricsFromDart(uint32_t reason, ExceptionState& exception_state) const;
+
   NativeBindingObject* binding_object_ = nullptr;
   std::unordered_set<BindingObjectPromiseContext*> pending_promise_contexts_;
 };
@@ -8,6 +8,7 @@
 
 #include "core_initializer.h"
 #include "../foundation/string/string_statics.h"
+#include "core/binding_name_table.h"
 #include "core/css/media_query_evaluator.h"
 #include "core/css/parser/css_parser_token_range.h"
 #include "core/css/style_change_reason.h"
@@ -26,6 +27,7 @@ void CoreInitializer::Initialize() {
   internal::InitializeDoubleConverter();
   StringStatics::Init();
   names_installer::Init();
+  BindingNameTable::Init();
   QualifiedName::Init();
 }
 
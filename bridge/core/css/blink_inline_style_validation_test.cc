@@ -5,6 +5,8 @@
 #include "gtest/gtest.h"
 
 #include <cstring>
+#include <string>
+#include <unordered_map>
 
 #include "foundation/native_string.h"
 #include "foundation/native_type.h"
@@ -33,6 +35,20 @@ std::string SharedNativeStringToUTF8(const SharedNativeString* s) {
   return String(reinterpret_cast<const UChar*>(s->string()), static_cast<size_t>(s->length())).ToUTF8String();
 }
 
+// Decodes the value slot of a kSetStyleById command. |defined_values| holds the
+// kDefineStyleValue handles seen earlier in the same pack.
+std::string StyleByIdValueToUTF8(const UICommandItem& item,
+                                 const std::unordered_map<int64_t, std::string>& defined_values) {
+  if (item.string_01 < 0) {
+    return getValueName(static_cast<CSSValueID>(-item.string_01 - 1));
+  }
+  if (item.string_01 & 1) {
+    auto it = defined_values.find(item.string_01 >> 1);
+    return it != defined_values.end() ? it->second : "";
+  }
+  return SharedNativeStringToUTF8(reinterpret_cast<SharedNativeString*>(static_cast<uintptr_t>(item.string_01)));
+}
+
 std::string ConvertCamelCaseToKebabCase(const std::string& property_name) {
   std::string result;
   result.reserve(property_name.size() + 8);
@@ -51,8 +67,13 @@ bool HasSetStyleWithKeyValue(ExecutingContext* context, const std::string& key,
   const CSSPropertyID expected_property_id = CssPropertyID(context, ConvertCamelCaseToKebabCase(key));
   auto* pack = static_cast<UICommandBufferPack*>(context->uiCommandBuffer()->data());
   auto* items = static_cast<UICommandItem*>(pack->data);
+  std::unordered_map<int64_t, std::string> defined_values;
   for (int64_t i = 0; i < pack->length; ++i) {
     const UICommandItem& item = items[i];
+    if (item.type == static_cast<int32_t>(UICommand::kDefineStyleValue)) {
+      defined_values[item.nativePtr2] = CommandArg01ToUTF8(item);
+      continue;
+    }
     if (item.type == static_cast<int32_t>(UICommand::kSetStyle)) {
       if (CommandArg01ToUTF8(item) != key) {
         continue;
@@ -75,14 +96,7 @@ bool HasSetStyleWithKeyValue(ExecutingContext* context, const std::string& key,
       continue;
     }
 
-    std::string value_text;
-    if (item.string_01 < 0) {
-      value_text = getValueName(static_cast<CSSValueID>(-item.string_01 - 1));
-    } else {
-      auto* value_ptr = reinterpret_cast<SharedNativeString*>(static_cast<uintptr_t>(item.string_01));
-      value_text = SharedNativeStringToUTF8(value_ptr);
-    }
-    if (value_text == value) {
+    if (StyleByIdValueToUTF8(item, defined_values) == value) {
       return true;
     }
   }
@@ -93,9 +107,11 @@ bool HasSetStyleByIdWithKeyValue(ExecutingContext* context, const std::string& k
   const CSSPropertyID expected_property_id = CssPropertyID(context, ConvertCamelCaseToKebabCase(key));
   auto* pack = static_cast<UICommandBufferPack*>(context->uiCommandBuffer()->data());
   auto* items = static_cast<UICommandItem*>(pack->data);
+  std::unordered_map<int64_t, std::string> defined_values;
   for (int64_t i = 0; i < pack->length; ++i) {
     const UICommandItem& item = items[i];
-    if (item.type != static_cast<int32_t>(UICommand::kSetStyleById)) {
+    if (item.type == static_cast<int32_t>(UICommand::kDefineStyleValue)) {
+      defined_values[item.nativePtr2] = CommandArg01ToUTF8(item);
       continue;
     }
     if (item.args_01_length != static_cast<int32_t>(expected_property_id)) {
@@ -103,11 +119,19 @@ bool HasSetStyleByIdWithKeyValue(ExecutingContext* context, const std::string& k
     }
 
     std::string value_text;
-    if (item.string_01 < 0) {
-      value_text = getValueName(static_cast<CSSValueID>(-item.string_01 - 1));
+    if (item.type == static_cast<int32_t>(UICommand::kSetStyleByIdTyped)) {
+      // Only px lengths are checked through the typed path here.
+      if ((item.nativePtr2 & 0xff) != static_cast<int64_t>(NativeStyleValueType::kNumeric) ||
+          ((item.nativePtr2 >> 8) & 0xff) != static_cast<int64_t>(NativeStyleValueUnit::kPx)) {
+        continue;
+      }
+      double number;
+      std::memcpy(&number, &item.string_01, sizeof(number));
+      value_text = String::Number(number).ToUTF8String() + "px";
+    } else if (item.type != static_cast<int32_t>(UICommand::kSetStyleById)) {
+      continue;
     } else {
-      auto* value_ptr = reinterpret_cast<SharedNativeString*>(static_cast<uintptr_t>(item.string_01));
-      value_text = SharedNativeStringToUTF8(value_ptr);
+      value_text = StyleByIdValueToUTF8(item, defined_values);
     }
     if (value_text == value) {
       return true;
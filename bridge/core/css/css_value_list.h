@@ -68,6 +68,7 @@ class CSSValueList : public CSSValue {
   const_reverse_iterator rend() const { return values_.rend(); }
 
   size_t length() const { return values_.size(); }
+  ValueListSeparator Separator() const { return static_cast<ValueListSeparator>(value_list_separator_); }
   std::shared_ptr<const CSSValue> Item(uint32_t index) const {
     if (index >= values_.size()) {
       return nullptr;
@@ -142,8 +142,8 @@ void ElementRuleCollector::CollectRuleSetMatchingRules(
       // If any typed compounds exist for this id, only match those and ignore
       // any pure #id variants that may have been created elsewhere.
       bool typed_exists = false;
-      for (const auto& rd : id_rules) {
-        if (rd && rd->HasRightmostType()) {
+      for (const RuleData& rd : id_rules) {
+        if (rd.HasRightmostType()) {
           typed_exists = true;
           break;
         }
@@ -177,8 +177,11 @@ void ElementRuleCollector::CollectMatchingRulesForList(
     bool is_id_bucket,
     bool typed_rules_only) {
 
-  for (const auto& rule_data : rules) {
-    if (!rule_data) {
+  for (const RuleData& rule_data : rules) {
+    // Reject rules whose ancestor identifiers are missing from the ancestor
+    // bloom filter using the hashes stored inline in the RuleData.
+    if (selector_filter_ &&
+        selector_filter_->FastRejectSelector<RuleData::kMaxIdentifierHashes>(rule_data.AncestorIdentifierHashes())) {
       continue;
     }
 
@@ -193,7 +196,7 @@ void ElementRuleCollector::CollectMatchingRulesForList(
       // always the rightmost simple selector (e.g. ".a::before:hover"), so scan
       // the rightmost compound for a pseudo-element match.
       bool targets_requested_pseudo = false;
-      for (const CSSSelector* s = &rule_data->Selector(); s; s = s->NextSimpleSelector()) {
+      for (const CSSSelector* s = &rule_data.Selector(); s; s = s->NextSimpleSelector()) {
         if (s->Match() == CSSSelector::kPseudoElement) {
           targets_requested_pseudo = CSSSelector::GetPseudoId(s->GetPseudoType()) == pseudo_element_id_;
           break;
@@ -209,17 +212,17 @@ void ElementRuleCollector::CollectMatchingRulesForList(
     }
     
     // Skip pure-id variants if we have typed compounds in the same ID bucket.
-    if (is_id_bucket && typed_rules_only && !rule_data->HasRightmostType()) {
+    if (is_id_bucket && typed_rules_only && !rule_data.HasRightmostType()) {
       continue;
     }
 
     // Check if selector matches element
     SelectorChecker::SelectorCheckingContext context(element_);
-    context.selector = &rule_data->Selector();
+    context.selector = &rule_data.Selector();
 
     // Blink-style prefilter: if the rightmost compound has a type selector,
     // ensure the element's tag matches before invoking the full matcher.
-    bool type_ok = RightmostCompoundTagMatchesElement(*rule_data, *element_);
+    bool type_ok = RightmostCompoundTagMatchesElement(rule_data, *element_);
     if (!type_ok) {
       continue;
     }
@@ -248,20 +251,20 @@ void ElementRuleCollector::CollectMatchingRulesForList(
         uint32_t bit = PseudoIdBit(match_result.dynamic_pseudo);
         if (bit) {
           matched_pseudo_element_mask_ |= bit;
-          if (rule_data->Rule() &&
-              rule_data->Rule()->Properties().HasProperty(CSSPropertyID::kContent)) {
+          if (rule_data.Rule() &&
+              rule_data.Rule()->Properties().HasProperty(CSSPropertyID::kContent)) {
             matched_pseudo_element_with_content_mask_ |= bit;
           }
         }
         continue;
       }
-      DidMatchRule(rule_data, cascade_origin, match_request);
+      DidMatchRule(&rule_data, cascade_origin, match_request);
     }
   }
 }
 
 void ElementRuleCollector::DidMatchRule(
-    std::shared_ptr<const RuleData> rule_data,
+    const RuleData* rule_data,
     CascadeOrigin cascade_origin,
     const MatchRequest& match_request) {
   
@@ -316,7 +319,7 @@ void ElementRuleCollector::DidMatchRule(
 }
 
 void ElementRuleCollector::AddMatchedRule(
-    std::shared_ptr<const RuleData> rule_data,
+    const RuleData* rule_data,
     unsigned specificity,
     CascadeOrigin cascade_origin,
     CascadeLayerLevel cascade_layer,
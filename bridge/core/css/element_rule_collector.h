@@ -140,7 +140,8 @@ class ElementRuleCollector {
   };
 
   struct MatchedRule {
-    std::shared_ptr<const RuleData> rule_data;
+    // Points into a RuleSet bucket; only valid until the rules are transferred.
+    const RuleData* rule_data = nullptr;
     unsigned specificity;
     CascadeOrigin cascade_origin;
     CascadeLayerLevel cascade_layer;
@@ -159,7 +160,7 @@ class ElementRuleCollector {
       bool is_id_bucket = false,
       bool typed_rules_only = false);
 
-  void DidMatchRule(std::shared_ptr<const RuleData>,
+  void DidMatchRule(const RuleData*,
                    CascadeOrigin,
                    const MatchRequest&);
 
@@ -171,7 +172,7 @@ class ElementRuleCollector {
   void SortMatchedRules();
   void TransferMatchedRules();
 
-  void AddMatchedRule(std::shared_ptr<const RuleData>,
+  void AddMatchedRule(const RuleData*,
                      unsigned specificity,
                      CascadeOrigin,
                      CascadeLayerLevel,
@@ -0,0 +1,21 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "exported_style_snapshot.h"
+
+namespace webf {
+
+const ExportedStyleSnapshot::Entry* ExportedStyleSnapshot::Find(const Entry& entry, size_t hint) const {
+  if (hint < entries_.size() && entries_[hint].SameProperty(entry)) {
+    return &entries_[hint];
+  }
+  for (const Entry& candidate : entries_) {
+    if (candidate.SameProperty(entry)) {
+      return &candidate;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace webf
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_CSS_EXPORTED_STYLE_SNAPSHOT_H_
+#define WEBF_CORE_CSS_EXPORTED_STYLE_SNAPSHOT_H_
+
+#include <cstdint>
+#include <vector>
+#include "core/css/typed_style_value.h"
+#include "foundation/string/atomic_string.h"
+#include "foundation/string/wtf_string.h"
+
+namespace webf {
+
+// The declared-value style the native style engine last exported to the Dart
+// layer for one element. StyleEngine compares a freshly exported winning
+// property set against it so that a recalc only sends added, changed and
+// removed properties instead of kClearStyle followed by the full set.
+class ExportedStyleSnapshot {
+ public:
+  struct Entry {
+    // CSSPropertyID as sent with kSetStyleById; kVariable for custom properties.
+    int32_t property_id = 0;
+    // Only set for custom properties, which are keyed by name.
+    AtomicString custom_name = AtomicString::Null();
+    // -(CSSValueID + 1) for identifier values, 0 otherwise.
+    int64_t keyword_slot = 0;
+    // Numeric/color values sent with kSetStyleByIdTyped.
+    TypedStyleValue typed;
+    // Serialized value when neither |keyword_slot| nor |typed| applies.
+    String value;
+    String base_href;
+    bool important = false;
+
+    bool SameProperty(const Entry& other) const {
+      return property_id == other.property_id && custom_name == other.custom_name;
+    }
+    bool operator==(const Entry& other) const {
+      return SameProperty(other) && keyword_slot == other.keyword_slot && important == other.important &&
+             typed == other.typed && value == other.value && base_href == other.base_href;
+    }
+    bool operator!=(const Entry& other) const { return !(*this == other); }
+  };
+
+  ExportedStyleSnapshot() = default;
+  explicit ExportedStyleSnapshot(std::vector<Entry> entries) : entries_(std::move(entries)) {}
+
+  // Returns the stored entry for the same property as |entry|, or nullptr.
+  // Export order is stable across recalcs, so callers walking a new export in
+  // order pass one past the previous match as |hint| and usually hit directly.
+  const Entry* Find(const Entry& entry, size_t hint) const;
+  size_t IndexOf(const Entry& stored) const { return &stored - entries_.data(); }
+
+  const std::vector<Entry>& Entries() const { return entries_; }
+  size_t size() const { return entries_.size(); }
+
+ private:
+  std::vector<Entry> entries_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_CSS_EXPORTED_STYLE_SNAPSHOT_H_
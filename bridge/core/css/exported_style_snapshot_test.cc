@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <vector>
+
+#include "bindings/qjs/cppgc/mutation_scope.h"
+#include "code_gen/css_property_names.h"
+#include "core/css/exported_style_snapshot.h"
+#include "core/css/resolver/style_resolver.h"
+#include "core/css/style_engine.h"
+#include "core/dom/document.h"
+#include "core/dom/element.h"
+#include "foundation/ui_command_buffer.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+namespace {
+
+int64_t CountCommands(const std::vector<UICommandItem>& items, UICommand command) {
+  int64_t count = 0;
+  for (const auto& item : items) {
+    if (item.type == static_cast<int32_t>(command)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+const UICommandItem* FindStyleCommand(const std::vector<UICommandItem>& items,
+                                      UICommand command,
+                                      CSSPropertyID property_id) {
+  for (const auto& item : items) {
+    if (item.type == static_cast<int32_t>(command) && item.args_01_length == static_cast<int32_t>(property_id)) {
+      return &item;
+    }
+  }
+  return nullptr;
+}
+
+// Runs |script| after the initial style export and returns only the commands
+// produced by it and the following style recalc.
+std::vector<UICommandItem> RunAndCollectStyleCommands(WebFTestEnv* env, const char* script) {
+  auto* context = env->page()->executingContext();
+  context->uiCommandBuffer()->clear();
+  env->page()->evaluateScript(script, strlen(script), "vm://", 0);
+  TEST_runLoop(context);
+  {
+    MemberMutationScope scope{context};
+    context->document()->UpdateStyleForThisDocument();
+  }
+  context->uiCommandBuffer()->SyncAllPackages();
+
+  auto* pack = static_cast<UICommandBufferPack*>(context->uiCommandBuffer()->data());
+  auto* items = static_cast<UICommandItem*>(pack->data);
+  return std::vector<UICommandItem>(items, items + pack->length);
+}
+
+}  // namespace
+
+TEST(ExportedStyleSnapshot, NoOpRecalcEmitsNoStyleCommands) {
+  auto env = TEST_init(nullptr, nullptr, 0, /*enable_blink=*/1);
+  auto* context = env->page()->executingContext();
+  TEST_runLoop(context);
+
+  const char* setup = R"JS(
+    const style = document.createElement('style');
+    style.textContent = `.box { color: blue; width: 10px; } .same { color: blue; }`;
+    document.body.appendChild(style);
+
+    const div = document.createElement('div');
+    div.className = 'box';
+    document.body.appendChild(div);
+  )JS";
+  env->page()->evaluateScript(setup, strlen(setup), "vm://", 0);
+  TEST_runLoop(context);
+
+  // Matching an extra rule that does not change any winning value must not
+  // re-send the element's style.
+  auto commands = RunAndCollectStyleCommands(env.get(), "document.querySelector('.box').classList.add('same');");
+
+  EXPECT_EQ(CountCommands(commands, UICommand::kClearStyle), 0);
+  EXPECT_EQ(CountCommands(commands, UICommand::kSetStyleById), 0);
+  EXPECT_EQ(CountCommands(commands, UICommand::kSetStyleByIdTyped), 0);
+  EXPECT_EQ(CountCommands(commands, UICommand::kSetStyle), 0);
+}
+
+TEST(ExportedStyleSnapshot, ClassToggleEmitsOnlyChangedProperties) {
+  auto env = TEST_init(nullptr, nullptr, 0, /*enable_blink=*/1);
+  auto* context = env->page()->executingContext();
+  TEST_runLoop(context);
+
+  const char* setup = R"JS(
+    const style = document.createElement('style');
+    style.textContent = `.box { color: blue; width: 10px; --accent: red; } .wide { width: 20px; }`;
+    document.body.appendChild(style);
+
+    const div = document.createElement('div');
+    div.className = 'box';
+    document.body.appendChild(div);
+  )JS";
+  env->page()->evaluateScript(setup, strlen(setup), "vm://", 0);
+  TEST_runLoop(context);
+
+  auto commands = RunAndCollectStyleCommands(env.get(), "document.querySelector('.box').classList.add('wide');");
+
+  EXPECT_EQ(CountCommands(commands, UICommand::kClearStyle), 0);
+  EXPECT_EQ(CountCommands(commands, UICommand::kSetStyleById), 0);
+  EXPECT_EQ(CountCommands(commands, UICommand::kSetStyleByIdTyped), 1);
+  EXPECT_EQ(CountCommands(commands, UICommand::kSetStyle), 0);
+  EXPECT_NE(FindStyleCommand(commands, UICommand::kSetStyleByIdTyped, CSSPropertyID::kWidth), nullptr);
+}
+
+TEST(ExportedStyleSnapshot, RemovedDeclarationsAreSentAsEmptyValues) {
+  auto env = TEST_init(nullptr, nullptr, 0, /*enable_blink=*/1);
+  auto* context = env->page()->executingContext();
+  TEST_runLoop(context);
+
+  const char* setup = R"JS(
+    const style = document.createElement('style');
+    style.textContent = `.box { color: blue; } .wide { width: 20px; --accent: red; }`;
+    document.body.appendChild(style);
+
+    const div = document.createElement('div');
+    div.className = 'box wide';
+    document.body.appendChild(div);
+  )JS";
+  env->page()->evaluateScript(setup, strlen(setup), "vm://", 0);
+  TEST_runLoop(context);
+
+  auto commands = RunAndCollectStyleCommands(env.get(), "document.querySelector('.box').classList.remove('wide');");
+
+  EXPECT_EQ(CountCommands(commands, UICommand::kClearStyle), 0);
+  EXPECT_EQ(CountCommands(commands, UICommand::kSetStyleById), 1);
+  EXPECT_EQ(CountCommands(commands, UICommand::kSetStyleByIdTyped), 0);
+  EXPECT_EQ(CountCommands(commands, UICommand::kSetStyle), 1);
+  const UICommandItem* width = FindStyleCommand(commands, UICommand::kSetStyleById, CSSPropertyID::kWidth);
+  ASSERT_NE(width, nullptr);
+  EXPECT_EQ(width->string_01, 0);
+}
+
+TEST(ExportedStyleSnapshot, ElementsMatchingTheSameRulesShareOneExport) {
+  auto env = TEST_init(nullptr, nullptr, 0, /*enable_blink=*/1);
+  auto* context = env->page()->executingContext();
+  TEST_runLoop(context);
+
+  const char* setup = R"JS(
+    const style = document.createElement('style');
+    style.textContent = `.item { color: blue; width: 10px; } .wide { width: 20px; }`;
+    document.body.appendChild(style);
+
+    const list = document.createElement('div');
+    for (let i = 0; i < 20; i++) {
+      const item = document.createElement('div');
+      item.className = 'item';
+      item.id = 'item-' + i;
+      list.appendChild(item);
+    }
+    list.lastChild.className = 'item wide';
+    document.body.appendChild(list);
+  )JS";
+  auto commands = RunAndCollectStyleCommands(env.get(), setup);
+
+  // Every element still gets its own commands.
+  EXPECT_GE(CountCommands(commands, UICommand::kSetStyleByIdTyped), 20);
+
+  TreeScope& scope = *context->document();
+  Element* first = scope.getElementById(AtomicString::CreateFromUTF8("item-0"));
+  Element* second = scope.getElementById(AtomicString::CreateFromUTF8("item-1"));
+  Element* wide = scope.getElementById(AtomicString::CreateFromUTF8("item-19"));
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  ASSERT_NE(wide, nullptr);
+  ASSERT_NE(first->GetExportedStyleSnapshot(), nullptr);
+  EXPECT_EQ(first->GetExportedStyleSnapshot(), second->GetExportedStyleSnapshot());
+  EXPECT_NE(first->GetExportedStyleSnapshot(), wide->GetExportedStyleSnapshot());
+
+  const MatchedPropertiesCache& cache =
+      context->document()->EnsureStyleEngine().EnsureStyleResolver().GetMatchedPropertiesCache();
+  EXPECT_GE(cache.hit_count(), 18u);
+}
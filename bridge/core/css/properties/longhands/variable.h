@@ -29,7 +29,7 @@ class Variable : public Longhand {
   const AtomicString& GetPropertyNameAtomicString() const override {
     // TODO(xiezuobing):
     ExecutingContext* context;
-    static const AtomicString name = AtomicString::CreateFromUTF8("variable", sizeof("variable") - 1);
+    static const AtomicString name = AtomicString::CreateStatic("variable");
     return name;
   }
 
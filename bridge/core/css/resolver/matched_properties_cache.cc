@@ -4,129 +4,90 @@
 
 #include "matched_properties_cache.h"
 
-#include "core/css/css_property_value_set.h"
-#include "core/css/resolver/style_resolver_state.h"
-#include "core/dom/element.h"
-#include "core/style/computed_style.h"
+#include "core/platform/hash_functions.h"
 
 namespace webf {
 
+namespace {
+
+// Homogeneous content only needs a handful of distinct entries; anything past
+// this is a page with little to share, so start over rather than grow.
+constexpr size_t kMaxCacheSize = 1000;
+
+bool SameMatchedProperties(const std::vector<MatchResult::MatchedProperties>& cached, const MatchResult& result) {
+  const auto& matched = result.GetMatchedProperties();
+  if (cached.size() != matched.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < matched.size(); ++i) {
+    if (cached[i].properties != matched[i].properties || cached[i].origin != matched[i].origin ||
+        cached[i].layer_level != matched[i].layer_level) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 MatchedPropertiesCache::MatchedPropertiesCache() = default;
 
 MatchedPropertiesCache::~MatchedPropertiesCache() = default;
 
-const MatchedPropertiesCache::CacheEntry* MatchedPropertiesCache::Find(
-    const Key& key,
-    const StyleResolverState& state) {
-  
-  if (!is_enabled_) {
-    return nullptr;
+bool MatchedPropertiesCache::IsCacheable(const MatchResult& result) {
+  for (const auto& entry : result.GetMatchedProperties()) {
+    if (entry.is_inline_style) {
+      return false;
+    }
   }
-  
-  auto it = cache_.find(key);
-  if (it == cache_.end()) {
-    ++miss_count_;
-    return nullptr;
+  return true;
+}
+
+unsigned MatchedPropertiesCache::ComputeMatchedPropertiesHash(const MatchResult& result) {
+  unsigned hash = 0;
+  for (const auto& entry : result.GetMatchedProperties()) {
+    AddIntToHash(hash, HashPointer(entry.properties));
+    AddIntToHash(hash, static_cast<unsigned>(entry.origin));
+    AddIntToHash(hash, entry.layer_level);
   }
-  
-  const CacheEntry& entry = it->second;
-  
-  // Verify the cached entry is still valid
-  if (!IsValid(entry, state)) {
-    // Remove invalid entry
-    cache_.erase(it);
-    ++miss_count_;
+  return hash;
+}
+
+MatchedPropertiesCache::Entry* MatchedPropertiesCache::Find(unsigned hash, const MatchResult& result) {
+  if (!IsEnabled()) {
     return nullptr;
   }
-  
-  ++hit_count_;
-  return &entry;
+
+  auto range = cache_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (SameMatchedProperties(it->second.matched_properties, result)) {
+      ++hit_count_;
+      return &it->second;
+    }
+  }
+  ++miss_count_;
+  return nullptr;
 }
 
-void MatchedPropertiesCache::Add(
-    const Key& key,
-    std::shared_ptr<const ComputedStyle> style,
-    std::shared_ptr<const ComputedStyle> parent_style) {
-  
-  if (!is_enabled_ || !style) {
-    return;
+MatchedPropertiesCache::Entry* MatchedPropertiesCache::Add(unsigned hash,
+                                                           const MatchResult& result,
+                                                           std::shared_ptr<MutableCSSPropertyValueSet> property_set) {
+  if (!IsEnabled()) {
+    return nullptr;
   }
-  
-  // Limit cache size to prevent unbounded growth
-  static const size_t kMaxCacheSize = 1000;
+
   if (cache_.size() >= kMaxCacheSize) {
-    // Simple eviction: clear the entire cache
-    // TODO: Implement LRU or other eviction strategy
-    Clear();
+    cache_.clear();
   }
-  
-  CacheEntry entry;
-  entry.computed_style = style;
-  entry.parent_computed_style = parent_style;
-  
-  cache_[key] = entry;
-  ++add_count_;
+
+  Entry entry;
+  entry.matched_properties = result.GetMatchedProperties();
+  entry.property_set = std::move(property_set);
+  return &cache_.emplace(hash, std::move(entry))->second;
 }
 
 void MatchedPropertiesCache::Clear() {
   cache_.clear();
-  hit_count_ = 0;
-  miss_count_ = 0;
-  add_count_ = 0;
-}
-
-bool MatchedPropertiesCache::IsValid(
-    const CacheEntry& entry,
-    const StyleResolverState& state) const {
-  
-  if (!entry.computed_style) {
-    return false;
-  }
-  
-  // Check if parent style matches
-  const ComputedStyle* current_parent = state.ParentStyle();
-  const ComputedStyle* cached_parent = entry.parent_computed_style.get();
-  
-  if (current_parent != cached_parent) {
-    // Parent style has changed
-    return false;
-  }
-  
-  // TODO: Add more validation checks:
-  // - Font size changes that affect em/rem units
-  // - Viewport size changes that affect viewport units
-  // - Custom property changes
-  // - Container query changes
-  
-  return true;
-}
-
-unsigned MatchedPropertiesCache::ComputeMatchedPropertiesHash(
-    const MatchResult& result) {
-  
-  unsigned hash = 0;
-  
-  for (const auto& entry : result.GetMatchedProperties()) {
-    if (!entry.properties) {
-      continue;
-    }
-    
-    // Simple hash combining property count and first few properties
-    hash = (hash << 5) ^ entry.properties->PropertyCount();
-    
-    // Hash first few properties
-    for (unsigned i = 0; i < std::min(3u, entry.properties->PropertyCount()); ++i) {
-      const auto property = entry.properties->PropertyAt(i);
-      hash = (hash << 3) ^ static_cast<unsigned>(property.Id());
-      hash = (hash << 1) ^ (property.IsImportant() ? 1 : 0);
-    }
-    
-    // Include origin and layer in hash
-    hash = (hash << 2) ^ static_cast<unsigned>(entry.origin);
-    hash = (hash << 4) ^ entry.layer_level;
-  }
-  
-  return hash;
 }
 
-}  // namespace webf
\ No newline at end of file
+}  // namespace webf
@@ -7,89 +7,77 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
+#include "core/css/css_property_value_set.h"
+#include "core/css/exported_style_snapshot.h"
 #include "core/css/match_result.h"
-#include "core/style/computed_style.h"
 #include "foundation/macros.h"
 
 namespace webf {
 
-class Element;
-class StyleResolverState;
-
-// Cache for matched properties to avoid redundant style resolution
+// Caches what the cascade exported for a match result, so that siblings and
+// cousins whose rules matched the same declaration blocks (long lists, table
+// rows) reuse one winning property set and one exported snapshot instead of
+// running StyleCascade and the export serialization per element.
+//
+// Entries are keyed on the identity of the matched declaration blocks, which
+// is only stable while no script runs. The cache is therefore only enabled
+// inside a RecalcScope and is emptied when the outermost scope ends.
 class MatchedPropertiesCache {
-
  public:
   MatchedPropertiesCache();
   ~MatchedPropertiesCache();
 
-  // Cache key for looking up cached styles
-  struct Key {
-    // Hash of matched properties
-    unsigned matched_properties_hash = 0;
-    
-    // Parent style hash
-    unsigned parent_style_hash = 0;
-    
-    // Element characteristics
-    bool is_link = false;
-    bool is_visited_link = false;
-    
-    bool operator==(const Key& other) const {
-      return matched_properties_hash == other.matched_properties_hash &&
-             parent_style_hash == other.parent_style_hash &&
-             is_link == other.is_link &&
-             is_visited_link == other.is_visited_link;
-    }
+  struct Entry {
+    std::vector<MatchResult::MatchedProperties> matched_properties;
+    std::shared_ptr<MutableCSSPropertyValueSet> property_set;
+    // Built on first use; pseudo-element exports only need |property_set|.
+    std::shared_ptr<ExportedStyleSnapshot> snapshot;
+    bool display_none = false;
   };
-  
-  struct KeyHash {
-    size_t operator()(const Key& key) const {
-      size_t hash = key.matched_properties_hash;
-      hash = (hash << 5) ^ key.parent_style_hash;
-      if (key.is_link) hash ^= 1;
-      if (key.is_visited_link) hash ^= 2;
-      return hash;
+
+  class RecalcScope {
+    WEBF_STACK_ALLOCATED();
+
+   public:
+    explicit RecalcScope(MatchedPropertiesCache& cache) : cache_(cache) { cache_.scope_depth_++; }
+    ~RecalcScope() {
+      if (--cache_.scope_depth_ == 0) {
+        cache_.Clear();
+      }
     }
-  };
 
-  // Cache entry containing computed style
-  struct CacheEntry {
-    std::shared_ptr<const ComputedStyle> computed_style;
-    std::shared_ptr<const ComputedStyle> parent_computed_style;
+   private:
+    MatchedPropertiesCache& cache_;
   };
 
-  // Try to find a cached style
-  const CacheEntry* Find(const Key&, const StyleResolverState&);
+  // Inline style blocks belong to a single element and are mutated in place,
+  // so match results that include one are never cached.
+  static bool IsCacheable(const MatchResult&);
+  static unsigned ComputeMatchedPropertiesHash(const MatchResult&);
 
-  // Add a style to the cache
-  void Add(const Key&, 
-           std::shared_ptr<const ComputedStyle>,
-           std::shared_ptr<const ComputedStyle> parent);
+  // Returns the entry for exactly the same matched declaration blocks, or
+  // nullptr. The pointer stays valid until the next Add() or Clear().
+  Entry* Find(unsigned hash, const MatchResult&);
+  Entry* Add(unsigned hash, const MatchResult&, std::shared_ptr<MutableCSSPropertyValueSet> property_set);
 
-  // Clear the cache
   void Clear();
 
-  // Check if caching is enabled
-  bool IsEnabled() const { return is_enabled_; }
+  bool IsEnabled() const { return is_enabled_ && scope_depth_ > 0; }
   void SetEnabled(bool enabled) { is_enabled_ = enabled; }
 
- private:
-  // Verify that a cached entry is still valid
-  bool IsValid(const CacheEntry&, const StyleResolverState&) const;
-
-  // Compute hash for matched properties
-  static unsigned ComputeMatchedPropertiesHash(const MatchResult&);
+  unsigned hit_count() const { return hit_count_; }
+  unsigned miss_count() const { return miss_count_; }
 
-  std::unordered_map<Key, CacheEntry, KeyHash> cache_;
+ private:
+  std::unordered_multimap<unsigned, Entry> cache_;
   bool is_enabled_ = true;
-  
-  // Cache statistics
-  mutable unsigned hit_count_ = 0;
-  mutable unsigned miss_count_ = 0;
-  mutable unsigned add_count_ = 0;
+  unsigned scope_depth_ = 0;
+
+  unsigned hit_count_ = 0;
+  unsigned miss_count_ = 0;
 };
 
 }  // namespace webf
 
-#endif  // WEBF_CSS_RESOLVER_MATCHED_PROPERTIES_CACHE_H
\ No newline at end of file
+#endif  // WEBF_CSS_RESOLVER_MATCHED_PROPERTIES_CACHE_H
@@ -183,6 +183,8 @@ class StyleResolver final {
 
  Document& GetDocument() const;
 
+  MatchedPropertiesCache& GetMatchedPropertiesCache() { return *matched_properties_cache_; }
+
   void SetRuleUsageTracker(StyleRuleUsageTracker*);
 
   void SetResizedForViewportUnits();
@@ -183,7 +183,7 @@ void WalkRulesFromChildVector(RuleSet& rule_set,
 
 }  // namespace
 
-const std::vector<std::shared_ptr<RuleData>> RuleSet::empty_rule_data_vector_;
+const RuleSet::RuleDataVector RuleSet::empty_rule_data_vector_;
 
 RuleData::RuleData(std::shared_ptr<StyleRule> rule,
                    unsigned selector_index,
@@ -211,8 +211,19 @@ RuleData::RuleData(std::shared_ptr<StyleRule> rule,
       }
     }
 
-    // Precompute ancestor identifier hashes for SelectorFilter.
-    SelectorFilter::CollectIdentifierHashes(selector, ancestor_identifier_hashes_);
+    // Precompute ancestor identifier hashes for SelectorFilter. A zero hash
+    // would terminate the list early, so skip it.
+    std::vector<uint32_t> hashes;
+    SelectorFilter::CollectIdentifierHashes(selector, hashes);
+    unsigned count = 0;
+    for (uint32_t hash : hashes) {
+      if (count == kMaxIdentifierHashes) {
+        break;
+      }
+      if (hash) {
+        ancestor_identifier_hashes_[count++] = hash;
+      }
+    }
   }
 }
 
@@ -272,16 +283,16 @@ void RuleSet::AddRule(std::shared_ptr<StyleRule> rule,
     return;
   }
   
-  auto rule_data = std::make_shared<RuleData>(rule, selector_index, rule_count_++, cascade_layer);
+  RuleData rule_data(std::move(rule), selector_index, rule_count_++, cascade_layer);
   
   // Update selector / invalidation features used for RuleInvalidationData.
   // We currently do not track style scopes here, so pass nullptr.
-  features_.CollectFeaturesFromSelector(rule_data->Selector(), nullptr);
+  features_.CollectFeaturesFromSelector(rule_data.Selector(), nullptr);
   
   // Find the best rule set for this selector
-  RuleDataVector* rules = FindBestRuleSetForSelector(rule_data->Selector());
+  RuleDataVector* rules = FindBestRuleSetForSelector(rule_data.Selector());
   if (rules) {
-    rules->push_back(rule_data);
+    rules->push_back(std::move(rule_data));
   }
 }
 
@@ -310,32 +321,32 @@ void RuleSet::AddStyleRule(std::shared_ptr<StyleRule> rule,
   }
 }
 
-const std::vector<std::shared_ptr<RuleData>>& RuleSet::IdRules(
+const RuleSet::RuleDataVector& RuleSet::IdRules(
     const AtomicString& id) const {
   
   auto it = id_rules_.find(id);
-  if (it != id_rules_.end() && it->second) {
-    return *it->second;
+  if (it != id_rules_.end()) {
+    return it->second;
   }
   return empty_rule_data_vector_;
 }
 
-const std::vector<std::shared_ptr<RuleData>>& RuleSet::ClassRules(
+const RuleSet::RuleDataVector& RuleSet::ClassRules(
     const AtomicString& class_name) const {
   
   auto it = class_rules_.find(class_name);
-  if (it != class_rules_.end() && it->second) {
-    return *it->second;
+  if (it != class_rules_.end()) {
+    return it->second;
   }
   return empty_rule_data_vector_;
 }
 
-const std::vector<std::shared_ptr<RuleData>>& RuleSet::TagRules(
+const RuleSet::RuleDataVector& RuleSet::TagRules(
     const AtomicString& tag_name) const {
   if (!tag_name.IsNull()) {
     auto it = tag_rules_.find(tag_name);
-    if (it != tag_rules_.end() && it->second) {
-      return *it->second;
+    if (it != tag_rules_.end()) {
+      return it->second;
     }
 
     // HTML tag selectors are ASCII case-insensitive. Retry lookup using
@@ -343,16 +354,16 @@ const std::vector<std::shared_ptr<RuleData>>& RuleSet::TagRules(
     AtomicString lower = tag_name.LowerASCII();
     if (lower != tag_name) {
       it = tag_rules_.find(lower);
-      if (it != tag_rules_.end() && it->second) {
-        return *it->second;
+      if (it != tag_rules_.end()) {
+        return it->second;
       }
     }
 
     AtomicString upper = tag_name.UpperASCII();
     if (upper != tag_name) {
       it = tag_rules_.find(upper);
-      if (it != tag_rules_.end() && it->second) {
-        return *it->second;
+      if (it != tag_rules_.end()) {
+        return it->second;
       }
     }
 
@@ -361,30 +372,47 @@ const std::vector<std::shared_ptr<RuleData>>& RuleSet::TagRules(
     // “BoDy”).
     StringView needle(tag_name);
     for (const auto& entry : tag_rules_) {
-      if (!entry.second || entry.second->empty()) {
+      if (entry.second.empty()) {
         continue;
       }
       const AtomicString& key = entry.first;
       if (EqualIgnoringASCIICase(StringView(key), needle)) {
-        return *entry.second;
+        return entry.second;
       }
     }
   }
   return empty_rule_data_vector_;
 }
 
-const std::vector<std::shared_ptr<RuleData>>& RuleSet::ShadowPseudoElementRules(
+const RuleSet::RuleDataVector& RuleSet::ShadowPseudoElementRules(
     const AtomicString& pseudo) const {
   
   auto it = shadow_pseudo_element_rules_.find(pseudo);
-  if (it != shadow_pseudo_element_rules_.end() && it->second) {
-    return *it->second;
+  if (it != shadow_pseudo_element_rules_.end()) {
+    return it->second;
   }
   return empty_rule_data_vector_;
 }
 
 void RuleSet::CompactRulesIfNeeded() {
-  // TODO: Implement rule compaction for memory efficiency
+  auto compact_map = [](RuleDataMap& map) {
+    for (auto it = map.begin(); it != map.end();) {
+      if (it->second.empty()) {
+        it = map.erase(it);
+        continue;
+      }
+      it->second.shrink_to_fit();
+      ++it;
+    }
+  };
+
+  universal_rules_.shrink_to_fit();
+  compact_map(id_rules_);
+  compact_map(class_rules_);
+  compact_map(tag_rules_);
+  compact_map(shadow_pseudo_element_rules_);
+  link_pseudo_class_rules_.shrink_to_fit();
+  focus_pseudo_class_rules_.shrink_to_fit();
 }
 
 RuleSet::RuleDataVector* RuleSet::FindBestRuleSetForSelector(
@@ -432,19 +460,11 @@ RuleSet::RuleDataVector* RuleSet::FindBestRuleSetForSelector(
   }
 
   if (found_id) {
-    const AtomicString& id = found_id->Value();
-    if (id_rules_.find(id) == id_rules_.end()) {
-      id_rules_[id] = std::make_unique<RuleDataVector>();
-    }
-    return id_rules_[id].get();
+    return &id_rules_[found_id->Value()];
   }
 
   if (found_class) {
-    const AtomicString& class_name = found_class->Value();
-    if (class_rules_.find(class_name) == class_rules_.end()) {
-      class_rules_[class_name] = std::make_unique<RuleDataVector>();
-    }
-    return class_rules_[class_name].get();
+    return &class_rules_[found_class->Value()];
   }
 
   if (found_tag) {
@@ -454,10 +474,7 @@ RuleSet::RuleDataVector* RuleSet::FindBestRuleSetForSelector(
       if (bucket.Is8Bit()) {
         bucket = tag_name.LowerASCII();
       }
-      if (tag_rules_.find(bucket) == tag_rules_.end()) {
-        tag_rules_[bucket] = std::make_unique<RuleDataVector>();
-      }
-      return tag_rules_[bucket].get();
+      return &tag_rules_[bucket];
     }
   }
 
@@ -481,15 +498,8 @@ RuleSet::RuleDataVector* RuleSet::FindBestRuleSetForSelector(
   return &universal_rules_;
 }
 
-void RuleSet::AddToRuleSet(
-    const AtomicString& key,
-    std::unordered_map<AtomicString, std::unique_ptr<RuleDataVector>, AtomicString::KeyHasher>& rules,
-    std::shared_ptr<RuleData> rule_data) {
-  
-  if (rules.find(key) == rules.end()) {
-    rules[key] = std::make_unique<RuleDataVector>();
-  }
-  rules[key]->push_back(rule_data);
+void RuleSet::AddToRuleSet(const AtomicString& key, RuleDataMap& rules, RuleData&& rule_data) {
+  rules[key].push_back(std::move(rule_data));
 }
 
 }  // namespace webf
@@ -66,7 +66,7 @@ class RuleData {
     return rule_->SelectorAt(selector_index_); 
   }
   
-  std::shared_ptr<StyleRule> Rule() const { return rule_; }
+  const std::shared_ptr<StyleRule>& Rule() const { return rule_; }
   unsigned SelectorIndex() const { return selector_index_; }
   unsigned Position() const { return position_; }
   unsigned SelectorSpecificity() const { return specificity_; }
@@ -76,8 +76,12 @@ class RuleData {
   bool HasRightmostType() const { return has_rightmost_type_; }
   const AtomicString& RightmostTag() const { return rightmost_tag_; }
 
-  // SelectorFilter precomputed hashes for ancestor requirements.
-  const std::vector<uint32_t>& AncestorIdentifierHashes() const { return ancestor_identifier_hashes_; }
+  // SelectorFilter precomputed hashes for ancestor requirements, kept inline
+  // like Blink so a bucket scan can reject rules without chasing a pointer.
+  // Holds at most kMaxIdentifierHashes entries, zero-terminated when shorter.
+  // Dropping hashes past the limit only makes the prefilter less selective.
+  static constexpr unsigned kMaxIdentifierHashes = 4;
+  const uint32_t* AncestorIdentifierHashes() const { return ancestor_identifier_hashes_; }
 
  private:
   std::shared_ptr<StyleRule> rule_;
@@ -90,9 +94,9 @@ class RuleData {
   bool has_rightmost_type_ = false;
   AtomicString rightmost_tag_;
 
-  // Hashes for SelectorFilter::FastRejectSelector(). Empty when the selector
-  // has no ancestor identifier requirements.
-  std::vector<uint32_t> ancestor_identifier_hashes_;
+  // Hashes for SelectorFilter::FastRejectSelector(). Starts with zero when
+  // the selector has no ancestor identifier requirements.
+  uint32_t ancestor_identifier_hashes_[kMaxIdentifierHashes] = {};
 };
 
 // Container for rules organized by selector characteristics
@@ -120,20 +124,20 @@ class RuleSet {
   void AddStyleRule(std::shared_ptr<StyleRule>, AddRuleFlags, const CascadeLayer* cascade_layer);
 
   // Get rules by category
-  const std::vector<std::shared_ptr<RuleData>>& UniversalRules() const { 
+  const std::vector<RuleData>& UniversalRules() const { 
     return universal_rules_; 
   }
   
-  const std::vector<std::shared_ptr<RuleData>>& IdRules(
+  const std::vector<RuleData>& IdRules(
       const AtomicString& id) const;
   
-  const std::vector<std::shared_ptr<RuleData>>& ClassRules(
+  const std::vector<RuleData>& ClassRules(
       const AtomicString& class_name) const;
   
-  const std::vector<std::shared_ptr<RuleData>>& TagRules(
+  const std::vector<RuleData>& TagRules(
       const AtomicString& tag_name) const;
   
-  const std::vector<std::shared_ptr<RuleData>>& ShadowPseudoElementRules(
+  const std::vector<RuleData>& ShadowPseudoElementRules(
       const AtomicString& pseudo) const;
 
   // Get features
@@ -142,26 +146,30 @@ class RuleSet {
   // Statistics
   unsigned RuleCount() const { return rule_count_; }
   
+  // Releases the spare capacity left in the buckets once all rules have been
+  // added. Adding more rules afterwards is allowed but reallocates.
   void CompactRulesIfNeeded();
   const CascadeLayer* GetCascadeLayerRoot() const { return cascade_layer_root_.get(); }
   CascadeLayer* GetMutableCascadeLayerRoot() { return cascade_layer_root_.get(); }
 
  private:
-  using RuleDataVector = std::vector<std::shared_ptr<RuleData>>;
-  
+  // RuleData is stored by value so that matching walks each bucket as one
+  // contiguous array.
+  using RuleDataVector = std::vector<RuleData>;
+  using RuleDataMap = std::unordered_map<AtomicString, RuleDataVector, AtomicString::KeyHasher>;
+
+
   // Find the appropriate list for a selector
   RuleDataVector* FindBestRuleSetForSelector(const CSSSelector&);
   
-  void AddToRuleSet(const AtomicString& key,
-                   std::unordered_map<AtomicString, std::unique_ptr<RuleDataVector>, AtomicString::KeyHasher>&,
-                   std::shared_ptr<RuleData>);
+  void AddToRuleSet(const AtomicString& key, RuleDataMap&, RuleData&&);
 
   // Rules organized by selector type for efficient matching
   RuleDataVector universal_rules_;
-  std::unordered_map<AtomicString, std::unique_ptr<RuleDataVector>, AtomicString::KeyHasher> id_rules_;
-  std::unordered_map<AtomicString, std::unique_ptr<RuleDataVector>, AtomicString::KeyHasher> class_rules_;
-  std::unordered_map<AtomicString, std::unique_ptr<RuleDataVector>, AtomicString::KeyHasher> tag_rules_;
-  std::unordered_map<AtomicString, std::unique_ptr<RuleDataVector>, AtomicString::KeyHasher> shadow_pseudo_element_rules_;
+  RuleDataMap id_rules_;
+  RuleDataMap class_rules_;
+  RuleDataMap tag_rules_;
+  RuleDataMap shadow_pseudo_element_rules_;
   
   // Link pseudo class rules
   RuleDataVector link_pseudo_class_rules_;
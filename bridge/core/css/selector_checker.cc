@@ -66,14 +66,14 @@ namespace webf {
 
 // Shadow element names used by UA shadow DOM
 namespace shadow_element_names {
-const AtomicString kPseudoFileUploadButton = AtomicString::CreateFromUTF8("file-upload-button");
-const AtomicString kSelectFallbackButton = AtomicString::CreateFromUTF8("select-fallback-button");
-const AtomicString kSelectFallbackButtonIcon = AtomicString::CreateFromUTF8("select-fallback-button-icon");
-const AtomicString kSelectFallbackButtonText = AtomicString::CreateFromUTF8("select-fallback-button-text");
-const AtomicString kSelectFallbackDatalist = AtomicString::CreateFromUTF8("select-fallback-datalist");
-const AtomicString kPseudoInputPlaceholder = AtomicString::CreateFromUTF8("input-placeholder");
-const AtomicString kIdDetailsContent = AtomicString::CreateFromUTF8("details-content");
-const AtomicString kPlaceholder = AtomicString::CreateFromUTF8("placeholder");
+const AtomicString kPseudoFileUploadButton = AtomicString::CreateStatic("file-upload-button");
+const AtomicString kSelectFallbackButton = AtomicString::CreateStatic("select-fallback-button");
+const AtomicString kSelectFallbackButtonIcon = AtomicString::CreateStatic("select-fallback-button-icon");
+const AtomicString kSelectFallbackButtonText = AtomicString::CreateStatic("select-fallback-button-text");
+const AtomicString kSelectFallbackDatalist = AtomicString::CreateStatic("select-fallback-datalist");
+const AtomicString kPseudoInputPlaceholder = AtomicString::CreateStatic("input-placeholder");
+const AtomicString kIdDetailsContent = AtomicString::CreateStatic("details-content");
+const AtomicString kPlaceholder = AtomicString::CreateStatic("placeholder");
 }  // namespace shadow_element_names
 
 // Stub for probe namespace - WebF doesn't have devtools probe functionality
@@ -107,17 +107,17 @@ static bool IsFrameFocused(const Element& element) {
 }
 
 static const AtomicString& SelectTagName() {
-  static const AtomicString kSelect = AtomicString::CreateFromUTF8("select");
+  static const AtomicString kSelect = AtomicString::CreateStatic("select");
   return kSelect;
 }
 
 static const AtomicString& OptionTagName() {
-  static const AtomicString kOption = AtomicString::CreateFromUTF8("option");
+  static const AtomicString kOption = AtomicString::CreateStatic("option");
   return kOption;
 }
 
 static const AtomicString& SelectedAttrName() {
-  static const AtomicString kSelected = AtomicString::CreateFromUTF8("selected");
+  static const AtomicString kSelected = AtomicString::CreateStatic("selected");
   return kSelected;
 }
 
@@ -38,6 +38,18 @@ class SelectorFilter {
 
   // Fast reject using precomputed identifier hashes.
   bool FastRejectSelector(const std::vector<uint32_t>& identifier_hashes) const;
+
+  // Same as above for hashes stored inline in a fixed-size array, which ends
+  // at the first zero entry.
+  template <unsigned kMaxHashes>
+  bool FastRejectSelector(const uint32_t* identifier_hashes) const {
+    for (unsigned i = 0; i < kMaxHashes && identifier_hashes[i]; ++i) {
+      if (!MayContainHash(identifier_hashes[i])) {
+        return true;
+      }
+    }
+    return false;
+  }
   
   // Check if a selector might match
   bool MightMatch(const CSSSelector&) const;
@@ -27,103 +27,105 @@
 #ifndef WEBF_CORE_CSS_SELECTOR_QUERY_H_
 #define WEBF_CORE_CSS_SELECTOR_QUERY_H_
 
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "bindings/qjs/exception_state.h"
 #include "core/css/css_selector_list.h"
-#include "foundation/macros.h"
+#include "foundation/string/atomic_string.h"
 
 namespace webf {
-//
-// class CSSSelector;
-// class ContainerNode;
-// class Document;
-// class Element;
-// class ExceptionState;
-////template <typename NodeType>
-//
-////class StaticNodeTypeList;
-////using StaticElementList = StaticNodeTypeList<Element>;
-//
-// class SelectorQuery {
-//  USING_FAST_MALLOC(SelectorQuery);
-//
-// public:
-//  SelectorQuery(const SelectorQuery&) = delete;
-//  SelectorQuery& operator=(const SelectorQuery&) = delete;
-//
-//  static std::unique_ptr<SelectorQuery> Adopt(CSSSelectorList*);
-//
-//  // https://dom.spec.whatwg.org/#dom-element-matches
-//  bool Matches(Element&) const;
-//
-//  // https://dom.spec.whatwg.org/#dom-element-closest
-//  Element* Closest(Element&) const;
-//
-//  // https://dom.spec.whatwg.org/#dom-parentnode-queryselectorall
-////  StaticElementList* QueryAll(ContainerNode& root_node) const;
-//
-//  // https://dom.spec.whatwg.org/#dom-parentnode-queryselector
-//  Element* QueryFirst(ContainerNode& root_node) const;
-//
-//  struct QueryStats {
-//    unsigned total_count;
-//    unsigned fast_id;
-//    unsigned fast_class;
-//    unsigned fast_tag_name;
-//    unsigned fast_scan;
-//    unsigned slow_scan;
-//    unsigned slow_traversing_shadow_tree_scan;
-//  };
-//  // Used by unit tests to get information about what paths were taken during
-//  // the last query. Always reset between queries. This system is disabled in
-//  // non DCHECK builds to avoid the overhead on the query process.
-//  static QueryStats LastQueryStats();
-//
-// private:
-//  explicit SelectorQuery(CSSSelectorList*);
-//
-//  template <typename SelectorQueryTrait>
-//  void ExecuteWithId(ContainerNode& root_node,
-//                     typename SelectorQueryTrait::OutputType&) const;
-//  template <typename SelectorQueryTrait>
-//  void FindTraverseRootsAndExecute(
-//      ContainerNode& root_node,
-//      typename SelectorQueryTrait::OutputType&) const;
-//  template <typename SelectorQueryTrait>
-//  void ExecuteForTraverseRoot(ContainerNode& traverse_root,
-//                              ContainerNode& root_node,
-//                              typename SelectorQueryTrait::OutputType&) const;
-//  template <typename SelectorQueryTrait>
-//  void ExecuteSlow(ContainerNode& root_node,
-//                   typename SelectorQueryTrait::OutputType&) const;
-//  template <typename SelectorQueryTrait>
-//  void Execute(ContainerNode& root_node,
-//               typename SelectorQueryTrait::OutputType&) const;
-//
-//  bool SelectorListMatches(ContainerNode& root_node, Element&) const;
-//
-//  // TODO(sesse): Consider moving SelectorQuery to Oilpan.
-//  std::unique_ptr<CSSSelectorList> selector_list_;
-//  // Contains the list of CSSSelector's to match, but without ones that could
-//  // never match like pseudo elements, div::before. This can be empty, while
-//  // |selector_list_| will never be empty as SelectorQueryCache::add would have
-//  // thrown an exception.
-//  std::vector<std::shared_ptr<const CSSSelector>> selectors_;
-//  AtomicString selector_id_;
-//  bool selector_id_is_rightmost_ : 1;
-//  bool selector_id_affected_by_sibling_combinator_ : 1;
-//  bool use_slow_scan_ : 1;
-//};
-//
-// class SelectorQueryCache {
-//  USING_FAST_MALLOC(SelectorQueryCache);
-//
-// public:
-//  SelectorQuery* Add(const AtomicString&, const Document&, ExceptionState&);
-//  void Invalidate();
-//
-// private:
-//  std::unordered_map<AtomicString, std::unique_ptr<SelectorQuery>> entries_;
-//};
-
-}
+
+class CSSSelector;
+class ContainerNode;
+class Element;
+
+// A parsed selector list plus the fast-path analysis Blink performs once per
+// selector string, so repeated querySelector*/matches/closest calls skip both
+// the CSS parser and the generic descendant scan where possible.
+class SelectorQuery {
+ public:
+  SelectorQuery(const SelectorQuery&) = delete;
+  SelectorQuery& operator=(const SelectorQuery&) = delete;
+
+  static std::unique_ptr<SelectorQuery> Adopt(std::shared_ptr<CSSSelectorList>);
+
+  // https://dom.spec.whatwg.org/#dom-element-matches
+  bool Matches(Element&) const;
+
+  // https://dom.spec.whatwg.org/#dom-element-closest
+  Element* Closest(Element&) const;
+
+  // https://dom.spec.whatwg.org/#dom-parentnode-queryselectorall
+  std::vector<Element*> QueryAll(ContainerNode& root_node) const;
+
+  // https://dom.spec.whatwg.org/#dom-parentnode-queryselector
+  Element* QueryFirst(ContainerNode& root_node) const;
+
+  struct QueryStats {
+    unsigned total_count;
+    unsigned fast_id;
+    unsigned fast_class;
+    unsigned fast_tag_name;
+    unsigned fast_scan;
+    unsigned slow_scan;
+  };
+  // Used by unit tests to get information about what paths were taken during
+  // the last query. Always reset between queries.
+  static QueryStats LastQueryStats();
+
+ private:
+  explicit SelectorQuery(std::shared_ptr<CSSSelectorList>);
+
+  template <typename SelectorQueryTrait>
+  void ExecuteWithId(ContainerNode& root_node, typename SelectorQueryTrait::OutputType&) const;
+  template <typename SelectorQueryTrait>
+  void FindTraverseRootsAndExecute(ContainerNode& root_node, typename SelectorQueryTrait::OutputType&) const;
+  template <typename SelectorQueryTrait>
+  void ExecuteForTraverseRoot(ContainerNode& traverse_root,
+                              ContainerNode& root_node,
+                              typename SelectorQueryTrait::OutputType&) const;
+  template <typename SelectorQueryTrait>
+  void ExecuteSlow(ContainerNode& root_node, typename SelectorQueryTrait::OutputType&) const;
+  template <typename SelectorQueryTrait>
+  void Execute(ContainerNode& root_node, typename SelectorQueryTrait::OutputType&) const;
+
+  bool SelectorListMatches(ContainerNode& root_node, Element&) const;
+
+  std::shared_ptr<CSSSelectorList> selector_list_;
+  // Contains the list of CSSSelector's to match, but without ones that could
+  // never match like pseudo elements, div::before. This can be empty, while
+  // |selector_list_| will never be empty as SelectorQueryCache::Add would have
+  // thrown an exception.
+  std::vector<const CSSSelector*> selectors_;
+  AtomicString selector_id_;
+  bool selector_id_is_rightmost_ : 1;
+  bool selector_id_affected_by_sibling_combinator_ : 1;
+  bool use_slow_scan_ : 1;
+};
+
+// Per-document LRU cache from selector text to its compiled SelectorQuery.
+// Selector parsing in WebF does not depend on document state, so entries
+// never need invalidation; the cache is only bounded in size.
+class SelectorQueryCache {
+ public:
+  static constexpr size_t kMaximumSelectorQueryCacheSize = 256;
+
+  SelectorQuery* Add(const AtomicString&, JSContext* ctx, ExceptionState&);
+  void Invalidate();
+
+  size_t size() const { return entries_.size(); }
+
+ private:
+  using Entry = std::pair<AtomicString, std::unique_ptr<SelectorQuery>>;
+
+  // Most recently used entry first.
+  std::list<Entry> lru_;
+  std::unordered_map<AtomicString, std::list<Entry>::iterator, AtomicString::KeyHasher> entries_;
+};
+
+}  // namespace webf
 
 #endif  // WEBF_CORE_CSS_SELECTOR_QUERY_H_
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "core/css/selector_query.h"
+#include "gtest/gtest.h"
+#include "core/dom/document.h"
+#include "core/dom/element.h"
+#include "webf_test_env.h"
+
+namespace webf {
+
+class SelectorQueryTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    env_ = TEST_init([](double, const char*) {}, nullptr, 0, /*enable_blink=*/1);
+    context_ = env_->page()->executingContext();
+    TEST_runLoop(context_);
+
+    const char* code =
+        "let root = document.createElement('div');"
+        "root.id = 'root';"
+        "for (let i = 0; i < 10; i++) {"
+        "  let item = document.createElement('div');"
+        "  item.className = 'item';"
+        "  let span = document.createElement('span');"
+        "  if (i === 7) span.id = 'target';"
+        "  item.appendChild(span);"
+        "  root.appendChild(item);"
+        "}"
+        "document.body.appendChild(root);";
+    env_->page()->evaluateScript(code, strlen(code), "vm://", 0);
+    TEST_runLoop(context_);
+  }
+
+  void TearDown() override {
+    context_ = nullptr;
+    env_.reset();
+  }
+
+  Document* GetDocument() { return context_->document(); }
+
+ private:
+  std::unique_ptr<WebFTestEnv> env_;
+  ExecutingContext* context_ = nullptr;
+};
+
+TEST_F(SelectorQueryTest, IdSelectorUsesIdIndex) {
+  Element* target = GetDocument()->QuerySelector(AtomicString::CreateFromUTF8("#target"));
+  ASSERT_NE(target, nullptr);
+  EXPECT_EQ(target->id(), AtomicString::CreateFromUTF8("target"));
+  SelectorQuery::QueryStats stats = SelectorQuery::LastQueryStats();
+  EXPECT_EQ(stats.fast_id, 1u);
+  EXPECT_EQ(stats.slow_scan, 0u);
+  EXPECT_EQ(stats.fast_scan, 0u);
+
+  EXPECT_EQ(GetDocument()->QuerySelector(AtomicString::CreateFromUTF8("#missing")), nullptr);
+  EXPECT_EQ(SelectorQuery::LastQueryStats().total_count, 0u);
+}
+
+TEST_F(SelectorQueryTest, ClassAndTagFastPaths) {
+  std::vector<Element*> items = GetDocument()->QuerySelectorAll(AtomicString::CreateFromUTF8(".item"));
+  EXPECT_EQ(items.size(), 10u);
+  EXPECT_GT(SelectorQuery::LastQueryStats().fast_class, 0u);
+  EXPECT_EQ(SelectorQuery::LastQueryStats().slow_scan, 0u);
+
+  std::vector<Element*> spans = GetDocument()->QuerySelectorAll(AtomicString::CreateFromUTF8("span"));
+  EXPECT_EQ(spans.size(), 10u);
+  EXPECT_GT(SelectorQuery::LastQueryStats().fast_tag_name, 0u);
+
+  EXPECT_TRUE(GetDocument()->QuerySelectorAll(AtomicString::CreateFromUTF8(".absent")).empty());
+  EXPECT_EQ(SelectorQuery::LastQueryStats().total_count, 0u);
+
+  // QuerySelector stops at the first hit in tree order.
+  Element* first_span = GetDocument()->QuerySelector(AtomicString::CreateFromUTF8("span"));
+  EXPECT_EQ(first_span, spans[0]);
+  EXPECT_LT(SelectorQuery::LastQueryStats().fast_tag_name, 10u);
+}
+
+TEST_F(SelectorQueryTest, SelectorListUsesSlowScanAndKeepsOrder) {
+  std::vector<Element*> result = GetDocument()->QuerySelectorAll(AtomicString::CreateFromUTF8("#target, .item"));
+  ASSERT_EQ(result.size(), 11u);
+  EXPECT_GT(SelectorQuery::LastQueryStats().slow_scan, 0u);
+  // #target is the span inside the 8th .item, so it follows that item.
+  EXPECT_EQ(result[8]->id(), AtomicString::CreateFromUTF8("target"));
+}
+
+TEST_F(SelectorQueryTest, CacheReusesCompiledQueriesAndIsBounded) {
+  SelectorQueryCache& cache = GetDocument()->GetSelectorQueryCache();
+  cache.Invalidate();
+
+  ExceptionState exception_state;
+  SelectorQuery* first = cache.Add(AtomicString::CreateFromUTF8(".item > span"), nullptr, exception_state);
+  SelectorQuery* second = cache.Add(AtomicString::CreateFromUTF8(".item > span"), nullptr, exception_state);
+  EXPECT_NE(first, nullptr);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(cache.size(), 1u);
+
+  for (size_t i = 0; i < SelectorQueryCache::kMaximumSelectorQueryCacheSize; i++) {
+    std::string selector = ".c" + std::to_string(i);
+    // Touch the first entry so that it stays most recently used.
+    cache.Add(AtomicString::CreateFromUTF8(".item > span"), nullptr, exception_state);
+    cache.Add(AtomicString::CreateFromUTF8(selector.c_str()), nullptr, exception_state);
+  }
+  EXPECT_EQ(cache.size(), SelectorQueryCache::kMaximumSelectorQueryCacheSize);
+  EXPECT_EQ(cache.Add(AtomicString::CreateFromUTF8(".item > span"), nullptr, exception_state), first);
+  EXPECT_FALSE(exception_state.HasException());
+}
+
+TEST_F(SelectorQueryTest, MatchesAndClosest) {
+  Element* target = GetDocument()->QuerySelector(AtomicString::CreateFromUTF8("#target"));
+  ASSERT_NE(target, nullptr);
+  ExceptionState exception_state;
+  EXPECT_TRUE(target->matches(AtomicString::CreateFromUTF8(".item > span"), exception_state));
+  EXPECT_FALSE(target->matches(AtomicString::CreateFromUTF8("div"), exception_state));
+  Element* root = target->closest(AtomicString::CreateFromUTF8("#root"), exception_state);
+  ASSERT_NE(root, nullptr);
+  EXPECT_EQ(root->id(), AtomicString::CreateFromUTF8("root"));
+  EXPECT_FALSE(exception_state.HasException());
+}
+
+}  // namespace webf
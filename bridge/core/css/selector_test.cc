@@ -73,15 +73,14 @@ TEST_F(SelectorTest, SimpleSelectorMatching) {
   ASSERT_GT(body_rules.size(), 0u);
   
   // Test selector matching directly
-  auto& rule_data = body_rules[0];
-  ASSERT_NE(rule_data, nullptr);
+  const RuleData& rule_data = body_rules[0];
   
   // Create selector checker
   SelectorChecker checker(SelectorChecker::kResolvingStyle);
   
   // Create checking context
   SelectorChecker::SelectorCheckingContext context(body);
-  context.selector = &rule_data->Selector();
+  context.selector = &rule_data.Selector();
   
   // Try to match
   SelectorChecker::MatchResult result;
@@ -197,4 +196,63 @@ TEST_F(SelectorTest, DescendantSelectorWithCompoundAncestorMatchesWhenAttributeS
   EXPECT_FALSE(collector.GetMatchResult().IsEmpty());
 }
 
+TEST_F(SelectorTest, AncestorBloomFilterRejectsRulesWithMissingAncestors) {
+  MemberMutationScope mutation_scope{GetDocument()->GetExecutingContext()};
+  GetDocument()->GetExecutingContext()->EnableBlinkEngine();
+
+  auto* body = GetDocument()->body();
+  ASSERT_NE(body, nullptr);
+
+  String css_text = ".present .target { color: green; } .missing .target { color: red; }"_s;
+
+  auto parser_context = std::make_shared<CSSParserContext>(kUASheetMode);
+  auto sheet = std::make_shared<StyleSheetContents>(parser_context);
+  CSSParser::ParseSheet(parser_context, sheet, css_text);
+
+  auto rule_set = std::make_shared<RuleSet>();
+  MediaQueryEvaluator evaluator("screen");
+  rule_set->AddRulesFromSheet(sheet, evaluator, kRuleHasNoSpecialState);
+  rule_set->CompactRulesIfNeeded();
+
+  // Both rules share the .target bucket and carry their ancestor hash inline.
+  const auto& target_rules = rule_set->ClassRules(AtomicString::CreateFromUTF8("target"));
+  ASSERT_EQ(target_rules.size(), 2u);
+  for (const RuleData& rule_data : target_rules) {
+    EXPECT_NE(rule_data.AncestorIdentifierHashes()[0], 0u);
+    EXPECT_EQ(rule_data.AncestorIdentifierHashes()[1], 0u);
+  }
+
+  auto* container = MakeGarbageCollected<HTMLDivElement>(*GetDocument());
+  container->setAttribute(AtomicString::CreateFromUTF8("class"), AtomicString::CreateFromUTF8("present"));
+  auto* target = MakeGarbageCollected<HTMLSpanElement>(*GetDocument());
+  target->setAttribute(AtomicString::CreateFromUTF8("class"), AtomicString::CreateFromUTF8("target"));
+  body->appendChild(container, ASSERT_NO_EXCEPTION());
+  container->appendChild(target, ASSERT_NO_EXCEPTION());
+
+  SelectorFilter selector_filter;
+  std::vector<Element*> ancestors;
+  for (Element* parent = target->parentElement(); parent; parent = parent->parentElement()) {
+    ancestors.push_back(parent);
+  }
+  for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+    selector_filter.PushElement(**it);
+  }
+  selector_filter.PushElement(*target);
+
+  EXPECT_FALSE(selector_filter.FastRejectSelector<RuleData::kMaxIdentifierHashes>(
+      target_rules[0].AncestorIdentifierHashes()));
+  EXPECT_TRUE(selector_filter.FastRejectSelector<RuleData::kMaxIdentifierHashes>(
+      target_rules[1].AncestorIdentifierHashes()));
+
+  StyleResolverState state(*GetDocument(), *target);
+  ElementRuleCollector collector(state, SelectorChecker::kResolvingStyle);
+  collector.SetSelectorFilter(&selector_filter);
+
+  MatchRequest match_request(rule_set, CascadeOrigin::kAuthor, 0);
+  collector.CollectMatchingRules(match_request);
+  collector.SortAndTransferMatchedRules();
+
+  EXPECT_FALSE(collector.GetMatchResult().IsEmpty());
+}
+
 }  // namespace webf
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "shared_style_sheet_cache.h"
+
+#include "core/css/style_sheet_contents.h"
+#include "foundation/string/string_builder.h"
+
+namespace webf {
+
+SharedStyleSheetCache::SharedStyleSheetCache(size_t capacity_in_bytes) : capacity_in_bytes_(capacity_in_bytes) {}
+
+std::shared_ptr<StyleSheetContents> SharedStyleSheetCache::Find(const String& text, const String& base_url) {
+  if (text.length() < kMinTextLength) {
+    return nullptr;
+  }
+
+  auto found = index_.find(MakeKey(text, base_url));
+  if (found == index_.end()) {
+    return nullptr;
+  }
+
+  EntryList::iterator it = found->second;
+  // The key only carries the text hash.
+  if (it->text != text) {
+    return nullptr;
+  }
+  // The page that parsed the sheet mutated it in place before anyone else
+  // picked it up; it no longer matches the text.
+  if (!it->contents->IsCacheableForStyleElement()) {
+    Remove(it);
+    return nullptr;
+  }
+
+  entries_.splice(entries_.begin(), entries_, it);
+
+  if (it->contents->HasMediaQueries()) {
+    return it->contents->Copy();
+  }
+  it->contents->SetIsUsedFromTextCache();
+  return it->contents;
+}
+
+void SharedStyleSheetCache::Add(const String& text,
+                                const String& base_url,
+                                const std::shared_ptr<StyleSheetContents>& contents) {
+  if (!contents || text.length() < kMinTextLength || !contents->IsCacheableForStyleElement()) {
+    return;
+  }
+
+  size_t cost = text.length();
+  if (cost > capacity_in_bytes_) {
+    return;
+  }
+
+  String key = MakeKey(text, base_url);
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    Remove(found->second);
+  }
+
+  // The cached contents outlive the document that parsed them.
+  contents->DetachParserContextFromDocument();
+
+  entries_.push_front(Entry{key, text, contents, cost});
+  index_[key] = entries_.begin();
+  size_in_bytes_ += cost;
+
+  while (size_in_bytes_ > capacity_in_bytes_) {
+    Remove(std::prev(entries_.end()));
+  }
+}
+
+void SharedStyleSheetCache::Clear() {
+  index_.clear();
+  entries_.clear();
+  size_in_bytes_ = 0;
+}
+
+String SharedStyleSheetCache::MakeKey(const String& text, const String& base_url) {
+  StringBuilder builder;
+  builder.AppendNumber(text.Impl() ? text.Impl()->GetHash() : 0);
+  builder.Append("|base="_s);
+  builder.Append(base_url);
+  return builder.ReleaseString();
+}
+
+void SharedStyleSheetCache::Remove(EntryList::iterator it) {
+  size_in_bytes_ -= it->cost;
+  index_.erase(it->key);
+  entries_.erase(it);
+}
+
+}  // namespace webf
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_CSS_SHARED_STYLE_SHEET_CACHE_H_
+#define WEBF_CORE_CSS_SHARED_STYLE_SHEET_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include "foundation/string/wtf_string.h"
+
+namespace webf {
+
+class StyleSheetContents;
+
+// Parsed <style>/<link> sheets shared by every page running on one JS thread,
+// so a large framework stylesheet loaded again by another page or after a
+// navigation skips parsing. Unlike StyleEngine's per-document text cache, the
+// entries outlive the document that parsed them.
+//
+// Entries are keyed by the full sheet text and the base URL the sheet was
+// parsed against, and evicted least-recently-used once the cached text exceeds
+// the byte budget. Pages get the cached StyleSheetContents itself, marked as
+// used from a text cache so that CSSOM mutations copy it first. Sheets with
+// media queries are handed out as copies instead, because their RuleSet
+// depends on the viewport of the page matching them.
+//
+// StyleSheetContents hold AtomicStrings, which belong to the thread that
+// created them, so there is one cache per JS thread (see DartIsolateContext).
+class SharedStyleSheetCache {
+ public:
+  // Smaller sheets parse about as fast as the lookup costs, and are already
+  // shared within a document by StyleEngine.
+  static constexpr size_t kMinTextLength = 1024;
+  static constexpr size_t kDefaultCapacityInBytes = 8 * 1024 * 1024;
+
+  explicit SharedStyleSheetCache(size_t capacity_in_bytes = kDefaultCapacityInBytes);
+  SharedStyleSheetCache(const SharedStyleSheetCache&) = delete;
+  SharedStyleSheetCache& operator=(const SharedStyleSheetCache&) = delete;
+
+  // Returns contents that can be attached to a new CSSStyleSheet, or nullptr.
+  std::shared_ptr<StyleSheetContents> Find(const String& text, const String& base_url);
+
+  // Caches freshly parsed |contents|. Ignored for small or uncacheable sheets.
+  void Add(const String& text, const String& base_url, const std::shared_ptr<StyleSheetContents>& contents);
+
+  void Clear();
+
+  size_t size() const { return entries_.size(); }
+  size_t SizeInBytes() const { return size_in_bytes_; }
+
+ private:
+  struct Entry {
+    String key;
+    String text;
+    std::shared_ptr<StyleSheetContents> contents;
+    size_t cost;
+  };
+  using EntryList = std::list<Entry>;
+  struct StringHash {
+    size_t operator()(const String& s) const { return s.Impl() ? s.Impl()->GetHash() : 0; }
+  };
+
+  static String MakeKey(const String& text, const String& base_url);
+  void Remove(EntryList::iterator it);
+
+  size_t capacity_in_bytes_;
+  size_t size_in_bytes_ = 0;
+  // Most recently used first.
+  EntryList entries_;
+  std::unordered_map<String, EntryList::iterator, StringHash> index_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_CSS_SHARED_STYLE_SHEET_CACHE_H_
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "shared_style_sheet_cache.h"
+
+#include "bindings/qjs/cppgc/mutation_scope.h"
+#include "core/css/css_style_sheet.h"
+#include "core/css/parser/css_parser_context.h"
+#include "core/css/style_engine.h"
+#include "core/css/style_sheet_contents.h"
+#include "core/dart_isolate_context.h"
+#include "core/dom/document.h"
+#include "core/html/html_body_element.h"
+#include "core/html/html_style_element.h"
+#include "foundation/string/string_builder.h"
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+namespace webf {
+
+namespace {
+
+// Builds a sheet above SharedStyleSheetCache::kMinTextLength.
+String LargeSheetText(const char* prefix, const char* extra = "") {
+  StringBuilder builder;
+  builder.Append(String::FromUTF8(extra));
+  for (int i = 0; builder.length() < SharedStyleSheetCache::kMinTextLength; i++) {
+    builder.Append(String::FromUTF8(prefix));
+    builder.AppendNumber(i);
+    builder.Append(" { color: red; }\n"_s);
+  }
+  return builder.ReleaseString();
+}
+
+std::shared_ptr<StyleSheetContents> ParseContents(const String& text) {
+  auto context = std::make_shared<CSSParserContext>(kHTMLStandardMode);
+  auto contents = std::make_shared<StyleSheetContents>(context);
+  contents->ParseString(text);
+  return contents;
+}
+
+}  // namespace
+
+class SharedStyleSheetCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override { env_ = TEST_init(); }
+  void TearDown() override { env_.reset(); }
+
+ private:
+  std::unique_ptr<WebFTestEnv> env_;
+};
+
+TEST_F(SharedStyleSheetCacheTest, SharesUnmutatedContents) {
+  SharedStyleSheetCache cache;
+  String text = LargeSheetText(".a");
+  auto contents = ParseContents(text);
+  cache.Add(text, "https://a.test/"_s, contents);
+
+  EXPECT_EQ(cache.Find(text, "https://a.test/"_s), contents);
+  EXPECT_TRUE(contents->IsUsedFromTextCache());
+  EXPECT_EQ(cache.Find(text, "https://b.test/"_s), nullptr);
+  EXPECT_EQ(cache.Find(LargeSheetText(".b"), "https://a.test/"_s), nullptr);
+}
+
+TEST_F(SharedStyleSheetCacheTest, SkipsSmallAndMutatedSheets) {
+  SharedStyleSheetCache cache;
+  String small_text = ".a { color: red; }"_s;
+  cache.Add(small_text, String(), ParseContents(small_text));
+  EXPECT_EQ(cache.size(), 0u);
+
+  String text = LargeSheetText(".a");
+  auto contents = ParseContents(text);
+  cache.Add(text, String(), contents);
+  contents->StartMutation();
+  EXPECT_EQ(cache.Find(text, String()), nullptr);
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(SharedStyleSheetCacheTest, CopiesSheetsWithMediaQueries) {
+  SharedStyleSheetCache cache;
+  String text = LargeSheetText(".a", "@media (min-width: 100px) { .m { color: blue; } }\n");
+  auto contents = ParseContents(text);
+  ASSERT_TRUE(contents->HasMediaQueries());
+  cache.Add(text, String(), contents);
+
+  auto found = cache.Find(text, String());
+  ASSERT_NE(found, nullptr);
+  EXPECT_NE(found, contents);
+  EXPECT_EQ(found->RuleCount(), contents->RuleCount());
+}
+
+TEST_F(SharedStyleSheetCacheTest, EvictsLeastRecentlyUsed) {
+  String a = LargeSheetText(".a");
+  String b = LargeSheetText(".b");
+  String c = LargeSheetText(".c");
+  SharedStyleSheetCache cache(a.length() + b.length());
+  cache.Add(a, String(), ParseContents(a));
+  cache.Add(b, String(), ParseContents(b));
+  ASSERT_NE(cache.Find(a, String()), nullptr);
+
+  cache.Add(c, String(), ParseContents(c));
+  EXPECT_NE(cache.Find(a, String()), nullptr);
+  EXPECT_EQ(cache.Find(b, String()), nullptr);
+  EXPECT_NE(cache.Find(c, String()), nullptr);
+  EXPECT_LE(cache.SizeInBytes(), a.length() + b.length());
+}
+
+TEST(SharedStyleSheetCache, PagesOnOneThreadShareParsedSheets) {
+  auto first = TEST_init(nullptr, nullptr, 0, /*enable_blink=*/1);
+  auto second = TEST_init(nullptr, nullptr, 0, /*enable_blink=*/1);
+  String text = LargeSheetText(".shared");
+
+  auto create_sheet = [&text](WebFTestEnv* env) {
+    ExecutingContext* context = env->page()->executingContext();
+    MemberMutationScope scope{context};
+    Document* document = context->document();
+    auto* element = MakeGarbageCollected<HTMLStyleElement>(*document);
+    document->body()->appendChild(element, ASSERT_NO_EXCEPTION());
+    return document->EnsureStyleEngine().CreateSheet(*element, text)->Contents();
+  };
+
+  auto first_contents = create_sheet(first.get());
+  auto second_contents = create_sheet(second.get());
+  EXPECT_EQ(first_contents, second_contents);
+  EXPECT_TRUE(second_contents->IsUsedFromTextCache());
+  EXPECT_EQ(second_contents->ParserContext()->GetDocument(), nullptr);
+}
+
+}  // namespace webf
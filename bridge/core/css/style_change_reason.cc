@@ -73,17 +73,17 @@ DEFINE_GLOBAL(AtomicString, g_past);
 DEFINE_GLOBAL(AtomicString, g_unresolved);
 
 void Init() {
-  new ((void*)&g_active) AtomicString(AtomicString::CreateFromUTF8(":active"));
-  new ((void*)&g_active_view_transition) AtomicString(AtomicString::CreateFromUTF8(":active_view_transition"));
-  new ((void*)&g_active_view_transition_type) AtomicString(AtomicString::CreateFromUTF8(":active_view_transition_type"));
-  new ((void*)&g_disabled) AtomicString(AtomicString::CreateFromUTF8(":disabled"));
-  new ((void*)&g_drag) AtomicString(AtomicString::CreateFromUTF8(":-webkit-drag"));
-  new ((void*)&g_focus) AtomicString(AtomicString::CreateFromUTF8(":focus"));
-  new ((void*)&g_focus_visible) AtomicString(AtomicString::CreateFromUTF8(":focus-visible"));
-  new ((void*)&g_focus_within) AtomicString(AtomicString::CreateFromUTF8(":focus-within"));
-  new ((void*)&g_hover) AtomicString(AtomicString::CreateFromUTF8(":hover"));
-  new ((void*)&g_past) AtomicString(AtomicString::CreateFromUTF8(":past"));
-  new ((void*)&g_unresolved) AtomicString(AtomicString::CreateFromUTF8(":unresolved"));
+  new ((void*)&g_active) AtomicString(AtomicString::CreateStatic(":active"));
+  new ((void*)&g_active_view_transition) AtomicString(AtomicString::CreateStatic(":active_view_transition"));
+  new ((void*)&g_active_view_transition_type) AtomicString(AtomicString::CreateStatic(":active_view_transition_type"));
+  new ((void*)&g_disabled) AtomicString(AtomicString::CreateStatic(":disabled"));
+  new ((void*)&g_drag) AtomicString(AtomicString::CreateStatic(":-webkit-drag"));
+  new ((void*)&g_focus) AtomicString(AtomicString::CreateStatic(":focus"));
+  new ((void*)&g_focus_visible) AtomicString(AtomicString::CreateStatic(":focus-visible"));
+  new ((void*)&g_focus_within) AtomicString(AtomicString::CreateStatic(":focus-within"));
+  new ((void*)&g_hover) AtomicString(AtomicString::CreateStatic(":hover"));
+  new ((void*)&g_past) AtomicString(AtomicString::CreateStatic(":past"));
+  new ((void*)&g_unresolved) AtomicString(AtomicString::CreateStatic(":unresolved"));
 }
 
 }  // namespace style_change_extra_data
@@ -32,6 +32,7 @@
  */
 #include "style_engine.h"
 
+#include <chrono>
 #include <functional>
 #include <cctype>
 #include <optional>
@@ -41,6 +42,7 @@
 #include "core/css/invalidation/invalidation_set.h"
 #include "core/css/css_property_name.h"
 #include "core/css/css_property_value_set.h"
+#include "core/css/exported_style_snapshot.h"
 #include "core/css/css_selector.h"
 #include "core/css/css_style_sheet.h"
 #include "core/css/css_identifier_value.h"
@@ -62,6 +64,9 @@
 #include "core/css/style_recalc_change.h"
 #include "core/css/style_recalc_context.h"
 #include "core/css/selector_filter.h"
+#include "core/css/shared_style_sheet_cache.h"
+#include "core/dart_isolate_context.h"
+#include "foundation/metrics_registry.h"
 // Logging and pending substitution value support
 #include "foundation/logging.h"
 #include "bindings/qjs/native_string_utils.h"
@@ -342,6 +347,353 @@ static void CollectSizeDependentMediaQueryResults(
     }
   }
 }
+
+// Builds what the style engine sends to Dart for an element's winning
+// declarations. white-space-collapse/text-wrap are folded into the legacy
+// white-space shorthand, which is what the Dart style engine understands.
+std::vector<ExportedStyleSnapshot::Entry> BuildExportedStyleEntries(MutableCSSPropertyValueSet* property_set) {
+  std::vector<ExportedStyleSnapshot::Entry> entries;
+  if (!property_set || property_set->IsEmpty()) {
+    return entries;
+  }
+
+  unsigned count = property_set->PropertyCount();
+  entries.reserve(count);
+
+  // Pre-scan white-space longhands
+  bool have_ws_collapse = false;
+  bool have_text_wrap = false;
+  WhiteSpaceCollapse ws_collapse_enum = WhiteSpaceCollapse::kCollapse;
+  TextWrap text_wrap_enum = TextWrap::kWrap;
+  for (unsigned i = 0; i < count; ++i) {
+    auto prop = property_set->PropertyAt(i);
+    CSSPropertyID id = prop.Id();
+    if (id == CSSPropertyID::kInvalid) continue;
+    const auto* value_ptr = prop.Value();
+    if (!value_ptr || !(*value_ptr)) continue;
+    const CSSValue& value = *(*value_ptr);
+    if (id == CSSPropertyID::kWhiteSpaceCollapse) {
+      std::string sv = value.CssTextForSerialization().ToUTF8String();
+      if (sv == "collapse") {
+        ws_collapse_enum = WhiteSpaceCollapse::kCollapse;
+        have_ws_collapse = true;
+      } else if (sv == "preserve") {
+        ws_collapse_enum = WhiteSpaceCollapse::kPreserve;
+        have_ws_collapse = true;
+      } else if (sv == "preserve-breaks") {
+        ws_collapse_enum = WhiteSpaceCollapse::kPreserveBreaks;
+        have_ws_collapse = true;
+      } else if (sv == "break-spaces") {
+        ws_collapse_enum = WhiteSpaceCollapse::kBreakSpaces;
+        have_ws_collapse = true;
+      }
+    } else if (id == CSSPropertyID::kTextWrap) {
+      std::string sv = value.CssTextForSerialization().ToUTF8String();
+      if (sv == "wrap") {
+        text_wrap_enum = TextWrap::kWrap;
+        have_text_wrap = true;
+      } else if (sv == "nowrap") {
+        text_wrap_enum = TextWrap::kNoWrap;
+        have_text_wrap = true;
+      } else if (sv == "balance") {
+        text_wrap_enum = TextWrap::kBalance;
+        have_text_wrap = true;
+      } else if (sv == "pretty") {
+        text_wrap_enum = TextWrap::kPretty;
+        have_text_wrap = true;
+      }
+    }
+  }
+
+  for (unsigned i = 0; i < count; ++i) {
+    auto prop = property_set->PropertyAt(i);
+    CSSPropertyID id = prop.Id();
+    if (id == CSSPropertyID::kInvalid) continue;
+    if (id == CSSPropertyID::kWhiteSpaceCollapse || id == CSSPropertyID::kTextWrap) {
+      continue;
+    }
+    const auto* value_ptr = prop.Value();
+    if (!value_ptr || !(*value_ptr)) continue;
+
+    AtomicString prop_name = prop.Name().ToAtomicString();
+    ExportedStyleSnapshot::Entry entry;
+    entry.property_id = static_cast<int32_t>(id);
+    entry.important = prop.IsImportant();
+
+    if (id == CSSPropertyID::kVariable) {
+      String value_string = property_set->GetPropertyValueWithHint(prop_name, i);
+      if (value_string.IsNull()) {
+        value_string = (*value_ptr)->CssTextForSerialization();
+      }
+      if (value_string.IsEmpty()) {
+        value_string = String(" ");
+      }
+      entry.custom_name = prop_name;
+      entry.value = value_string;
+    } else if ((*value_ptr)->IsIdentifierValue()) {
+      const auto& ident = To<CSSIdentifierValue>(*(*value_ptr));
+      entry.keyword_slot = -static_cast<int64_t>(ident.GetValueID()) - 1;
+    } else if (TypedStyleValue typed = TypedStyleValue::FromCSSValue(*(*value_ptr)); !typed.IsEmpty()) {
+      entry.typed = std::move(typed);
+    } else {
+      String value_string = property_set->GetPropertyValueWithHint(prop_name, i);
+      if (value_string.IsNull()) {
+        value_string = (*value_ptr)->CssTextForSerialization();
+      }
+      if (value_string.IsEmpty()) {
+        continue;
+      }
+      entry.value = value_string;
+    }
+
+    entry.base_href = property_set->GetPropertyBaseHrefWithHint(prop_name, i);
+    entries.push_back(std::move(entry));
+  }
+
+  if (have_ws_collapse || have_text_wrap) {
+    CSSValueID ws_value_id = CSSValueID::kNormal;
+    switch (ToWhiteSpace(ws_collapse_enum, text_wrap_enum)) {
+      case EWhiteSpace::kNormal:
+        ws_value_id = CSSValueID::kNormal;
+        break;
+      case EWhiteSpace::kNowrap:
+        ws_value_id = CSSValueID::kNowrap;
+        break;
+      case EWhiteSpace::kPre:
+        ws_value_id = CSSValueID::kPre;
+        break;
+      case EWhiteSpace::kPreLine:
+        ws_value_id = CSSValueID::kPreLine;
+        break;
+      case EWhiteSpace::kPreWrap:
+        ws_value_id = CSSValueID::kPreWrap;
+        break;
+      case EWhiteSpace::kBreakSpaces:
+        ws_value_id = CSSValueID::kBreakSpaces;
+        break;
+    }
+
+    ExportedStyleSnapshot::Entry entry;
+    entry.property_id = static_cast<int32_t>(CSSPropertyID::kWhiteSpace);
+    entry.keyword_slot = -static_cast<int64_t>(ws_value_id) - 1;
+    entries.push_back(std::move(entry));
+  }
+
+  return entries;
+}
+
+void SendExportedStyleEntry(SharedUICommand* command_buffer,
+                            Element& element,
+                            const ExportedStyleSnapshot::Entry& entry) {
+  if (entry.property_id == static_cast<int32_t>(CSSPropertyID::kVariable)) {
+    auto* payload = reinterpret_cast<NativeStyleValueWithHref*>(dart_malloc(sizeof(NativeStyleValueWithHref)));
+    payload->value = stringToNativeString(entry.value).release();
+    if (!entry.base_href.IsEmpty()) {
+      payload->href = stringToNativeString(entry.base_href).release();
+    } else {
+      payload->href = nullptr;
+    }
+    command_buffer->AddCommand(UICommand::kSetStyle, entry.custom_name.ToStylePropertyNameNativeString(),
+                               element.bindingObject(), payload);
+    return;
+  }
+
+  if (!entry.typed.IsEmpty()) {
+    int64_t value_bits = 0;
+    int64_t descriptor = 0;
+    entry.typed.Encode(value_bits, descriptor);
+    command_buffer->AddTypedStyleByIdCommand(element.bindingObject(), entry.property_id, value_bits, descriptor,
+                                             /*request_ui_update*/ true);
+    return;
+  }
+
+  int64_t value_slot = entry.keyword_slot;
+  if (value_slot == 0) {
+    value_slot = command_buffer->StyleValueSlot(entry.value);
+  }
+
+  SharedNativeString* base_href = nullptr;
+  if (!entry.base_href.IsEmpty()) {
+    base_href = stringToNativeString(entry.base_href).release();
+  }
+
+  // The cascade already picked the winning declaration, so Dart needs no
+  // !important flag for exported styles.
+  command_buffer->AddStyleByIdCommand(element.bindingObject(), entry.property_id, value_slot, base_href,
+                                      /*request_ui_update*/ true);
+}
+
+// An empty value removes the property from the Dart-side inline style.
+void SendExportedStyleRemoval(SharedUICommand* command_buffer,
+                              Element& element,
+                              const ExportedStyleSnapshot::Entry& entry) {
+  if (entry.property_id == static_cast<int32_t>(CSSPropertyID::kVariable)) {
+    command_buffer->AddCommand(UICommand::kSetStyle, entry.custom_name.ToStylePropertyNameNativeString(),
+                               element.bindingObject(), nullptr);
+    return;
+  }
+  command_buffer->AddStyleByIdCommand(element.bindingObject(), entry.property_id, /*value_slot*/ 0, nullptr);
+}
+
+// Sends |next| (the element's exported winning declarations) to Dart. The
+// first export for an element is kClearStyle followed by the full set; later
+// exports are diffed against the element's ExportedStyleSnapshot so only
+// added, changed and removed properties cross the bridge, and a no-op recalc
+// emits nothing. Snapshots may be shared between elements that matched the
+// same rules, in which case an unchanged element is skipped without a diff.
+void SendWinningPropertySetToDart(SharedUICommand* command_buffer,
+                              Element& element,
+                              std::shared_ptr<ExportedStyleSnapshot> next) {
+  std::shared_ptr<ExportedStyleSnapshot> previous = element.GetExportedStyleSnapshot();
+
+  if (!previous) {
+    command_buffer->AddCommand(UICommand::kClearStyle, nullptr, element.bindingObject(), nullptr);
+    for (const auto& entry : next->Entries()) {
+      SendExportedStyleEntry(command_buffer, element, entry);
+    }
+    element.SetExportedStyleSnapshot(std::move(next));
+    return;
+  }
+
+  if (previous == next) {
+    return;
+  }
+
+  size_t hint = 0;
+  for (const auto& entry : next->Entries()) {
+    if (const ExportedStyleSnapshot::Entry* sent = previous->Find(entry, hint)) {
+      hint = previous->IndexOf(*sent) + 1;
+      if (*sent == entry) {
+        continue;
+      }
+    }
+    SendExportedStyleEntry(command_buffer, element, entry);
+  }
+
+  hint = 0;
+  for (const auto& sent : previous->Entries()) {
+    if (const ExportedStyleSnapshot::Entry* kept = next->Find(sent, hint)) {
+      hint = next->IndexOf(*kept) + 1;
+      continue;
+    }
+    SendExportedStyleRemoval(command_buffer, element, sent);
+  }
+  element.SetExportedStyleSnapshot(std::move(next));
+}
+
+struct ExportedStyle {
+  std::shared_ptr<MutableCSSPropertyValueSet> property_set;
+  // Only filled in when requested; pseudo-element exports go out as plain
+  // kSetPseudoStyle commands.
+  std::shared_ptr<ExportedStyleSnapshot> snapshot;
+  bool display_none = false;
+};
+
+bool IsDisplayNone(const MutableCSSPropertyValueSet* property_set) {
+  if (!property_set || property_set->IsEmpty()) {
+    return false;
+  }
+  if (const auto* display_ptr = property_set->GetPropertyCSSValue(CSSPropertyID::kDisplay);
+      display_ptr && *display_ptr && (*display_ptr)->IsIdentifierValue()) {
+    const auto& ident = To<CSSIdentifierValue>(*(*display_ptr));
+    return ident.GetValueID() == CSSValueID::kNone;
+  }
+  String display_value = property_set->GetPropertyValue(CSSPropertyID::kDisplay);
+  return display_value.StripWhiteSpace().LowerASCII() == "none";
+}
+
+// Runs the cascade for |match_result|, unless an element earlier in this
+// recalc matched exactly the same declaration blocks, in which case its
+// winning property set and export snapshot are reused. The export only
+// depends on the matched declarations, so siblings and cousins in a list
+// share one cascade and one serialization.
+ExportedStyle ExportMatchedStyle(MatchedPropertiesCache& cache,
+                                 StyleResolverState& state,
+                                 const MatchResult& match_result,
+                                 bool need_snapshot) {
+  const bool cacheable = cache.IsEnabled() && MatchedPropertiesCache::IsCacheable(match_result);
+  unsigned hash = 0;
+  MatchedPropertiesCache::Entry* entry = nullptr;
+  if (cacheable) {
+    hash = MatchedPropertiesCache::ComputeMatchedPropertiesHash(match_result);
+    entry = cache.Find(hash, match_result);
+  }
+
+  if (!entry) {
+    StyleCascade cascade(state);
+    cascade.MutableMatchResult() = match_result;
+    std::shared_ptr<MutableCSSPropertyValueSet> property_set = cascade.ExportWinningPropertySet();
+    if (!cacheable) {
+      ExportedStyle exported;
+      exported.display_none = IsDisplayNone(property_set.get());
+      if (need_snapshot) {
+        exported.snapshot = std::make_shared<ExportedStyleSnapshot>(BuildExportedStyleEntries(property_set.get()));
+      }
+      exported.property_set = std::move(property_set);
+      return exported;
+    }
+    entry = cache.Add(hash, match_result, std::move(property_set));
+    entry->display_none = IsDisplayNone(entry->property_set.get());
+  }
+
+  if (need_snapshot && !entry->snapshot) {
+    entry->snapshot = std::make_shared<ExportedStyleSnapshot>(BuildExportedStyleEntries(entry->property_set.get()));
+  }
+  return ExportedStyle{entry->property_set, need_snapshot ? entry->snapshot : nullptr, entry->display_none};
+}
+
+void PushAncestorsOf(SelectorFilter& filter, Element& element) {
+  std::vector<Element*> ancestors;
+  for (Element* parent = element.parentElement(); parent; parent = parent->parentElement()) {
+    ancestors.push_back(parent);
+  }
+  for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+    filter.PushElement(**it);
+  }
+}
+
+// Keeps a SelectorFilter in step with the ancestor chain of the node a
+// RecalcStyle walk is visiting. Ancestors are only pushed once an element
+// below them is recalculated, so clean subtrees cost nothing and dirty
+// siblings share one set of ancestor pushes instead of rebuilding the chain
+// per element.
+class RecalcAncestorFilter {
+  WEBF_STACK_ALLOCATED();
+
+ public:
+  void Reset(Element& walk_root) {
+    filter_.Clear();
+    path_.clear();
+    pushed_ = 0;
+    for (Element* parent = walk_root.parentElement(); parent; parent = parent->parentElement()) {
+      path_.push_back(parent);
+    }
+    std::reverse(path_.begin(), path_.end());
+  }
+
+  void Enter(Element& element) { path_.push_back(&element); }
+  void Leave() {
+    if (pushed_ == path_.size()) {
+      filter_.PopElement(*path_.back());
+      pushed_--;
+    }
+    path_.pop_back();
+  }
+
+  // The filter for the parent of the element the walk is at.
+  SelectorFilter& Get() {
+    for (; pushed_ < path_.size(); ++pushed_) {
+      filter_.PushElement(*path_[pushed_]);
+    }
+    return filter_;
+  }
+
+ private:
+  SelectorFilter filter_;
+  std::vector<Element*> path_;
+  size_t pushed_ = 0;
+};
+
 }  // namespace
 
 void PossiblyScheduleNthPseudoInvalidations(Node& node) {
@@ -391,7 +743,7 @@ CSSStyleSheet* StyleEngine::CreateSheet(Element& element, const String& text) {
   }
 
   if (text_to_sheet_cache_.count(key) == 0 || !text_to_sheet_cache_[key]->IsCacheableForStyleElement()) {
-    style_sheet = ParseSheet(element, text);
+    style_sheet = ParseOrReuseSharedSheet(element, text, String(GetDocument().BaseURL().GetString()), nullptr);
     assert(style_sheet != nullptr);
     if (style_sheet->Contents()->IsCacheableForStyleElement()) {
       text_to_sheet_cache_[key] = style_sheet->Contents();
@@ -511,7 +863,7 @@ CSSStyleSheet* StyleEngine::CreateSheet(Element& element, const String& text, co
   }
 
   if (text_to_sheet_cache_.count(key) == 0 || !text_to_sheet_cache_[key]->IsCacheableForStyleElement()) {
-    style_sheet = ParseSheet(element, text, base_href);
+    style_sheet = ParseOrReuseSharedSheet(element, text, base_href.GetString(), &base_href);
     assert(style_sheet != nullptr);
     if (style_sheet->Contents()->IsCacheableForStyleElement()) {
       text_to_sheet_cache_[key] = style_sheet->Contents();
@@ -620,6 +972,29 @@ CSSStyleSheet* StyleEngine::CreateSheet(Element& element, const String& text, co
   return style_sheet;
 }
 
+CSSStyleSheet* StyleEngine::ParseOrReuseSharedSheet(Element& element,
+                                                    const String& text,
+                                                    const String& base_url,
+                                                    const AtomicString* base_href) {
+  SharedStyleSheetCache* shared_cache = nullptr;
+  if (DartIsolateContext* isolate = GetDocument().GetExecutingContext()->dartIsolateContext()) {
+    shared_cache = isolate->styleSheetCache();
+  }
+
+  if (shared_cache) {
+    if (std::shared_ptr<StyleSheetContents> contents = shared_cache->Find(text, base_url)) {
+      contents->SetDidLoadErrorOccur(false);
+      return CSSStyleSheet::CreateInline(element.GetExecutingContext(), contents, element);
+    }
+  }
+
+  CSSStyleSheet* style_sheet = base_href ? ParseSheet(element, text, *base_href) : ParseSheet(element, text);
+  if (shared_cache) {
+    shared_cache->Add(text, base_url, style_sheet->Contents());
+  }
+  return style_sheet;
+}
+
 CSSStyleSheet* StyleEngine::ParseSheet(Element& element, const String& text) {
   assert(GetDocument().GetExecutingContext()->isBlinkEnabled());
   // Create parser context with the document and its base URL so relative
@@ -1287,7 +1662,29 @@ void StyleEngine::AttributeChangedForElement(const AtomicString& attribute_local
   }
 }
 
+void StyleEngine::CollectMatchedRules(StyleResolver& resolver,
+                                      StyleResolverState& state,
+                                      ElementRuleCollector& collector) {
+  if (!recalc_style_metrics_) {
+    resolver.CollectAllRules(state, collector, /*include_smil_properties*/ false);
+    collector.SortAndTransferMatchedRules();
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  resolver.CollectAllRules(state, collector, /*include_smil_properties*/ false);
+  collector.SortAndTransferMatchedRules();
+  recalc_style_metrics_->rule_match_nanos +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
 void StyleEngine::RecalcStyleForSubtree(Element& root_element) {
+  SelectorFilter selector_filter;
+  PushAncestorsOf(selector_filter, root_element);
+  RecalcStyleForSubtree(root_element, selector_filter);
+}
+
+void StyleEngine::RecalcStyleForSubtree(Element& root_element, SelectorFilter& selector_filter) {
   Document& document = GetDocument();
   ExecutingContext* ctx = document.GetExecutingContext();
   if (!ctx || !ctx->isBlinkEnabled()) {
@@ -1308,47 +1705,28 @@ void StyleEngine::RecalcStyleForSubtree(Element& root_element) {
 
   StyleResolver& resolver = EnsureStyleResolver();
   auto* command_buffer = ctx->uiCommandBuffer();
-
-  // Build a selector bloom filter for the ancestor chain so we can cheaply
-  // reject rules that mention ids/classes/tags/attrs not present in ancestors.
-  SelectorFilter selector_filter;
-  std::vector<Element*> ancestors;
-  for (Element* parent = root_element.parentElement(); parent; parent = parent->parentElement()) {
-    ancestors.push_back(parent);
-  }
-  for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
-    selector_filter.PushElement(**it);
-  }
+  MatchedPropertiesCache& matched_properties_cache = resolver.GetMatchedPropertiesCache();
+  MatchedPropertiesCache::RecalcScope matched_properties_scope(matched_properties_cache);
 
   auto apply_for_element = [&](Element* element) -> bool {
     if (!element || !element->IsStyledElement()) {
       return false;
     }
+    if (recalc_style_metrics_) {
+      recalc_style_metrics_->element_count++;
+    }
 
     StyleResolverState state(document, *element);
     ElementRuleCollector collector(state, SelectorChecker::kResolvingStyle);
     collector.SetSelectorFilter(&selector_filter);
-    resolver.CollectAllRules(state, collector, /*include_smil_properties*/ false);
-    collector.SortAndTransferMatchedRules();
+    CollectMatchedRules(resolver, state, collector);
     const uint32_t matched_pseudo_mask = collector.MatchedPseudoElementMask();
     const uint32_t matched_pseudo_content_mask = collector.MatchedPseudoElementWithContentMask();
 
-    StyleCascade cascade(state);
-    cascade.MutableMatchResult() = collector.GetMatchResult();
-    std::shared_ptr<MutableCSSPropertyValueSet> property_set = cascade.ExportWinningPropertySet();
-
-    bool display_none_for_invalidation = false;
-    if (property_set && !property_set->IsEmpty()) {
-      if (const auto* display_ptr = property_set->GetPropertyCSSValue(CSSPropertyID::kDisplay);
-          display_ptr && *display_ptr && (*display_ptr)->IsIdentifierValue()) {
-        const auto& ident = To<CSSIdentifierValue>(*(*display_ptr));
-        display_none_for_invalidation = ident.GetValueID() == CSSValueID::kNone;
-      } else {
-        String display_value = property_set->GetPropertyValue(CSSPropertyID::kDisplay);
-        display_none_for_invalidation = display_value.StripWhiteSpace().LowerASCII() == "none";
-      }
-    }
-    element->SetDisplayNoneForStyleInvalidation(display_none_for_invalidation);
+    ExportedStyle exported =
+        ExportMatchedStyle(matched_properties_cache, state, collector.GetMatchResult(), /*need_snapshot*/ true);
+    const std::shared_ptr<MutableCSSPropertyValueSet>& property_set = exported.property_set;
+    element->SetDisplayNoneForStyleInvalidation(exported.display_none);
 
     auto pseudo_bit = [](PseudoId pseudo_id) -> uint32_t {
       unsigned id = static_cast<unsigned>(pseudo_id);
@@ -1392,7 +1770,7 @@ void StyleEngine::RecalcStyleForSubtree(Element& root_element) {
     if (!property_set || property_set->IsEmpty()) {
       // Even if there are no element-level winners, clear any previously-sent
       // sheet overrides (to avoid stale styles) and emit pseudo styles if any exist.
-      command_buffer->AddCommand(UICommand::kClearStyle, nullptr, element->bindingObject(), nullptr);
+      SendWinningPropertySetToDart(command_buffer, *element, exported.snapshot);
       auto emit_pseudo_if_any = [&](PseudoId pseudo_id, const char* pseudo_name) {
         if (!should_resolve_pseudo(pseudo_id)) {
           clear_pseudo_if_sent(pseudo_id, pseudo_name);
@@ -1401,13 +1779,12 @@ void StyleEngine::RecalcStyleForSubtree(Element& root_element) {
         ElementRuleCollector pseudo_collector(state, SelectorChecker::kResolvingStyle);
         pseudo_collector.SetSelectorFilter(&selector_filter);
         pseudo_collector.SetPseudoElementStyleRequest(PseudoElementStyleRequest(pseudo_id));
-        resolver.CollectAllRules(state, pseudo_collector, /*include_smil_properties*/ false);
-        pseudo_collector.SortAndTransferMatchedRules();
-
-        StyleCascade pseudo_cascade(state);
-        pseudo_cascade.MutableMatchResult() = pseudo_collector.GetMatchResult();
+        CollectMatchedRules(resolver, state, pseudo_collector);
 
-        std::shared_ptr<MutableCSSPropertyValueSet> pseudo_set = pseudo_cascade.ExportWinningPropertySet();
+        std::shared_ptr<MutableCSSPropertyValueSet> pseudo_set =
+            ExportMatchedStyle(matched_properties_cache, state, pseudo_collector.GetMatchResult(),
+                               /*need_snapshot*/ false)
+                .property_set;
 
         bool has_pseudo = pseudo_set && pseudo_set->PropertyCount() != 0;
         if (!has_pseudo) {
@@ -1482,175 +1859,7 @@ void StyleEngine::RecalcStyleForSubtree(Element& root_element) {
       return element->IsDisplayNoneForStyleInvalidation();
     }
 
-    command_buffer->AddCommand(UICommand::kClearStyle, nullptr, element->bindingObject(), nullptr);
-
-    unsigned count = property_set->PropertyCount();
-
-    // Pre-scan white-space longhands
-    bool have_ws_collapse = false;
-    bool have_text_wrap = false;
-    WhiteSpaceCollapse ws_collapse_enum = WhiteSpaceCollapse::kCollapse;
-    TextWrap text_wrap_enum = TextWrap::kWrap;
-    for (unsigned i = 0; i < count; ++i) {
-      auto prop = property_set->PropertyAt(i);
-      CSSPropertyID id = prop.Id();
-      if (id == CSSPropertyID::kInvalid) continue;
-      const auto* value_ptr = prop.Value();
-      if (!value_ptr || !(*value_ptr)) continue;
-      const CSSValue& value = *(*value_ptr);
-      if (id == CSSPropertyID::kWhiteSpaceCollapse) {
-        std::string sv = value.CssTextForSerialization().ToUTF8String();
-        if (sv == "collapse") {
-          ws_collapse_enum = WhiteSpaceCollapse::kCollapse;
-          have_ws_collapse = true;
-        } else if (sv == "preserve") {
-          ws_collapse_enum = WhiteSpaceCollapse::kPreserve;
-          have_ws_collapse = true;
-        } else if (sv == "preserve-breaks") {
-          ws_collapse_enum = WhiteSpaceCollapse::kPreserveBreaks;
-          have_ws_collapse = true;
-        } else if (sv == "break-spaces") {
-          ws_collapse_enum = WhiteSpaceCollapse::kBreakSpaces;
-          have_ws_collapse = true;
-        }
-      } else if (id == CSSPropertyID::kTextWrap) {
-        std::string sv = value.CssTextForSerialization().ToUTF8String();
-        if (sv == "wrap") {
-          text_wrap_enum = TextWrap::kWrap;
-          have_text_wrap = true;
-        } else if (sv == "nowrap") {
-          text_wrap_enum = TextWrap::kNoWrap;
-          have_text_wrap = true;
-        } else if (sv == "balance") {
-          text_wrap_enum = TextWrap::kBalance;
-          have_text_wrap = true;
-        } else if (sv == "pretty") {
-          text_wrap_enum = TextWrap::kPretty;
-          have_text_wrap = true;
-        }
-      }
-    }
-
-    bool emit_white_space_shorthand = have_ws_collapse || have_text_wrap;
-    String white_space_value_str;
-    if (emit_white_space_shorthand) {
-      EWhiteSpace ws = ToWhiteSpace(ws_collapse_enum, text_wrap_enum);
-      switch (ws) {
-        case EWhiteSpace::kNormal:
-          white_space_value_str = String("normal");
-          break;
-        case EWhiteSpace::kNowrap:
-          white_space_value_str = String("nowrap");
-          break;
-        case EWhiteSpace::kPre:
-          white_space_value_str = String("pre");
-          break;
-        case EWhiteSpace::kPreLine:
-          white_space_value_str = String("pre-line");
-          break;
-        case EWhiteSpace::kPreWrap:
-          white_space_value_str = String("pre-wrap");
-          break;
-        case EWhiteSpace::kBreakSpaces:
-          white_space_value_str = String("break-spaces");
-          break;
-      }
-    }
-
-    for (unsigned i = 0; i < count; ++i) {
-      auto prop = property_set->PropertyAt(i);
-      CSSPropertyID id = prop.Id();
-      if (id == CSSPropertyID::kInvalid) continue;
-      if (id == CSSPropertyID::kWhiteSpaceCollapse || id == CSSPropertyID::kTextWrap) {
-        continue;
-      }
-      const auto* value_ptr = prop.Value();
-      if (!value_ptr || !(*value_ptr)) continue;
-
-      AtomicString prop_name = prop.Name().ToAtomicString();
-      String base_href_string = property_set->GetPropertyBaseHrefWithHint(prop_name, i);
-
-      if (id == CSSPropertyID::kVariable) {
-        String value_string = property_set->GetPropertyValueWithHint(prop_name, i);
-        if (value_string.IsNull()) {
-          value_string = (*value_ptr)->CssTextForSerialization();
-        }
-        if (value_string.IsEmpty()) {
-          value_string = String(" ");
-        }
-
-        auto key_ns = prop_name.ToStylePropertyNameNativeString();
-        auto* payload = reinterpret_cast<NativeStyleValueWithHref*>(dart_malloc(sizeof(NativeStyleValueWithHref)));
-        payload->value = stringToNativeString(value_string).release();
-        if (!base_href_string.IsEmpty()) {
-          payload->href = stringToNativeString(base_href_string).release();
-        } else {
-          payload->href = nullptr;
-        }
-        command_buffer->AddCommand(UICommand::kSetStyle, std::move(key_ns), element->bindingObject(), payload);
-        continue;
-      }
-
-      int64_t value_slot = 0;
-      if ((*value_ptr)->IsIdentifierValue()) {
-        const auto& ident = To<CSSIdentifierValue>(*(*value_ptr));
-        value_slot = -static_cast<int64_t>(ident.GetValueID()) - 1;
-      } else {
-        String value_string = property_set->GetPropertyValueWithHint(prop_name, i);
-        if (value_string.IsNull()) {
-          value_string = (*value_ptr)->CssTextForSerialization();
-        }
-        if (value_string.IsEmpty()) {
-          continue;
-        }
-        auto* value_ns = stringToNativeString(value_string).release();
-        value_slot = static_cast<int64_t>(reinterpret_cast<intptr_t>(value_ns));
-      }
-
-      SharedNativeString* base_href = nullptr;
-      if (!base_href_string.IsEmpty()) {
-        base_href = stringToNativeString(base_href_string).release();
-      }
-
-      command_buffer->AddStyleByIdCommand(element->bindingObject(), static_cast<int32_t>(id), value_slot,
-                                               base_href, prop.IsImportant());
-    }
-
-    if (emit_white_space_shorthand) {
-      CSSValueID ws_value_id = CSSValueID::kInvalid;
-      EWhiteSpace ws = ToWhiteSpace(ws_collapse_enum, text_wrap_enum);
-      switch (ws) {
-        case EWhiteSpace::kNormal:
-          ws_value_id = CSSValueID::kNormal;
-          break;
-        case EWhiteSpace::kNowrap:
-          ws_value_id = CSSValueID::kNowrap;
-          break;
-        case EWhiteSpace::kPre:
-          ws_value_id = CSSValueID::kPre;
-          break;
-        case EWhiteSpace::kPreLine:
-          ws_value_id = CSSValueID::kPreLine;
-          break;
-        case EWhiteSpace::kPreWrap:
-          ws_value_id = CSSValueID::kPreWrap;
-          break;
-        case EWhiteSpace::kBreakSpaces:
-          ws_value_id = CSSValueID::kBreakSpaces;
-          break;
-      }
-
-      int64_t value_slot = 0;
-      if (ws_value_id != CSSValueID::kInvalid) {
-        value_slot = -static_cast<int64_t>(ws_value_id) - 1;
-      } else if (!white_space_value_str.IsEmpty()) {
-        auto* value_ns = stringToNativeString(white_space_value_str).release();
-        value_slot = static_cast<int64_t>(reinterpret_cast<intptr_t>(value_ns));
-      }
-
-      command_buffer->AddStyleByIdCommand(element->bindingObject(), static_cast<int32_t>(CSSPropertyID::kWhiteSpace),
-                                               value_slot, nullptr, /*important*/ false);
-    }
+    SendWinningPropertySetToDart(command_buffer, *element, exported.snapshot);
 
     // Pseudo emission (only minimal content properties as in RecalcStyle)
     auto send_pseudo_for = [&](PseudoId pseudo_id, const char* pseudo_name) {
@@ -1661,13 +1870,12 @@ void StyleEngine::RecalcStyleForSubtree(Element& root_element) {
       ElementRuleCollector pseudo_collector(state, SelectorChecker::kResolvingStyle);
       pseudo_collector.SetSelectorFilter(&selector_filter);
       pseudo_collector.SetPseudoElementStyleRequest(PseudoElementStyleRequest(pseudo_id));
-      resolver.CollectAllRules(state, pseudo_collector, /*include_smil_properties*/ false);
-      pseudo_collector.SortAndTransferMatchedRules();
+      CollectMatchedRules(resolver, state, pseudo_collector);
 
-      StyleCascade pseudo_cascade(state);
-      pseudo_cascade.MutableMatchResult() = pseudo_collector.GetMatchResult();
-
-      std::shared_ptr<MutableCSSPropertyValueSet> pseudo_set = pseudo_cascade.ExportWinningPropertySet();
+      std::shared_ptr<MutableCSSPropertyValueSet> pseudo_set =
+          ExportMatchedStyle(matched_properties_cache, state, pseudo_collector.GetMatchResult(),
+                             /*need_snapshot*/ false)
+              .property_set;
       bool has_pseudo = pseudo_set && pseudo_set->PropertyCount() != 0;
       if (!has_pseudo) {
         clear_pseudo_if_sent(pseudo_id, pseudo_name);
@@ -1786,6 +1994,12 @@ void StyleEngine::RecalcStyleForSubtree(Element& root_element) {
 }
 
 void StyleEngine::RecalcStyleForElementOnly(Element& element) {
+  SelectorFilter selector_filter;
+  PushAncestorsOf(selector_filter, element);
+  RecalcStyleForElementOnly(element, selector_filter);
+}
+
+void StyleEngine::RecalcStyleForElementOnly(Element& element, SelectorFilter& selector_filter) {
   Document& document = GetDocument();
   ExecutingContext* ctx = document.GetExecutingContext();
   if (!ctx || !ctx->isBlinkEnabled()) {
@@ -1808,46 +2022,30 @@ void StyleEngine::RecalcStyleForElementOnly(Element& element) {
   // not recurse into children.
   StyleResolver& resolver = EnsureStyleResolver();
   auto* command_buffer = ctx->uiCommandBuffer();
+  MatchedPropertiesCache& matched_properties_cache = resolver.GetMatchedPropertiesCache();
+  MatchedPropertiesCache::RecalcScope matched_properties_scope(matched_properties_cache);
 
-  SelectorFilter selector_filter;
-  std::vector<Element*> ancestors;
-  for (Element* parent = element.parentElement(); parent; parent = parent->parentElement()) {
-    ancestors.push_back(parent);
-  }
-  for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
-    selector_filter.PushElement(**it);
-  }
   selector_filter.PushElement(element);
 
   auto apply_for_element = [&](Element* el) {
     if (!el || !el->IsStyledElement()) {
       return;
     }
+    if (recalc_style_metrics_) {
+      recalc_style_metrics_->element_count++;
+    }
 
     StyleResolverState state(document, *el);
     ElementRuleCollector collector(state, SelectorChecker::kResolvingStyle);
     collector.SetSelectorFilter(&selector_filter);
-    resolver.CollectAllRules(state, collector, /*include_smil_properties*/ false);
-    collector.SortAndTransferMatchedRules();
+    CollectMatchedRules(resolver, state, collector);
     const uint32_t matched_pseudo_mask = collector.MatchedPseudoElementMask();
     const uint32_t matched_pseudo_content_mask = collector.MatchedPseudoElementWithContentMask();
 
-    StyleCascade cascade(state);
-    cascade.MutableMatchResult() = collector.GetMatchResult();
-    std::shared_ptr<MutableCSSPropertyValueSet> property_set = cascade.ExportWinningPropertySet();
-
-    bool display_none_for_invalidation = false;
-    if (property_set && !property_set->IsEmpty()) {
-      if (const auto* display_ptr = property_set->GetPropertyCSSValue(CSSPropertyID::kDisplay);
-          display_ptr && *display_ptr && (*display_ptr)->IsIdentifierValue()) {
-        const auto& ident = To<CSSIdentifierValue>(*(*display_ptr));
-        display_none_for_invalidation = ident.GetValueID() == CSSValueID::kNone;
-      } else {
-        String display_value = property_set->GetPropertyValue(CSSPropertyID::kDisplay);
-        display_none_for_invalidation = display_value.StripWhiteSpace().LowerASCII() == "none";
-      }
-    }
-    el->SetDisplayNoneForStyleInvalidation(display_none_for_invalidation);
+    ExportedStyle exported =
+        ExportMatchedStyle(matched_properties_cache, state, collector.GetMatchResult(), /*need_snapshot*/ true);
+    const std::shared_ptr<MutableCSSPropertyValueSet>& property_set = exported.property_set;
+    el->SetDisplayNoneForStyleInvalidation(exported.display_none);
 
     auto pseudo_bit = [](PseudoId pseudo_id) -> uint32_t {
       unsigned id = static_cast<unsigned>(pseudo_id);
@@ -1889,7 +2087,7 @@ void StyleEngine::RecalcStyleForElementOnly(Element& element) {
     };
 
     if (!property_set || property_set->IsEmpty()) {
-      command_buffer->AddCommand(UICommand::kClearStyle, nullptr, el->bindingObject(), nullptr);
+      SendWinningPropertySetToDart(command_buffer, *el, exported.snapshot);
 
       auto emit_pseudo_if_any = [&](PseudoId pseudo_id, const char* pseudo_name) {
         if (!should_resolve_pseudo(pseudo_id)) {
@@ -1899,13 +2097,12 @@ void StyleEngine::RecalcStyleForElementOnly(Element& element) {
         ElementRuleCollector pseudo_collector(state, SelectorChecker::kResolvingStyle);
         pseudo_collector.SetSelectorFilter(&selector_filter);
         pseudo_collector.SetPseudoElementStyleRequest(PseudoElementStyleRequest(pseudo_id));
-        resolver.CollectAllRules(state, pseudo_collector, /*include_smil_properties*/ false);
-        pseudo_collector.SortAndTransferMatchedRules();
+        CollectMatchedRules(resolver, state, pseudo_collector);
 
-        StyleCascade pseudo_cascade(state);
-        pseudo_cascade.MutableMatchResult() = pseudo_collector.GetMatchResult();
-
-        std::shared_ptr<MutableCSSPropertyValueSet> pseudo_set = pseudo_cascade.ExportWinningPropertySet();
+        std::shared_ptr<MutableCSSPropertyValueSet> pseudo_set =
+            ExportMatchedStyle(matched_properties_cache, state, pseudo_collector.GetMatchResult(),
+                               /*need_snapshot*/ false)
+                .property_set;
         if (!pseudo_set || pseudo_set->PropertyCount() == 0) {
           clear_pseudo_if_sent(pseudo_id, pseudo_name);
           return false;
@@ -1980,174 +2177,7 @@ void StyleEngine::RecalcStyleForElementOnly(Element& element) {
       return;
     }
 
-    command_buffer->AddCommand(UICommand::kClearStyle, nullptr, el->bindingObject(), nullptr);
-
-    unsigned count = property_set->PropertyCount();
-
-    bool have_ws_collapse = false;
-    bool have_text_wrap = false;
-    WhiteSpaceCollapse ws_collapse_enum = WhiteSpaceCollapse::kCollapse;
-    TextWrap text_wrap_enum = TextWrap::kWrap;
-    for (unsigned i = 0; i < count; ++i) {
-      auto prop = property_set->PropertyAt(i);
-      CSSPropertyID id = prop.Id();
-      if (id == CSSPropertyID::kInvalid) continue;
-      const auto* value_ptr = prop.Value();
-      if (!value_ptr || !(*value_ptr)) continue;
-      const CSSValue& value = *(*value_ptr);
-      if (id == CSSPropertyID::kWhiteSpaceCollapse) {
-        std::string sv = value.CssTextForSerialization().ToUTF8String();
-        if (sv == "collapse") {
-          ws_collapse_enum = WhiteSpaceCollapse::kCollapse;
-          have_ws_collapse = true;
-        } else if (sv == "preserve") {
-          ws_collapse_enum = WhiteSpaceCollapse::kPreserve;
-          have_ws_collapse = true;
-        } else if (sv == "preserve-breaks") {
-          ws_collapse_enum = WhiteSpaceCollapse::kPreserveBreaks;
-          have_ws_collapse = true;
-        } else if (sv == "break-spaces") {
-          ws_collapse_enum = WhiteSpaceCollapse::kBreakSpaces;
-          have_ws_collapse = true;
-        }
-      } else if (id == CSSPropertyID::kTextWrap) {
-        std::string sv = value.CssTextForSerialization().ToUTF8String();
-        if (sv == "wrap") {
-          text_wrap_enum = TextWrap::kWrap;
-          have_text_wrap = true;
-        } else if (sv == "nowrap") {
-          text_wrap_enum = TextWrap::kNoWrap;
-          have_text_wrap = true;
-        } else if (sv == "balance") {
-          text_wrap_enum = TextWrap::kBalance;
-          have_text_wrap = true;
-        } else if (sv == "pretty") {
-          text_wrap_enum = TextWrap::kPretty;
-          have_text_wrap = true;
-        }
-      }
-    }
-
-    bool emit_white_space_shorthand = have_ws_collapse || have_text_wrap;
-    String white_space_value_str;
-    if (emit_white_space_shorthand) {
-      EWhiteSpace ws = ToWhiteSpace(ws_collapse_enum, text_wrap_enum);
-      switch (ws) {
-        case EWhiteSpace::kNormal:
-          white_space_value_str = String("normal");
-          break;
-        case EWhiteSpace::kNowrap:
-          white_space_value_str = String("nowrap");
-          break;
-        case EWhiteSpace::kPre:
-          white_space_value_str = String("pre");
-          break;
-        case EWhiteSpace::kPreLine:
-          white_space_value_str = String("pre-line");
-          break;
-        case EWhiteSpace::kPreWrap:
-          white_space_value_str = String("pre-wrap");
-          break;
-        case EWhiteSpace::kBreakSpaces:
-          white_space_value_str = String("break-spaces");
-          break;
-      }
-    }
-
-    for (unsigned i = 0; i < count; ++i) {
-      auto prop = property_set->PropertyAt(i);
-      CSSPropertyID id = prop.Id();
-      if (id == CSSPropertyID::kInvalid) continue;
-      if (id == CSSPropertyID::kWhiteSpaceCollapse || id == CSSPropertyID::kTextWrap) {
-        continue;
-      }
-      const auto* value_ptr = prop.Value();
-      if (!value_ptr || !(*value_ptr)) continue;
-
-      AtomicString prop_name = prop.Name().ToAtomicString();
-      String base_href_string = property_set->GetPropertyBaseHrefWithHint(prop_name, i);
-
-      if (id == CSSPropertyID::kVariable) {
-        String value_string = property_set->GetPropertyValueWithHint(prop_name, i);
-        if (value_string.IsNull()) {
-          value_string = (*value_ptr)->CssTextForSerialization();
-        }
-        if (value_string.IsEmpty()) {
-          value_string = String(" ");
-        }
-
-        auto key_ns = prop_name.ToStylePropertyNameNativeString();
-        auto* payload = reinterpret_cast<NativeStyleValueWithHref*>(dart_malloc(sizeof(NativeStyleValueWithHref)));
-        payload->value = stringToNativeString(value_string).release();
-        if (!base_href_string.IsEmpty()) {
-          payload->href = stringToNativeString(base_href_string).release();
-        } else {
-          payload->href = nullptr;
-        }
-        command_buffer->AddCommand(UICommand::kSetStyle, std::move(key_ns), el->bindingObject(), payload);
-        continue;
-      }
-
-      int64_t value_slot = 0;
-      if ((*value_ptr)->IsIdentifierValue()) {
-        const auto& ident = To<CSSIdentifierValue>(*(*value_ptr));
-        value_slot = -static_cast<int64_t>(ident.GetValueID()) - 1;
-      } else {
-        String value_string = property_set->GetPropertyValueWithHint(prop_name, i);
-        if (value_string.IsNull()) {
-          value_string = (*value_ptr)->CssTextForSerialization();
-        }
-        if (value_string.IsEmpty()) {
-          continue;
-        }
-        auto* value_ns = stringToNativeString(value_string).release();
-        value_slot = static_cast<int64_t>(reinterpret_cast<intptr_t>(value_ns));
-      }
-
-      SharedNativeString* base_href = nullptr;
-      if (!base_href_string.IsEmpty()) {
-        base_href = stringToNativeString(base_href_string).release();
-      }
-
-      command_buffer->AddStyleByIdCommand(el->bindingObject(), static_cast<int32_t>(id), value_slot, base_href,
-                                               prop.IsImportant());
-    }
-
-    if (emit_white_space_shorthand) {
-      CSSValueID ws_value_id = CSSValueID::kInvalid;
-      EWhiteSpace ws = ToWhiteSpace(ws_collapse_enum, text_wrap_enum);
-      switch (ws) {
-        case EWhiteSpace::kNormal:
-          ws_value_id = CSSValueID::kNormal;
-          break;
-        case EWhiteSpace::kNowrap:
-          ws_value_id = CSSValueID::kNowrap;
-          break;
-        case EWhiteSpace::kPre:
-          ws_value_id = CSSValueID::kPre;
-          break;
-        case EWhiteSpace::kPreLine:
-          ws_value_id = CSSValueID::kPreLine;
-          break;
-        case EWhiteSpace::kPreWrap:
-          ws_value_id = CSSValueID::kPreWrap;
-          break;
-        case EWhiteSpace::kBreakSpaces:
-          ws_value_id = CSSValueID::kBreakSpaces;
-          break;
-      }
-
-      int64_t value_slot = 0;
-      if (ws_value_id != CSSValueID::kInvalid) {
-        value_slot = -static_cast<int64_t>(ws_value_id) - 1;
-      } else if (!white_space_value_str.IsEmpty()) {
-        auto* value_ns = stringToNativeString(white_space_value_str).release();
-        value_slot = static_cast<int64_t>(reinterpret_cast<intptr_t>(value_ns));
-      }
-
-    command_buffer->AddStyleByIdCommand(el->bindingObject(), static_cast<int32_t>(CSSPropertyID::kWhiteSpace),
-                                               value_slot, nullptr, /*important*/ false);
-    }
+    SendWinningPropertySetToDart(command_buffer, *el, exported.snapshot);
 
     auto send_pseudo_for = [&](PseudoId pseudo_id, const char* pseudo_name) {
       if (!should_resolve_pseudo(pseudo_id)) {
@@ -2157,13 +2187,12 @@ void StyleEngine::RecalcStyleForElementOnly(Element& element) {
       ElementRuleCollector pseudo_collector(state, SelectorChecker::kResolvingStyle);
       pseudo_collector.SetSelectorFilter(&selector_filter);
       pseudo_collector.SetPseudoElementStyleRequest(PseudoElementStyleRequest(pseudo_id));
-      resolver.CollectAllRules(state, pseudo_collector, /*include_smil_properties*/ false);
-      pseudo_collector.SortAndTransferMatchedRules();
+      CollectMatchedRules(resolver, state, pseudo_collector);
 
-      StyleCascade pseudo_cascade(state);
-      pseudo_cascade.MutableMatchResult() = pseudo_collector.GetMatchResult();
-
-      std::shared_ptr<MutableCSSPropertyValueSet> pseudo_set = pseudo_cascade.ExportWinningPropertySet();
+      std::shared_ptr<MutableCSSPropertyValueSet> pseudo_set =
+          ExportMatchedStyle(matched_properties_cache, state, pseudo_collector.GetMatchResult(),
+                             /*need_snapshot*/ false)
+              .property_set;
       if (!pseudo_set || pseudo_set->PropertyCount() == 0) {
         clear_pseudo_if_sent(pseudo_id, pseudo_name);
         return;
@@ -2238,6 +2267,7 @@ void StyleEngine::RecalcStyleForElementOnly(Element& element) {
   };
 
   apply_for_element(&element);
+  selector_filter.PopElement(element);
 }
 
 void StyleEngine::RecalcStyle(StyleRecalcChange change, const StyleRecalcContext& style_recalc_context) {
@@ -2261,6 +2291,29 @@ void StyleEngine::RecalcStyle(StyleRecalcChange change, const StyleRecalcContext
 
   MemberMutationScope scope{context};
 
+  // Reports the elements this pass styled and the time spent matching their
+  // rules. Passes that end before styling anything are not recorded.
+  struct RecalcStyleMetricsScope {
+    StyleEngine& engine;
+    MetricsRegistry* registry;
+    RecalcStyleMetrics metrics;
+    RecalcStyleMetrics* previous;
+    RecalcStyleMetricsScope(StyleEngine& e, MetricsRegistry* r)
+        : engine(e), registry(r), previous(e.recalc_style_metrics_) {
+      engine.recalc_style_metrics_ = &metrics;
+    }
+    ~RecalcStyleMetricsScope() {
+      engine.recalc_style_metrics_ = previous;
+      if (metrics.element_count) {
+        registry->Record(MetricsHistogram::kRecalcStyleElementCount, metrics.element_count);
+        registry->Record(MetricsHistogram::kRuleMatchNanos, metrics.rule_match_nanos);
+      }
+    }
+  } recalc_style_metrics_scope(*this, context->dartIsolateContext()->metrics());
+
+  // Elements in this pass that match the same rules share one export.
+  MatchedPropertiesCache::RecalcScope matched_properties_scope(EnsureStyleResolver().GetMatchedPropertiesCache());
+
   Element* root = nullptr;
   if (style_recalc_root_.GetRootNode()) {
     // When we have a tracked recalc root, start from there to avoid walking
@@ -2372,6 +2425,7 @@ void StyleEngine::RecalcStyle(StyleRecalcChange change, const StyleRecalcContext
     }
   };
 
+  RecalcAncestorFilter ancestor_filter;
   std::function<void(Node*, bool)> walk = [&](Node* node, bool force_traverse) {
     if (!node) {
       return;
@@ -2391,7 +2445,7 @@ void StyleEngine::RecalcStyle(StyleRecalcChange change, const StyleRecalcContext
         StyleChangeType change_type = element->GetStyleChangeType();
         if (change_type == kInlineIndependentStyleChange) {
           // Inline-only independent style changes only require rule matching for this element.
-          RecalcStyleForElementOnly(*element);
+          RecalcStyleForElementOnly(*element, ancestor_filter.Get());
           element->ClearNeedsStyleRecalc();
         } else if (change_type == kLocalStyleChange) {
           // If this element was previously display:none, its descendants may not have had any
@@ -2401,23 +2455,23 @@ void StyleEngine::RecalcStyle(StyleRecalcChange change, const StyleRecalcContext
           // recompute styles for its subtree so descendants like <img> pick up their inline
           // styles and render correctly.
           if (element->IsDisplayNoneForStyleInvalidation()) {
-            RecalcStyleForSubtree(*element);
+            RecalcStyleForSubtree(*element, ancestor_filter.Get());
             clear_flags_for_subtree(element);
             return;
           }
 
           if (!element->HasEmittedStyle()) {
-            RecalcStyleForSubtree(*element);
+            RecalcStyleForSubtree(*element, ancestor_filter.Get());
             clear_flags_for_subtree(element);
             return;
           }
 
-          RecalcStyleForElementOnly(*element);
+          RecalcStyleForElementOnly(*element, ancestor_filter.Get());
           element->ClearNeedsStyleRecalc();
         } else {
           // For subtree changes, recompute styles for this element and its
           // descendants and then clear dirty bits in that subtree.
-          RecalcStyleForSubtree(*element);
+          RecalcStyleForSubtree(*element, ancestor_filter.Get());
           clear_flags_for_subtree(element);
           return;
         }
@@ -2431,12 +2485,18 @@ void StyleEngine::RecalcStyle(StyleRecalcChange change, const StyleRecalcContext
       return;
     }
 
+    if (node->IsElementNode()) {
+      ancestor_filter.Enter(*static_cast<Element*>(node));
+    }
     for (Node* child = node->firstChild(); child; child = child->nextSibling()) {
       if (!force_traverse && !child->NeedsStyleRecalc() && !child->ChildNeedsStyleRecalc()) {
         continue;
       }
       walk(child, force_traverse);
     }
+    if (node->IsElementNode()) {
+      ancestor_filter.Leave();
+    }
 
     // Blink's Element::RecalcStyle clears ChildNeedsStyleRecalc breadcrumbs as
     // the traversal unwinds. Mirror that behavior so we don't leave
@@ -2445,6 +2505,7 @@ void StyleEngine::RecalcStyle(StyleRecalcChange change, const StyleRecalcContext
     node->ClearChildNeedsStyleRecalc();
   };
 
+  ancestor_filter.Reset(*root);
   walk(root, false);
 
   // Clear breadcrumbs on the traversal root as well, not only its ancestors.
@@ -2473,6 +2534,7 @@ void StyleEngine::RecalcStyle(StyleRecalcChange change, const StyleRecalcContext
       // fall back to a full traversal. This mirrors Blink's defensive logic
       // for keeping style dirtiness invariants intact even when breadcrumbs
       // are missing (e.g. due to non-standard dirtiness marks).
+      ancestor_filter.Reset(*doc_root);
       walk(doc_root, true);
       doc_root->ClearChildNeedsStyleRecalc();
     }
@@ -86,6 +86,14 @@ class StyleEngine final {
   void Trace(GCVisitor* visitor);
   CSSStyleSheet* ParseSheet(Element&, const String& text);
   CSSStyleSheet* ParseSheet(Element&, const String& text, const AtomicString& base_href);
+  // Takes the sheet from the SharedStyleSheetCache of this JS thread when
+  // another page already parsed |text| against |base_url|, and otherwise parses
+  // it and offers the result to that cache. |base_href| selects the
+  // ParseSheet() overload.
+  CSSStyleSheet* ParseOrReuseSharedSheet(Element&,
+                                         const String& text,
+                                         const String& base_url,
+                                         const AtomicString* base_href);
 
   bool InRebuildLayoutTree() const { return in_layout_tree_rebuild_; }
   bool InDOMRemoval() const { return in_dom_removal_; }
@@ -252,6 +260,16 @@ class StyleEngine final {
                                   Element&);
 
  private:
+  // Variants used by the RecalcStyle() walk, which passes a filter that
+  // already holds the ancestors of the element. The filter is left as it was
+  // found on return.
+  void RecalcStyleForSubtree(Element& root, SelectorFilter& ancestor_filter);
+  void RecalcStyleForElementOnly(Element& element, SelectorFilter& ancestor_filter);
+
+  // CollectAllRules() and SortAndTransferMatchedRules(), timed into
+  // |recalc_style_metrics_| when a RecalcStyle() pass is running.
+  void CollectMatchedRules(StyleResolver&, StyleResolverState&, ElementRuleCollector&);
+
   // Helper to decide whether selector-based invalidation work should be
   // skipped for a given element (e.g., because it is not in the active
   // document or we are already in the middle of a style recalc).
@@ -310,6 +328,14 @@ class StyleEngine final {
   // selectors in sync with pseudo-state changes.
   bool needs_has_pseudo_state_recalc_{false};
 
+  // Work done by the RecalcStyle() pass in progress, reported to the isolate's
+  // MetricsRegistry when the pass ends. Null outside RecalcStyle().
+  struct RecalcStyleMetrics {
+    uint64_t element_count = 0;
+    uint64_t rule_match_nanos = 0;
+  };
+  RecalcStyleMetrics* recalc_style_metrics_{nullptr};
+
   PendingInvalidations pending_invalidations_;
   // Root for selector-based style invalidation. Updated when nodes are marked
   // with NeedsStyleInvalidation / ChildNeedsStyleInvalidation and consulted by
@@ -6,6 +6,7 @@
 
 #include "bindings/qjs/cppgc/mutation_scope.h"
 #include "core/css/css_style_sheet.h"
+#include "core/css/exported_style_snapshot.h"
 #include "core/css/resolver/style_resolver.h"
 #include "core/dom/document.h"
 #include "core/html/html_body_element.h"
@@ -388,6 +389,67 @@ TEST_F(StyleEngineTest, SiblingInvalidationDirectAdjacentOnInsertion) {
   EXPECT_TRUE(b->NeedsStyleRecalc());
 }
 
+TEST_F(StyleEngineTest, DirtySiblingsMatchDescendantRulesThroughSharedAncestorFilter) {
+  MemberMutationScope mutation_scope{GetExecutingContext()};
+  GetExecutingContext()->EnableBlinkEngine();
+
+  ASSERT_NE(GetDocument()->body(), nullptr);
+  const AtomicString class_attr = AtomicString::CreateFromUTF8("class");
+
+  auto* list = MakeGarbageCollected<HTMLDivElement>(*GetDocument());
+  list->setAttribute(class_attr, AtomicString::CreateFromUTF8("list"));
+  GetDocument()->body()->appendChild(list, ASSERT_NO_EXCEPTION());
+
+  auto* style_element = MakeGarbageCollected<HTMLStyleElement>(*GetDocument());
+  GetDocument()->body()->appendChild(style_element, ASSERT_NO_EXCEPTION());
+  CSSStyleSheet* sheet = GetStyleEngine().CreateSheet(*style_element, ".list .item { width: 10px; }"_s);
+  ASSERT_NE(sheet, nullptr);
+  GetStyleEngine().RegisterAuthorSheet(sheet);
+  GetStyleEngine().SetNeedsActiveStyleUpdate();
+  GetDocument()->UpdateStyleForThisDocument();
+
+  // Items appended one by one to an already styled list are recalculated as
+  // separate dirty elements, interleaved with a nested one and one outside the
+  // list, all against the same ancestor filter.
+  std::vector<HTMLDivElement*> items;
+  for (int i = 0; i < 3; i++) {
+    auto* item = MakeGarbageCollected<HTMLDivElement>(*GetDocument());
+    item->setAttribute(class_attr, AtomicString::CreateFromUTF8("item"));
+    list->appendChild(item, ASSERT_NO_EXCEPTION());
+    items.push_back(item);
+  }
+  auto* wrapper = MakeGarbageCollected<HTMLDivElement>(*GetDocument());
+  list->appendChild(wrapper, ASSERT_NO_EXCEPTION());
+  auto* nested = MakeGarbageCollected<HTMLDivElement>(*GetDocument());
+  nested->setAttribute(class_attr, AtomicString::CreateFromUTF8("item"));
+  wrapper->appendChild(nested, ASSERT_NO_EXCEPTION());
+  items.push_back(nested);
+  auto* outside = MakeGarbageCollected<HTMLDivElement>(*GetDocument());
+  outside->setAttribute(class_attr, AtomicString::CreateFromUTF8("item"));
+  GetDocument()->body()->appendChild(outside, ASSERT_NO_EXCEPTION());
+
+  GetDocument()->UpdateStyleForThisDocument();
+
+  auto has_width = [](Element* element) {
+    const auto& snapshot = element->GetExportedStyleSnapshot();
+    if (!snapshot) {
+      return false;
+    }
+    for (const auto& entry : snapshot->Entries()) {
+      if (entry.property_id == static_cast<int32_t>(CSSPropertyID::kWidth)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  for (auto* item : items) {
+    EXPECT_TRUE(item->HasEmittedStyle());
+    EXPECT_TRUE(has_width(item));
+  }
+  EXPECT_TRUE(outside->HasEmittedStyle());
+  EXPECT_FALSE(has_width(outside));
+}
+
 TEST_F(StyleEngineTest, MediaQuerySizeChangeSkipsRecalcWithoutQueries) {
   MemberMutationScope mutation_scope{GetExecutingContext()};
   GetExecutingContext()->EnableBlinkEngine();
@@ -106,6 +106,14 @@ StyleSheetContents::StyleSheetContents(const webf::StyleSheetContents& o)
 
 StyleSheetContents::~StyleSheetContents() = default;
 
+void StyleSheetContents::DetachParserContextFromDocument() {
+  if (!parser_context_ || !parser_context_->GetDocument()) {
+    return;
+  }
+  parser_context_ =
+      std::make_shared<CSSParserContext>(parser_context_->BaseURL().GetString(), parser_context_->Mode(), nullptr);
+}
+
 ParseSheetResult StyleSheetContents::ParseString(const String& sheet_text,
                                                  bool allow_import_rules,
                                                  CSSDeferPropertyParsing defer_property_parsing) {
@@ -440,6 +448,7 @@ std::shared_ptr<RuleSet> StyleSheetContents::EnsureRuleSet(const MediaQueryEvalu
   if (!rule_set_) {
     rule_set_ = std::make_shared<RuleSet>();
     rule_set_->AddRulesFromSheet(shared_from_this(), medium, kRuleHasNoSpecialState);
+    rule_set_->CompactRulesIfNeeded();
   }
   return rule_set_;
 }
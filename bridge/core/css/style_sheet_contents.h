@@ -52,6 +52,10 @@ class StyleSheetContents : public std::enable_shared_from_this<StyleSheetContent
     return parser_context_;
   }
 
+  // Rebinds the parser context to no document, for contents kept alive by
+  // SharedStyleSheetCache after the parsing document is gone.
+  void DetachParserContextFromDocument();
+
   ParseSheetResult ParseString(const String& sheet_text,
                                bool allow_import_rules = true,
                                CSSDeferPropertyParsing defer_property_parsing = CSSDeferPropertyParsing::kNo);
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "typed_style_value.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include "core/css/css_color.h"
+#include "core/css/css_numeric_literal_value.h"
+#include "core/css/css_value_list.h"
+#include "foundation/dart_readable.h"
+
+namespace webf {
+
+namespace {
+
+bool ToNativeUnit(CSSPrimitiveValue::UnitType unit, NativeStyleValueUnit& out) {
+  using UnitType = CSSPrimitiveValue::UnitType;
+  switch (unit) {
+    case UnitType::kNumber:
+      out = NativeStyleValueUnit::kNumber;
+      return true;
+    case UnitType::kInteger:
+      out = NativeStyleValueUnit::kInteger;
+      return true;
+    case UnitType::kPercentage:
+      out = NativeStyleValueUnit::kPercentage;
+      return true;
+    case UnitType::kPixels:
+      out = NativeStyleValueUnit::kPx;
+      return true;
+    case UnitType::kEms:
+      out = NativeStyleValueUnit::kEm;
+      return true;
+    case UnitType::kRems:
+      out = NativeStyleValueUnit::kRem;
+      return true;
+    case UnitType::kExs:
+      out = NativeStyleValueUnit::kEx;
+      return true;
+    case UnitType::kChs:
+      out = NativeStyleValueUnit::kCh;
+      return true;
+    case UnitType::kViewportWidth:
+      out = NativeStyleValueUnit::kVw;
+      return true;
+    case UnitType::kViewportHeight:
+      out = NativeStyleValueUnit::kVh;
+      return true;
+    case UnitType::kViewportMin:
+      out = NativeStyleValueUnit::kVmin;
+      return true;
+    case UnitType::kViewportMax:
+      out = NativeStyleValueUnit::kVmax;
+      return true;
+    case UnitType::kCentimeters:
+      out = NativeStyleValueUnit::kCm;
+      return true;
+    case UnitType::kMillimeters:
+      out = NativeStyleValueUnit::kMm;
+      return true;
+    case UnitType::kInches:
+      out = NativeStyleValueUnit::kIn;
+      return true;
+    case UnitType::kPoints:
+      out = NativeStyleValueUnit::kPt;
+      return true;
+    case UnitType::kPicas:
+      out = NativeStyleValueUnit::kPc;
+      return true;
+    case UnitType::kQuarterMillimeters:
+      out = NativeStyleValueUnit::kQ;
+      return true;
+    case UnitType::kDegrees:
+      out = NativeStyleValueUnit::kDeg;
+      return true;
+    case UnitType::kRadians:
+      out = NativeStyleValueUnit::kRad;
+      return true;
+    case UnitType::kGradians:
+      out = NativeStyleValueUnit::kGrad;
+      return true;
+    case UnitType::kTurns:
+      out = NativeStyleValueUnit::kTurn;
+      return true;
+    case UnitType::kMilliseconds:
+      out = NativeStyleValueUnit::kMs;
+      return true;
+    case UnitType::kSeconds:
+      out = NativeStyleValueUnit::kS;
+      return true;
+    case UnitType::kFlex:
+      out = NativeStyleValueUnit::kFr;
+      return true;
+    default:
+      return false;
+  }
+}
+
+int64_t DescriptorFor(const NativeTypedStyleValue& item) {
+  return static_cast<int64_t>(item.type) | (static_cast<int64_t>(item.unit) << 8);
+}
+
+int64_t ValueBitsFor(const NativeTypedStyleValue& item) {
+  if (item.type == static_cast<uint8_t>(NativeStyleValueType::kColor)) {
+    return static_cast<int64_t>(item.argb);
+  }
+  int64_t bits;
+  static_assert(sizeof(bits) == sizeof(item.number));
+  std::memcpy(&bits, &item.number, sizeof(bits));
+  return bits;
+}
+
+bool SameItem(const NativeTypedStyleValue& a, const NativeTypedStyleValue& b) {
+  return a.type == b.type && a.unit == b.unit && a.argb == b.argb &&
+         std::memcmp(&a.number, &b.number, sizeof(a.number)) == 0;
+}
+
+}  // namespace
+
+bool TypedStyleValue::ToItem(const CSSValue& value, NativeTypedStyleValue& item) {
+  if (value.IsNumericLiteralValue()) {
+    const auto& numeric = To<CSSNumericLiteralValue>(value);
+    NativeStyleValueUnit unit;
+    if (!std::isfinite(numeric.DoubleValue()) || !ToNativeUnit(numeric.GetType(), unit)) {
+      return false;
+    }
+    item.type = static_cast<uint8_t>(NativeStyleValueType::kNumeric);
+    item.unit = static_cast<uint8_t>(unit);
+    item.number = numeric.DoubleValue();
+    return true;
+  }
+
+  if (value.IsColorValue()) {
+    Color color = To<cssvalue::CSSColor>(value).Value();
+    // Only sRGB colors survive the 8-bit ARGB packing that Dart paints with.
+    if (!Color::IsLegacyColorSpace(color.GetColorSpace())) {
+      return false;
+    }
+    item.type = static_cast<uint8_t>(NativeStyleValueType::kColor);
+    item.argb = color.Rgb();
+    return true;
+  }
+
+  return false;
+}
+
+TypedStyleValue TypedStyleValue::FromCSSValue(const CSSValue& value) {
+  TypedStyleValue result;
+  if (ToItem(value, result.single_)) {
+    return result;
+  }
+
+  if (!value.IsBaseValueList()) {
+    return TypedStyleValue();
+  }
+  const auto& list = To<CSSValueList>(value);
+  if (list.length() == 0 || list.length() > kMaxListLength ||
+      list.Separator() == CSSValue::kSlashSeparator) {
+    return TypedStyleValue();
+  }
+
+  result.list_.resize(list.length());
+  for (size_t i = 0; i < list.length(); ++i) {
+    std::shared_ptr<const CSSValue> item = list.Item(i);
+    if (!item || !ToItem(*item, result.list_[i])) {
+      return TypedStyleValue();
+    }
+  }
+  result.comma_separated_ = list.Separator() == CSSValue::kCommaSeparator;
+  return result;
+}
+
+void TypedStyleValue::Encode(int64_t& value_bits, int64_t& descriptor) const {
+  assert(!IsEmpty());
+  if (list_.empty()) {
+    value_bits = ValueBitsFor(single_);
+    descriptor = DescriptorFor(single_);
+    return;
+  }
+
+  size_t bytes = sizeof(NativeTypedStyleValue) * list_.size();
+  auto* items = static_cast<NativeTypedStyleValue*>(dart_malloc(bytes));
+  std::memcpy(items, list_.data(), bytes);
+  value_bits = static_cast<int64_t>(reinterpret_cast<intptr_t>(items));
+  descriptor = static_cast<int64_t>(NativeStyleValueType::kList) |
+               (static_cast<int64_t>(comma_separated_ ? CSSValue::kCommaSeparator : CSSValue::kSpaceSeparator)
+                << 8) |
+               (static_cast<int64_t>(list_.size()) << 16);
+}
+
+bool TypedStyleValue::operator==(const TypedStyleValue& other) const {
+  if (!SameItem(single_, other.single_) || comma_separated_ != other.comma_separated_ ||
+      list_.size() != other.list_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < list_.size(); ++i) {
+    if (!SameItem(list_[i], other.list_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace webf
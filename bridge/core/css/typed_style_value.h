@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_CSS_TYPED_STYLE_VALUE_H_
+#define WEBF_CORE_CSS_TYPED_STYLE_VALUE_H_
+
+#include <cstdint>
+#include <vector>
+#include "foundation/native_type.h"
+
+namespace webf {
+
+class CSSValue;
+
+// A CSS value in the typed form carried by UICommand::kSetStyleByIdTyped:
+// a numeric literal with a unit, an sRGB color, or a short space/comma
+// separated list of those. Anything else (keywords, calc(), urls, strings,
+// wide-gamut colors) is sent as CSS text.
+class TypedStyleValue {
+ public:
+  static constexpr size_t kMaxListLength = 16;
+
+  TypedStyleValue() = default;
+
+  // Returns an empty value when |value| has no typed form.
+  static TypedStyleValue FromCSSValue(const CSSValue& value);
+
+  bool IsEmpty() const { return single_.type == 0 && list_.empty(); }
+
+  // Fills the kSetStyleByIdTyped payload. For lists this allocates the item
+  // array that Dart releases after applying the command.
+  void Encode(int64_t& value_bits, int64_t& descriptor) const;
+
+  bool operator==(const TypedStyleValue& other) const;
+  bool operator!=(const TypedStyleValue& other) const { return !(*this == other); }
+
+ private:
+  static bool ToItem(const CSSValue& value, NativeTypedStyleValue& item);
+
+  // Single values stay inline; only lists allocate.
+  NativeTypedStyleValue single_{};
+  std::vector<NativeTypedStyleValue> list_;
+  bool comma_separated_ = false;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_CSS_TYPED_STYLE_VALUE_H_
@@ -12,7 +12,9 @@
 #include <unordered_set>
 #include <vector>
 #include "../foundation/string/atomic_string_table.h"
+#include "core/binding_name_table.h"
 #include "core/core_initializer.h"
+#include "core/css/shared_style_sheet_cache.h"
 #include "core/html/custom/widget_element_shape.h"
 #include "defined_properties_initializer.h"
 #include "event_factory.h"
@@ -27,10 +29,43 @@ namespace webf {
 
 thread_local std::unordered_set<DartWireContext*> alive_wires;
 
+namespace {
+
+// Prewarmed contexts live under ids Dart never hands out until they are
+// reassigned to the page that takes them.
+thread_local double next_prewarmed_context_id = multi_threading::kFirstPrewarmedContextId;
+
+// Leaves the looper to the page that was just created before building spares.
+constexpr int64_t kPrewarmDelayMs = 500;
+constexpr int64_t kPrewarmRetryDelayMs = 100;
+
+// Page groups sharing this JS thread, and with it the JS runtime.
+thread_local uint32_t page_groups_on_thread = 0;
+
+}  // namespace
+
 PageGroup::~PageGroup() {
+  if (prewarm_timer_ != 0) {
+    looper_->CancelTimer(prewarm_timer_);
+  }
+  prewarmed_pages_.clear();
   for (auto page : pages_) {
     delete page;
   }
+  if (bound_to_thread_) {
+    page_groups_on_thread--;
+  }
+}
+
+void PageGroup::BindToCurrentThread() {
+  if (!bound_to_thread_) {
+    bound_to_thread_ = true;
+    page_groups_on_thread++;
+  }
+}
+
+bool PageGroup::HasGroupsOnCurrentThread() {
+  return page_groups_on_thread > 0;
 }
 
 void PageGroup::AddNewPage(webf::WebFPage* new_page) {
@@ -42,6 +77,53 @@ void PageGroup::RemovePage(webf::WebFPage* page) {
   pages_.erase(std::find(pages_.begin(), pages_.end(), page));
 }
 
+std::unique_ptr<WebFPage> PageGroup::TakePrewarmedPage(int32_t sync_buffer_size, int8_t use_legacy_ui_command) {
+  if (prewarmed_pages_.empty() || sync_buffer_size != prewarm_sync_buffer_size_ ||
+      use_legacy_ui_command != prewarm_use_legacy_ui_command_) {
+    return nullptr;
+  }
+  std::unique_ptr<WebFPage> page = std::move(prewarmed_pages_.back());
+  prewarmed_pages_.pop_back();
+  return page;
+}
+
+void PageGroup::SchedulePrewarm(DartIsolateContext* dart_isolate_context,
+                                int32_t sync_buffer_size,
+                                int8_t use_legacy_ui_command) {
+  if (sync_buffer_size != prewarm_sync_buffer_size_ || use_legacy_ui_command != prewarm_use_legacy_ui_command_) {
+    prewarmed_pages_.clear();
+    prewarm_sync_buffer_size_ = sync_buffer_size;
+    prewarm_use_legacy_ui_command_ = use_legacy_ui_command;
+  }
+  dart_isolate_context_ = dart_isolate_context;
+
+  if (prewarm_timer_ != 0) {
+    looper_->CancelTimer(prewarm_timer_);
+  }
+  prewarm_timer_ = looper_->ScheduleTimer(kPrewarmDelayMs, [this]() { PrewarmNextPage(); });
+}
+
+void PageGroup::PrewarmNextPage() {
+  prewarm_timer_ = 0;
+  size_t target = static_cast<size_t>(dart_isolate_context_->prewarmedPageCount());
+  if (prewarmed_pages_.size() >= target) {
+    prewarmed_pages_.resize(target);
+    return;
+  }
+
+  if (!looper_->HasPendingTasks()) {
+    prewarmed_pages_.emplace_back(std::make_unique<WebFPage>(
+        dart_isolate_context_, true, prewarm_sync_buffer_size_, prewarm_use_legacy_ui_command_,
+        next_prewarmed_context_id--, nullptr, 0, nullptr));
+    if (prewarmed_pages_.size() >= target) {
+      return;
+    }
+  }
+  // One page per turn, so tasks posted meanwhile are never held up by more
+  // than a single page setup.
+  prewarm_timer_ = looper_->ScheduleTimer(kPrewarmRetryDelayMs, [this]() { PrewarmNextPage(); });
+}
+
 void WatchDartWire(DartWireContext* wire) {
   alive_wires.emplace(wire);
 }
@@ -68,6 +150,7 @@ thread_local DartIsolateContext* g_current_isolate_context = nullptr;
 thread_local uint32_t running_dart_isolates = 0;
 thread_local bool is_core_global_initialized = false;
 thread_local std::unique_ptr<StringCache> DartIsolateContext::string_cache_{nullptr};
+thread_local std::unique_ptr<SharedStyleSheetCache> DartIsolateContext::style_sheet_cache_{nullptr};
 
 void InitializeCoreGlobals() {
   if (!is_core_global_initialized) {
@@ -103,7 +186,10 @@ void DartIsolateContext::FinalizeJSRuntime() {
 
   string_cache_->Dispose();
   string_cache_ = nullptr;
+  // Cached stylesheets hold AtomicStrings from the table cleared below.
+  style_sheet_cache_ = nullptr;
   // Prebuilt strings stored in JSRuntime. Only needs to dispose when runtime disposed.
+  BindingNameTable::Dispose();
   names_installer::Dispose();
   HTMLElementFactory::Dispose();
   SVGElementFactory::Dispose();
@@ -142,6 +228,13 @@ StringCache* DartIsolateContext::ensureStringCache(JSContext* ctx) const {
   return string_cache_.get();
 }
 
+SharedStyleSheetCache* DartIsolateContext::styleSheetCache() const {
+  if (style_sheet_cache_ == nullptr) {
+    style_sheet_cache_ = std::make_unique<SharedStyleSheetCache>();
+  }
+  return style_sheet_cache_.get();
+}
+
 void DartIsolateContext::InitializeGlobalsPerThread() {
   DCHECK(runtime_ != nullptr);
   if (string_cache_ == nullptr) {
@@ -159,7 +252,15 @@ void DartIsolateContext::Dispose(multi_threading::Callback callback) {
 
     // Pretty-print metrics snapshot at teardown.
     auto snapshot = metrics_.SnapshotAllNamed();
-    if (!snapshot.empty()) {
+    std::vector<std::pair<MetricsHistogram, MetricsHistogramSnapshot>> histograms;
+    for (size_t i = 0; i < static_cast<size_t>(MetricsHistogram::kCount); ++i) {
+      auto metric = static_cast<MetricsHistogram>(i);
+      MetricsHistogramSnapshot histogram = metrics_.Get(metric);
+      if (histogram.count) {
+        histograms.emplace_back(metric, histogram);
+      }
+    }
+    if (!snapshot.empty() || !histograms.empty()) {
       // Collect items and sort by value desc, then key asc for readability.
       std::vector<std::pair<std::string, uint64_t>> items;
       items.reserve(snapshot.size());
@@ -183,6 +284,14 @@ void DartIsolateContext::Dispose(multi_threading::Callback callback) {
         line << "  " << std::left << std::setw(static_cast<int>(max_key_len)) << key << " : " << value;
         WEBF_LOG(INFO) << line.str();
       }
+      if (!histograms.empty()) {
+        WEBF_LOG(INFO) << "Histograms: " << histograms.size();
+        for (const auto& [metric, histogram] : histograms) {
+          WEBF_LOG(INFO) << "  " << MetricName(metric) << " : count=" << histogram.count
+                         << " mean=" << histogram.Mean() << " p50=" << histogram.ValueAtPercentile(50)
+                         << " p90=" << histogram.ValueAtPercentile(90) << " p99=" << histogram.ValueAtPercentile(99);
+        }
+      }
       WEBF_LOG(INFO) << "============================================";
     }
 
@@ -204,8 +313,17 @@ void DartIsolateContext::InitializeNewPageInJSThread(PageGroup* page_group,
                                                      AllocateNewPageCallback result_callback) {
   DartIsolateContext::InitializeJSRuntime();
   dart_isolate_context->InitializeGlobalsPerThread();
-  auto* page = new WebFPage(dart_isolate_context, true, sync_buffer_size, use_legacy_ui_command, page_context_id, native_widget_element_shapes,
-                            shape_len, nullptr);
+  page_group->BindToCurrentThread();
+
+  WebFPage* page;
+  if (auto prewarmed = page_group->TakePrewarmedPage(sync_buffer_size, use_legacy_ui_command)) {
+    page = prewarmed.release();
+    page->executingContext()->ReassignContextId(page_context_id);
+    page->executingContext()->SetWidgetElementShape(native_widget_element_shapes, shape_len);
+  } else {
+    page = new WebFPage(dart_isolate_context, true, sync_buffer_size, use_legacy_ui_command, page_context_id,
+                        native_widget_element_shapes, shape_len, nullptr);
+  }
 
   if (enable_blink) {
     page->executingContext()->EnableBlinkEngine();
@@ -213,6 +331,10 @@ void DartIsolateContext::InitializeNewPageInJSThread(PageGroup* page_group,
 
   dart_isolate_context->dispatcher_->PostToDart(true, HandleNewPageResult, page_group, dart_handle, result_callback,
                                                 page);
+
+  if (dart_isolate_context->prewarmedPageCount() > 0) {
+    page_group->SchedulePrewarm(dart_isolate_context, sync_buffer_size, use_legacy_ui_command);
+  }
 }
 
 void DartIsolateContext::DisposePageAndKilledJSThread(DartIsolateContext* dart_isolate_context,
@@ -249,10 +371,13 @@ void* DartIsolateContext::AddNewPage(double thread_identity,
   PageGroup* page_group;
   if (!dispatcher_->IsThreadGroupExist(thread_group_id)) {
     dispatcher_->AllocateNewJSThread(thread_group_id);
-    page_group = new PageGroup();
+    page_group = new PageGroup(dispatcher_->looper(thread_group_id).get());
     dispatcher_->SetOpaqueForJSThread(thread_group_id, page_group, [](void* p) {
       delete static_cast<PageGroup*>(p);
-      DartIsolateContext::FinalizeJSRuntime();
+      // Other groups multiplexed onto this worker still run on its runtime.
+      if (!PageGroup::HasGroupsOnCurrentThread()) {
+        DartIsolateContext::FinalizeJSRuntime();
+      }
     });
   } else {
     page_group = static_cast<PageGroup*>(dispatcher_->GetOpaque(thread_group_id));
@@ -313,7 +438,7 @@ void DartIsolateContext::HandleDisposePageAndKillJSThread(DartIsolateContext* da
                                                           int thread_group_id,
                                                           Dart_Handle persistent_handle,
                                                           DisposePageCallback result_callback) {
-  dart_isolate_context->dispatcher_->KillJSThreadSync(thread_group_id);
+  dart_isolate_context->dispatcher_->KillJSThread(thread_group_id);
 
   Dart_Handle handle = Dart_HandleFromPersistent_DL(persistent_handle);
   result_callback(handle);
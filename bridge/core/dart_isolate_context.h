@@ -9,11 +9,14 @@
 #ifndef WEBF_DART_CONTEXT_H_
 #define WEBF_DART_CONTEXT_H_
 
+#include <algorithm>
+#include <atomic>
 #include <unordered_set>
 #include "bindings/qjs/script_value.h"
 #include "bindings/qjs/value_cache.h"
 #include "dart_methods.h"
 #include "multiple_threading/dispatcher.h"
+#include "foundation/bytecode_cache.h"
 #include "foundation/metrics_registry.h"
 
 namespace webf {
@@ -24,9 +27,11 @@ class DartMethodPointer;
 class WebFPage;
 class DartIsolateContext;
 class NativeWidgetElementShape;
+class SharedStyleSheetCache;
 
 class PageGroup {
  public:
+  explicit PageGroup(multi_threading::Looper* looper) : looper_(looper) {}
   ~PageGroup();
   void AddNewPage(WebFPage* new_page);
   void RemovePage(WebFPage* page);
@@ -34,8 +39,30 @@ class PageGroup {
 
   std::vector<WebFPage*>* pages() { return &pages_; };
 
+  // Counts this group against the JS thread it runs on; the thread's runtime
+  // is released once no group is left on it.
+  void BindToCurrentThread();
+  static bool HasGroupsOnCurrentThread();
+
+  // Pages are built ahead of demand on this group's JS thread, while its looper
+  // is idle, and handed out by the next AddNewPage with the same UI command
+  // settings. Both calls must be made on the JS thread.
+  std::unique_ptr<WebFPage> TakePrewarmedPage(int32_t sync_buffer_size, int8_t use_legacy_ui_command);
+  void SchedulePrewarm(DartIsolateContext* dart_isolate_context,
+                       int32_t sync_buffer_size,
+                       int8_t use_legacy_ui_command);
+
  private:
+  void PrewarmNextPage();
+
   std::vector<WebFPage*> pages_;
+  bool bound_to_thread_{false};
+  multi_threading::Looper* looper_;
+  DartIsolateContext* dart_isolate_context_{nullptr};
+  std::vector<std::unique_ptr<WebFPage>> prewarmed_pages_;
+  int32_t prewarm_sync_buffer_size_{0};
+  int8_t prewarm_use_legacy_ui_command_{0};
+  multi_threading::TimerWheel::TimerId prewarm_timer_{0};
 };
 
 struct DartWireContext {
@@ -70,6 +97,14 @@ class DartIsolateContext {
   }
   FORCE_INLINE StringCache* stringCache() const { return string_cache_.get(); }
   StringCache* ensureStringCache(JSContext* ctx) const;
+  // Parsed stylesheets shared by the pages running on the current JS thread.
+  SharedStyleSheetCache* styleSheetCache() const;
+  // Compiled scripts on disk, or nullptr when Dart did not configure a directory.
+  FORCE_INLINE BytecodeCache* bytecodeCache() const { return bytecode_cache_.get(); }
+  FORCE_INLINE void SetBytecodeCache(std::unique_ptr<BytecodeCache>&& cache) { bytecode_cache_ = std::move(cache); }
+  // Spare pages each dedicated JS thread keeps ready for allocateNewPage.
+  FORCE_INLINE int32_t prewarmedPageCount() const { return prewarmed_page_count_; }
+  FORCE_INLINE void SetPrewarmedPageCount(int32_t count) { prewarmed_page_count_ = std::max(count, 0); }
   FORCE_INLINE MetricsRegistry* metrics() { return &metrics_; }
   FORCE_INLINE const MetricsRegistry* metrics() const { return &metrics_; }
 
@@ -91,6 +126,7 @@ class DartIsolateContext {
   void Dispose(multi_threading::Callback callback);
 
  private:
+  friend class PrewarmedContextTest;
   static void InitializeJSRuntime();
   static void FinalizeJSRuntime();
   static std::unique_ptr<WebFPage> InitializeNewPageSync(DartIsolateContext* dart_isolate_context,
@@ -131,7 +167,10 @@ class DartIsolateContext {
   std::thread::id running_thread_;
   std::unordered_set<std::unique_ptr<WebFPage>> pages_in_ui_thread_;
   static thread_local std::unique_ptr<StringCache> string_cache_;
+  static thread_local std::unique_ptr<SharedStyleSheetCache> style_sheet_cache_;
   std::unique_ptr<multi_threading::Dispatcher> dispatcher_ = nullptr;
+  std::unique_ptr<BytecodeCache> bytecode_cache_ = nullptr;
+  std::atomic<int32_t> prewarmed_page_count_{0};
   // Dart methods ptr should keep alive when ExecutingContext is disposing.
   const std::unique_ptr<DartMethodPointer> dart_method_ptr_ = nullptr;
   // Per-isolate metrics shared across all pages in the isolate.
@@ -58,6 +58,15 @@ DartMethodPointer::DartMethodPointer(DartIsolateContext* dart_isolate_context,
            "Dart native methods count is not equal with C++ side method registrations.");
 }
 
+template <typename Func, typename... Args>
+void DartMethodPointer::PostToDartForContext(bool is_dedicated, double context_id, Func&& func, Args&&... args) {
+  // A prewarmed page has no Dart controller until it is handed out, so what it
+  // would post is dropped instead of reaching Dart under a placeholder id.
+  if (multi_threading::IsPrewarmedContextId(context_id))
+    return;
+  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, std::forward<Func>(func), std::forward<Args>(args)...);
+}
+
 NativeValue* DartMethodPointer::invokeModule(bool is_dedicated,
                                              void* callback_context,
                                              double context_id,
@@ -92,7 +101,7 @@ void DartMethodPointer::requestBatchUpdate(bool is_dedicated, double context_id)
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::requestBatchUpdate Call";
 #endif
 
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, request_batch_update_, context_id);
+  PostToDartForContext(is_dedicated, context_id, request_batch_update_, context_id);
 }
 
 void DartMethodPointer::registerFontFace(bool is_dedicated,
@@ -106,15 +115,15 @@ void DartMethodPointer::registerFontFace(bool is_dedicated,
 #if ENABLE_LOG
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::registerFontFace Call";
 #endif
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, register_font_face_, context_id, sheet_id, font_family,
-                                                  src, font_weight, font_style, base_href);
+  PostToDartForContext(is_dedicated, context_id, register_font_face_, context_id, sheet_id, font_family, src,
+                       font_weight, font_style, base_href);
 }
 
 void DartMethodPointer::unregisterFontFace(bool is_dedicated, double context_id, int64_t sheet_id) {
 #if ENABLE_LOG
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::unregisterFontFace Call";
 #endif
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, unregister_font_face_, context_id, sheet_id);
+  PostToDartForContext(is_dedicated, context_id, unregister_font_face_, context_id, sheet_id);
 }
 
 void DartMethodPointer::registerKeyframes(bool is_dedicated,
@@ -129,8 +138,8 @@ void DartMethodPointer::registerKeyframes(bool is_dedicated,
   if (!register_keyframes_) {
     return;  // Dart side not supporting this yet; fail silently
   }
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, register_keyframes_, context_id, sheet_id, name,
-                                                  css_text, is_prefixed);
+  PostToDartForContext(is_dedicated, context_id, register_keyframes_, context_id, sheet_id, name, css_text,
+                       is_prefixed);
 }
 
 void DartMethodPointer::unregisterKeyframes(bool is_dedicated, double context_id, int64_t sheet_id) {
@@ -140,7 +149,7 @@ void DartMethodPointer::unregisterKeyframes(bool is_dedicated, double context_id
   if (!unregister_keyframes_) {
     return;  // Dart side not supporting this yet; fail silently
   }
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, unregister_keyframes_, context_id, sheet_id);
+  PostToDartForContext(is_dedicated, context_id, unregister_keyframes_, context_id, sheet_id);
 }
 
 void DartMethodPointer::reloadApp(bool is_dedicated, double context_id) {
@@ -148,7 +157,7 @@ void DartMethodPointer::reloadApp(bool is_dedicated, double context_id) {
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::reloadApp Call";
 #endif
 
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, reload_app_, context_id);
+  PostToDartForContext(is_dedicated, context_id, reload_app_, context_id);
 }
 
 int32_t DartMethodPointer::setTimeout(bool is_dedicated,
@@ -162,8 +171,8 @@ int32_t DartMethodPointer::setTimeout(bool is_dedicated,
 
   int32_t new_timer_id = start_timer_id++;
 
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, set_timeout_, new_timer_id, callback_context,
-                                                  context_id, callback, timeout);
+  PostToDartForContext(is_dedicated, context_id, set_timeout_, new_timer_id, callback_context, context_id, callback,
+                       timeout);
 
 #if ENABLE_LOG
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::setTimeout callSync END";
@@ -183,8 +192,8 @@ int32_t DartMethodPointer::setInterval(bool is_dedicated,
 
   int32_t new_timer_id = start_timer_id++;
 
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, set_interval_, new_timer_id, callback_context,
-                                                  context_id, callback, timeout);
+  PostToDartForContext(is_dedicated, context_id, set_interval_, new_timer_id, callback_context, context_id, callback,
+                       timeout);
 #if ENABLE_LOG
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::setInterval callSync END";
 #endif
@@ -196,7 +205,7 @@ void DartMethodPointer::clearTimeout(bool is_dedicated, double context_id, int32
   WEBF_LOG(VERBOSE) << "[CPP] ClearTimeoutWrapper call" << std::endl;
 #endif
 
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, clear_timeout_, context_id, timer_id);
+  PostToDartForContext(is_dedicated, context_id, clear_timeout_, context_id, timer_id);
 }
 
 int32_t DartMethodPointer::requestIdleCallback(bool is_dedicated,
@@ -211,8 +220,8 @@ int32_t DartMethodPointer::requestIdleCallback(bool is_dedicated,
 
   int32_t new_idle_id = start_idle_id++;
 
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, request_idle_callback_, new_idle_id, callback_context,
-                                                  context_id, timeout, ui_command_size, callback);
+  PostToDartForContext(is_dedicated, context_id, request_idle_callback_, new_idle_id, callback_context, context_id,
+                       timeout, ui_command_size, callback);
 
 #if ENABLE_LOG
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::requestAnimationFrame call END";
@@ -226,7 +235,7 @@ void DartMethodPointer::cancelAnimationFrame(bool is_dedicated, double context_i
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::cancelAnimationFrame call START";
 #endif
 
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, cancel_animation_frame_, context_id, id);
+  PostToDartForContext(is_dedicated, context_id, cancel_animation_frame_, context_id, id);
 }
 
 void DartMethodPointer::cancelIdleCallback(bool is_dedicated, double context_id, int32_t id) {
@@ -234,7 +243,7 @@ void DartMethodPointer::cancelIdleCallback(bool is_dedicated, double context_id,
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::cancelAnimationFrame call START";
 #endif
 
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, cancel_idle_callback_, context_id, id);
+  PostToDartForContext(is_dedicated, context_id, cancel_idle_callback_, context_id, id);
 }
 
 void DartMethodPointer::toBlob(bool is_dedicated,
@@ -247,8 +256,8 @@ void DartMethodPointer::toBlob(bool is_dedicated,
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::toBlob call START";
 #endif
 
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, to_blob_, callback_context, context_id, blobCallback,
-                                                  element_ptr, devicePixelRatio);
+  PostToDartForContext(is_dedicated, context_id, to_blob_, callback_context, context_id, blobCallback, element_ptr,
+                       devicePixelRatio);
 }
 
 void DartMethodPointer::flushUICommand(bool is_dedicated, double context_id, void* native_binding_object) {
@@ -305,8 +314,8 @@ void DartMethodPointer::loadNativeLibrary(bool is_dedicated,
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::loadNativeLibrary SYNC call START";
 #endif
 
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, load_native_library_, context_id, lib_name,
-                                                  initialize_data, import_data, callback);
+  PostToDartForContext(is_dedicated, context_id, load_native_library_, context_id, lib_name, initialize_data,
+                       import_data, callback);
 
 #if ENABLE_LOG
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::loadNativeLibrary SYNC call END";
@@ -322,8 +331,8 @@ void DartMethodPointer::fetchJavaScriptESMModule(bool is_dedicated,
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::fetchJavaScriptESMModule ASYNC call START";
 #endif
 
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, fetch_javascript_esm_module_, callback_context,
-                                                  context_id, module_url, callback);
+  PostToDartForContext(is_dedicated, context_id, fetch_javascript_esm_module_, callback_context, context_id, module_url,
+                       callback);
 
 #if ENABLE_LOG
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::fetchJavaScriptESMModule ASYNC call END";
@@ -340,8 +349,8 @@ void DartMethodPointer::fetchImportCSSContent(bool is_dedicated,
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::fetchImportCSSContent ASYNC call START";
 #endif
 
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, fetch_import_css_content_, callback_context,
-                                                  context_id, base_href, import_href, callback);
+  PostToDartForContext(is_dedicated, context_id, fetch_import_css_content_, callback_context, context_id, base_href,
+                       import_href, callback);
 
 #if ENABLE_LOG
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::fetchImportCSSContent ASYNC call END";
@@ -349,11 +358,11 @@ void DartMethodPointer::fetchImportCSSContent(bool is_dedicated,
 }
 
 void DartMethodPointer::onJSError(bool is_dedicated, double context_id, const char* error) {
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, on_js_error_, context_id, error);
+  PostToDartForContext(is_dedicated, context_id, on_js_error_, context_id, error);
 }
 
 void DartMethodPointer::onJSLog(bool is_dedicated, double context_id, int32_t level, const char* log) {
-  if (on_js_log_ == nullptr)
+  if (on_js_log_ == nullptr || multi_threading::IsPrewarmedContextId(context_id))
     return;
   int log_length = strlen(log) + 1;
   char* log_str = (char*)dart_malloc(sizeof(char) * log_length);
@@ -363,7 +372,7 @@ void DartMethodPointer::onJSLog(bool is_dedicated, double context_id, int32_t le
 }
 
 void DartMethodPointer::onJSLogStructured(bool is_dedicated, double context_id, int32_t level, int32_t argc, NativeValue* argv) {
-  if (on_js_log_structured_ == nullptr)
+  if (on_js_log_structured_ == nullptr || multi_threading::IsPrewarmedContextId(context_id))
     return;
   
   // Allocate memory for the native values array
@@ -387,8 +396,8 @@ void DartMethodPointer::matchImageSnapshot(bool is_dedicated,
 #if ENABLE_LOG
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::createBindingObject call START";
 #endif
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, match_image_snapshot_, callback_context, context_id,
-                                                  bytes, length, name, callback);
+  PostToDartForContext(is_dedicated, context_id, match_image_snapshot_, callback_context, context_id, bytes, length,
+                       name, callback);
 }
 
 void DartMethodPointer::matchImageSnapshotBytes(bool is_dedicated,
@@ -402,9 +411,8 @@ void DartMethodPointer::matchImageSnapshotBytes(bool is_dedicated,
 #if ENABLE_LOG
   WEBF_LOG(VERBOSE) << "[Dispatcher] DartMethodPointer::matchImageSnapshotBytes call START";
 #endif
-  dart_isolate_context_->dispatcher()->PostToDart(is_dedicated, match_image_snapshot_bytes_, callback_context,
-                                                  context_id, image_a_bytes, image_a_size, image_b_bytes, image_b_size,
-                                                  callback);
+  PostToDartForContext(is_dedicated, context_id, match_image_snapshot_bytes_, callback_context, context_id,
+                       image_a_bytes, image_a_size, image_b_bytes, image_b_size, callback);
 }
 
 const char* DartMethodPointer::environment(bool is_dedicated, double context_id) {
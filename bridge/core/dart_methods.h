@@ -310,6 +310,9 @@ class DartMethodPointer {
   void SetSimulateInputText(SimulateInputText func);
 
  private:
+  template <typename Func, typename... Args>
+  void PostToDartForContext(bool is_dedicated, double context_id, Func&& func, Args&&... args);
+
   DartIsolateContext* dart_isolate_context_{nullptr};
   InvokeModule invoke_module_{nullptr};
   RequestBatchUpdate request_batch_update_{nullptr};
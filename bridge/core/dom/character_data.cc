@@ -15,8 +15,8 @@ void CharacterData::setData(const AtomicString& data, ExceptionState& exception_
   AtomicString old_data = data_;
   data_ = data;
 
-  std::unique_ptr<SharedNativeString> args_01 = data.ToNativeString();
-  std::unique_ptr<SharedNativeString> args_02 = AtomicString::CreateFromUTF8("data").ToNativeString();
+  std::unique_ptr<SharedNativeString> args_01 = data.ToCompactNativeString();
+  std::unique_ptr<SharedNativeString> args_02 = AtomicString::CreateFromUTF8("data").ToCompactNativeString();
   GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kSetAttribute, std::move(args_01), bindingObject(),
                                                        args_02.release());
 
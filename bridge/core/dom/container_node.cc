@@ -31,7 +31,7 @@
 #include "core/css/parser/css_nesting_type.h"
 #include "core/css/parser/css_parser.h"
 #include "core/css/parser/css_parser_context.h"
-#include "core/css/selector_checker.h"
+#include "core/css/selector_query.h"
 #include "core/css/style_engine.h"
 #include "core/css/style_change_reason.h"
 #include "core/css/style_sheet_contents.h"
@@ -42,6 +42,7 @@
 #include "core/dom/child_node_list.h"
 #include "core/dom/events/event_dispatch_forbidden_scope.h"
 #include "core/dom/node_lists_node_data.h"
+#include "core/dom/space_split_string.h"
 #include "core/html/html_all_collection.h"
 #include "core/script_forbidden_scope.h"
 #include "document.h"
@@ -51,45 +52,6 @@
 
 namespace webf {
 
-namespace {
-
-std::shared_ptr<CSSSelectorList> ParseSelectorListOrThrow(const AtomicString &selectors,
-                                                          ExceptionState &exception_state,
-                                                          JSContext *ctx) {
-  auto parser_context = std::make_shared<CSSParserContext>(kHTMLStandardMode);
-  auto sheet = std::make_shared<StyleSheetContents>(parser_context);
-
-  std::vector<CSSSelector> arena;
-  tcb::span<CSSSelector> vector =
-      CSSParser::ParseSelector(parser_context, CSSNestingType::kNone, /*parent_rule_for_nesting=*/nullptr, sheet,
-                               selectors.GetString(), arena);
-
-  auto selector_list = CSSSelectorList::AdoptSelectorVector(vector);
-  if (!selector_list->IsValid()) {
-    exception_state.ThrowException(ctx, ErrorType::SyntaxError,
-                                   "'" + selectors.ToUTF8String() + "' is not a valid selector.");
-    return nullptr;
-  }
-  return selector_list;
-}
-
-bool MatchesAnySelectorInList(Element &element, const CSSSelectorList &selector_list, const ContainerNode &scope) {
-  SelectorChecker checker(SelectorChecker::kQueryingRules);
-  SelectorChecker::SelectorCheckingContext context(&element);
-  context.scope = &scope;
-
-  for (const CSSSelector *selector = selector_list.First(); selector; selector = CSSSelectorList::Next(*selector)) {
-    context.selector = selector;
-    SelectorChecker::MatchResult result;
-    if (checker.Match(context, result)) {
-      return true;
-    }
-  }
-  return false;
-}
-
-}  // namespace
-
 // Legacy impls due to limited time, should remove this func in the future.
 HTMLCollection *ContainerNode::Children() {
   return EnsureCachedCollection<HTMLCollection>(CollectionType::kNodeChildren);
@@ -103,17 +65,11 @@ unsigned ContainerNode::CountChildren() const {
 }
 
 Element *ContainerNode::QuerySelector(const AtomicString &selectors, ExceptionState &exception_state) {
-  auto selector_list = ParseSelectorListOrThrow(selectors, exception_state, ctx());
-  if (!selector_list) {
+  SelectorQuery *selector_query = GetDocument().GetSelectorQueryCache().Add(selectors, ctx(), exception_state);
+  if (!selector_query) {
     return nullptr;
   }
-
-  for (Element &element : ElementTraversal::DescendantsOf(*this)) {
-    if (MatchesAnySelectorInList(element, *selector_list, *this)) {
-      return &element;
-    }
-  }
-  return nullptr;
+  return selector_query->QueryFirst(*this);
 }
 
 Element *ContainerNode::QuerySelector(const AtomicString &selectors) {
@@ -121,22 +77,93 @@ Element *ContainerNode::QuerySelector(const AtomicString &selectors) {
 }
 
 std::vector<Element *> ContainerNode::QuerySelectorAll(const AtomicString &selectors, ExceptionState &exception_state) {
-  auto selector_list = ParseSelectorListOrThrow(selectors, exception_state, ctx());
-  if (!selector_list) {
+  SelectorQuery *selector_query = GetDocument().GetSelectorQueryCache().Add(selectors, ctx(), exception_state);
+  if (!selector_query) {
+    return {};
+  }
+  return selector_query->QueryAll(*this);
+}
+
+std::vector<Element *> ContainerNode::QuerySelectorAll(const AtomicString &selectors) {
+  return QuerySelectorAll(selectors, ASSERT_NO_EXCEPTION());
+}
+
+std::vector<Element *> ContainerNode::GetElementsByClassName(const AtomicString &class_names) const {
+  SpaceSplitString query(class_names);
+  if (query.size() == 0) {
     return {};
   }
 
+  // Pick the rarest token in the scope. If any token has no connected
+  // element, nothing can match; if we are walking the whole scope, we can
+  // stop once every element carrying the rarest token has been seen.
+  const AtomicString *rarest = nullptr;
+  uint32_t remaining = 0;
+  if (isConnected()) {
+    const TreeScope &scope = GetTreeScope();
+    for (size_t i = 0; i < query.size(); i++) {
+      uint32_t count = scope.CountElementsWithClassName(query[i]);
+      if (count == 0) {
+        return {};
+      }
+      if (!rarest || count < remaining) {
+        rarest = &query[i];
+        remaining = count;
+      }
+    }
+    if (&scope.RootNode() != this) {
+      rarest = nullptr;
+    }
+  }
+
   std::vector<Element *> result;
   for (Element &element : ElementTraversal::DescendantsOf(*this)) {
-    if (MatchesAnySelectorInList(element, *selector_list, *this)) {
+    if (!element.HasClass()) {
+      continue;
+    }
+    const SpaceSplitString &element_classes = element.ClassNames();
+    if (element_classes.ContainsAll(query)) {
       result.emplace_back(&element);
     }
+    if (rarest && element_classes.Contains(*rarest) && --remaining == 0) {
+      break;
+    }
   }
   return result;
 }
 
-std::vector<Element *> ContainerNode::QuerySelectorAll(const AtomicString &selectors) {
-  return QuerySelectorAll(selectors, ASSERT_NO_EXCEPTION());
+std::vector<Element *> ContainerNode::GetElementsByTagName(const AtomicString &tag_name) const {
+  if (tag_name.empty()) {
+    return {};
+  }
+
+  const bool match_all = tag_name == g_star_atom;
+  uint32_t remaining = 0;
+  bool bounded = false;
+  if (isConnected()) {
+    const TreeScope &scope = GetTreeScope();
+    remaining = match_all ? scope.ElementCount() : scope.CountElementsWithTagName(tag_name);
+    if (remaining == 0) {
+      return {};
+    }
+    bounded = &scope.RootNode() == this;
+  }
+
+  std::vector<Element *> result;
+  if (bounded) {
+    result.reserve(remaining);
+  }
+  StringView query(tag_name);
+  for (Element &element : ElementTraversal::DescendantsOf(*this)) {
+    if (!match_all && !EqualIgnoringASCIICase(StringView(element.localName()), query)) {
+      continue;
+    }
+    result.emplace_back(&element);
+    if (bounded && --remaining == 0) {
+      break;
+    }
+  }
+  return result;
 }
 
 inline void GetChildNodes(ContainerNode &node, NodeVector &nodes) {
@@ -765,7 +792,7 @@ void ContainerNode::InsertBeforeCommon(Node &next_child, Node &new_child) {
   new_child.SetPreviousSibling(prev);
   new_child.SetNextSibling(&next_child);
 
-  std::unique_ptr<SharedNativeString> args_01 = AtomicString::CreateFromUTF8("beforebegin").ToNativeString();
+  std::unique_ptr<SharedNativeString> args_01 = AtomicString::CreateFromUTF8("beforebegin").ToCompactNativeString();
   GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kInsertAdjacentNode, std::move(args_01),
                                                        next_child.bindingObject(), new_child.bindingObject());
 }
@@ -785,7 +812,7 @@ void ContainerNode::AppendChildCommon(Node &child) {
   }
   SetLastChild(&child);
 
-  std::unique_ptr<SharedNativeString> args_01 = AtomicString::CreateFromUTF8("beforeend").ToNativeString();
+  std::unique_ptr<SharedNativeString> args_01 = AtomicString::CreateFromUTF8("beforeend").ToCompactNativeString();
   GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kInsertAdjacentNode, std::move(args_01),
                                                        bindingObject(), child.bindingObject());
 }
@@ -66,6 +66,13 @@ class ContainerNode : public Node {
   std::vector<Element*> QuerySelectorAll(const AtomicString& selectors, ExceptionState&);
   std::vector<Element*> QuerySelectorAll(const AtomicString& selectors);
 
+  // Native getElementsByClassName()/getElementsByTagName() over the
+  // descendants of this node, answered from the C++ DOM. When this node is
+  // the root of its tree scope the scope's class/tag counts are used to stop
+  // the walk as soon as every candidate has been visited.
+  std::vector<Element*> GetElementsByClassName(const AtomicString& class_names) const;
+  std::vector<Element*> GetElementsByTagName(const AtomicString& tag_name) const;
+
   Node* InsertBefore(Node* new_child, Node* ref_child, ExceptionState&);
   Node* ReplaceChild(Node* new_child, Node* old_child, ExceptionState&);
   Node* RemoveChild(Node* child, ExceptionState&);
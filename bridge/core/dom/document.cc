@@ -9,6 +9,7 @@
 #include "binding_call_methods.h"
 #include "bindings/qjs/exception_message.h"
 #include "core/css/css_style_sheet.h"
+#include "core/css/selector_query.h"
 #include "core/css/style_engine.h"
 #include "core/dom/comment.h"
 #include "core/dom/document_fragment.h"
@@ -229,34 +230,16 @@ std::vector<Element*> Document::querySelectorAll(const AtomicString& selectors,
 }
 
 Element* Document::getElementById(const AtomicString& id, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), id)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetElementById, 1, arguments,
-                                           FlushUICommandReason::kDependentsAll, exception_state);
-  if (exception_state.HasException()) {
-    return {};
-  }
-  return NativeValueConverter<NativeTypePointer<Element>>::FromNativeValue(ctx(), result);
+  return TreeScope::getElementById(id);
 }
 
 std::vector<Element*> Document::getElementsByClassName(const AtomicString& class_name,
                                                        ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), class_name)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetElementsByClassName, 1, arguments,
-                                           FlushUICommandReason::kDependentsAll, exception_state);
-  if (exception_state.HasException()) {
-    return {};
-  }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+  return GetElementsByClassName(class_name);
 }
 
 std::vector<Element*> Document::getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), tag_name)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetElementsByTagName, 1, arguments,
-                                           FlushUICommandReason::kDependentsAll, exception_state);
-  if (exception_state.HasException()) {
-    return {};
-  }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+  return GetElementsByTagName(tag_name);
 }
 
 std::vector<Element*> Document::getElementsByName(const AtomicString& name, ExceptionState& exception_state) {
@@ -652,6 +635,13 @@ StyleEngine& Document::EnsureStyleEngine() {
   return *style_engine_;
 }
 
+SelectorQueryCache& Document::GetSelectorQueryCache() {
+  if (!selector_query_cache_) {
+    selector_query_cache_ = std::make_shared<SelectorQueryCache>();
+  }
+  return *selector_query_cache_;
+}
+
 bool Document::InStyleRecalc() const {
   // Until the full DocumentLifecycle plumbing is wired, use a local flag
   // toggled by StyleEngine to indicate when we are in the middle of a style
@@ -26,6 +26,7 @@ class HTMLHeadElement;
 class HTMLHtmlElement;
 class HTMLScriptElement;
 class StyleEngine;
+class SelectorQueryCache;
 class CSSStyleSheet;
 class HTMLAllCollection;
 class Text;
@@ -190,6 +191,8 @@ class Document : public ContainerNode, public TreeScope {
   void Trace(GCVisitor* visitor) const override;
   const DocumentPublicMethods* documentPublicMethods();
   StyleEngine& EnsureStyleEngine();
+  // Compiled querySelector*/matches/closest selectors keyed by selector text.
+  SelectorQueryCache& GetSelectorQueryCache();
   bool IsForMarkupSanitization() const { return is_for_markup_sanitization_; }
 
   bool InStyleRecalc() const;
@@ -258,6 +261,7 @@ class Document : public ContainerNode, public TreeScope {
   ScriptAnimationController script_animation_controller_;
   MutationObserverOptions mutation_observer_types_;
   std::shared_ptr<StyleEngine> style_engine_{nullptr};
+  std::shared_ptr<SelectorQueryCache> selector_query_cache_{nullptr};
   bool is_for_markup_sanitization_ = false;
   KURL url_;                // Document.URL: The URL from which this document was retrieved.
   KURL base_url_;           // Node.baseURI: The URL to use when resolving relative URLs.
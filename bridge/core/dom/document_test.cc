@@ -231,6 +231,61 @@ TEST(Document, getElementsByTagNameAndClassNameUseBlinkWhenEnabled) {
   EXPECT_STREQ(logMessage.c_str(), "true true true true true");
 }
 
+TEST(Document, getElementByIdAndGetElementsByAreAnsweredNatively) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  std::string static logMessage;
+  errorCalled = false;
+  logCalled = false;
+  logMessage = "";
+
+  webf::WebFPage::consoleMessageHandler = [](void*, const std::string& message, int) {
+    logCalled = true;
+    logMessage = message;
+  };
+
+  auto env = TEST_init([](double, const char*) { errorCalled = true; });
+  auto* context = env->page()->executingContext();
+  TEST_runLoop(context);
+
+  // The tree scope indexes must answer these lookups without Dart, with or
+  // without Blink CSS enabled.
+  context->document()->bindingObject()->invoke_bindings_methods_from_native = nullptr;
+
+  const char* code =
+      "let a = document.createElement('div');"
+      "a.id = 'x';"
+      "a.className = 'item first';"
+      "let b = document.createElement('div');"
+      "b.id = 'x';"
+      "b.className = 'item';"
+      "let ok1 = document.getElementById('x') === null;"
+      "document.body.appendChild(b);"
+      "document.body.insertBefore(a, b);"
+      "let ok2 = document.getElementById('x') === a;"
+      "document.body.removeChild(a);"
+      "let ok3 = document.getElementById('x') === b;"
+      "b.id = 'y';"
+      "let ok4 = document.getElementById('x') === null && document.getElementById('y') === b;"
+      "document.body.appendChild(a);"
+      "let ok5 = document.getElementsByClassName('item').length === 2 &&"
+      "  document.getElementsByClassName('item')[0] === b;"
+      "a.className = 'item';"
+      "let ok6 = document.getElementsByClassName('first').length === 0 &&"
+      "  document.getElementsByClassName('item first').length === 0;"
+      "let ok7 = document.getElementsByTagName('DIV').length === 2 &&"
+      "  document.getElementsByTagName('section').length === 0 &&"
+      "  document.getElementsByTagName('*')[0] === document.documentElement;"
+      "console.log(ok1 + ' ' + ok2 + ' ' + ok3 + ' ' + ok4 + ' ' + ok5 + ' ' + ok6 + ' ' + ok7);";
+
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  TEST_runLoop(context);
+
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+  EXPECT_STREQ(logMessage.c_str(), "true true true true true true true");
+}
+
 TEST(Document, appendParentWillFail) {
   bool static errorCalled = false;
   bool static logCalled = false;
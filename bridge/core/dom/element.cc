@@ -29,6 +29,7 @@
 #include "core/css/parser/css_parser.h"
 #include "core/css/parser/css_parser_context.h"
 #include "core/css/selector_checker.h"
+#include "core/css/selector_query.h"
 #include "core/css/parser/css_parser_context.h"
 #include "core/css/style_recalc_change.h"
 #include "core/css/style_recalc_context.h"
@@ -36,6 +37,7 @@
 #include "core/css/style_scope_data.h"
 #include "core/css/style_engine.h"
 #include "core/css/style_sheet_contents.h"
+#include "core/css/typed_style_value.h"
 #include "core/css/selector_checker.h"
 #include "core/css/white_space.h"
 #include "core/dom/document_fragment.h"
@@ -108,12 +110,12 @@ Element::Element(const AtomicString& namespace_uri,
       tag_name_(QualifiedName(prefix, local_name, namespace_uri)) {
   auto buffer = GetExecutingContext()->uiCommandBuffer();
   if (namespace_uri == element_namespace_uris::khtml) {
-    buffer->AddCommand(UICommand::kCreateElement, local_name.ToNativeString(), bindingObject(), nullptr);
+    buffer->AddCommand(UICommand::kCreateElement, local_name.ToCompactNativeString(), bindingObject(), nullptr);
   } else if (namespace_uri == element_namespace_uris::ksvg) {
-    buffer->AddCommand(UICommand::kCreateSVGElement, local_name.ToNativeString(), bindingObject(), nullptr);
+    buffer->AddCommand(UICommand::kCreateSVGElement, local_name.ToCompactNativeString(), bindingObject(), nullptr);
   } else {
-    buffer->AddCommand(UICommand::kCreateElementNS, local_name.ToNativeString(), bindingObject(),
-                       namespace_uri.ToNativeString().release());
+    buffer->AddCommand(UICommand::kCreateElementNS, local_name.ToCompactNativeString(), bindingObject(),
+                       namespace_uri.ToCompactNativeString().release());
   }
 }
 
@@ -143,43 +145,43 @@ bool IsPotentiallyDisableableFormControl(const Element& element) {
 }
 
 const AtomicString& InputTagName() {
-  static const AtomicString kInput = AtomicString::CreateFromUTF8("input");
+  static const AtomicString kInput = AtomicString::CreateStatic("input");
   return kInput;
 }
 const AtomicString& SelectTagName() {
-  static const AtomicString kSelect = AtomicString::CreateFromUTF8("select");
+  static const AtomicString kSelect = AtomicString::CreateStatic("select");
   return kSelect;
 }
 const AtomicString& TextareaTagName() {
-  static const AtomicString kTextarea = AtomicString::CreateFromUTF8("textarea");
+  static const AtomicString kTextarea = AtomicString::CreateStatic("textarea");
   return kTextarea;
 }
 const AtomicString& OptionTagName() {
-  static const AtomicString kOption = AtomicString::CreateFromUTF8("option");
+  static const AtomicString kOption = AtomicString::CreateStatic("option");
   return kOption;
 }
 const AtomicString& TypeAttrName() {
-  static const AtomicString kType = AtomicString::CreateFromUTF8("type");
+  static const AtomicString kType = AtomicString::CreateStatic("type");
   return kType;
 }
 const AtomicString& ValueAttrName() {
-  static const AtomicString kValue = AtomicString::CreateFromUTF8("value");
+  static const AtomicString kValue = AtomicString::CreateStatic("value");
   return kValue;
 }
 const AtomicString& RequiredAttrName() {
-  static const AtomicString kRequired = AtomicString::CreateFromUTF8("required");
+  static const AtomicString kRequired = AtomicString::CreateStatic("required");
   return kRequired;
 }
 const AtomicString& CheckedAttrName() {
-  static const AtomicString kChecked = AtomicString::CreateFromUTF8("checked");
+  static const AtomicString kChecked = AtomicString::CreateStatic("checked");
   return kChecked;
 }
 const AtomicString& SelectedAttrName() {
-  static const AtomicString kSelected = AtomicString::CreateFromUTF8("selected");
+  static const AtomicString kSelected = AtomicString::CreateStatic("selected");
   return kSelected;
 }
 const AtomicString& DisabledAttrName() {
-  static const AtomicString kDisabled = AtomicString::CreateFromUTF8("disabled");
+  static const AtomicString kDisabled = AtomicString::CreateStatic("disabled");
   return kDisabled;
 }
 
@@ -209,43 +211,6 @@ bool IsValidEmailAddress(const AtomicString& value) {
   return true;
 }
 
-std::shared_ptr<CSSSelectorList> ParseSelectorListOrThrow(const AtomicString& selectors,
-                                                          ExceptionState& exception_state,
-                                                          JSContext* ctx) {
-  auto parser_context = std::make_shared<CSSParserContext>(kHTMLStandardMode);
-  auto sheet = std::make_shared<StyleSheetContents>(parser_context);
-
-  std::vector<CSSSelector> arena;
-  tcb::span<CSSSelector> vector =
-      CSSParser::ParseSelector(parser_context, CSSNestingType::kNone, /*parent_rule_for_nesting=*/nullptr, sheet,
-                               selectors.GetString(), arena);
-
-  auto selector_list = CSSSelectorList::AdoptSelectorVector(vector);
-  if (!selector_list->IsValid()) {
-    exception_state.ThrowException(ctx, ErrorType::SyntaxError,
-                                   "'" + selectors.ToUTF8String() + "' is not a valid selector.");
-    return nullptr;
-  }
-  return selector_list;
-}
-
-bool MatchesAnySelectorInList(Element& element,
-                              const CSSSelectorList& selector_list,
-                              const ContainerNode* scope) {
-  SelectorChecker checker(SelectorChecker::kQueryingRules);
-  SelectorChecker::SelectorCheckingContext context(&element);
-  context.scope = scope;
-
-  for (const CSSSelector* selector = selector_list.First(); selector; selector = CSSSelectorList::Next(*selector)) {
-    context.selector = selector;
-    SelectorChecker::MatchResult result;
-    if (checker.Match(context, result)) {
-      return true;
-    }
-  }
-  return false;
-}
-
 }  // namespace
 
 AttributeCollection Element::Attributes() const {
@@ -421,6 +386,26 @@ void Element::removeAttribute(const AtomicString& name, ExceptionState& exceptio
   EnsureElementAttributes().removeAttribute(name, exception_state);
 }
 
+// The rect the last frame published for |element|, if JS hasn't changed layout since.
+static BoundingClientRect* BoundingClientRectFromSnapshot(ExecutingContext* context, const Element* element) {
+  if (context == nullptr) {
+    return nullptr;
+  }
+  const NativeLayoutGeometry* geometry = context->layoutGeometrySnapshot()->Find(element->bindingObject());
+  if (geometry == nullptr) {
+    return nullptr;
+  }
+  BoundingClientRectData data{geometry->x,
+                              geometry->y,
+                              geometry->width,
+                              geometry->height,
+                              geometry->y,
+                              geometry->x + geometry->width,
+                              geometry->y + geometry->height,
+                              geometry->x};
+  return BoundingClientRect::Create(context, data);
+}
+
 BoundingClientRect* Element::getBoundingClientRect(ExceptionState& exception_state) {
   ExecutingContext* context = GetExecutingContext();
   if (context && context->isBlinkEnabled()) {
@@ -431,6 +416,10 @@ BoundingClientRect* Element::getBoundingClientRect(ExceptionState& exception_sta
     }
   }
 
+  if (BoundingClientRect* rect = BoundingClientRectFromSnapshot(context, this)) {
+    return rect;
+  }
+
   NativeValue result = InvokeBindingMethod(
       binding_call_methods::kgetBoundingClientRect, 0, nullptr,
       FlushUICommandReason::kDependentsOnElement | FlushUICommandReason::kDependentsOnLayout, exception_state);
@@ -454,6 +443,11 @@ std::vector<BoundingClientRect*> Element::getClientRects(ExceptionState& excepti
     }
   }
 
+  // Elements have a single client rect on the Dart side.
+  if (BoundingClientRect* rect = BoundingClientRectFromSnapshot(context, this)) {
+    return {rect};
+  }
+
   NativeValue result = InvokeBindingMethod(
       binding_call_methods::kgetClientRects, 0, nullptr,
       FlushUICommandReason::kDependentsOnElement | FlushUICommandReason::kDependentsOnLayout, exception_state);
@@ -652,6 +646,47 @@ void Element::ChildrenChanged(const ChildrenChange& change) {
   }
 }
 
+Node::InsertionNotificationRequest Element::InsertedInto(ContainerNode& insertion_point) {
+  ContainerNode::InsertedInto(insertion_point);
+  if (!insertion_point.isConnected()) {
+    return kInsertionDone;
+  }
+
+  TreeScope& scope = GetTreeScope();
+  scope.AddElementByTagName(local_name_);
+  if (HasID()) {
+    UpdateIdIndex(AtomicString::Null(), IdForStyleResolution());
+  }
+  if (HasClass()) {
+    scope.AddElementClassNames(ClassNames());
+  }
+  return kInsertionDone;
+}
+
+void Element::RemovedFrom(ContainerNode& insertion_point) {
+  if (insertion_point.isConnected()) {
+    TreeScope& scope = GetTreeScope();
+    scope.RemoveElementByTagName(local_name_);
+    if (HasID()) {
+      UpdateIdIndex(IdForStyleResolution(), AtomicString::Null());
+    }
+    if (HasClass()) {
+      scope.RemoveElementClassNames(ClassNames());
+    }
+  }
+  ContainerNode::RemovedFrom(insertion_point);
+}
+
+void Element::UpdateIdIndex(const AtomicString& old_id, const AtomicString& new_id) {
+  TreeScope& scope = GetTreeScope();
+  if (!old_id.IsNull() && !old_id.empty()) {
+    scope.RemoveElementById(old_id, *this);
+  }
+  if (!new_id.IsNull() && !new_id.empty()) {
+    scope.AddElementById(new_id, *this);
+  }
+}
+
 String Element::nodeName() const {
   // For HTML elements in HTML namespace, return uppercased tagName
   // For all other elements (including those created with createElementNS), preserve original case
@@ -679,60 +714,11 @@ void Element::setId(const AtomicString& value, ExceptionState& exception_state)
 }
 
 std::vector<Element*> Element::getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state) {
-  if (GetExecutingContext() && GetExecutingContext()->isBlinkEnabled()) {
-    SpaceSplitString query(class_name);
-    if (query.size() == 0) {
-      return {};
-    }
-
-    std::vector<Element*> result;
-    for (Element& element : ElementTraversal::DescendantsOf(*this)) {
-      if (element.HasClass() && element.ClassNames().ContainsAll(query)) {
-        result.emplace_back(&element);
-      }
-    }
-    return result;
-  }
-
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), class_name)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetElementsByClassName, 1, arguments,
-                                           FlushUICommandReason::kDependentsAll, exception_state);
-  if (exception_state.HasException()) {
-    return {};
-  }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+  return GetElementsByClassName(class_name);
 }
 
 std::vector<Element*> Element::getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state) {
-  if (GetExecutingContext() && GetExecutingContext()->isBlinkEnabled()) {
-    if (tag_name.empty()) {
-      return {};
-    }
-
-    std::vector<Element*> result;
-    if (tag_name == g_star_atom) {
-      for (Element& element : ElementTraversal::DescendantsOf(*this)) {
-        result.emplace_back(&element);
-      }
-      return result;
-    }
-
-    StringView query(tag_name);
-    for (Element& element : ElementTraversal::DescendantsOf(*this)) {
-      if (EqualIgnoringASCIICase(StringView(element.localName()), query)) {
-        result.emplace_back(&element);
-      }
-    }
-    return result;
-  }
-
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), tag_name)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetElementsByTagName, 1, arguments,
-                                           FlushUICommandReason::kDependentsAll, exception_state);
-  if (exception_state.HasException()) {
-    return {};
-  }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+  return GetElementsByTagName(tag_name);
 }
 
 Element* Element::querySelector(const AtomicString& selectors, ExceptionState& exception_state) {
@@ -765,11 +751,11 @@ std::vector<Element*> Element::querySelectorAll(const AtomicString& selectors, E
 
 bool Element::matches(const AtomicString& selectors, ExceptionState& exception_state) {
   if (GetExecutingContext() && GetExecutingContext()->isBlinkEnabled()) {
-    auto selector_list = ParseSelectorListOrThrow(selectors, exception_state, ctx());
-    if (!selector_list) {
+    SelectorQuery* selector_query = GetDocument().GetSelectorQueryCache().Add(selectors, ctx(), exception_state);
+    if (!selector_query) {
       return false;
     }
-    return MatchesAnySelectorInList(*this, *selector_list, this);
+    return selector_query->Matches(*this);
   }
 
   NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), selectors)};
@@ -783,17 +769,11 @@ bool Element::matches(const AtomicString& selectors, ExceptionState& exception_s
 
 Element* Element::closest(const AtomicString& selectors, ExceptionState& exception_state) {
   if (GetExecutingContext() && GetExecutingContext()->isBlinkEnabled()) {
-    auto selector_list = ParseSelectorListOrThrow(selectors, exception_state, ctx());
-    if (!selector_list) {
+    SelectorQuery* selector_query = GetDocument().GetSelectorQueryCache().Add(selectors, ctx(), exception_state);
+    if (!selector_query) {
       return nullptr;
     }
-    ContainerNode* scope = this;
-    for (Element* current = this; current; current = current->parentElement()) {
-      if (MatchesAnySelectorInList(*current, *selector_list, scope)) {
-        return current;
-      }
-    }
-    return nullptr;
+    return selector_query->Closest(*this);
   }
 
   NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), selectors)};
@@ -1396,6 +1376,10 @@ void Element::InvalidateStyleAttribute(bool only_changed_independent_properties)
 void Element::AttributeChanged(const AttributeModificationParams& params) {
   if (GetExecutingContext()->isBlinkEnabled()) {
     ParseAttribute(params);
+  } else if (params.name == html_names::kIdAttr || params.name == html_names::kClassAttr) {
+    // The tree scope id/class indexes read the parsed tokens from ElementData,
+    // so keep them current even when Blink CSS is disabled.
+    Element::ParseAttribute(params);
   }
 
   const AtomicString& name = params.name;
@@ -1407,6 +1391,16 @@ void Element::AttributeChanged(const AttributeModificationParams& params) {
     return;
   }
 
+  if (isConnected()) {
+    if (name == html_names::kIdAttr) {
+      UpdateIdIndex(params.old_value, params.new_value);
+    } else if (name == html_names::kClassAttr) {
+      TreeScope& scope = GetTreeScope();
+      scope.RemoveElementClassNames(SpaceSplitString(params.old_value));
+      scope.AddElementClassNames(SpaceSplitString(params.new_value));
+    }
+  }
+
   if (name == CheckedAttrName()) {
     // HTML boolean attributes are true by presence, even when the value is empty.
     checked_state_ = !params.new_value.IsNull();
@@ -1483,6 +1477,7 @@ void Element::StyleAttributeChanged(const AtomicString& new_style_string,
       // Clear all inline styles on Dart side when style attribute is removed.
       if (InActiveDocument()) {
         GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kClearStyle, nullptr, bindingObject(), nullptr);
+        ClearExportedStyleSnapshot();
       }
     }
   } else {
@@ -1539,6 +1534,7 @@ void Element::SetInlineStyleFromString(const webf::AtomicString& new_style_strin
       unsigned count = inline_style->PropertyCount();
       // Always clear existing inline styles before applying new set to avoid stale properties.
       GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kClearStyle, nullptr, bindingObject(), nullptr);
+      ClearExportedStyleSnapshot();
       for (unsigned i = 0; i < count; ++i) {
         auto property = inline_style->PropertyAt(i);
         CSSPropertyID id = property.Id();
@@ -1573,6 +1569,15 @@ void Element::SetInlineStyleFromString(const webf::AtomicString& new_style_strin
           continue;
         }
 
+        if (TypedStyleValue typed = TypedStyleValue::FromCSSValue(*(*value_ptr)); !typed.IsEmpty()) {
+          int64_t value_bits = 0;
+          int64_t descriptor = 0;
+          typed.Encode(value_bits, descriptor);
+          GetExecutingContext()->uiCommandBuffer()->AddTypedStyleByIdCommand(bindingObject(), static_cast<int32_t>(id),
+                                                                             value_bits, descriptor);
+          continue;
+        }
+
         int64_t value_slot = 0;
         if ((*value_ptr)->IsIdentifierValue()) {
           const auto& ident = To<CSSIdentifierValue>(*(*value_ptr));
@@ -1582,10 +1587,7 @@ void Element::SetInlineStyleFromString(const webf::AtomicString& new_style_strin
           if (value_string.IsNull()) {
             value_string = (*value_ptr)->CssTextForSerialization();
           }
-          if (!value_string.IsEmpty()) {
-            auto* value_ns = stringToNativeString(value_string).release();
-            value_slot = static_cast<int64_t>(reinterpret_cast<intptr_t>(value_ns));
-          }
+          value_slot = GetExecutingContext()->uiCommandBuffer()->StyleValueSlot(value_string);
         }
 
         GetExecutingContext()->uiCommandBuffer()->AddStyleByIdCommand(bindingObject(), static_cast<int32_t>(id),
@@ -29,6 +29,7 @@ namespace webf {
 
 class ShadowRoot;
 class StyleScopeData;
+class ExportedStyleSnapshot;
 class StyleRecalcChange;
 class StyleRecalcContext;
 
@@ -176,6 +177,8 @@ class Element : public ContainerNode {
   bool HasTagName(const AtomicString&) const;
   AtomicString nodeValue() const override;
   void ChildrenChanged(const ChildrenChange& change) override;
+  InsertionNotificationRequest InsertedInto(ContainerNode& insertion_point) override;
+  void RemovedFrom(ContainerNode& insertion_point) override;
   const QualifiedName& TagQName() const { return tag_name_; }
   AtomicString tagName() const { return getUppercasedQualifiedName(); }
   AtomicString prefix() const { return prefix_; }
@@ -257,6 +260,16 @@ class Element : public ContainerNode {
   bool HasEmittedStyle() const { return has_emitted_style_; }
   void SetHasEmittedStyle(bool value) { has_emitted_style_ = value; }
 
+  // The declared-value style most recently exported to the Dart layer, used by
+  // the native style engine to send only property changes on recalc. Cleared
+  // whenever the Dart-side inline style is rewritten through another path, so
+  // the next export falls back to kClearStyle plus the full property set.
+  const std::shared_ptr<ExportedStyleSnapshot>& GetExportedStyleSnapshot() const { return exported_style_snapshot_; }
+  void SetExportedStyleSnapshot(std::shared_ptr<ExportedStyleSnapshot> snapshot) {
+    exported_style_snapshot_ = std::move(snapshot);
+  }
+  void ClearExportedStyleSnapshot() { exported_style_snapshot_ = nullptr; }
+
   // NOTE: This shadows Node::GetComputedStyle().
   const ComputedStyle* GetComputedStyle() const {
     // return computed_style_.Get();
@@ -407,12 +420,14 @@ class Element : public ContainerNode {
   void _notifyNodeInsert(Node* insertNode);
   void _notifyChildInsert();
   void _beforeUpdateId(JSValue oldIdValue, JSValue newIdValue);
+  void UpdateIdIndex(const AtomicString& old_id, const AtomicString& new_id);
 
   mutable std::shared_ptr<ElementData> element_data_;
   mutable Member<ElementAttributes> attributes_;
   bool is_display_none_for_style_invalidation_ = false;
   uint32_t sent_pseudo_style_mask_ = 0;
   bool has_emitted_style_ = false;
+  std::shared_ptr<ExportedStyleSnapshot> exported_style_snapshot_;
   bool checked_state_ = false;
   bool disabled_state_ = false;
 
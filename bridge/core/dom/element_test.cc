@@ -3,7 +3,10 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 
+#include "core/dom/document.h"
+#include "core/dom/layout_geometry_snapshot.h"
 #include "core/dom/legacy/bounding_client_rect.h"
+#include "core/html/html_body_element.h"
 #include "gtest/gtest.h"
 #include "webf_test_env.h"
 using namespace webf;
@@ -202,3 +205,87 @@ TEST(Element, instanceofEventTarget) {
   EXPECT_EQ(errorCalled, false);
   EXPECT_EQ(logCalled, true);
 }
+
+TEST(Element, geometryReadsServedFromLayoutGeometrySnapshot) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "10,20,40,60,5");
+  };
+  auto env = TEST_init([](double contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->executingContext();
+  const char* setup =
+      "globalThis.div = document.createElement('div');"
+      "document.body.appendChild(div);";
+  env->page()->evaluateScript(setup, strlen(setup), "vm://", 0);
+
+  auto* div = To<Element>(context->document()->body()->lastChild());
+  NativeLayoutGeometry geometry;
+  geometry.target = div->bindingObject();
+  geometry.x = 10;
+  geometry.y = 20;
+  geometry.width = 30;
+  geometry.height = 40;
+  geometry.offset_top = 5;
+
+  LayoutGeometrySnapshot* snapshot = context->layoutGeometrySnapshot();
+  EXPECT_FALSE(snapshot->Publish(snapshot->generation() - 1, &geometry, 1));
+  EXPECT_TRUE(snapshot->Publish(snapshot->generation(), &geometry, 1));
+
+  const char* read =
+      "let rect = div.getBoundingClientRect();"
+      "console.log([rect.left, rect.top, rect.right, rect.bottom, div.offsetTop].join(','));";
+  env->page()->evaluateScript(read, strlen(read), "vm://", 0);
+  EXPECT_EQ(snapshot->size(), 1u);
+
+  const char* mutate = "div.appendChild(document.createElement('span'));";
+  env->page()->evaluateScript(mutate, strlen(mutate), "vm://", 0);
+  EXPECT_EQ(snapshot->size(), 0u);
+
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(Element, boxMetricsReadsServedUntilLayoutChanges) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "1,2,3,4,5,6,7,8");
+  };
+  auto env = TEST_init([](double contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->executingContext();
+  const char* setup =
+      "globalThis.div = document.createElement('div');"
+      "document.body.appendChild(div);";
+  env->page()->evaluateScript(setup, strlen(setup), "vm://", 0);
+
+  auto* div = To<Element>(context->document()->body()->lastChild());
+  LayoutGeometrySnapshot* snapshot = context->layoutGeometrySnapshot();
+  snapshot->RememberBoxMetrics(div->bindingObject(), BoxMetrics{1, 2, 3, 4, 5, 6, 7, 8});
+
+  const char* read =
+      "console.log([div.offsetLeft, div.offsetTop, div.offsetWidth, div.offsetHeight,"
+      " div.clientLeft, div.clientTop, div.clientWidth, div.clientHeight].join(','));";
+  env->page()->evaluateScript(read, strlen(read), "vm://", 0);
+  EXPECT_EQ(snapshot->box_metrics_size(), 1u);
+
+  const char* mutate = "div.style.width = '100px';";
+  env->page()->evaluateScript(mutate, strlen(mutate), "vm://", 0);
+  EXPECT_EQ(snapshot->box_metrics_size(), 0u);
+
+  // A published frame supersedes metrics read before it.
+  snapshot->RememberBoxMetrics(div->bindingObject(), BoxMetrics{1, 2, 3, 4, 5, 6, 7, 8});
+  EXPECT_TRUE(snapshot->Publish(snapshot->generation(), nullptr, 0));
+  EXPECT_EQ(snapshot->box_metrics_size(), 0u);
+
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
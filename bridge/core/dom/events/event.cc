@@ -117,7 +117,7 @@ void Event::NamedPropertyEnumerator(std::vector<AtomicString>& names, webf::Exce
   auto* raw_event_props = raw_event_->props;
 #endif
   for (int i = 0; i < raw_event_->props_len; i++) {
-    std::shared_ptr<StringImpl> string =
+    scoped_refptr<StringImpl> string =
         GetExecutingContext()->dartIsolateContext()->ensureStringCache(ctx())->GetStringFromJSAtom(ctx(),
                                                                                         raw_event_props[i].key_atom);
     AtomicString key = AtomicString(string);
@@ -153,6 +153,9 @@ class Event : public ScriptWrappable {
   ScriptValue item(const AtomicString& key, ExceptionState& exception_state);
   bool SetItem(const AtomicString& key, const ScriptValue& value, ExceptionState& exception_state);
   bool DeleteItem(const AtomicString& key, ExceptionState& exception_state);
+  // Whether JS stored expando properties in the raw event that Dart reads
+  // back; their values stay alive only as long as this event does.
+  bool HasSharedPropsForDart() const { return raw_event_ != nullptr && raw_event_->props_len > 0; }
 
   // These events are general classes of events.
   virtual bool IsUiEvent() const;
@@ -3,6 +3,7 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 #include "plugin_api/event_target.h"
+#include <algorithm>
 #include <cstdint>
 #include "binding_call_methods.h"
 #include "bindings/qjs/converter_impl.h"
@@ -313,7 +314,7 @@ bool EventTarget::AddEventListenerInternal(const AtomicString& event_type,
     //                          ASSERT_NO_EXCEPTION());
     //    } else {
     GetExecutingContext()->uiCommandBuffer()->AddCommand(
-        UICommand::kAddEvent, event_type.ToNativeString(), bindingObject(), listener_options);
+        UICommand::kAddEvent, event_type.ToCompactNativeString(), bindingObject(), listener_options);
     //    }
   }
 
@@ -362,7 +363,7 @@ bool EventTarget::RemoveEventListenerInternal(const AtomicString& event_type,
     bool has_capture = options->hasCapture() && options->capture();
 
     GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kRemoveEvent,
-                                                         event_type.ToNativeString(), bindingObject(),
+                                                         event_type.ToCompactNativeString(), bindingObject(),
                                                          has_capture ? (void*)0x01 : nullptr);
   }
 
@@ -401,6 +402,20 @@ NativeValue EventTarget::HandleDispatchEventFromDart(int32_t argc, const NativeV
   AtomicString event_type = NativeValueConverter<NativeTypeString>::FromNativeValue(std::move(native_event_type));
   RawEvent* raw_event = NativeValueConverter<NativeTypePointer<RawEvent>>::FromNativeValue(argv[1]);
 
+  DispatchEventResult dispatch_result;
+  Event* event = DispatchEventFromDart(event_type, raw_event, isCapture, dart_object, dispatch_result);
+
+  auto* result = new EventDispatchResult{.canceled = dispatch_result == DispatchEventResult::kCanceledByEventHandler,
+                                         .propagationStopped = event->propagationStopped(),
+                                         .preventDefaulted = event->defaultPrevented()};
+  return NativeValueConverter<NativeTypePointer<EventDispatchResult>>::ToNativeValue(result);
+}
+
+Event* EventTarget::DispatchEventFromDart(const AtomicString& event_type,
+                                          RawEvent* raw_event,
+                                          bool is_capture,
+                                          Dart_Handle dart_object,
+                                          DispatchEventResult& dispatch_result) {
   Event* event = EventFactory::Create(GetExecutingContext(), event_type, raw_event);
   assert(event->target() != nullptr);
   assert(event->currentTarget() != nullptr);
@@ -415,40 +430,45 @@ NativeValue EventTarget::HandleDispatchEventFromDart(int32_t argc, const NativeV
   ExceptionState exception_state;
   event->SetTrusted(false);
   event->SetEventPhase(Event::kAtTarget);
-  DispatchEventResult dispatch_result = FireEventListeners(*event, isCapture, exception_state);
+  dispatch_result = FireEventListeners(*event, is_capture, exception_state);
   event->SetEventPhase(0);
 
-  auto* wire = new DartWireContext();
-  wire->jsObject = event->ToValue();
-  wire->is_dedicated = GetExecutingContext()->isDedicated();
-  wire->context_id = GetExecutingContext()->contextId();
-  wire->dispatcher = GetDispatcher();
-  wire->disposed = false;
-
-  auto dart_object_finalize_callback = [](void* isolate_callback_data, void* peer) {
-    auto* wire = (DartWireContext*)(peer);
-
-    if (wire->disposed)
-      return;
-
-    wire->dispatcher->PostToJs(
-        wire->is_dedicated, wire->context_id,
-        [](DartWireContext* wire) -> void {
-          if (IsDartWireAlive(wire)) {
-            DeleteDartWire(wire);
-          }
+  // Dart reads the props JS stored on the event from the raw event it owns, so
+  // the JS values have to outlive the Dart side's use of it. Events without
+  // such props need nothing from the JS object once dispatched.
+  if (event->HasSharedPropsForDart() && dart_object != nullptr) {
+    auto* wire = new DartWireContext();
+    wire->jsObject = event->ToValue();
+    wire->is_dedicated = GetExecutingContext()->isDedicated();
+    wire->context_id = GetExecutingContext()->contextId();
+    wire->dispatcher = GetDispatcher();
+    wire->disposed = false;
+
+    auto dart_object_finalize_callback = [](void* isolate_callback_data, void* peer) {
+      auto* wire = (DartWireContext*)(peer);
+
+      if (wire->disposed)
+        return;
+
+      wire->dispatcher->PostToJs(
+          wire->is_dedicated, wire->context_id,
+          [](DartWireContext* wire) -> void {
+            if (IsDartWireAlive(wire)) {
+              DeleteDartWire(wire);
+            }
+          },
+          wire);
+    };
+
+    WatchDartWire(wire);
+
+    GetDispatcher()->PostToDart(
+        GetExecutingContext()->isDedicated(),
+        [](Dart_Handle object, void* peer, intptr_t external_allocation_size, Dart_HandleFinalizer callback) {
+          Dart_NewFinalizableHandle_DL(object, peer, external_allocation_size, callback);
         },
-        wire);
-  };
-
-  WatchDartWire(wire);
-
-  GetDispatcher()->PostToDart(
-      GetExecutingContext()->isDedicated(),
-      [](Dart_Handle object, void* peer, intptr_t external_allocation_size, Dart_HandleFinalizer callback) {
-        Dart_NewFinalizableHandle_DL(object, peer, external_allocation_size, callback);
-      },
-      dart_object, reinterpret_cast<void*>(wire), sizeof(DartWireContext), dart_object_finalize_callback);
+        dart_object, reinterpret_cast<void*>(wire), sizeof(DartWireContext), dart_object_finalize_callback);
+  }
 
   if (exception_state.HasException()) {
     JSValue error = JS_GetException(ctx());
@@ -456,10 +476,106 @@ NativeValue EventTarget::HandleDispatchEventFromDart(int32_t argc, const NativeV
     JS_FreeValue(ctx(), error);
   }
 
-  auto* result = new EventDispatchResult{.canceled = dispatch_result == DispatchEventResult::kCanceledByEventHandler,
-                                         .propagationStopped = event->propagationStopped(),
-                                         .preventDefaulted = event->defaultPrevented()};
-  return NativeValueConverter<NativeTypePointer<EventDispatchResult>>::ToNativeValue(result);
+  return event;
+}
+
+static bool IsContinuousEventType(const AtomicString& type) {
+  return type == event_type_names::kpointermove || type == event_type_names::kmousemove ||
+         type == event_type_names::ktouchmove || type == event_type_names::kscroll ||
+         type == event_type_names::kwheel || type == event_type_names::kresize;
+}
+
+void EventTarget::CoalesceContinuousEvents(const std::vector<AtomicString>& types,
+                                           NativeDispatchEventItem* items,
+                                           int32_t count) {
+  for (int32_t i = 0; i < count; i++) {
+    items[i].dispatched_index = i;
+  }
+
+  // Walk backwards, remembering the latest continuous event per target, type
+  // and phase. Any other event for a target is a barrier: moves before a
+  // pointerdown must not be folded into moves after it.
+  struct Latest {
+    NativeBindingObject* current_target;
+    const AtomicString* type;
+    int32_t is_capture;
+    int32_t index;
+  };
+  std::vector<Latest> latest;
+  for (int32_t i = count - 1; i >= 0; i--) {
+    NativeDispatchEventItem& item = items[i];
+    if (!IsContinuousEventType(types[i])) {
+      latest.erase(std::remove_if(latest.begin(), latest.end(),
+                                  [&item](const Latest& entry) { return entry.current_target == item.current_target; }),
+                   latest.end());
+      continue;
+    }
+
+    auto it = std::find_if(latest.begin(), latest.end(), [&](const Latest& entry) {
+      return entry.current_target == item.current_target && entry.is_capture == item.is_capture &&
+             *entry.type == types[i];
+    });
+    if (it != latest.end()) {
+      item.dispatched_index = it->index;
+    } else {
+      latest.push_back(Latest{item.current_target, &types[i], item.is_capture, i});
+    }
+  }
+}
+
+void EventTarget::DispatchEventBatchFromDart(ExecutingContext* context,
+                                             NativeDispatchEventItem* items,
+                                             int32_t count,
+                                             Dart_Handle dart_object) {
+  MemberMutationScope mutation_scope{context};
+
+  std::vector<AtomicString> types;
+  types.reserve(count);
+  for (int32_t i = 0; i < count; i++) {
+    types.emplace_back(std::unique_ptr<AutoFreeNativeString>(static_cast<AutoFreeNativeString*>(items[i].type)));
+    items[i].type = nullptr;
+  }
+
+  CoalesceContinuousEvents(types, items, count);
+
+  for (int32_t i = 0; i < count; i++) {
+    NativeDispatchEventItem& item = items[i];
+    if (item.dispatched_index != i) {
+      continue;
+    }
+    // A listener earlier in the batch may have torn the page or the target down.
+    if (!context->IsContextValid() || item.current_target == nullptr ||
+        NativeBindingObject::IsDisposed(item.current_target)) {
+      item.dispatched_index = -1;
+      continue;
+    }
+    auto* target = DynamicTo<EventTarget>(BindingObject::From(item.current_target));
+    if (target == nullptr) {
+      item.dispatched_index = -1;
+      continue;
+    }
+
+    DispatchEventResult dispatch_result;
+    Event* event = target->DispatchEventFromDart(types[i], item.raw_event, item.is_capture != 0, dart_object,
+                                                 dispatch_result);
+    item.canceled = dispatch_result == DispatchEventResult::kCanceledByEventHandler;
+    item.propagation_stopped = event->propagationStopped();
+    item.prevent_defaulted = event->defaultPrevented();
+  }
+
+  for (int32_t i = 0; i < count; i++) {
+    NativeDispatchEventItem& item = items[i];
+    if (item.dispatched_index < 0 || item.dispatched_index == i) {
+      continue;
+    }
+    const NativeDispatchEventItem& dispatched = items[item.dispatched_index];
+    item.canceled = dispatched.canceled;
+    item.propagation_stopped = dispatched.propagation_stopped;
+    item.prevent_defaulted = dispatched.prevent_defaulted;
+    if (dispatched.dispatched_index < 0) {
+      item.dispatched_index = -1;
+    }
+  }
 }
 
 RegisteredEventListener* EventTarget::GetAttributeRegisteredEventListener(const AtomicString& event_type) {
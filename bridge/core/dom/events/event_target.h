@@ -46,6 +46,24 @@ enum class DispatchEventResult {
   kCanceledBeforeDispatch,
 };
 
+struct RawEvent;
+
+// One event of a batch Dart delivers with dispatchEventBatch(), in dispatch
+// order. The JS thread takes ownership of |type| and writes the result fields.
+// Keep layout in sync with NativeDispatchEventItem in ../webf/lib/src/bridge/native_types.dart
+struct NativeDispatchEventItem : public DartReadable {
+  NativeBindingObject* current_target{nullptr};
+  SharedNativeString* type{nullptr};
+  RawEvent* raw_event{nullptr};
+  int32_t is_capture{0};
+  // The item whose dispatch answered this one: its own index, or the index of
+  // the later event it was coalesced into. -1 if it was not dispatched.
+  int32_t dispatched_index{-1};
+  int8_t canceled{0};
+  int8_t propagation_stopped{0};
+  int8_t prevent_defaulted{0};
+};
+
 struct FiringEventIterator {
   WEBF_DISALLOW_NEW();
 
@@ -128,6 +146,21 @@ class EventTarget : public BindingObject {
 
   static DispatchEventResult GetDispatchEventResult(const Event&);
 
+  // Dispatches a batch of events Dart delivered in one hop. Continuous events
+  // (moves, scroll, wheel, resize) that a later event of the same type
+  // supersedes at the same target, with no other event for that target in
+  // between, are skipped and report the later event's result, the way
+  // browsers coalesce them per frame.
+  static void DispatchEventBatchFromDart(ExecutingContext* context,
+                                         NativeDispatchEventItem* items,
+                                         int32_t count,
+                                         Dart_Handle dart_object);
+  // Marks coalesced items by pointing their dispatched_index at the item that
+  // supersedes them. |types| holds the event type of each item.
+  static void CoalesceContinuousEvents(const std::vector<AtomicString>& types,
+                                       NativeDispatchEventItem* items,
+                                       int32_t count);
+
   // Used for legacy "onEvent" attribute APIs.
   bool SetAttributeEventListener(const AtomicString& event_type,
                                  const std::shared_ptr<EventListener>& listener,
@@ -161,6 +194,14 @@ class EventTarget : public BindingObject {
   DispatchEventResult DispatchEventInternal(Event& event, ExceptionState& exception_state);
 
   NativeValue HandleDispatchEventFromDart(int32_t argc, const NativeValue* argv, Dart_Handle dart_object);
+  // Creates and fires an event Dart dispatched at this target. Events that
+  // carry JS props Dart reads back are kept alive until |dart_object| is
+  // finalized.
+  Event* DispatchEventFromDart(const AtomicString& event_type,
+                               RawEvent* raw_event,
+                               bool is_capture,
+                               Dart_Handle dart_object,
+                               DispatchEventResult& dispatch_result);
 
   // Subclasses should likely not override these themselves; instead, they
   // should subclass EventTargetWithInlineData.
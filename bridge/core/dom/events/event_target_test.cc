@@ -4,7 +4,9 @@
  */
 #include "event_target.h"
 #include "core/dom/container_node.h"
+#include "core/dom/document.h"
 #include "core/dom/events/event.h"
+#include "core/html/html_body_element.h"
 #include "event_type_names.h"
 #include "gtest/gtest.h"
 #include "webf_test_env.h"
@@ -276,4 +278,50 @@ proxy.dispatchEvent(new Event('click'));
 
   JS_RunGC(JS_GetRuntime(env->page()->executingContext()->ctx()));
   EXPECT_EQ(logCalled, true);
-}
\ No newline at end of file
+}
+
+TEST(EventTarget, dispatchEventBatchCoalescesContinuousEvents) {
+  auto env = TEST_init();
+  static std::string log;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) { log = message; };
+  auto context = env->page()->executingContext();
+  std::string code = R"(
+let moves = 0;
+document.body.addEventListener('pointermove', () => moves++);
+document.body.addEventListener('pointerdown', (e) => e.preventDefault());
+)";
+  env->page()->evaluateScript(code.c_str(), code.size(), "internal://", 0);
+
+  NativeBindingObject* body = context->document()->body()->bindingObject();
+  const char* types[] = {"pointermove", "pointermove", "pointerdown", "pointermove", "pointermove"};
+  constexpr int32_t kCount = 5;
+  NativeEvent native_events[kCount];
+  RawEvent raw_events[kCount];
+  NativeDispatchEventItem items[kCount];
+  for (int32_t i = 0; i < kCount; i++) {
+    native_events[i].cancelable = 1;
+    native_events[i].target = body;
+    native_events[i].currentTarget = body;
+    raw_events[i].bytes = reinterpret_cast<uint64_t*>(&native_events[i]);
+    raw_events[i].length = sizeof(NativeEvent) / sizeof(int64_t);
+    raw_events[i].is_custom_event = 0;
+    items[i].current_target = body;
+    items[i].type = stringToNativeString(types[i]).release();
+    items[i].raw_event = &raw_events[i];
+  }
+
+  EventTarget::DispatchEventBatchFromDart(context, items, kCount, nullptr);
+
+  // Moves on either side of the pointerdown are folded into the last one.
+  EXPECT_EQ(items[0].dispatched_index, 1);
+  EXPECT_EQ(items[1].dispatched_index, 1);
+  EXPECT_EQ(items[2].dispatched_index, 2);
+  EXPECT_EQ(items[3].dispatched_index, 4);
+  EXPECT_EQ(items[4].dispatched_index, 4);
+  EXPECT_TRUE(items[2].prevent_defaulted);
+  EXPECT_FALSE(items[3].prevent_defaulted);
+
+  std::string check = "console.log(moves);";
+  env->page()->evaluateScript(check.c_str(), check.size(), "internal://", 0);
+  EXPECT_EQ(log, "2");
+}
@@ -156,7 +156,7 @@ void IntersectionObserver::disconnect(ExceptionState& exception_state) {
 }
 
 std::vector<IntersectionObserverEntry*> IntersectionObserver::takeRecords(ExceptionState& exception_state) {
-  static const AtomicString kTakeRecords = AtomicString::CreateFromUTF8("takeRecords");
+  static const AtomicString kTakeRecords = AtomicString::CreateStatic("takeRecords");
 
   NativeValue result = InvokeBindingMethod(kTakeRecords, 0, nullptr, FlushUICommandReason::kStandard, exception_state);
   if (exception_state.HasException()) {
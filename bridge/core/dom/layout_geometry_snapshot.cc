@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "layout_geometry_snapshot.h"
+
+#include <algorithm>
+
+namespace webf {
+
+void LayoutGeometrySnapshot::Invalidate() {
+  generation_++;
+  Clear();
+}
+
+void LayoutGeometrySnapshot::Clear() {
+  if (!entries_.empty()) {
+    entries_.clear();
+  }
+  if (!box_metrics_.empty()) {
+    box_metrics_.clear();
+  }
+}
+
+bool LayoutGeometrySnapshot::Publish(uint64_t generation, const NativeLayoutGeometry* entries, int32_t length) {
+  if (generation != generation_) {
+    return false;
+  }
+
+  entries_.clear();
+  // Metrics read before this frame may describe boxes it has moved.
+  box_metrics_.clear();
+  length = std::min(length, kMaxEntries);
+  for (int32_t i = 0; i < length; i++) {
+    if (entries[i].target != nullptr) {
+      entries_[entries[i].target] = entries[i];
+    }
+  }
+  return true;
+}
+
+const NativeLayoutGeometry* LayoutGeometrySnapshot::Find(const NativeBindingObject* target) const {
+  auto it = entries_.find(target);
+  return it != entries_.end() ? &it->second : nullptr;
+}
+
+void LayoutGeometrySnapshot::RememberBoxMetrics(const NativeBindingObject* target, const BoxMetrics& metrics) {
+  if (box_metrics_.size() >= kMaxEntries && box_metrics_.find(target) == box_metrics_.end()) {
+    return;
+  }
+  box_metrics_[target] = metrics;
+}
+
+const BoxMetrics* LayoutGeometrySnapshot::FindBoxMetrics(const NativeBindingObject* target) const {
+  auto it = box_metrics_.find(target);
+  return it != box_metrics_.end() ? &it->second : nullptr;
+}
+
+}  // namespace webf
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_DOM_LAYOUT_GEOMETRY_SNAPSHOT_H_
+#define WEBF_CORE_DOM_LAYOUT_GEOMETRY_SNAPSHOT_H_
+
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include "foundation/dart_readable.h"
+
+namespace webf {
+
+struct NativeBindingObject;
+
+// Geometry of one element after a Flutter frame, written by the Dart side.
+// Keep layout in sync with NativeLayoutGeometry in ../webf/lib/src/bridge/native_types.dart
+struct NativeLayoutGeometry : public DartReadable {
+  NativeBindingObject* target{nullptr};
+  // getBoundingClientRect(), relative to the viewport.
+  double x{0};
+  double y{0};
+  double width{0};
+  double height{0};
+  double offset_left{0};
+  double offset_top{0};
+  double offset_width{0};
+  double offset_height{0};
+};
+
+// offset* and client* of one element, fetched from Dart in a single hop the
+// first time JS reads any of them. Lives as long as the snapshot table.
+struct BoxMetrics {
+  double offset_left{0};
+  double offset_top{0};
+  double offset_width{0};
+  double offset_height{0};
+  double client_left{0};
+  double client_top{0};
+  double client_width{0};
+  double client_height{0};
+};
+
+// Layout geometry of the elements JS has measured, as laid out by the last
+// Flutter frame. getBoundingClientRect(), getClientRects() and offset* are
+// answered from here without a synchronous call into Dart.
+//
+// Every UICommand or binding call that may change layout bumps the generation
+// and drops the table. Dart tags a table with VisibleGeneration() read before
+// it flushed the commands its layout reflects, and Publish() ignores tables
+// whose generation has moved on since. A mutation can move boxes anywhere in
+// the document, so the whole table is invalidated rather than a subtree.
+//
+// Dart-side layout changes that JS does not cause, such as scrolling, a
+// resized viewport or a frame that relaid out boxes but could not publish,
+// Clear() the table until the next frame publishes one.
+// Everything but VisibleGeneration() runs on the JS thread.
+class LayoutGeometrySnapshot {
+ public:
+  // An element that is measured once keeps being published, so the table is
+  // capped for pages that measure everything.
+  static constexpr int32_t kMaxEntries = 1024;
+
+  void Invalidate();
+  void Clear();
+
+  // Called once every command added so far can be read by Dart.
+  void MarkCommandsVisibleToDart() { visible_generation_.store(generation_, std::memory_order_release); }
+  // The tag for a table laid out from the commands Dart reads next. Any thread.
+  uint64_t VisibleGeneration() const { return visible_generation_.load(std::memory_order_acquire); }
+
+  // Replaces the table with |entries| if no layout-affecting change happened
+  // since |generation| was read. Returns whether the table was taken.
+  bool Publish(uint64_t generation, const NativeLayoutGeometry* entries, int32_t length);
+
+  const NativeLayoutGeometry* Find(const NativeBindingObject* target) const;
+
+  // Box metrics read synchronously from Dart since the last invalidation, for
+  // elements the last frame did not publish. Dropped together with the table
+  // and whenever a frame publishes a new one.
+  void RememberBoxMetrics(const NativeBindingObject* target, const BoxMetrics& metrics);
+  const BoxMetrics* FindBoxMetrics(const NativeBindingObject* target) const;
+
+  uint64_t generation() const { return generation_; }
+  size_t size() const { return entries_.size(); }
+  size_t box_metrics_size() const { return box_metrics_.size(); }
+
+ private:
+  uint64_t generation_{0};
+  std::atomic<uint64_t> visible_generation_{0};
+  std::unordered_map<const NativeBindingObject*, NativeLayoutGeometry> entries_;
+  std::unordered_map<const NativeBindingObject*, BoxMetrics> box_metrics_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_DOM_LAYOUT_GEOMETRY_SNAPSHOT_H_
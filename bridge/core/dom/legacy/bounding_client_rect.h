@@ -33,7 +33,10 @@ class BoundingClientRect : public BindingObject {
   using ImplType = BoundingClientRect*;
   BoundingClientRect() = delete;
   static BoundingClientRect* Create(ExecutingContext* context, NativeBindingObject* native_binding_object);
+  // A rect served from the LayoutGeometrySnapshot, which has no Dart counterpart.
+  static BoundingClientRect* Create(ExecutingContext* context, const BoundingClientRectData& data);
   explicit BoundingClientRect(ExecutingContext* context, NativeBindingObject* native_binding_object);
+  explicit BoundingClientRect(ExecutingContext* context, const BoundingClientRectData& data);
 
   NativeValue HandleCallFromDartSide(const AtomicString& method,
                                      int32_t argc,
@@ -52,6 +55,7 @@ class BoundingClientRect : public BindingObject {
 
  private:
   BoundingClientRectData* extra_ = nullptr;
+  BoundingClientRectData data_{};
 };
 
 }  // namespace webf
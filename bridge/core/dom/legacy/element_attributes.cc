@@ -85,8 +85,8 @@ bool ElementAttributes::setAttribute(const AtomicString& name,
   if (ignore_ui_command)
     return true;
 
-  std::unique_ptr<SharedNativeString> args_01 = value.ToNativeString();
-  std::unique_ptr<SharedNativeString> args_02 = name.ToNativeString();
+  std::unique_ptr<SharedNativeString> args_01 = value.ToCompactNativeString();
+  std::unique_ptr<SharedNativeString> args_02 = name.ToCompactNativeString();
 
   GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kSetAttribute, std::move(args_01),
                                                        element_->bindingObject(), args_02.release());
@@ -131,7 +131,7 @@ void ElementAttributes::removeAttribute(const AtomicString& name, ExceptionState
   attributes_.erase(name);
 
   if (!ignore_ui_command) {
-    std::unique_ptr<SharedNativeString> args_01 = name.ToNativeString();
+    std::unique_ptr<SharedNativeString> args_01 = name.ToCompactNativeString();
     GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kRemoveAttribute, std::move(args_01),
                                                          element_->bindingObject(), nullptr);
     element_->DidModifyAttribute(name, old_value, AtomicString::Null(),
@@ -33,9 +33,9 @@ namespace webf {
 
 struct QualifiedNameComponents {
   WEBF_DISALLOW_NEW();
-  std::shared_ptr<StringImpl> prefix_;
-  std::shared_ptr<StringImpl> local_name_;
-  std::shared_ptr<StringImpl> namespace_;
+  scoped_refptr<StringImpl> prefix_;
+  scoped_refptr<StringImpl> local_name_;
+  scoped_refptr<StringImpl> namespace_;
 };
 
 // This struct is used to pass data between QualifiedName and the
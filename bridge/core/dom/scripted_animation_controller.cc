@@ -72,7 +72,7 @@ uint32_t ScriptAnimationController::RegisterFrameCallback(const std::shared_ptr<
   // nativePtr: callback context (FrameCallback*)
   // nativePtr2: function pointer to invoke when frame fires (AsyncRAFCallback)
   context->uiCommandBuffer()->AddCommand(UICommand::kRequestAnimationFrame,
-                                         AtomicString::CreateFromUTF8(id_str).ToNativeString(), frame_callback.get(),
+                                         AtomicString::CreateFromUTF8(id_str).ToCompactNativeString(), frame_callback.get(),
                                          reinterpret_cast<void*>(handleRAFTransientCallbackWrapper));
 
   return requestId;
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "tree_ordered_map.h"
+#include "core/dom/container_node.h"
+#include "core/dom/element.h"
+#include "core/dom/element_traversal.h"
+#include "core/dom/tree_scope.h"
+
+namespace webf {
+
+void TreeOrderedMap::Add(const AtomicString& key, Element& element) {
+  assert(!key.IsNull() && !key.empty());
+  auto it = map_.find(key);
+  if (it == map_.end()) {
+    map_.emplace(key, MapEntry{&element, 1});
+    return;
+  }
+
+  MapEntry& entry = it->second;
+  assert(entry.count > 0);
+  entry.element = nullptr;
+  entry.count++;
+}
+
+void TreeOrderedMap::Remove(const AtomicString& key, Element& element) {
+  auto it = map_.find(key);
+  if (it == map_.end()) {
+    return;
+  }
+
+  MapEntry& entry = it->second;
+  assert(entry.count > 0);
+  if (entry.count == 1) {
+    assert(!entry.element || entry.element == &element);
+    map_.erase(it);
+    return;
+  }
+
+  if (entry.element == &element) {
+    entry.element = nullptr;
+  }
+  entry.count--;
+}
+
+bool TreeOrderedMap::ContainsMultiple(const AtomicString& key) const {
+  auto it = map_.find(key);
+  return it != map_.end() && it->second.count > 1;
+}
+
+Element* TreeOrderedMap::GetElementById(const AtomicString& key, const TreeScope& scope) const {
+  auto it = map_.find(key);
+  if (it == map_.end()) {
+    return nullptr;
+  }
+
+  MapEntry& entry = it->second;
+  if (entry.element) {
+    return entry.element;
+  }
+
+  for (Element& element : ElementTraversal::DescendantsOf(scope.RootNode())) {
+    if (element.HasID() && element.IdForStyleResolution() == key) {
+      entry.element = &element;
+      return &element;
+    }
+  }
+
+  // The map is updated from InsertedInto()/RemovedFrom() and id attribute
+  // changes, so a resolvable entry must always exist in the scope.
+  assert(false);
+  return nullptr;
+}
+
+}  // namespace webf
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_DOM_TREE_ORDERED_MAP_H_
+#define WEBF_CORE_DOM_TREE_ORDERED_MAP_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include "foundation/string/atomic_string.h"
+
+namespace webf {
+
+class Element;
+class TreeScope;
+
+// Maps an id to the first element in tree order that carries it, mirroring
+// Blink's TreeOrderedMap. When several connected elements share a key, the
+// cached element is dropped and resolved lazily by walking the tree scope on
+// the next lookup, so insert/remove stays O(1).
+class TreeOrderedMap {
+ public:
+  TreeOrderedMap() = default;
+  TreeOrderedMap(const TreeOrderedMap&) = delete;
+  TreeOrderedMap& operator=(const TreeOrderedMap&) = delete;
+
+  void Add(const AtomicString& key, Element& element);
+  void Remove(const AtomicString& key, Element& element);
+
+  bool Contains(const AtomicString& key) const { return map_.find(key) != map_.end(); }
+  bool ContainsMultiple(const AtomicString& key) const;
+
+  // Returns the first element in tree order under |scope| whose id is |key|.
+  Element* GetElementById(const AtomicString& key, const TreeScope& scope) const;
+
+  void Clear() { map_.clear(); }
+
+ private:
+  struct MapEntry {
+    // Null when the first element has not been resolved after a duplicate was
+    // added or the cached element was removed.
+    Element* element;
+    uint32_t count;
+  };
+
+  mutable std::unordered_map<AtomicString, MapEntry, AtomicString::KeyHasher> map_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_DOM_TREE_ORDERED_MAP_H_
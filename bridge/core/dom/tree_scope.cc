@@ -5,6 +5,7 @@
 
 #include "tree_scope.h"
 #include "document.h"
+#include "space_split_string.h"
 
 namespace webf {
 
@@ -12,4 +13,75 @@ TreeScope::TreeScope(Document& document) : root_node_(&document), document_(&doc
   root_node_->SetTreeScope(this);
 }
 
+Element* TreeScope::getElementById(const AtomicString& element_id) const {
+  if (element_id.IsNull() || element_id.empty()) {
+    return nullptr;
+  }
+  return elements_by_id_.GetElementById(element_id, *this);
+}
+
+bool TreeScope::HasElementWithId(const AtomicString& id) const {
+  assert(!id.IsNull());
+  return elements_by_id_.Contains(id);
+}
+
+bool TreeScope::ContainsMultipleElementsWithId(const AtomicString& id) const {
+  return elements_by_id_.ContainsMultiple(id);
+}
+
+void TreeScope::AddElementById(const AtomicString& element_id, Element& element) {
+  elements_by_id_.Add(element_id, element);
+}
+
+void TreeScope::RemoveElementById(const AtomicString& element_id, Element& element) {
+  elements_by_id_.Remove(element_id, element);
+}
+
+void TreeScope::AddElementByTagName(const AtomicString& local_name) {
+  element_count_++;
+  IncrementCount(tag_name_counts_, local_name.LowerASCII());
+}
+
+void TreeScope::RemoveElementByTagName(const AtomicString& local_name) {
+  assert(element_count_ > 0);
+  element_count_--;
+  DecrementCount(tag_name_counts_, local_name.LowerASCII());
+}
+
+void TreeScope::AddElementClassNames(const SpaceSplitString& class_names) {
+  for (size_t i = 0; i < class_names.size(); i++) {
+    IncrementCount(class_name_counts_, class_names[i]);
+  }
+}
+
+void TreeScope::RemoveElementClassNames(const SpaceSplitString& class_names) {
+  for (size_t i = 0; i < class_names.size(); i++) {
+    DecrementCount(class_name_counts_, class_names[i]);
+  }
+}
+
+uint32_t TreeScope::CountElementsWithTagName(const AtomicString& local_name) const {
+  auto it = tag_name_counts_.find(local_name.LowerASCII());
+  return it == tag_name_counts_.end() ? 0 : it->second;
+}
+
+uint32_t TreeScope::CountElementsWithClassName(const AtomicString& class_name) const {
+  auto it = class_name_counts_.find(class_name);
+  return it == class_name_counts_.end() ? 0 : it->second;
+}
+
+void TreeScope::IncrementCount(CountMap& map, const AtomicString& key) {
+  map[key]++;
+}
+
+void TreeScope::DecrementCount(CountMap& map, const AtomicString& key) {
+  auto it = map.find(key);
+  if (it == map.end()) {
+    return;
+  }
+  if (--it->second == 0) {
+    map.erase(it);
+  }
+}
+
 }  // namespace webf
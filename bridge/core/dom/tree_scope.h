@@ -7,11 +7,17 @@
 #define BRIDGE_CORE_DOM_TREE_SCOPE_H_
 
 #include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include "core/dom/tree_ordered_map.h"
+#include "foundation/string/atomic_string.h"
 
 namespace webf {
 
 class ContainerNode;
 class Document;
+class Element;
+class SpaceSplitString;
 
 // The root node of a document tree (in which case this is a Document) or of a
 // shadow tree (in which case this is a ShadowRoot). Various things, like
@@ -31,13 +37,46 @@ class TreeScope {
 
   ContainerNode& RootNode() const { return *root_node_; }
 
+  // Lookup tables for connected elements, kept up to date from
+  // Element::InsertedInto()/RemovedFrom() and id/class attribute changes so
+  // that getElementById() and getElementsBy*() can be answered on the JS
+  // thread without asking Dart.
+  Element* getElementById(const AtomicString& element_id) const;
+  bool HasElementWithId(const AtomicString& id) const;
+  bool ContainsMultipleElementsWithId(const AtomicString& id) const;
+  void AddElementById(const AtomicString& element_id, Element& element);
+  void RemoveElementById(const AtomicString& element_id, Element& element);
+
+  void AddElementByTagName(const AtomicString& local_name);
+  void RemoveElementByTagName(const AtomicString& local_name);
+  void AddElementClassNames(const SpaceSplitString& class_names);
+  void RemoveElementClassNames(const SpaceSplitString& class_names);
+
+  // Number of connected elements in this scope with the given (ASCII
+  // case-insensitive) local name or class token. Callers use these to skip
+  // tree walks that cannot match and to stop walking once every candidate
+  // has been seen.
+  uint32_t CountElementsWithTagName(const AtomicString& local_name) const;
+  uint32_t CountElementsWithClassName(const AtomicString& class_name) const;
+  uint32_t ElementCount() const { return element_count_; }
+
  protected:
   explicit TreeScope(Document&);
 
  private:
+  using CountMap = std::unordered_map<AtomicString, uint32_t, AtomicString::KeyHasher>;
+
+  static void IncrementCount(CountMap& map, const AtomicString& key);
+  static void DecrementCount(CountMap& map, const AtomicString& key);
+
   ContainerNode* root_node_;
   Document* document_;
   TreeScope* parent_tree_scope_;
+
+  TreeOrderedMap elements_by_id_;
+  CountMap tag_name_counts_;
+  CountMap class_name_counts_;
+  uint32_t element_count_ = 0;
 };
 
 }  // namespace webf
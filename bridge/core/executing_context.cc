@@ -32,6 +32,7 @@
 #include "core/platform/url/kurl.h"
 #include "event_type_names.h"
 #include "foundation/logging.h"
+#include "foundation/metrics_registry.h"
 #include "foundation/native_byte_data.h"
 #include "foundation/native_value_converter.h"
 #include "foundation/shared_ui_command.h"
@@ -98,6 +99,7 @@ ExecutingContext::ExecutingContext(DartIsolateContext* dart_isolate_context,
       owner_(owner),
       public_method_ptr_(std::make_unique<ExecutingContextWebFMethods>()),
       is_dedicated_(is_dedicated),
+      looper_(is_dedicated ? multi_threading::Looper::Current() : nullptr),
       unique_id_(context_unique_id++),
       is_context_valid_(true) {
   if (is_dedicated) {
@@ -157,11 +159,30 @@ ExecutingContext::ExecutingContext(DartIsolateContext* dart_isolate_context,
 
   // Register this context for DevTools access
   devtools_internal::RegisterExecutingContext(this);
+
+  dart_isolate_context_->metrics()->Add(MetricsGauge::kLiveExecutingContexts, 1);
+}
+
+void ExecutingContext::ReassignContextId(double context_id) {
+  assert_m(valid_contexts[context_id] != true, "Conflict context found!");
+  devtools_internal::UnregisterExecutingContext(this);
+  valid_contexts[context_id_] = false;
+  context_id_ = context_id;
+  valid_contexts[context_id] = true;
+  if (context_id > running_context_list)
+    running_context_list = context_id;
+
+  time_origin_ = std::chrono::system_clock::now();
+  devtools_internal::RegisterExecutingContext(this);
+
+  // Batch updates asked for while prewarming were never posted to Dart.
+  dartMethodPtr()->requestBatchUpdate(is_dedicated_, context_id_);
 }
 
 ExecutingContext::~ExecutingContext() {
   is_context_valid_ = false;
   valid_contexts[context_id_] = false;
+  dart_isolate_context_->metrics()->Add(MetricsGauge::kLiveExecutingContexts, -1);
   executing_context_status_->disposed = true;
 
   // Clear remote object registry for this context
@@ -268,7 +289,7 @@ bool ExecutingContext::EvaluateJavaScript(const char* code,
 
   JSValue result;
   if (parsed_bytecodes == nullptr) {
-    result = JS_Eval(script_state_.ctx(), code, code_len, sourceURL, JS_EVAL_TYPE_GLOBAL);
+    result = EvalWithBytecodeCache(code, code_len, sourceURL);
   } else {
     JSValue byte_object =
         JS_Eval(script_state_.ctx(), code, code_len, sourceURL, JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
@@ -300,6 +321,39 @@ bool ExecutingContext::EvaluateJavaScript(const char* code,
   return success;
 }
 
+JSValue ExecutingContext::EvalWithBytecodeCache(const char* code, size_t code_len, const char* sourceURL) {
+  JSContext* ctx = script_state_.ctx();
+  BytecodeCache* cache = dart_isolate_context_->bytecodeCache();
+  if (cache == nullptr || code_len < BytecodeCache::kMinSourceLength) {
+    return JS_Eval(ctx, code, code_len, sourceURL, JS_EVAL_TYPE_GLOBAL);
+  }
+
+  BytecodeCache::Key key = cache->KeyFor(code, code_len, sourceURL);
+  if (auto entry = cache->Find(key)) {
+    JSValue function = JS_ReadObject(ctx, entry->data(), entry->size(), JS_READ_OBJ_BYTECODE);
+    if (!JS_IsException(function)) {
+      return JS_EvalFunction(ctx, function);
+    }
+    // Valid on disk but not loadable by this engine; compile and replace it.
+    JS_FreeValue(ctx, JS_GetException(ctx));
+    cache->Remove(key);
+  }
+
+  JSValue function = JS_Eval(ctx, code, code_len, sourceURL, JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
+  if (JS_IsException(function)) {
+    return function;
+  }
+  size_t length;
+  uint8_t* bytes = JS_WriteObject(ctx, &length, function, JS_WRITE_OBJ_BYTECODE);
+  if (bytes != nullptr) {
+    cache->Store(key, bytes, length);
+    js_free(ctx, bytes);
+  } else {
+    JS_FreeValue(ctx, JS_GetException(ctx));
+  }
+  return JS_EvalFunction(ctx, function);
+}
+
 bool ExecutingContext::EvaluateJavaScript(const char16_t* code, size_t length, const char* sourceURL, int startLine) {
   return EvaluateJavaScript(code, length, sourceURL, startLine, nullptr);
 }
@@ -33,6 +33,7 @@
 
 #include "dart_isolate_context.h"
 #include "dart_methods.h"
+#include "dom/layout_geometry_snapshot.h"
 #include "executing_context_data.h"
 #include "frame/dom_timer_coordinator.h"
 #include "frame/module_context_coordinator.h"
@@ -138,6 +139,10 @@ class ExecutingContext {
   JSValue Global();
   JSContext* ctx();
   FORCE_INLINE double contextId() const { return context_id_; };
+  // Hands a prewarmed context to the page Dart allocated: moves it to
+  // |context_id| and restarts the performance timeline. Until then nothing
+  // the context does is sent to Dart.
+  void ReassignContextId(double context_id);
   FORCE_INLINE int32_t uniqueId() const { return unique_id_; }
   void* owner();
   bool HandleException(JSValue* exc);
@@ -203,6 +208,7 @@ class ExecutingContext {
   FORCE_INLINE DartIsolateContext* dartIsolateContext() const { return dart_isolate_context_; };
   FORCE_INLINE Performance* performance() const { return performance_; }
   FORCE_INLINE SharedUICommand* uiCommandBuffer() { return &ui_command_buffer_; };
+  FORCE_INLINE LayoutGeometrySnapshot* layoutGeometrySnapshot() { return &layout_geometry_snapshot_; }
   FORCE_INLINE DartMethodPointer* dartMethodPtr() const {
     assert(dart_isolate_context_->valid());
     return dart_isolate_context_->dartMethodPtr();
@@ -211,6 +217,10 @@ class ExecutingContext {
   FORCE_INLINE StringCache* stringCache() const { return dart_isolate_context_->stringCache(); }
   FORCE_INLINE ExecutingContextWebFMethods* publicMethodPtr() const { return public_method_ptr_.get(); }
   FORCE_INLINE bool isDedicated() { return is_dedicated_; }
+  // The looper of the JS thread this context was created on; nullptr when
+  // not dedicated. Captured once, so timers never look it up in the
+  // dispatcher's thread map, which the Dart thread mutates.
+  FORCE_INLINE multi_threading::Looper* looper() const { return looper_; }
   FORCE_INLINE std::chrono::time_point<std::chrono::system_clock> timeOrigin() const { return time_origin_; }
   FORCE_INLINE bool isBlinkEnabled() { return enable_blink_engine_; }
   FORCE_INLINE bool isIdle() const { return is_idle_; }
@@ -285,6 +295,10 @@ class ExecutingContext {
 
   void DrainPendingPromiseJobs();
 
+  // Evaluates a classic script through the isolate's on-disk bytecode cache
+  // when one is configured.
+  JSValue EvalWithBytecodeCache(const char* code, size_t code_len, const char* sourceURL);
+
   static void promiseRejectTracker(JSContext* ctx,
                                    JSValueConst promise,
                                    JSValueConst reason,
@@ -296,6 +310,8 @@ class ExecutingContext {
   // Keep uiCommandBuffer below dartMethod ptr to make sure we can flush all disposeEventTarget when UICommandBuffer
   // release.
   SharedUICommand ui_command_buffer_{this};
+  // Commands added while ScriptState frees the JSContext still touch it.
+  LayoutGeometrySnapshot layout_geometry_snapshot_;
   DartIsolateContext* dart_isolate_context_{nullptr};
   // Keep uiCommandBuffer above ScriptState to make sure we can collect all disposedEventTarget command when free
   // JSContext. When call JSFreeContext(ctx) inside ScriptState, all eventTargets will be finalized and UICommandBuffer
@@ -331,6 +347,7 @@ class ExecutingContext {
   std::unordered_set<NativeJSFunctionRef*> active_js_function_refs_;
   std::unordered_map<AtomicString, std::unique_ptr<WidgetElementShape>, AtomicString::KeyHasher> widget_element_shapes_;
   bool is_dedicated_;
+  multi_threading::Looper* looper_;
   std::unique_ptr<RemoteObjectRegistry> remote_object_registry_;
   bool enable_blink_engine_ = false;
   // When Blink CSS is enabled, defer UICommand packages until we've run at
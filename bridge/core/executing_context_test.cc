@@ -7,8 +7,11 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 
+#include <chrono>
+#include <thread>
 #include "gtest/gtest.h"
 #include "include/webf_bridge.h"
+#include "multiple_threading/looper.h"
 #include "page.h"
 #include "webf_test_env.h"
 
@@ -27,6 +30,77 @@ TEST(Context, isValid) {
   //  }
 }
 
+TEST(Context, reassignContextIdMovesPrewarmedContext) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  double old_id = context->contextId();
+  double new_id = old_id + 1000;
+
+  context->ReassignContextId(new_id);
+  EXPECT_EQ(context->contextId(), new_id);
+  EXPECT_TRUE(isContextValid(new_id));
+  EXPECT_FALSE(isContextValid(old_id));
+
+  std::string code = "globalThis.reassigned = performance.now() >= 0;";
+  EXPECT_TRUE(context->EvaluateJavaScript(code.c_str(), code.size(), "vm://", 0));
+}
+
+namespace webf {
+
+class PrewarmedContextTest : public ::testing::Test {
+ protected:
+  // Prepares the calling JS thread the way InitializeNewPageInJSThread does.
+  static void SetUpJSThread(DartIsolateContext* dart_isolate_context) {
+    DartIsolateContext::InitializeJSRuntime();
+    dart_isolate_context->InitializeGlobalsPerThread();
+  }
+  static void TearDownJSThread() { DartIsolateContext::FinalizeJSRuntime(); }
+};
+
+TEST_F(PrewarmedContextTest, RunsTimersScheduledDuringInit) {
+  auto mocked_dart_methods = TEST_getMockDartMethods(nullptr);
+  auto* dart_isolate_context = static_cast<DartIsolateContext*>(
+      initDartIsolateContextSync(0, mocked_dart_methods.data(), mocked_dart_methods.size(), nullptr));
+  ExecutingContext::plugin_string_code["prewarmed_timer"] =
+      "globalThis.prewarmedTimerFired = false; setTimeout(() => { globalThis.prewarmedTimerFired = true; }, 0);";
+
+  // Built the way PageGroup::PrewarmNextPage builds spares: on a JS thread,
+  // under a placeholder id that no thread group or Dart controller knows.
+  multi_threading::Looper looper(0);
+  looper.Start();
+  WebFPage* page = looper.PostMessageSync([&](bool cancel) {
+    SetUpJSThread(dart_isolate_context);
+    return new WebFPage(dart_isolate_context, true, 4, 0, multi_threading::kFirstPrewarmedContextId, nullptr, 0,
+                        nullptr);
+  });
+  ExecutingContext::plugin_string_code.erase("prewarmed_timer");
+
+  auto timer_fired = [&]() {
+    JSContext* ctx = page->executingContext()->ctx();
+    JSValue global = JS_GetGlobalObject(ctx);
+    JSValue fired = JS_GetPropertyStr(ctx, global, "prewarmedTimerFired");
+    bool result = JS_ToBool(ctx, fired);
+    JS_FreeValue(ctx, fired);
+    JS_FreeValue(ctx, global);
+    return result;
+  };
+  bool fired = false;
+  for (int i = 0; i < 200 && !fired; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    fired = looper.PostMessageSync([&](bool cancel) { return timer_fired(); });
+  }
+  EXPECT_TRUE(fired);
+
+  looper.PostMessageSync([&](bool cancel) {
+    delete page;
+    TearDownJSThread();
+  });
+  looper.Stop();
+  delete dart_isolate_context;
+}
+
+}  // namespace webf
+
 TEST(Context, evalWithError) {
   static bool errorHandlerExecuted = false;
   auto errorHandler = [](double contextId, const char* errmsg) {
@@ -278,7 +352,7 @@ TEST(Context, unrejectPromiseErrorWithMultipleContext) {
 
 TEST(Context, disposeContext) {
   auto mockedDartMethods = TEST_getMockDartMethods(nullptr);
-  void* dart_context = initDartIsolateContextSync(0, mockedDartMethods.data(), mockedDartMethods.size());
+  void* dart_context = initDartIsolateContextSync(0, mockedDartMethods.data(), mockedDartMethods.size(), nullptr);
   double contextId = 0;
   auto* page = static_cast<webf::WebFPage*>(allocateNewPageSync(0.0, dart_context, nullptr, 0, /*enable_blink=*/kEnableBlink));
   static bool disposed = false;
@@ -12,6 +12,7 @@
 #include "bindings/qjs/qjs_function.h"
 #include "bindings/qjs/script_wrappable.h"
 #include "dom_timer_coordinator.h"
+#include "multiple_threading/timer_wheel.h"
 
 namespace webf {
 
@@ -41,12 +42,23 @@ class DOMTimer {
 
   ExecutingContext* context() { return context_; }
 
+  // Used when the timer is driven natively by the JS thread's Looper.
+  int32_t timeout() const { return timeout_; }
+  void setTimeout(int32_t timeout) { timeout_ = timeout; }
+  int32_t nestingLevel() const { return nesting_level_; }
+  void setNestingLevel(int32_t nesting_level) { nesting_level_ = nesting_level; }
+  multi_threading::TimerWheel::TimerId nativeTimerId() const { return native_timer_id_; }
+  void setNativeTimerId(multi_threading::TimerWheel::TimerId id) { native_timer_id_ = id; }
+
  private:
   TimerKind kind_;
   ExecutingContext* context_{nullptr};
   int32_t timer_id_{-1};
   TimerStatus status_;
   std::shared_ptr<Function> callback_;
+  int32_t timeout_{0};
+  int32_t nesting_level_{0};
+  multi_threading::TimerWheel::TimerId native_timer_id_{0};
 };
 
 }  // namespace webf
@@ -37,9 +37,18 @@ class DOMTimerCoordinator {
 
   std::shared_ptr<DOMTimer> getTimerById(int32_t timer_id);
 
+  // Ids for timers scheduled natively; Dart assigns them otherwise.
+  int32_t nextNativeTimerId() { return next_native_timer_id_++; }
+
+  // Nesting level of the timer whose callback is running, 0 outside timers.
+  int32_t timerNestingLevel() const { return timer_nesting_level_; }
+  void setTimerNestingLevel(int32_t nesting_level) { timer_nesting_level_ = nesting_level; }
+
  private:
   std::unordered_map<int, std::shared_ptr<DOMTimer>> active_timers_;
   std::unordered_map<int, std::shared_ptr<DOMTimer>> terminated_timers;
+  int32_t next_native_timer_id_{1};
+  int32_t timer_nesting_level_{0};
 };
 
 }  // namespace webf
@@ -8,6 +8,7 @@
  */
 #include "window_or_worker_global_scope.h"
 
+#include <algorithm>
 #include "bindings/qjs/script_promise_resolver.h"
 #include "bindings/qjs/script_wrappable.h"
 #include "core/dom/document.h"
@@ -208,6 +209,72 @@ static void handlePersistentCallbackWrapper(void* ptr, double contextId, char* e
                                                         webf::handlePersistentCallback, ptr, contextId, errmsg);
 }
 
+// Timers nested more than this deep are clamped to kMinimumTimerInterval,
+// following the HTML timer initialization steps.
+constexpr int32_t kMaxTimerNestingLevel = 5;
+constexpr int32_t kMinimumTimerInterval = 4;
+
+static void scheduleNativeTimer(ExecutingContext* context,
+                                const std::shared_ptr<DOMTimer>& timer,
+                                int32_t nesting_level);
+
+// On a dedicated JS thread, timers are kept in the thread's Looper and fire
+// there directly instead of being scheduled and called back through Dart.
+static void handleNativeTimer(ExecutingContext* context, double contextId, int32_t timerId) {
+  if (!isContextValid(contextId))
+    return;
+
+  auto timer = context->Timers()->getTimerById(timerId);
+  if (timer == nullptr)
+    return;
+
+  context->Timers()->setTimerNestingLevel(timer->nestingLevel());
+  if (timer->kind() == DOMTimer::TimerKind::kOnce) {
+    handleTransientCallback(timer.get(), contextId, nullptr);
+  } else {
+    handlePersistentCallback(timer.get(), contextId, nullptr);
+  }
+
+  if (!isContextValid(contextId))
+    return;
+  context->Timers()->setTimerNestingLevel(0);
+
+  if (timer->kind() == DOMTimer::TimerKind::kMultiple && timer->status() == DOMTimer::TimerStatus::kFinished) {
+    scheduleNativeTimer(context, timer, timer->nestingLevel());
+  }
+}
+
+static void scheduleNativeTimer(ExecutingContext* context,
+                                const std::shared_ptr<DOMTimer>& timer,
+                                int32_t nesting_level) {
+  int32_t timeout = std::max(timer->timeout(), 0);
+  if (nesting_level > kMaxTimerNestingLevel && timeout < kMinimumTimerInterval) {
+    timeout = kMinimumTimerInterval;
+  }
+  timer->setNestingLevel(nesting_level + 1);
+
+  double contextId = context->contextId();
+  int32_t timerId = timer->timerId();
+  timer->setNativeTimerId(context->looper()->ScheduleTimer(
+      timeout, [context, contextId, timerId]() { handleNativeTimer(context, contextId, timerId); }));
+}
+
+static int32_t installNativeTimer(ExecutingContext* context, const std::shared_ptr<DOMTimer>& timer, int32_t timeout) {
+  int32_t timerId = context->Timers()->nextNativeTimerId();
+  timer->setTimerId(timerId);
+  timer->setTimeout(timeout);
+  context->Timers()->installNewTimer(context, timerId, timer);
+  scheduleNativeTimer(context, timer, context->Timers()->timerNestingLevel());
+  return timerId;
+}
+
+static void cancelNativeTimer(ExecutingContext* context, int32_t timerId) {
+  auto timer = context->Timers()->getTimerById(timerId);
+  if (timer == nullptr)
+    return;
+  context->looper()->CancelTimer(timer->nativeTimerId());
+}
+
 int WindowOrWorkerGlobalScope::setTimeout(ExecutingContext* context,
                                           const std::shared_ptr<Function>& handler,
                                           ExceptionState& exception) {
@@ -225,6 +292,10 @@ int WindowOrWorkerGlobalScope::setTimeout(ExecutingContext* context,
 
   // Create a timer object to keep track timer callback.
   auto timer = DOMTimer::create(context, handler, DOMTimer::TimerKind::kOnce);
+  if (context->isDedicated()) {
+    return installNativeTimer(context, timer, timeout);
+  }
+
   auto timer_id = context->dartMethodPtr()->setTimeout(context->isDedicated(), timer.get(), context->contextId(),
                                                        handleTransientCallbackWrapper, timeout);
 
@@ -253,6 +324,9 @@ int WindowOrWorkerGlobalScope::setInterval(ExecutingContext* context,
 
   // Create a timer object to keep track timer callback.
   auto timer = DOMTimer::create(context, handler, DOMTimer::TimerKind::kMultiple);
+  if (context->isDedicated()) {
+    return installNativeTimer(context, timer, timeout);
+  }
 
   int32_t timerId = context->dartMethodPtr()->setInterval(context->isDedicated(), timer.get(), context->contextId(),
                                                           handlePersistentCallbackWrapper, timeout);
@@ -265,12 +339,20 @@ int WindowOrWorkerGlobalScope::setInterval(ExecutingContext* context,
 }
 
 void WindowOrWorkerGlobalScope::clearTimeout(ExecutingContext* context, int32_t timerId, ExceptionState& exception) {
-  context->dartMethodPtr()->clearTimeout(context->isDedicated(), context->contextId(), timerId);
+  if (context->isDedicated()) {
+    cancelNativeTimer(context, timerId);
+  } else {
+    context->dartMethodPtr()->clearTimeout(context->isDedicated(), context->contextId(), timerId);
+  }
   context->Timers()->forceStopTimeoutById(timerId);
 }
 
 void WindowOrWorkerGlobalScope::clearInterval(ExecutingContext* context, int32_t timerId, ExceptionState& exception) {
-  context->dartMethodPtr()->clearTimeout(context->isDedicated(), context->contextId(), timerId);
+  if (context->isDedicated()) {
+    cancelNativeTimer(context, timerId);
+  } else {
+    context->dartMethodPtr()->clearTimeout(context->isDedicated(), context->contextId(), timerId);
+  }
   context->Timers()->forceStopTimeoutById(timerId);
 }
 
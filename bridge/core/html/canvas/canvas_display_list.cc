@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "canvas_display_list.h"
+
+#include <cstring>
+#include "foundation/dart_readable.h"
+
+namespace webf {
+
+void CanvasDisplayList::Record(CanvasOp op,
+                               std::initializer_list<double> args,
+                               const std::vector<double>& trailing_args) {
+  uint32_t argc = static_cast<uint32_t>(args.size() + trailing_args.size());
+  ops_.emplace_back(static_cast<uint32_t>(op) | (argc << 8));
+  args_.insert(args_.end(), args.begin(), args.end());
+  args_.insert(args_.end(), trailing_args.begin(), trailing_args.end());
+}
+
+NativeCanvasDisplayList* CanvasDisplayList::Release() {
+  auto* list = new NativeCanvasDisplayList();
+  list->op_count = static_cast<uint32_t>(ops_.size());
+  list->ops = static_cast<uint32_t*>(dart_malloc(sizeof(uint32_t) * ops_.size()));
+  std::memcpy(list->ops, ops_.data(), sizeof(uint32_t) * ops_.size());
+  list->arg_count = static_cast<uint32_t>(args_.size());
+  if (!args_.empty()) {
+    list->args = static_cast<double*>(dart_malloc(sizeof(double) * args_.size()));
+    std::memcpy(list->args, args_.data(), sizeof(double) * args_.size());
+  }
+  Clear();
+  return list;
+}
+
+}  // namespace webf
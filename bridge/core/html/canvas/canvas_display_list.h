@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_HTML_CANVAS_CANVAS_DISPLAY_LIST_H_
+#define BRIDGE_CORE_HTML_CANVAS_CANVAS_DISPLAY_LIST_H_
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+#include "foundation/native_type.h"
+
+namespace webf {
+
+// Canvas 2D calls whose arguments are all numbers, recorded natively and
+// replayed by the Dart CanvasRenderingContext2D. Append-only; mirrored in
+// webf/lib/src/html/canvas/canvas_context_2d.dart.
+enum class CanvasOp : uint32_t {
+  kFillRect = 1,
+  kStrokeRect,
+  kClearRect,
+  kBeginPath,
+  kClosePath,
+  kMoveTo,
+  kLineTo,
+  kBezierCurveTo,
+  kQuadraticCurveTo,
+  kArc,      // x, y, radius, startAngle, endAngle, anticlockwise (0 or 1).
+  kArcTo,
+  kEllipse,  // x, y, radiusX, radiusY, rotation, startAngle, endAngle, anticlockwise (0 or 1).
+  kRect,
+  kRoundRect,  // x, y, w, h followed by the radii.
+  kFill,
+  kStroke,
+  kClip,
+  kSave,
+  kRestore,
+  kTranslate,
+  kRotate,
+  kScale,
+  kTransform,
+  kSetTransform,
+  kResetTransform,
+  kSetGlobalAlpha,
+  kSetLineWidth,
+  kSetMiterLimit,
+  kSetLineDashOffset,
+  kSetShadowOffsetX,
+  kSetShadowOffsetY,
+  kSetShadowBlur,
+};
+
+// Accumulates CanvasOps for one canvas between submits. Each op is one word
+// in |ops| (opcode in the low byte, argument count above it) and its
+// arguments follow in |args| in call order.
+class CanvasDisplayList {
+ public:
+  // A frame that records more than this is submitted in several parts so
+  // the buffered arguments stay bounded.
+  static constexpr size_t kMaxOps = 1 << 16;
+
+  // |trailing_args| carries variable-length arguments such as roundRect radii.
+  void Record(CanvasOp op, std::initializer_list<double> args, const std::vector<double>& trailing_args = {});
+
+  void Clear() {
+    ops_.clear();
+    args_.clear();
+  }
+
+  bool empty() const { return ops_.empty(); }
+  size_t size() const { return ops_.size(); }
+
+  // Hands the recorded ops to Dart, which frees the returned payload after
+  // replaying it, and leaves this list empty.
+  NativeCanvasDisplayList* Release();
+
+ private:
+  std::vector<uint32_t> ops_;
+  std::vector<double> args_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_HTML_CANVAS_CANVAS_DISPLAY_LIST_H_
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "gtest/gtest.h"
+
+#include "core/html/canvas/canvas_display_list.h"
+#include "foundation/dart_readable.h"
+
+using namespace webf;
+
+namespace {
+
+void FreeDisplayList(NativeCanvasDisplayList* list) {
+  dart_free(list->ops);
+  dart_free(list->args);
+  dart_free(list);
+}
+
+}  // namespace
+
+TEST(CanvasDisplayList, EncodesOpcodeAndArgumentCount) {
+  CanvasDisplayList display_list;
+  display_list.Record(CanvasOp::kBeginPath, {});
+  display_list.Record(CanvasOp::kArc, {10, 20, 5, 0, 3.5, 1});
+  display_list.Record(CanvasOp::kRoundRect, {0, 0, 40, 30}, {4, 8});
+  display_list.Record(CanvasOp::kSetLineWidth, {2.25});
+  EXPECT_EQ(display_list.size(), 4);
+
+  NativeCanvasDisplayList* list = display_list.Release();
+  EXPECT_TRUE(display_list.empty());
+
+  ASSERT_EQ(list->op_count, 4);
+  EXPECT_EQ(list->ops[0], static_cast<uint32_t>(CanvasOp::kBeginPath));
+  EXPECT_EQ(list->ops[1], static_cast<uint32_t>(CanvasOp::kArc) | (6 << 8));
+  EXPECT_EQ(list->ops[2], static_cast<uint32_t>(CanvasOp::kRoundRect) | (6 << 8));
+  EXPECT_EQ(list->ops[3], static_cast<uint32_t>(CanvasOp::kSetLineWidth) | (1 << 8));
+
+  ASSERT_EQ(list->arg_count, 13);
+  EXPECT_EQ(list->args[4], 3.5);
+  EXPECT_EQ(list->args[5], 1);
+  EXPECT_EQ(list->args[10], 4);
+  EXPECT_EQ(list->args[11], 8);
+  EXPECT_EQ(list->args[12], 2.25);
+  FreeDisplayList(list);
+}
+
+TEST(CanvasDisplayList, ArgumentlessListHasNoArgumentBuffer) {
+  CanvasDisplayList display_list;
+  display_list.Record(CanvasOp::kSave, {});
+  display_list.Record(CanvasOp::kRestore, {});
+
+  NativeCanvasDisplayList* list = display_list.Release();
+  EXPECT_EQ(list->op_count, 2);
+  EXPECT_EQ(list->arg_count, 0);
+  EXPECT_EQ(list->args, nullptr);
+  FreeDisplayList(list);
+}
+
+TEST(CanvasDisplayList, ClearDropsRecordedOps) {
+  CanvasDisplayList display_list;
+  display_list.Record(CanvasOp::kFillRect, {0, 0, 10, 10});
+  display_list.Clear();
+  EXPECT_TRUE(display_list.empty());
+}
@@ -8,6 +8,7 @@
 
 #include "canvas_rendering_context_2d.h"
 #include <cmath>
+#include <initializer_list>
 #include <limits>
 #include "binding_call_methods.h"
 #include "canvas_gradient.h"
@@ -30,7 +31,7 @@ bool CanvasRenderingContext2D::IsCanvas2d() const {
 
 CanvasRenderingContext2D::CanvasRenderingContext2D(ExecutingContext* context,
                                                    NativeBindingObject* native_binding_object)
-    : CanvasRenderingContext(context->ctx(), native_binding_object) {
+    : CanvasRenderingContext(context->ctx(), native_binding_object), state_(DefaultDrawingState()) {
   context->RegisterActiveCanvasContext2D(this);
 }
 
@@ -427,239 +428,240 @@ CanvasPattern* CanvasRenderingContext2D::createPattern(
   return MakeGarbageCollected<CanvasPattern>(GetExecutingContext(), native_binding_object);
 }
 
+namespace {
+
+bool IsOneOf(const AtomicString& value, std::initializer_list<const char*> keywords) {
+  for (const char* keyword : keywords) {
+    if (value == keyword)
+      return true;
+  }
+  return false;
+}
+
+NativeValue FillOrStrokeStyleToNativeValue(JSContext* ctx,
+                                           const std::shared_ptr<QJSUnionDomStringCanvasGradientCanvasPattern>& style) {
+  if (style->IsDomString()) {
+    return NativeValueConverter<NativeTypeString>::ToNativeValue(ctx, style->GetAsDomString());
+  } else if (style->IsCanvasGradient()) {
+    return NativeValueConverter<NativeTypePointer<CanvasGradient>>::ToNativeValue(style->GetAsCanvasGradient());
+  } else if (style->IsCanvasPattern()) {
+    return NativeValueConverter<NativeTypePointer<CanvasPattern>>::ToNativeValue(style->GetAsCanvasPattern());
+  }
+  return Native_NewNull();
+}
+
+}  // namespace
+
+CanvasRenderingContext2D::DrawingState CanvasRenderingContext2D::DefaultDrawingState() {
+  DrawingState state;
+  auto black = AtomicString::CreateFromUTF8("#000000");
+  state.fill_style = std::make_shared<QJSUnionDomStringCanvasGradientCanvasPattern>(black);
+  state.stroke_style = std::make_shared<QJSUnionDomStringCanvasGradientCanvasPattern>(black);
+  state.global_composite_operation = AtomicString::CreateFromUTF8("source-over");
+  state.direction = AtomicString::CreateFromUTF8("inherit");
+  state.font = AtomicString::CreateFromUTF8("10px sans-serif");
+  state.line_cap = AtomicString::CreateFromUTF8("butt");
+  state.line_join = AtomicString::CreateFromUTF8("miter");
+  state.text_align = AtomicString::CreateFromUTF8("start");
+  state.text_baseline = AtomicString::CreateFromUTF8("alphabetic");
+  state.shadow_color = AtomicString::CreateFromUTF8("rgba(0, 0, 0, 0)");
+  return state;
+}
+
+void CanvasRenderingContext2D::DrawingState::Trace(GCVisitor* visitor) const {
+  if (fill_style != nullptr)
+    fill_style->Trace(visitor);
+  if (stroke_style != nullptr)
+    stroke_style->Trace(visitor);
+}
+
 std::shared_ptr<QJSUnionDomStringCanvasGradientCanvasPattern> CanvasRenderingContext2D::strokeStyle() {
-  return stroke_style_;
+  return state_.stroke_style;
 }
 
 std::shared_ptr<QJSUnionDomStringCanvasGradientCanvasPattern> CanvasRenderingContext2D::fillStyle() {
-  return fill_style_;
+  return state_.fill_style;
 }
 
 void CanvasRenderingContext2D::setFillStyle(
     const std::shared_ptr<QJSUnionDomStringCanvasGradientCanvasPattern>& style,
     ExceptionState& exception_state) {
-  NativeValue value = Native_NewNull();
-
-  if (style->IsDomString()) {
-    value = NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), style->GetAsDomString());
-  } else if (style->IsCanvasGradient()) {
-    value = NativeValueConverter<NativeTypePointer<CanvasGradient>>::ToNativeValue(style->GetAsCanvasGradient());
-  } else if (style->IsCanvasPattern()) {
-    value = NativeValueConverter<NativeTypePointer<CanvasPattern>>::ToNativeValue(style->GetAsCanvasPattern());
-  }
-  SetBindingPropertyAsync(binding_call_methods::kfillStyle, value, exception_state);
-
-  fill_style_ = style;
+  SetBindingPropertyAsync(binding_call_methods::kfillStyle, FillOrStrokeStyleToNativeValue(ctx(), style),
+                          exception_state);
+  state_.fill_style = style;
 }
 
 double CanvasRenderingContext2D::globalAlpha() {
-  if (global_alpha_cache_.has_value())
-    return global_alpha_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::kglobalAlpha,
-                                          FlushUICommandReason::kDependentsOnElement, ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeDouble>::FromNativeValue(result);
+  return state_.global_alpha;
 }
 
 void CanvasRenderingContext2D::setGlobalAlpha(double global_alpha, ExceptionState& exception_state) {
-  global_alpha_cache_ = global_alpha;
-  SetBindingPropertyAsync(binding_call_methods::kglobalAlpha,
-                          NativeValueConverter<NativeTypeDouble>::ToNativeValue(global_alpha), exception_state);
+  if (!std::isfinite(global_alpha) || global_alpha < 0 || global_alpha > 1)
+    return;
+  state_.global_alpha = global_alpha;
+  Record(CanvasOp::kSetGlobalAlpha, {global_alpha});
 }
 
 AtomicString CanvasRenderingContext2D::globalCompositeOperation() {
-  if (global_composite_operation_cache_.has_value())
-    return global_composite_operation_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::kglobalCompositeOperation,
-                                          FlushUICommandReason::kDependentsOnElement, ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeString>::FromNativeValue(std::move(result));
+  return state_.global_composite_operation;
 }
 
 void CanvasRenderingContext2D::setGlobalCompositeOperation(const AtomicString& global_composite_operation,
                                                            ExceptionState& exception_state) {
-  global_composite_operation_cache_ = global_composite_operation;
+  if (!IsOneOf(global_composite_operation,
+               {"source-over", "source-in", "source-out", "source-atop", "destination-over", "destination-in",
+                "destination-out", "destination-atop", "lighter", "copy", "xor", "multiply", "screen", "overlay",
+                "darken", "lighten", "color-dodge", "color-burn", "hard-light", "soft-light", "difference",
+                "exclusion", "hue", "saturation", "color", "luminosity"}))
+    return;
+  state_.global_composite_operation = global_composite_operation;
   SetBindingPropertyAsync(binding_call_methods::kglobalCompositeOperation,
                           NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), global_composite_operation),
                           exception_state);
 }
 
 AtomicString CanvasRenderingContext2D::direction() {
-  if (direction_cache_.has_value())
-    return direction_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::kdirection,
-                                          FlushUICommandReason::kDependentsOnElement, ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeString>::FromNativeValue(std::move(result));
+  return state_.direction;
 }
 
 void CanvasRenderingContext2D::setDirection(const AtomicString& direction, ExceptionState& exception_state) {
-  direction_cache_ = direction;
+  if (!IsOneOf(direction, {"ltr", "rtl", "inherit"}))
+    return;
+  state_.direction = direction;
   SetBindingPropertyAsync(binding_call_methods::kdirection,
                           NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), direction), exception_state);
 }
 
 AtomicString CanvasRenderingContext2D::font() {
-  if (font_cache_.has_value())
-    return font_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::kfont, FlushUICommandReason::kDependentsOnElement,
-                                          ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeString>::FromNativeValue(std::move(result));
+  return state_.font;
 }
 
 void CanvasRenderingContext2D::setFont(const AtomicString& font, ExceptionState& exception_state) {
-  font_cache_ = font;
+  state_.font = font;
   SetBindingPropertyAsync(binding_call_methods::kfont, NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), font),
                           exception_state);
 }
 
 AtomicString CanvasRenderingContext2D::lineCap() {
-  if (line_cap_cache_.has_value())
-    return line_cap_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::klineCap, FlushUICommandReason::kDependentsOnElement,
-                                          ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeString>::FromNativeValue(std::move(result));
+  return state_.line_cap;
 }
 
 void CanvasRenderingContext2D::setLineCap(const AtomicString& line_cap, ExceptionState& exception_state) {
-  line_cap_cache_ = line_cap;
+  if (!IsOneOf(line_cap, {"butt", "round", "square"}))
+    return;
+  state_.line_cap = line_cap;
   SetBindingPropertyAsync(binding_call_methods::klineCap,
                           NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), line_cap), exception_state);
 }
 
 double CanvasRenderingContext2D::lineDashOffset() {
-  if (line_dash_offset_cache_.has_value())
-    return line_dash_offset_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::klineDashOffset,
-                                          FlushUICommandReason::kDependentsOnElement, ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeDouble>::FromNativeValue(result);
+  return state_.line_dash_offset;
 }
 
 void CanvasRenderingContext2D::setLineDashOffset(double line_dash_offset, ExceptionState& exception_state) {
-  line_dash_offset_cache_ = line_dash_offset;
-  SetBindingPropertyAsync(binding_call_methods::klineDashOffset,
-                          NativeValueConverter<NativeTypeDouble>::ToNativeValue(line_dash_offset), exception_state);
+  if (!std::isfinite(line_dash_offset))
+    return;
+  state_.line_dash_offset = line_dash_offset;
+  Record(CanvasOp::kSetLineDashOffset, {line_dash_offset});
 }
 
 AtomicString CanvasRenderingContext2D::lineJoin() {
-  if (line_join_cache_.has_value())
-    return line_join_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::klineJoin,
-                                          FlushUICommandReason::kDependentsOnElement, ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeString>::FromNativeValue(std::move(result));
+  return state_.line_join;
 }
 
 void CanvasRenderingContext2D::setLineJoin(const AtomicString& line_join, ExceptionState& exception_state) {
-  line_join_cache_ = line_join;
+  if (!IsOneOf(line_join, {"round", "bevel", "miter"}))
+    return;
+  state_.line_join = line_join;
   SetBindingPropertyAsync(binding_call_methods::klineJoin,
                           NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), line_join), exception_state);
 }
 
 double CanvasRenderingContext2D::lineWidth() {
-  if (line_width_cache_.has_value())
-    return line_width_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::klineWidth, FlushUICommandReason::kDependentsOnElement,
-                                          ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeDouble>::FromNativeValue(result);
+  return state_.line_width;
 }
 
 void CanvasRenderingContext2D::setLineWidth(double line_width, ExceptionState& exception_state) {
-  line_width_cache_ = line_width;
-  SetBindingPropertyAsync(binding_call_methods::klineWidth,
-                          NativeValueConverter<NativeTypeDouble>::ToNativeValue(line_width), exception_state);
+  if (!std::isfinite(line_width) || line_width <= 0)
+    return;
+  state_.line_width = line_width;
+  Record(CanvasOp::kSetLineWidth, {line_width});
 }
 
 double CanvasRenderingContext2D::miterLimit() {
-  if (miter_limit_cache_.has_value())
-    return miter_limit_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::kmiterLimit,
-                                          FlushUICommandReason::kDependentsOnElement, ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeDouble>::FromNativeValue(result);
+  return state_.miter_limit;
 }
 
 void CanvasRenderingContext2D::setMiterLimit(double miter_limit, ExceptionState& exception_state) {
-  miter_limit_cache_ = miter_limit;
-  SetBindingPropertyAsync(binding_call_methods::kmiterLimit,
-                          NativeValueConverter<NativeTypeDouble>::ToNativeValue(miter_limit), exception_state);
+  if (!std::isfinite(miter_limit) || miter_limit <= 0)
+    return;
+  state_.miter_limit = miter_limit;
+  Record(CanvasOp::kSetMiterLimit, {miter_limit});
 }
 
 AtomicString CanvasRenderingContext2D::textAlign() {
-  if (text_align_cache_.has_value())
-    return text_align_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::ktextAlign,
-                                          FlushUICommandReason::kDependentsOnElement, ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeString>::FromNativeValue(std::move(result));
+  return state_.text_align;
 }
 
 void CanvasRenderingContext2D::setTextAlign(const AtomicString& text_align, ExceptionState& exception_state) {
-  text_align_cache_ = text_align;
+  if (!IsOneOf(text_align, {"start", "end", "left", "right", "center"}))
+    return;
+  state_.text_align = text_align;
   SetBindingPropertyAsync(binding_call_methods::ktextAlign,
                           NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), text_align), exception_state);
 }
 
 AtomicString CanvasRenderingContext2D::textBaseline() {
-  if (text_baseline_cache_.has_value())
-    return text_baseline_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::ktextBaseline,
-                                          FlushUICommandReason::kDependentsOnElement, ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeString>::FromNativeValue(std::move(result));
+  return state_.text_baseline;
 }
 
 void CanvasRenderingContext2D::setTextBaseline(const AtomicString& text_baseline, ExceptionState& exception_state) {
-  text_baseline_cache_ = text_baseline;
+  if (!IsOneOf(text_baseline, {"top", "hanging", "middle", "alphabetic", "ideographic", "bottom"}))
+    return;
+  state_.text_baseline = text_baseline;
   SetBindingPropertyAsync(binding_call_methods::ktextBaseline,
                           NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), text_baseline), exception_state);
 }
 
 double CanvasRenderingContext2D::shadowOffsetX() {
-  if (shadow_offset_x_cache_.has_value())
-    return shadow_offset_x_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::kshadowOffsetX,
-                                          FlushUICommandReason::kDependentsOnElement, ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeDouble>::FromNativeValue(result);
+  return state_.shadow_offset_x;
 }
 
 void CanvasRenderingContext2D::setShadowOffsetX(double shadow_offset_x, ExceptionState& exception_state) {
-  shadow_offset_x_cache_ = shadow_offset_x;
-  SetBindingPropertyAsync(binding_call_methods::kshadowOffsetX,
-                          NativeValueConverter<NativeTypeDouble>::ToNativeValue(shadow_offset_x), exception_state);
+  if (!std::isfinite(shadow_offset_x))
+    return;
+  state_.shadow_offset_x = shadow_offset_x;
+  Record(CanvasOp::kSetShadowOffsetX, {shadow_offset_x});
 }
 
 double CanvasRenderingContext2D::shadowOffsetY() {
-  if (shadow_offset_y_cache_.has_value())
-    return shadow_offset_y_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::kshadowOffsetY,
-                                          FlushUICommandReason::kDependentsOnElement, ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeDouble>::FromNativeValue(result);
+  return state_.shadow_offset_y;
 }
 
 void CanvasRenderingContext2D::setShadowOffsetY(double shadow_offset_y, ExceptionState& exception_state) {
-  shadow_offset_y_cache_ = shadow_offset_y;
-  SetBindingPropertyAsync(binding_call_methods::kshadowOffsetY,
-                          NativeValueConverter<NativeTypeDouble>::ToNativeValue(shadow_offset_y), exception_state);
+  if (!std::isfinite(shadow_offset_y))
+    return;
+  state_.shadow_offset_y = shadow_offset_y;
+  Record(CanvasOp::kSetShadowOffsetY, {shadow_offset_y});
 }
 
 double CanvasRenderingContext2D::shadowBlur() {
-  if (shadow_blur_cache_.has_value())
-    return shadow_blur_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::kshadowBlur,
-                                          FlushUICommandReason::kDependentsOnElement, ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeDouble>::FromNativeValue(result);
+  return state_.shadow_blur;
 }
 
 void CanvasRenderingContext2D::setShadowBlur(double shadow_blur, ExceptionState& exception_state) {
-  shadow_blur_cache_ = shadow_blur;
-  SetBindingPropertyAsync(binding_call_methods::kshadowBlur,
-                          NativeValueConverter<NativeTypeDouble>::ToNativeValue(shadow_blur), exception_state);
+  if (!std::isfinite(shadow_blur) || shadow_blur < 0)
+    return;
+  state_.shadow_blur = shadow_blur;
+  Record(CanvasOp::kSetShadowBlur, {shadow_blur});
 }
 
 AtomicString CanvasRenderingContext2D::shadowColor() {
-  if (shadow_color_cache_.has_value())
-    return shadow_color_cache_.value();
-  NativeValue result = GetBindingProperty(binding_call_methods::kshadowColor,
-                                          FlushUICommandReason::kDependentsOnElement, ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeString>::FromNativeValue(std::move(result));
+  return state_.shadow_color;
 }
 
 void CanvasRenderingContext2D::setShadowColor(const AtomicString& shadow_color, ExceptionState& exception_state) {
-  shadow_color_cache_ = shadow_color;
+  state_.shadow_color = shadow_color;
   SetBindingPropertyAsync(binding_call_methods::kshadowColor,
                           NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), shadow_color), exception_state);
 }
@@ -667,19 +669,9 @@ void CanvasRenderingContext2D::setShadowColor(const AtomicString& shadow_color,
 void CanvasRenderingContext2D::setStrokeStyle(
     const std::shared_ptr<QJSUnionDomStringCanvasGradientCanvasPattern>& style,
     ExceptionState& exception_state) {
-  NativeValue value = Native_NewNull();
-
-  if (style->IsDomString()) {
-    value = NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), style->GetAsDomString());
-  } else if (style->IsCanvasGradient()) {
-    value = NativeValueConverter<NativeTypePointer<CanvasGradient>>::ToNativeValue(style->GetAsCanvasGradient());
-  } else if (style->IsCanvasPattern()) {
-    value = NativeValueConverter<NativeTypePointer<CanvasPattern>>::ToNativeValue(style->GetAsCanvasPattern());
-  }
-
-  SetBindingPropertyAsync(binding_call_methods::kstrokeStyle, value, exception_state);
-
-  stroke_style_ = style;
+  SetBindingPropertyAsync(binding_call_methods::kstrokeStyle, FillOrStrokeStyleToNativeValue(ctx(), style),
+                          exception_state);
+  state_.stroke_style = style;
 }
 TextMetrics* CanvasRenderingContext2D::measureText(const AtomicString& text, ExceptionState& exception_state) {
   NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), text)};
@@ -791,12 +783,7 @@ void CanvasRenderingContext2D::arc(double x,
                                    double startAngle,
                                    double endAngle,
                                    ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(radius),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(startAngle),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(endAngle)};
-  InvokeBindingMethodAsync(binding_call_methods::karc, sizeof(arguments) / sizeof(NativeValue), arguments, exception_state);
+  Record(CanvasOp::kArc, {x, y, radius, startAngle, endAngle});
 }
 
 void CanvasRenderingContext2D::arc(double x,
@@ -806,14 +793,7 @@ void CanvasRenderingContext2D::arc(double x,
                                    double endAngle,
                                    bool anticlockwise,
                                    ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(radius),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(startAngle),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(endAngle),
-                             NativeValueConverter<NativeTypeBool>::ToNativeValue(anticlockwise)};
-  InvokeBindingMethodAsync(binding_call_methods::karc, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kArc, {x, y, radius, startAngle, endAngle, anticlockwise ? 1.0 : 0.0});
 }
 
 void CanvasRenderingContext2D::arcTo(double x1,
@@ -822,17 +802,11 @@ void CanvasRenderingContext2D::arcTo(double x1,
                                      double y2,
                                      double radius,
                                      ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x1),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y1),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(x2),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y2),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(radius)};
-  InvokeBindingMethodAsync(binding_call_methods::karcTo, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kArcTo, {x1, y1, x2, y2, radius});
 }
 
 void CanvasRenderingContext2D::beginPath(ExceptionState& exception_state) {
-  InvokeBindingMethodAsync(binding_call_methods::kbeginPath, 0, nullptr, exception_state);
+  Record(CanvasOp::kBeginPath, {});
 }
 
 void CanvasRenderingContext2D::bezierCurveTo(double cp1x,
@@ -842,14 +816,7 @@ void CanvasRenderingContext2D::bezierCurveTo(double cp1x,
                                              double x,
                                              double y,
                                              ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(cp1x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(cp1y),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(cp2x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(cp2y),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y)};
-  InvokeBindingMethodAsync(binding_call_methods::kbezierCurveTo, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kBezierCurveTo, {cp1x, cp1y, cp2x, cp2y, x, y});
 }
 
 void CanvasRenderingContext2D::clearRect(double x,
@@ -857,20 +824,15 @@ void CanvasRenderingContext2D::clearRect(double x,
                                          double w,
                                          double h,
                                          ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(w),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(h)};
-  InvokeBindingMethodAsync(binding_call_methods::kclearRect, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kClearRect, {x, y, w, h});
 }
 
 void CanvasRenderingContext2D::closePath(ExceptionState& exception_state) {
-  InvokeBindingMethodAsync(binding_call_methods::kclosePath, 0, nullptr, exception_state);
+  Record(CanvasOp::kClosePath, {});
 }
 
 void CanvasRenderingContext2D::clip(ExceptionState& exception_state) {
-  InvokeBindingMethodAsync(binding_call_methods::kclip, 0, nullptr, exception_state);
+  Record(CanvasOp::kClip, {});
 }
 
 void CanvasRenderingContext2D::clip(Path2D* path, ExceptionState& exception_state) {
@@ -1031,15 +993,7 @@ void CanvasRenderingContext2D::ellipse(double x,
                                        double startAngle,
                                        double endAngle,
                                        ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(radiusX),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(radiusY),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(rotation),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(startAngle),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(endAngle)};
-  InvokeBindingMethodAsync(binding_call_methods::kellipse, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kEllipse, {x, y, radiusX, radiusY, rotation, startAngle, endAngle});
 }
 
 void CanvasRenderingContext2D::ellipse(double x,
@@ -1051,16 +1005,7 @@ void CanvasRenderingContext2D::ellipse(double x,
                                        double endAngle,
                                        bool anticlockwise,
                                        ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(radiusX),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(radiusY),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(rotation),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(startAngle),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(endAngle),
-                             NativeValueConverter<NativeTypeBool>::ToNativeValue(anticlockwise)};
-  InvokeBindingMethodAsync(binding_call_methods::kellipse, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kEllipse, {x, y, radiusX, radiusY, rotation, startAngle, endAngle, anticlockwise ? 1.0 : 0.0});
 }
 
 void CanvasRenderingContext2D::fillRect(double x,
@@ -1068,12 +1013,7 @@ void CanvasRenderingContext2D::fillRect(double x,
                                         double w,
                                         double h,
                                         ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(w),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(h)};
-  InvokeBindingMethodAsync(binding_call_methods::kfillRect, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kFillRect, {x, y, w, h});
 }
 
 void CanvasRenderingContext2D::fillText(const AtomicString& text,
@@ -1101,53 +1041,53 @@ void CanvasRenderingContext2D::fillText(const AtomicString& text,
 }
 
 void CanvasRenderingContext2D::setLineDash(const std::vector<double>& segments, ExceptionState& exception_state) {
-  line_dash_segments_ = segments;
+  for (double segment : segments) {
+    if (!std::isfinite(segment) || segment < 0)
+      return;
+  }
+  state_.line_dash = segments;
+  // An odd number of segments is repeated to make it even.
+  if (segments.size() % 2 == 1) {
+    state_.line_dash.insert(state_.line_dash.end(), segments.begin(), segments.end());
+  }
   NativeValue arguments[] = {
-      NativeValueConverter<NativeTypeArray<NativeTypeDouble>>::ToNativeValue(segments),
+      NativeValueConverter<NativeTypeArray<NativeTypeDouble>>::ToNativeValue(state_.line_dash),
   };
   InvokeBindingMethodAsync(binding_call_methods::ksetLineDash, sizeof(arguments) / sizeof(NativeValue), arguments,
                            exception_state);
 }
 
 std::vector<double> CanvasRenderingContext2D::getLineDash(ExceptionState& exception_state) {
-  return line_dash_segments_;
+  return state_.line_dash;
 }
 
 void CanvasRenderingContext2D::lineTo(double x, double y, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y)};
-  InvokeBindingMethodAsync(binding_call_methods::klineTo, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kLineTo, {x, y});
 }
 
 void CanvasRenderingContext2D::moveTo(double x, double y, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y)};
-  InvokeBindingMethodAsync(binding_call_methods::kmoveTo, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kMoveTo, {x, y});
 }
 
 void CanvasRenderingContext2D::rect(double x, double y, double w, double h, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(w),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(h)};
-  InvokeBindingMethodAsync(binding_call_methods::krect, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kRect, {x, y, w, h});
 }
 
 void CanvasRenderingContext2D::restore(ExceptionState& exception_state) {
-  InvokeBindingMethodAsync(binding_call_methods::krestore, 0, nullptr, exception_state);
+  // Restoring with an empty stack is a no-op; the Dart side expects a matching save().
+  if (saved_states_.empty())
+    return;
+  state_ = std::move(saved_states_.back());
+  saved_states_.pop_back();
+  Record(CanvasOp::kRestore, {});
 }
 
 void CanvasRenderingContext2D::resetTransform(ExceptionState& exception_state) {
-  InvokeBindingMethodAsync(binding_call_methods::kresetTransform, 0, nullptr, exception_state);
+  Record(CanvasOp::kResetTransform, {});
 }
 
 void CanvasRenderingContext2D::rotate(double angle, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(angle)};
-  InvokeBindingMethodAsync(binding_call_methods::krotate, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kRotate, {angle});
 }
 
 void CanvasRenderingContext2D::quadraticCurveTo(double cpx,
@@ -1155,16 +1095,11 @@ void CanvasRenderingContext2D::quadraticCurveTo(double cpx,
                                                 double x,
                                                 double y,
                                                 ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(cpx),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(cpy),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y)};
-  InvokeBindingMethodAsync(binding_call_methods::kquadraticCurveTo, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kQuadraticCurveTo, {cpx, cpy, x, y});
 }
 
 void CanvasRenderingContext2D::stroke(ExceptionState& exception_state) {
-  InvokeBindingMethodAsync(binding_call_methods::kstroke, 0, nullptr, exception_state);
+  Record(CanvasOp::kStroke, {});
 }
 
 void CanvasRenderingContext2D::stroke(Path2D* path, ExceptionState& exception_state) {
@@ -1182,23 +1117,16 @@ void CanvasRenderingContext2D::strokeRect(double x,
                                           double w,
                                           double h,
                                           ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(w),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(h)};
-  InvokeBindingMethodAsync(binding_call_methods::kstrokeRect, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kStrokeRect, {x, y, w, h});
 }
 
 void CanvasRenderingContext2D::save(ExceptionState& exception_state) {
-  InvokeBindingMethodAsync(binding_call_methods::ksave, 0, nullptr, exception_state);
+  saved_states_.push_back(state_);
+  Record(CanvasOp::kSave, {});
 }
 
 void CanvasRenderingContext2D::scale(double x, double y, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y)};
-  InvokeBindingMethodAsync(binding_call_methods::kscale, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kScale, {x, y});
 }
 
 void CanvasRenderingContext2D::strokeText(const AtomicString& text,
@@ -1232,14 +1160,7 @@ void CanvasRenderingContext2D::setTransform(double a,
                                             double e,
                                             double f,
                                             ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(a),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(b),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(c),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(d),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(e),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(f)};
-  InvokeBindingMethodAsync(binding_call_methods::ksetTransform, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kSetTransform, {a, b, c, d, e, f});
 }
 
 void CanvasRenderingContext2D::transform(double a,
@@ -1249,26 +1170,16 @@ void CanvasRenderingContext2D::transform(double a,
                                          double e,
                                          double f,
                                          ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(a),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(b),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(c),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(d),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(e),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(f)};
-  InvokeBindingMethodAsync(binding_call_methods::ktransform, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kTransform, {a, b, c, d, e, f});
 }
 
 void CanvasRenderingContext2D::translate(double x, double y, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y)};
-  InvokeBindingMethodAsync(binding_call_methods::ktranslate, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kTranslate, {x, y});
 }
 
 void CanvasRenderingContext2D::reset(ExceptionState& exception_state) {
   InvokeBindingMethodAsync(binding_call_methods::kreset, 0, nullptr, exception_state);
-  ClearPropertyCaches();
+  ResetDrawingState();
 }
 
 void CanvasRenderingContext2D::roundRect(double x,
@@ -1285,14 +1196,7 @@ void CanvasRenderingContext2D::roundRect(double x,
     radii_vector.assign(radii_sequence.begin(), radii_sequence.end());
   }
 
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(w),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(h),
-                             NativeValueConverter<NativeTypeArray<NativeTypeDouble>>::ToNativeValue(radii_vector)};
-
-  InvokeBindingMethodAsync(binding_call_methods::kroundRect, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kRoundRect, {x, y, w, h}, radii_vector);
 }
 
 void CanvasRenderingContext2D::requestPaint() const {
@@ -1309,7 +1213,27 @@ void CanvasRenderingContext2D::needsPaint() const {
   if (!_needsPaint)
     return;
   _needsPaint = false;
-  GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kRequestCanvasPaint, nullptr, bindingObject(), nullptr, true);
+  // The frame's recorded calls ride along with the paint request.
+  NativeCanvasDisplayList* display_list = display_list_.empty() ? nullptr : display_list_.Release();
+  GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kRequestCanvasPaint, nullptr, bindingObject(),
+                                                       display_list, true);
+}
+
+void CanvasRenderingContext2D::FlushDisplayList() const {
+  if (display_list_.empty())
+    return;
+  GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kRequestCanvasPaint, nullptr, bindingObject(),
+                                                       display_list_.Release(), true);
+}
+
+void CanvasRenderingContext2D::Record(CanvasOp op,
+                                      std::initializer_list<double> args,
+                                      const std::vector<double>& trailing_args) {
+  display_list_.Record(op, args, trailing_args);
+  requestPaint();
+  if (display_list_.size() >= CanvasDisplayList::kMaxOps) {
+    FlushDisplayList();
+  }
 }
 
 void CanvasRenderingContext2D::roundRect_async(double x,
@@ -1326,18 +1250,11 @@ void CanvasRenderingContext2D::roundRect_async(double x,
     radii_vector.assign(radii_sequence.begin(), radii_sequence.end());
   }
 
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeDouble>::ToNativeValue(x),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(y),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(w),
-                             NativeValueConverter<NativeTypeDouble>::ToNativeValue(h),
-                             NativeValueConverter<NativeTypeArray<NativeTypeDouble>>::ToNativeValue(radii_vector)};
-
-  InvokeBindingMethodAsync(binding_call_methods::kroundRect, sizeof(arguments) / sizeof(NativeValue), arguments,
-                           exception_state);
+  Record(CanvasOp::kRoundRect, {x, y, w, h}, radii_vector);
 }
 
 void CanvasRenderingContext2D::fill(webf::ExceptionState& exception_state) {
-  InvokeBindingMethodAsync(binding_call_methods::kfill, 0, nullptr, exception_state);
+  Record(CanvasOp::kFill, {});
 }
 
 void CanvasRenderingContext2D::fill(std::shared_ptr<const QJSUnionPath2DDomString> pathOrPattern,
@@ -1367,29 +1284,17 @@ void CanvasRenderingContext2D::fill(std::shared_ptr<const QJSUnionPath2DDomStrin
 }
 
 void CanvasRenderingContext2D::Trace(GCVisitor* visitor) const {
-  if (fill_style_ != nullptr)
-    fill_style_->Trace(visitor);
-  if (stroke_style_ != nullptr)
-    stroke_style_->Trace(visitor);
-}
-
-void CanvasRenderingContext2D::ClearPropertyCaches() {
-  global_alpha_cache_.reset();
-  global_composite_operation_cache_.reset();
-  line_dash_segments_.clear();
-  direction_cache_.reset();
-  font_cache_.reset();
-  line_cap_cache_.reset();
-  line_dash_offset_cache_.reset();
-  line_join_cache_.reset();
-  line_width_cache_.reset();
-  miter_limit_cache_.reset();
-  text_align_cache_.reset();
-  text_baseline_cache_.reset();
-  shadow_offset_x_cache_.reset();
-  shadow_offset_y_cache_.reset();
-  shadow_blur_cache_.reset();
-  shadow_color_cache_.reset();
+  state_.Trace(visitor);
+  for (const auto& saved : saved_states_) {
+    saved.Trace(visitor);
+  }
+}
+
+void CanvasRenderingContext2D::ResetDrawingState() {
+  state_ = DefaultDrawingState();
+  saved_states_.clear();
+  // Calls not yet submitted drew into the bitmap being cleared.
+  display_list_.Clear();
 }
 
 }  // namespace webf
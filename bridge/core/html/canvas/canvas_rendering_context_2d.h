@@ -12,6 +12,7 @@
 #include <optional>
 
 #include "bindings/qjs/script_value.h"
+#include "canvas_display_list.h"
 #include "canvas_gradient.h"
 #include "canvas_pattern.h"
 #include "canvas_rendering_context.h"
@@ -256,31 +257,53 @@ class CanvasRenderingContext2D : public CanvasRenderingContext {
 
   void requestPaint() const;
   void needsPaint() const;
+  // Submits the calls recorded since the last submit ahead of any other
+  // command for this context, so Dart sees them in call order.
+  void FlushDisplayList() const;
+
+  // Returns the drawing state to its defaults and drops the save() stack, as
+  // happens on reset() and when the canvas bitmap is resized.
+  void ResetDrawingState();
 
   void Trace(GCVisitor* visitor) const override;
 
  private:
-  void ClearPropertyCaches();
+  // The canvas drawing state, mirrored from what JS sets so that attribute
+  // getters are answered locally instead of round-tripping to Dart. save()
+  // and restore() push and pop it like the Dart-side state stack does.
+  struct DrawingState {
+    std::shared_ptr<QJSUnionDomStringCanvasGradientCanvasPattern> fill_style;
+    std::shared_ptr<QJSUnionDomStringCanvasGradientCanvasPattern> stroke_style;
+    std::vector<double> line_dash;
+    double global_alpha = 1;
+    AtomicString global_composite_operation;
+    AtomicString direction;
+    AtomicString font;
+    AtomicString line_cap;
+    double line_dash_offset = 0;
+    AtomicString line_join;
+    double line_width = 1;
+    double miter_limit = 10;
+    AtomicString text_align;
+    AtomicString text_baseline;
+    double shadow_offset_x = 0;
+    double shadow_offset_y = 0;
+    double shadow_blur = 0;
+    AtomicString shadow_color;
+
+    void Trace(GCVisitor* visitor) const;
+  };
+
+  static DrawingState DefaultDrawingState();
+
+  // Numeric-only calls are recorded instead of sent one by one, and reach
+  // Dart as a single kRequestCanvasPaint per frame.
+  void Record(CanvasOp op, std::initializer_list<double> args, const std::vector<double>& trailing_args = {});
 
   mutable bool _needsPaint = false;
-  std::shared_ptr<QJSUnionDomStringCanvasGradientCanvasPattern> fill_style_ = nullptr;
-  std::shared_ptr<QJSUnionDomStringCanvasGradientCanvasPattern> stroke_style_ = nullptr;
-  std::vector<double> line_dash_segments_;
-  std::optional<double> global_alpha_cache_;
-  std::optional<AtomicString> global_composite_operation_cache_;
-  std::optional<AtomicString> direction_cache_;
-  std::optional<AtomicString> font_cache_;
-  std::optional<AtomicString> line_cap_cache_;
-  std::optional<double> line_dash_offset_cache_;
-  std::optional<AtomicString> line_join_cache_;
-  std::optional<double> line_width_cache_;
-  std::optional<double> miter_limit_cache_;
-  std::optional<AtomicString> text_align_cache_;
-  std::optional<AtomicString> text_baseline_cache_;
-  std::optional<double> shadow_offset_x_cache_;
-  std::optional<double> shadow_offset_y_cache_;
-  std::optional<double> shadow_blur_cache_;
-  std::optional<AtomicString> shadow_color_cache_;
+  mutable CanvasDisplayList display_list_;
+  DrawingState state_;
+  std::vector<DrawingState> saved_states_;
 };
 
 template <>
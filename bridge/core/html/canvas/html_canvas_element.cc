@@ -19,6 +19,15 @@ namespace webf {
 HTMLCanvasElement::HTMLCanvasElement(Document& document) : HTMLElement(html_names::kCanvas, &document) {}
 
 CanvasRenderingContext2D* HTMLCanvasElement::getContext(const AtomicString& type, ExceptionState& exception_state) {
+  // A canvas has a single 2D context. Returning the existing wrapper keeps its
+  // mirrored drawing state and skips the synchronous call into Dart.
+  if (type == canvas_types::k2d) {
+    for (auto&& context : running_context_2ds_) {
+      if (context->IsCanvas2d())
+        return static_cast<CanvasRenderingContext2D*>(context.Get());
+    }
+  }
+
   NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), type)};
   NativeValue value = InvokeBindingMethod(binding_call_methods::kgetContext, 1, arguments,
                                           FlushUICommandReason::kDependentsOnElement, exception_state);
@@ -38,6 +47,75 @@ CanvasRenderingContext2D* HTMLCanvasElement::getContext(const AtomicString& type
   return nullptr;
 }
 
+int64_t HTMLCanvasElement::width() const {
+  ExceptionState exception_state;
+  NativeValue native_value =
+      GetBindingProperty(binding_call_methods::kwidth, FlushUICommandReason::kDependentsOnElement, exception_state);
+  return NativeValueConverter<NativeTypeInt64>::FromNativeValue(native_value);
+}
+
+void HTMLCanvasElement::setWidth(int64_t value, ExceptionState& exception_state) {
+  SetBindingProperty(binding_call_methods::kwidth, NativeValueConverter<NativeTypeInt64>::ToNativeValue(value),
+                     exception_state);
+  ResetRenderingContexts();
+}
+
+ScriptPromise HTMLCanvasElement::width_async(ExceptionState& exception_state) {
+  return GetBindingPropertyAsync(binding_call_methods::kwidth, exception_state);
+}
+
+void HTMLCanvasElement::setWidth_async(int64_t value, ExceptionState& exception_state) {
+  SetBindingPropertyAsync(binding_call_methods::kwidth, NativeValueConverter<NativeTypeInt64>::ToNativeValue(value),
+                          exception_state);
+  ResetRenderingContexts();
+}
+
+int64_t HTMLCanvasElement::height() const {
+  ExceptionState exception_state;
+  NativeValue native_value =
+      GetBindingProperty(binding_call_methods::kheight, FlushUICommandReason::kDependentsOnElement, exception_state);
+  return NativeValueConverter<NativeTypeInt64>::FromNativeValue(native_value);
+}
+
+void HTMLCanvasElement::setHeight(int64_t value, ExceptionState& exception_state) {
+  SetBindingProperty(binding_call_methods::kheight, NativeValueConverter<NativeTypeInt64>::ToNativeValue(value),
+                     exception_state);
+  ResetRenderingContexts();
+}
+
+ScriptPromise HTMLCanvasElement::height_async(ExceptionState& exception_state) {
+  return GetBindingPropertyAsync(binding_call_methods::kheight, exception_state);
+}
+
+void HTMLCanvasElement::setHeight_async(int64_t value, ExceptionState& exception_state) {
+  SetBindingPropertyAsync(binding_call_methods::kheight, NativeValueConverter<NativeTypeInt64>::ToNativeValue(value),
+                          exception_state);
+  ResetRenderingContexts();
+}
+
+void HTMLCanvasElement::AttributeChanged(const AttributeModificationParams& params) {
+  HTMLElement::AttributeChanged(params);
+  if (params.name == html_names::kWidthAttr || params.name == html_names::kHeightAttr) {
+    ResetRenderingContexts();
+  }
+}
+
+void HTMLCanvasElement::ResetRenderingContexts() {
+  for (auto&& context : running_context_2ds_) {
+    if (context->IsCanvas2d()) {
+      static_cast<CanvasRenderingContext2D*>(context.Get())->ResetDrawingState();
+    }
+  }
+}
+
+void HTMLCanvasElement::FlushRenderingContexts() const {
+  for (auto&& context : running_context_2ds_) {
+    if (context->IsCanvas2d()) {
+      static_cast<CanvasRenderingContext2D*>(context.Get())->FlushDisplayList();
+    }
+  }
+}
+
 void HTMLCanvasElement::Trace(GCVisitor* visitor) const {
   for (auto&& context : running_context_2ds_) {
     visitor->TraceMember(context);
@@ -25,6 +25,23 @@ class HTMLCanvasElement : public HTMLElement {
 
   CanvasRenderingContext2D* getContext(const AtomicString& type, ExceptionState& exception_state);
 
+  // Setting either dimension resets the bitmap and every 2D context's drawing
+  // state on the Dart side, so the mirrored state is reset here as well.
+  int64_t width() const;
+  void setWidth(int64_t value, ExceptionState& exception_state);
+  ScriptPromise width_async(ExceptionState& exception_state);
+  void setWidth_async(int64_t value, ExceptionState& exception_state);
+  int64_t height() const;
+  void setHeight(int64_t value, ExceptionState& exception_state);
+  ScriptPromise height_async(ExceptionState& exception_state);
+  void setHeight_async(int64_t value, ExceptionState& exception_state);
+
+  void AttributeChanged(const AttributeModificationParams& params) override;
+
+  // Submits the calls recorded by this canvas's 2D contexts, so that a sync
+  // read of the canvas on the Dart side sees everything script drew.
+  void FlushRenderingContexts() const;
+
   void Trace(GCVisitor* visitor) const override;
 
   std::vector<Member<CanvasRenderingContext>> running_context_2ds_;
@@ -32,6 +49,7 @@ class HTMLCanvasElement : public HTMLElement {
   const HTMLCanvasElementPublicMethods* htmlCanvasElementPublicMethods();
 
  private:
+  void ResetRenderingContexts();
 };
 
 }  // namespace webf
@@ -27,12 +27,12 @@ bool IsPseudoStateProperty(const AtomicString& name) {
   if (name.IsNull()) {
     return false;
   }
-  static const AtomicString kChecked = AtomicString::CreateFromUTF8("checked");
-  static const AtomicString kSelected = AtomicString::CreateFromUTF8("selected");
-  static const AtomicString kDisabled = AtomicString::CreateFromUTF8("disabled");
-  static const AtomicString kRequired = AtomicString::CreateFromUTF8("required");
-  static const AtomicString kValue = AtomicString::CreateFromUTF8("value");
-  static const AtomicString kType = AtomicString::CreateFromUTF8("type");
+  static const AtomicString kChecked = AtomicString::CreateStatic("checked");
+  static const AtomicString kSelected = AtomicString::CreateStatic("selected");
+  static const AtomicString kDisabled = AtomicString::CreateStatic("disabled");
+  static const AtomicString kRequired = AtomicString::CreateStatic("required");
+  static const AtomicString kValue = AtomicString::CreateStatic("value");
+  static const AtomicString kType = AtomicString::CreateStatic("type");
   return name == kChecked || name == kSelected || name == kDisabled || name == kRequired || name == kValue ||
          name == kType;
 }
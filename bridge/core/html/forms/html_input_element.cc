@@ -7,6 +7,7 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 #include "html_input_element.h"
+#include "binding_call_methods.h"
 #include "bindings/qjs/cppgc/mutation_scope.h"
 #include "foundation/native_value_converter.h"
 #include "html_names.h"
@@ -25,8 +26,7 @@ NativeValue HTMLInputElement::HandleCallFromDartSide(const AtomicString& method,
   }
   MemberMutationScope mutation_scope{GetExecutingContext()};
 
-  static const AtomicString kSyncChecked = AtomicString::CreateFromUTF8("__syncCheckedState");
-  if (method == kSyncChecked) {
+  if (method == binding_call_methods::k__syncCheckedState) {
     if (argc < 1) {
       return Native_NewNull();
     }
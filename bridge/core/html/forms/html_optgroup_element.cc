@@ -13,12 +13,12 @@ namespace webf {
 namespace {
 
 static const AtomicString& OptGroupTagName() {
-  static const AtomicString kOptGroup = AtomicString::CreateFromUTF8("optgroup");
+  static const AtomicString kOptGroup = AtomicString::CreateStatic("optgroup");
   return kOptGroup;
 }
 
 static const AtomicString& DisabledAttrName() {
-  static const AtomicString kDisabled = AtomicString::CreateFromUTF8("disabled");
+  static const AtomicString kDisabled = AtomicString::CreateStatic("disabled");
   return kDisabled;
 }
 
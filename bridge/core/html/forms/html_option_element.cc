@@ -16,27 +16,27 @@ namespace webf {
 namespace {
 
 static const AtomicString& SelectTagName() {
-  static const AtomicString kSelect = AtomicString::CreateFromUTF8("select");
+  static const AtomicString kSelect = AtomicString::CreateStatic("select");
   return kSelect;
 }
 static const AtomicString& OptionTagName() {
-  static const AtomicString kOption = AtomicString::CreateFromUTF8("option");
+  static const AtomicString kOption = AtomicString::CreateStatic("option");
   return kOption;
 }
 static const AtomicString& MultipleAttrName() {
-  static const AtomicString kMultiple = AtomicString::CreateFromUTF8("multiple");
+  static const AtomicString kMultiple = AtomicString::CreateStatic("multiple");
   return kMultiple;
 }
 static const AtomicString& ValueAttrName() {
-  static const AtomicString kValue = AtomicString::CreateFromUTF8("value");
+  static const AtomicString kValue = AtomicString::CreateStatic("value");
   return kValue;
 }
 static const AtomicString& SelectedAttrName() {
-  static const AtomicString kSelected = AtomicString::CreateFromUTF8("selected");
+  static const AtomicString kSelected = AtomicString::CreateStatic("selected");
   return kSelected;
 }
 static const AtomicString& DisabledAttrName() {
-  static const AtomicString kDisabled = AtomicString::CreateFromUTF8("disabled");
+  static const AtomicString kDisabled = AtomicString::CreateStatic("disabled");
   return kDisabled;
 }
 
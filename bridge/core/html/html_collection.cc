@@ -197,7 +197,7 @@ inline bool HTMLCollection::ElementMatches(const Element& element) const {
     case kNodeChildren:
       return true;
     case kSelectOptions: {
-      static const AtomicString kOption = AtomicString::CreateFromUTF8("option");
+      static const AtomicString kOption = AtomicString::CreateStatic("option");
       return element.HasTagName(kOption);
     }
     default:
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "html_document_parser.h"
+
+#include <cstring>
+
+#include "bindings/qjs/cppgc/mutation_scope.h"
+#include "core/dom/comment.h"
+#include "core/dom/document.h"
+#include "core/dom/element.h"
+#include "core/dom/text.h"
+#include "core/executing_context.h"
+#include "core/html/html_script_element.h"
+#include "element_namespace_uris.h"
+#include "foundation/logging.h"
+#include "html_names.h"
+#include "html_parser.h"
+
+// Defined in gumbo-parser/src/parser.c but not exported by gumbo.h.
+extern "C" void gumbo_destroy_node(GumboOptions* options, GumboNode* node);
+
+namespace webf {
+
+static bool IsBlank(const char* code, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    if (code[i] != ' ')
+      return false;
+  }
+  return true;
+}
+
+// Removes the slots of |node| cleared for children that were already built
+// and freed; Gumbo does not expect null children.
+static void DropBuiltChildren(GumboNode* node) {
+  GumboVector* children = &node->v.element.children;
+  unsigned int length = 0;
+  for (unsigned int i = 0; i < children->length; i++) {
+    if (children->data[i] != nullptr) {
+      children->data[length++] = children->data[i];
+    }
+  }
+  children->length = length;
+}
+
+HTMLDocumentParser::HTMLDocumentParser(ContainerNode* root) : root_(root), options_(kGumboDefaultOptions) {}
+
+HTMLDocumentParser::~HTMLDocumentParser() {
+  UnpinOpenElements();
+  // Stopped half way: only the open elements hold cleared slots.
+  for (Frame& frame : stack_) {
+    DropBuiltChildren(frame.node);
+  }
+  stack_.clear();
+  ReleaseTree();
+}
+
+bool HTMLDocumentParser::Parse(const char* code, size_t length) {
+  assert(output_ == nullptr);
+  ExecutingContext* context = root_->GetExecutingContext();
+  MemberMutationScope scope{context};
+  root_->RemoveChildren();
+
+  if (IsBlank(code, length)) {
+    return false;
+  }
+
+  output_ = gumbo_parse_with_options(&options_, code, length);
+  if (output_ == nullptr) {
+    ExceptionState exception_state;
+    exception_state.ThrowException(context->ctx(), ErrorType::TypeError, "Failed to parse HTML: Invalid HTML content");
+    context->HandleException(exception_state);
+    return false;
+  }
+
+  GumboNode* html = output_->root;
+  auto* root_element = DynamicTo<Element>(root_);
+  if (root_element != nullptr && root_element->localName() == html_names::kHtml) {
+    HTMLParser::parseProperty(root_element, &html->v.element);
+  }
+  root_->ParserFinishedBuildingDocumentFragment();
+
+  stack_.push_back(Frame{root_, html, 0});
+  return true;
+}
+
+bool HTMLDocumentParser::Build(Clock::time_point deadline) {
+  if (stack_.empty()) {
+    return true;
+  }
+
+  UnpinOpenElements();
+  MemberMutationScope scope{root_->GetExecutingContext()};
+  int nodes = 0;
+  while (!stack_.empty()) {
+    if (++nodes % kNodesPerDeadlineCheck == 0 && Clock::now() >= deadline) {
+      PinOpenElements();
+      return false;
+    }
+
+    Frame& frame = stack_.back();
+    GumboVector* children = &frame.node->v.element.children;
+    if (frame.next_child >= children->length) {
+      PopFrame();
+      continue;
+    }
+
+    unsigned int index = frame.next_child++;
+    auto* child = static_cast<GumboNode*>(children->data[index]);
+    if (child == nullptr) {
+      continue;
+    }
+    // May push a frame for |child|, invalidating |frame|.
+    AppendChild(frame.parent, child);
+    // Elements are freed by PopFrame() once their own children are built.
+    if (child->type != GUMBO_NODE_ELEMENT) {
+      gumbo_destroy_node(&options_, child);
+      children->data[index] = nullptr;
+    }
+  }
+
+  ReleaseTree();
+  return true;
+}
+
+void HTMLDocumentParser::AppendChild(ContainerNode* parent, GumboNode* child) {
+  ExecutingContext* context = parent->GetExecutingContext();
+  Document* document = context->document();
+  ExceptionState exception_state;
+
+  switch (child->type) {
+    case GUMBO_NODE_ELEMENT: {
+      AtomicString tag_name = HTMLParser::tagNameOf(child->v.element);
+      if (tag_name.IsEmpty()) {
+        WEBF_LOG(WARN) << "Skipping element with empty tag name";
+        return;
+      }
+
+      Element* element;
+      if (child->v.element.tag_namespace == GUMBO_NAMESPACE_SVG) {
+        element = document->createElementNS(element_namespace_uris::ksvg, tag_name, exception_state);
+      } else {
+        element = document->createElement(tag_name, exception_state);
+      }
+      if (exception_state.HasException()) {
+        context->HandleException(exception_state);
+        WEBF_LOG(ERROR) << "Failed to create element: " << tag_name.ToUTF8String();
+        return;
+      }
+      if (element == nullptr) {
+        WEBF_LOG(ERROR) << "Failed to create element (null): " << tag_name.ToUTF8String();
+        return;
+      }
+
+      HTMLParser::parseProperty(element, &child->v.element);
+      element->BeginParsingChildren();
+      if (IsA<HTMLScriptElement>(element)) {
+        stack_.push_back(Frame{element, child, 0, parent});
+        return;
+      }
+      parent->AppendChild(element);
+      stack_.push_back(Frame{element, child, 0});
+      return;
+    }
+    case GUMBO_NODE_TEXT:
+    case GUMBO_NODE_WHITESPACE:
+    case GUMBO_NODE_CDATA: {
+      const char* data = child->v.text.text;
+      if (data == nullptr) {
+        return;
+      }
+      auto* text = document->createTextNode(AtomicString::CreateFromUTF8(data, strlen(data)), exception_state);
+      if (exception_state.HasException()) {
+        context->HandleException(exception_state);
+      } else if (text != nullptr) {
+        parent->AppendChild(text);
+      }
+      return;
+    }
+    case GUMBO_NODE_COMMENT: {
+      // Svelte and other frameworks use comments as insertion anchors.
+      const char* data = child->v.text.text;
+      auto* comment = document->createComment(AtomicString::CreateFromUTF8(data ? data : ""), exception_state);
+      if (exception_state.HasException()) {
+        context->HandleException(exception_state);
+      } else if (comment != nullptr) {
+        parent->AppendChild(comment);
+      }
+      return;
+    }
+    default:
+      return;
+  }
+}
+
+void HTMLDocumentParser::PopFrame() {
+  Frame frame = stack_.back();
+  stack_.pop_back();
+
+  if (frame.parent != root_) {
+    To<Element>(frame.parent)->FinishParsingChildren();
+  }
+  if (frame.attach_to != nullptr) {
+    frame.attach_to->AppendChild(frame.parent);
+  }
+
+  DropBuiltChildren(frame.node);
+  // The root <html> node is owned by |output_| and freed with it.
+  if (stack_.empty()) {
+    return;
+  }
+  gumbo_destroy_node(&options_, frame.node);
+  Frame& parent_frame = stack_.back();
+  parent_frame.node->v.element.children.data[parent_frame.next_child - 1] = nullptr;
+}
+
+void HTMLDocumentParser::PinOpenElements() {
+  // Scripts running between slices may detach an element that still has
+  // children to come.
+  for (Frame& frame : stack_) {
+    frame.parent->KeepAlive();
+  }
+  pinned_ = true;
+}
+
+void HTMLDocumentParser::UnpinOpenElements() {
+  if (!pinned_) {
+    return;
+  }
+  for (Frame& frame : stack_) {
+    frame.parent->ReleaseAlive();
+  }
+  pinned_ = false;
+}
+
+void HTMLDocumentParser::ReleaseTree() {
+  if (output_ == nullptr) {
+    return;
+  }
+  gumbo_destroy_output(&options_, output_);
+  output_ = nullptr;
+}
+
+}  // namespace webf
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_HTML_PARSER_HTML_DOCUMENT_PARSER_H_
+#define WEBF_CORE_HTML_PARSER_HTML_DOCUMENT_PARSER_H_
+
+#include <third_party/gumbo-parser/src/gumbo.h>
+#include <chrono>
+#include <vector>
+
+namespace webf {
+
+class ContainerNode;
+
+// Builds a whole document from HTML in slices, so that a large page does not
+// hold the JS thread until its last node exists.
+//
+// Nodes are attached to the document as soon as they are created, parents
+// before their children, so styles and UI commands flushed between slices
+// already describe the top of the page. Scripts are the exception: Dart runs
+// an inline script when it is connected, so a <script> is attached only once
+// its text is in place, as its end tag would run it in a browser. Each Gumbo node is freed as soon as
+// its DOM counterpart is complete; the parse tree shrinks while the DOM grows
+// instead of both staying alive until the end.
+//
+// Gumbo has no incremental tokenizer, so Parse() tokenizes the whole input in
+// one go; only DOM construction is sliced.
+class HTMLDocumentParser {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // How long one Build() slice may run when the caller yields between slices.
+  static constexpr std::chrono::milliseconds kSliceBudget{8};
+
+  explicit HTMLDocumentParser(ContainerNode* root);
+  ~HTMLDocumentParser();
+  HTMLDocumentParser(const HTMLDocumentParser&) = delete;
+  HTMLDocumentParser& operator=(const HTMLDocumentParser&) = delete;
+
+  // Replaces the children of the root with the document in |code|. Gumbo
+  // keeps pointers into |code|, which must outlive the parser. Returns false
+  // if there is nothing to build.
+  bool Parse(const char* code, size_t length);
+
+  // Appends nodes until the document is complete or |deadline| has passed.
+  // Returns true once the whole document is built.
+  bool Build(Clock::time_point deadline);
+  bool Build() { return Build(Clock::time_point::max()); }
+
+  bool IsFinished() const { return stack_.empty(); }
+
+ private:
+  // An element whose Gumbo children are still being appended.
+  struct Frame {
+    ContainerNode* parent;
+    GumboNode* node;
+    unsigned int next_child;
+    // Where |parent| goes once its children are built, for elements that
+    // must not be connected while still empty.
+    ContainerNode* attach_to{nullptr};
+  };
+
+  // Checking the clock after every node costs more than most nodes do.
+  static constexpr int kNodesPerDeadlineCheck = 32;
+
+  void AppendChild(ContainerNode* parent, GumboNode* child);
+  void PopFrame();
+  void PinOpenElements();
+  void UnpinOpenElements();
+  void ReleaseTree();
+
+  ContainerNode* root_;
+  GumboOptions options_;
+  GumboOutput* output_{nullptr};
+  std::vector<Frame> stack_;
+  bool pinned_{false};
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_HTML_PARSER_HTML_DOCUMENT_PARSER_H_
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "html_document_parser.h"
+
+#include "core/dom/document.h"
+#include "core/html/html_body_element.h"
+#include "core/html/html_html_element.h"
+#include "core/html/html_script_element.h"
+#include "foundation/ui_command_buffer.h"
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+namespace {
+
+std::string ListDocument(int items) {
+  std::string html = "<html lang=\"en\"><head><title>list</title></head><body><ul>";
+  for (int i = 0; i < items; i++) {
+    html += "<li class=\"item\"><span>" + std::to_string(i) + "</span></li>";
+  }
+  html += "</ul><p>tail</p></body></html>";
+  return html;
+}
+
+}  // namespace
+
+TEST(HTMLDocumentParser, BuildsInSlicesWithPartialDocumentAttached) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  Document* document = context->document();
+  std::string html = ListDocument(200);
+
+  HTMLDocumentParser parser(document->documentElement());
+  ASSERT_TRUE(parser.Parse(html.c_str(), html.length()));
+  EXPECT_EQ(document->documentElement()->getAttribute(AtomicString("lang"), ASSERT_NO_EXCEPTION()),
+            AtomicString("en"));
+
+  // A deadline in the past still builds one batch of nodes per call.
+  EXPECT_FALSE(parser.Build(HTMLDocumentParser::Clock::now()));
+  ASSERT_NE(document->body(), nullptr);
+  auto* list = To<ContainerNode>(document->body()->firstChild());
+  ASSERT_NE(list, nullptr);
+  unsigned built = list->CountChildren();
+  EXPECT_GT(built, 0u);
+  EXPECT_LT(built, 200u);
+
+  int slices = 1;
+  while (!parser.Build(HTMLDocumentParser::Clock::now())) {
+    slices++;
+  }
+  EXPECT_GT(slices, 2);
+  EXPECT_TRUE(parser.IsFinished());
+  EXPECT_EQ(list->CountChildren(), 200u);
+  EXPECT_EQ(document->body()->CountChildren(), 2u);
+  EXPECT_TRUE(To<Element>(list)->IsFinishedParsingChildren());
+}
+
+TEST(HTMLDocumentParser, StopsHalfWay) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  Document* document = context->document();
+  std::string html = ListDocument(200);
+
+  {
+    HTMLDocumentParser parser(document->documentElement());
+    ASSERT_TRUE(parser.Parse(html.c_str(), html.length()));
+    EXPECT_FALSE(parser.Build(HTMLDocumentParser::Clock::now()));
+    EXPECT_FALSE(parser.Build(HTMLDocumentParser::Clock::now()));
+  }
+
+  // The partial document stays; parsing again replaces it.
+  ASSERT_NE(document->body(), nullptr);
+  HTMLDocumentParser parser(document->documentElement());
+  ASSERT_TRUE(parser.Parse(html.c_str(), html.length()));
+  EXPECT_TRUE(parser.Build());
+  EXPECT_EQ(To<ContainerNode>(document->body()->firstChild())->CountChildren(), 200u);
+}
+
+TEST(HTMLDocumentParser, BlankInputClearsDocument) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  Document* document = context->document();
+
+  HTMLDocumentParser parser(document->documentElement());
+  EXPECT_FALSE(parser.Parse("   ", 3));
+  EXPECT_TRUE(parser.IsFinished());
+  EXPECT_EQ(document->documentElement()->CountChildren(), 0u);
+}
+
+TEST(HTMLDocumentParser, InlineScriptIsConnectedWithItsText) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  Document* document = context->document();
+  std::string html = "<html><head></head><body><script>globalThis.ran = true;</script><p>after</p></body></html>";
+
+  context->uiCommandBuffer()->clear();
+  HTMLDocumentParser parser(document->documentElement());
+  ASSERT_TRUE(parser.Parse(html.c_str(), html.length()));
+  EXPECT_TRUE(parser.Build());
+
+  auto* script = DynamicTo<HTMLScriptElement>(document->body()->firstChild());
+  ASSERT_NE(script, nullptr);
+  EXPECT_EQ(script->textContent(), AtomicString("globalThis.ran = true;"));
+  EXPECT_TRUE(IsA<Element>(script->nextSibling()));
+
+  // Dart queues an inline script for execution when the script is connected,
+  // and skips it if it has no children yet. Its text must reach Dart first.
+  context->uiCommandBuffer()->SyncAllPackages();
+  auto* pack = static_cast<UICommandBufferPack*>(context->uiCommandBuffer()->data());
+  auto* items = static_cast<UICommandItem*>(pack->data);
+  auto script_ptr = reinterpret_cast<int64_t>(script->bindingObject());
+  int64_t text_inserted = -1;
+  int64_t script_inserted = -1;
+  for (int64_t i = 0; i < pack->length; i++) {
+    if (items[i].type != static_cast<int32_t>(UICommand::kInsertAdjacentNode)) {
+      continue;
+    }
+    if (items[i].nativePtr == script_ptr) {
+      text_inserted = i;
+    } else if (items[i].nativePtr2 == script_ptr) {
+      script_inserted = i;
+    }
+  }
+  ASSERT_NE(text_inserted, -1);
+  ASSERT_NE(script_inserted, -1);
+  EXPECT_LT(text_inserted, script_inserted);
+}
@@ -7,6 +7,11 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 
+#include <array>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 
 #include "core/dom/document.h"
@@ -19,6 +24,7 @@
 #include "foundation/logging.h"
 #include "gumbo-parser/src/error.h"
 #include "html_names.h"
+#include "html_document_parser.h"
 #include "html_parser.h"
 
 namespace webf {
@@ -30,12 +36,6 @@ std::string trim(const std::string& str) {
   return tmp;
 }
 
-// Parse html,isHTMLFragment should be false if you need to automatically complete html, head, and body when they are
-// missing.
-static GumboOutput* parseDocument(const std::string& html) {
-  return gumbo_parse_with_options(&kGumboDefaultOptions, html.c_str(), html.length());
-}
-
 static GumboOutput* parseFragment(const std::string& html, GumboTag fragment_context) {
   GumboOptions options = kGumboDefaultOptions;
   options.fragment_context = fragment_context;
@@ -136,17 +136,10 @@ bool HTMLParser::traverseHTML(Node* root_node, GumboNode* node) {
       }
 
       if (child->type == GUMBO_NODE_ELEMENT) {
-        std::string tagName;
-        if (child->v.element.tag != GUMBO_TAG_UNKNOWN) {
-          tagName = gumbo_normalized_tagname(child->v.element.tag);
-        } else {
-          GumboStringPiece piece = child->v.element.original_tag;
-          gumbo_tag_from_original_text(&piece);
-          tagName = std::string(piece.data, piece.length);
-        }
+        AtomicString tagName = tagNameOf(child->v.element);
 
         // Skip empty tag names
-        if (tagName.empty()) {
+        if (tagName.IsEmpty()) {
           WEBF_LOG(WARN) << "Skipping element with empty tag name";
           continue;
         }
@@ -156,23 +149,23 @@ bool HTMLParser::traverseHTML(Node* root_node, GumboNode* node) {
 
         switch (child->v.element.tag_namespace) {
           case ::GUMBO_NAMESPACE_SVG: {
-            element = context->document()->createElementNS(element_namespace_uris::ksvg, AtomicString(tagName),
+            element = context->document()->createElementNS(element_namespace_uris::ksvg, tagName,
                                                            exception_state);
             break;
           }
           default: {
-            element = context->document()->createElement(AtomicString(tagName), exception_state);
+            element = context->document()->createElement(tagName, exception_state);
           }
         }
 
         if (exception_state.HasException()) {
           context->HandleException(exception_state);
-          WEBF_LOG(ERROR) << "Failed to create element: " << tagName;
+          WEBF_LOG(ERROR) << "Failed to create element: " << tagName.ToUTF8String();
           continue; // Continue processing other elements
         }
 
         if (element == nullptr) {
-          WEBF_LOG(ERROR) << "Failed to create element (null): " << tagName;
+          WEBF_LOG(ERROR) << "Failed to create element (null): " << tagName.ToUTF8String();
           continue;
         }
 
@@ -187,7 +180,7 @@ bool HTMLParser::traverseHTML(Node* root_node, GumboNode* node) {
         // Recursively traverse children
         if (!traverseHTML(element, child)) {
           // Log but continue processing other children
-          WEBF_LOG(WARN) << "Failed to traverse child element: " << tagName;
+          WEBF_LOG(WARN) << "Failed to traverse child element: " << tagName.ToUTF8String();
         }
 
         // Append child
@@ -200,7 +193,8 @@ bool HTMLParser::traverseHTML(Node* root_node, GumboNode* node) {
         const char* text_content = child->v.text.text;
         if (text_content != nullptr) {
           ExceptionState exception_state;
-          auto* text = context->document()->createTextNode(AtomicString::CreateFromUTF8(text_content), exception_state);
+          auto* text = context->document()->createTextNode(
+              AtomicString::CreateFromUTF8(text_content, strlen(text_content)), exception_state);
           if (!exception_state.HasException() && text != nullptr) {
             root_container->AppendChild(text);
           } else if (exception_state.HasException()) {
@@ -224,7 +218,8 @@ bool HTMLParser::traverseHTML(Node* root_node, GumboNode* node) {
         const char* cdata_content = child->v.text.text;
         if (cdata_content != nullptr) {
           ExceptionState exception_state;
-          auto* text = context->document()->createTextNode(AtomicString::CreateFromUTF8(cdata_content), exception_state);
+          auto* text = context->document()->createTextNode(
+              AtomicString::CreateFromUTF8(cdata_content, strlen(cdata_content)), exception_state);
           if (!exception_state.HasException() && text != nullptr) {
             root_container->AppendChild(text);
           } else if (exception_state.HasException()) {
@@ -239,7 +234,7 @@ bool HTMLParser::traverseHTML(Node* root_node, GumboNode* node) {
   return true;
 }
 
-bool HTMLParser::parseHTML(const std::string& html, Node* root_node, bool isHTMLFragment) {
+bool HTMLParser::parseFragmentHTML(const std::string& html, Node* root_node) {
   if (root_node == nullptr) {
     WEBF_LOG(ERROR) << "Root node is null.";
     return false;
@@ -272,12 +267,7 @@ bool HTMLParser::parseHTML(const std::string& html, Node* root_node, bool isHTML
   }
 
   // Parse HTML with Gumbo - it has built-in error recovery.
-  GumboOutput* htmlTree = nullptr;
-  if (isHTMLFragment) {
-    htmlTree = parseFragment(html, fragmentContextFor(root_node));
-  } else {
-    htmlTree = parseDocument(html);
-  }
+  GumboOutput* htmlTree = parseFragment(html, fragmentContextFor(root_node));
   if (htmlTree == nullptr) {
     ExceptionState exception_state;
     exception_state.ThrowException(context->ctx(), ErrorType::TypeError, "Failed to parse HTML: Invalid HTML content");
@@ -305,16 +295,9 @@ bool HTMLParser::parseHTML(const std::string& html, Node* root_node, bool isHTML
     }
 
     if (child->type == GUMBO_NODE_ELEMENT) {
-      std::string tagName;
-      if (child->v.element.tag != GUMBO_TAG_UNKNOWN) {
-        tagName = gumbo_normalized_tagname(child->v.element.tag);
-      } else {
-        GumboStringPiece piece = child->v.element.original_tag;
-        gumbo_tag_from_original_text(&piece);
-        tagName = std::string(piece.data, piece.length);
-      }
+      AtomicString tagName = tagNameOf(child->v.element);
 
-      if (tagName.empty()) {
+      if (tagName.IsEmpty()) {
         WEBF_LOG(WARN) << "Skipping element with empty tag name";
         return false;
       }
@@ -324,23 +307,23 @@ bool HTMLParser::parseHTML(const std::string& html, Node* root_node, bool isHTML
 
       switch (child->v.element.tag_namespace) {
         case ::GUMBO_NAMESPACE_SVG: {
-          element = context->document()->createElementNS(element_namespace_uris::ksvg, AtomicString(tagName),
+          element = context->document()->createElementNS(element_namespace_uris::ksvg, tagName,
                                                          exception_state);
           break;
         }
         default: {
-          element = context->document()->createElement(AtomicString(tagName), exception_state);
+          element = context->document()->createElement(tagName, exception_state);
         }
       }
 
       if (exception_state.HasException()) {
         context->HandleException(exception_state);
-        WEBF_LOG(ERROR) << "Failed to create element: " << tagName;
+        WEBF_LOG(ERROR) << "Failed to create element: " << tagName.ToUTF8String();
         return false;
       }
 
       if (element == nullptr) {
-        WEBF_LOG(ERROR) << "Failed to create element (null): " << tagName;
+        WEBF_LOG(ERROR) << "Failed to create element (null): " << tagName.ToUTF8String();
         return false;
       }
 
@@ -350,7 +333,7 @@ bool HTMLParser::parseHTML(const std::string& html, Node* root_node, bool isHTML
 
       element->BeginParsingChildren();
       if (!traverseHTML(element, child)) {
-        WEBF_LOG(WARN) << "Failed to traverse child element: " << tagName;
+        WEBF_LOG(WARN) << "Failed to traverse child element: " << tagName.ToUTF8String();
       }
       parent->AppendChild(element);
       element->FinishParsingChildren();
@@ -363,7 +346,8 @@ bool HTMLParser::parseHTML(const std::string& html, Node* root_node, bool isHTML
         return true;
       }
       ExceptionState exception_state;
-      auto* text = context->document()->createTextNode(AtomicString::CreateFromUTF8(text_content), exception_state);
+      auto* text = context->document()->createTextNode(
+          AtomicString::CreateFromUTF8(text_content, strlen(text_content)), exception_state);
       if (!exception_state.HasException() && text != nullptr) {
         parent->AppendChild(text);
         return true;
@@ -395,7 +379,8 @@ bool HTMLParser::parseHTML(const std::string& html, Node* root_node, bool isHTML
         return true;
       }
       ExceptionState exception_state;
-      auto* text = context->document()->createTextNode(AtomicString::CreateFromUTF8(cdata_content), exception_state);
+      auto* text = context->document()->createTextNode(
+          AtomicString::CreateFromUTF8(cdata_content, strlen(cdata_content)), exception_state);
       if (!exception_state.HasException() && text != nullptr) {
         parent->AppendChild(text);
         return true;
@@ -441,7 +426,7 @@ bool HTMLParser::parseHTML(const std::string& html, Node* root_node, bool isHTML
     return traverseHTML(root_container_node, root);
   };
 
-  bool traverse_result = isHTMLFragment ? traverse_fragment_root(htmlTree->root) : traverseHTML(root_container_node, htmlTree->root);
+  bool traverse_result = traverse_fragment_root(htmlTree->root);
 
   // Free gumbo parse nodes
   gumbo_destroy_output(&kGumboDefaultOptions, htmlTree);
@@ -455,17 +440,26 @@ bool HTMLParser::parseHTML(const std::string& html, Node* root_node, bool isHTML
 }
 
 bool HTMLParser::parseHTML(const std::string& html, Node* root_node) {
-  return parseHTML(html, root_node, false);
+  return parseHTML(html.c_str(), html.length(), root_node);
 }
 
 bool HTMLParser::parseHTML(const char* code, size_t codeLength, Node* root_node) {
-  std::string html = std::string(code, codeLength);
-  return parseHTML(html, root_node, false);
+  auto* root_container_node = DynamicTo<ContainerNode>(root_node);
+  if (root_container_node == nullptr || root_node->GetExecutingContext() == nullptr) {
+    WEBF_LOG(ERROR) << "Invalid root node for parseHTML.";
+    return false;
+  }
+
+  HTMLDocumentParser parser(root_container_node);
+  if (parser.Parse(code, codeLength)) {
+    parser.Build();
+  }
+  return true;
 }
 
 bool HTMLParser::parseHTMLFragment(const char* code, size_t codeLength, Node* rootNode) {
   std::string html = std::string(code, codeLength);
-  return parseHTML(html, rootNode, true);
+  return parseFragmentHTML(html, rootNode);
 }
 
 GumboOutput* HTMLParser::parseSVGResult(const char* code, size_t codeLength) {
@@ -484,17 +478,75 @@ void HTMLParser::freeSVGResult(GumboOutput* svgTree) {
 }
 
 void HTMLParser::parseProperty(Element* element, GumboElement* gumboElement) {
-  auto* context = element->GetExecutingContext();
-  JSContext* ctx = context->ctx();
-
   GumboVector* attributes = &gumboElement->attributes;
   for (int j = 0; j < attributes->length; ++j) {
     auto* attribute = (GumboAttribute*)attributes->data[j];
+    AtomicString value = AtomicString::CreateFromUTF8(attribute->value, strlen(attribute->value));
+    element->setAttribute(attributeNameOf(*attribute), value, ASSERT_NO_EXCEPTION());
+  }
+}
+
+namespace {
+
+constexpr uint16_t kNoNameIndex = std::numeric_limits<uint16_t>::max();
+
+// Index in html_names of the name of every GumboTag. The names are the same on
+// every JS thread, only their atoms are per thread.
+const std::array<uint16_t, GUMBO_TAG_LAST>& GumboTagNameIndices() {
+  static const std::array<uint16_t, GUMBO_TAG_LAST> indices = [] {
+    std::unordered_map<std::string_view, uint16_t> names;
+    for (unsigned i = 0; i < html_names::kNamesCount; i++) {
+      names.emplace(html_names::NameStringAt(i), i);
+    }
+    std::array<uint16_t, GUMBO_TAG_LAST> result;
+    result.fill(kNoNameIndex);
+    for (int tag = 0; tag < GUMBO_TAG_UNKNOWN; tag++) {
+      auto it = names.find(gumbo_normalized_tagname(static_cast<GumboTag>(tag)));
+      if (it != names.end()) {
+        result[tag] = it->second;
+      }
+    }
+    return result;
+  }();
+  return indices;
+}
+
+const std::unordered_map<std::string_view, uint16_t>& HTMLAttributeNameIndices() {
+  static const std::unordered_map<std::string_view, uint16_t> indices = [] {
+    std::unordered_map<std::string_view, uint16_t> result;
+    for (unsigned i = 0; i < html_names::kHtmlAttributeNamesCount; i++) {
+      result.emplace(html_names::HtmlAttributeNameStringAt(i), i);
+    }
+    return result;
+  }();
+  return indices;
+}
+
+}  // namespace
+
+AtomicString HTMLParser::tagNameOf(const GumboElement& gumboElement) {
+  if (gumboElement.tag != GUMBO_TAG_UNKNOWN) {
+    uint16_t index = GumboTagNameIndices()[gumboElement.tag];
+    if (index != kNoNameIndex) {
+      return html_names::NameAt(index);
+    }
+    const char* name = gumbo_normalized_tagname(gumboElement.tag);
+    return AtomicString::CreateFromUTF8(name, strlen(name));
+  }
+
+  GumboStringPiece piece = gumboElement.original_tag;
+  gumbo_tag_from_original_text(&piece);
+  return AtomicString::CreateFromUTF8(piece.data, piece.length);
+}
 
-    std::string strName = attribute->name;
-    std::string strValue = attribute->value;
-    element->setAttribute(AtomicString(strName), AtomicString(strValue), ASSERT_NO_EXCEPTION());
+AtomicString HTMLParser::attributeNameOf(const GumboAttribute& attribute) {
+  std::string_view name(attribute.name);
+  const auto& indices = HTMLAttributeNameIndices();
+  auto it = indices.find(name);
+  if (it != indices.end()) {
+    return html_names::HtmlAttributeNameAt(it->second);
   }
+  return AtomicString::CreateFromUTF8(name.data(), name.length());
 }
 
 }  // namespace webf
@@ -12,6 +12,7 @@
 #include <third_party/gumbo-parser/src/gumbo.h>
 #include <string>
 #include "foundation/native_string.h"
+#include "foundation/string/atomic_string.h"
 
 namespace webf {
 
@@ -31,11 +32,17 @@ class HTMLParser {
   static void freeSVGResult(GumboOutput* svgTree);
 
  private:
+  friend class HTMLDocumentParser;
+
   ExecutingContext* context_;
   static bool traverseHTML(Node* root, GumboNode* node);
   static void parseProperty(Element* element, GumboElement* gumboElement);
+  // Names of Gumbo nodes, taken from html_names when it has them instead of
+  // interning a new string for every node.
+  static AtomicString tagNameOf(const GumboElement& gumboElement);
+  static AtomicString attributeNameOf(const GumboAttribute& attribute);
 
-  static bool parseHTML(const std::string& html, Node* rootNode, bool isHTMLFragment);
+  static bool parseFragmentHTML(const std::string& html, Node* rootNode);
 };
 }  // namespace webf
 
@@ -14,10 +14,12 @@
 #include "core/css/style_engine.h"
 #include "core/dart_methods.h"
 #include "core/dom/document.h"
+#include "core/dom/events/event_target.h"
 #include "core/frame/window.h"
 #include "core/html/custom/widget_element_shape.h"
 #include "core/html/html_html_element.h"
 #include "core/html/html_script_element.h"
+#include "core/html/parser/html_document_parser.h"
 #include "core/html/parser/html_parser.h"
 #include "event_factory.h"
 #include "foundation/logging.h"
@@ -202,6 +204,8 @@ WebFPage::~WebFPage() {
     disposeCallback(this);
   }
 #endif
+  // Answers Dart and drops the pinned nodes while the context is still alive.
+  FinishParsingHTML();
   delete context_;
 }
 
@@ -314,6 +318,12 @@ void WebFPage::ParseHTMLInternal(void* page_,
     page->executingContext()->MaybeInitializeDocumentURLFromSourceURL(url);
   }
 
+  if (page->isDedicated()) {
+    page->StartParsingHTML(code, length, dart_handle, result_callback);
+    return;
+  }
+
+  // Without a looper of its own the page cannot yield, so it is built in one go.
   page->parseHTML(code, length);
   dart_free(code);
 
@@ -321,6 +331,60 @@ void WebFPage::ParseHTMLInternal(void* page_,
                                                        result_callback);
 }
 
+void WebFPage::StartParsingHTML(char* code,
+                                size_t length,
+                                Dart_PersistentHandle dart_handle,
+                                ParseHTMLCallback result_callback) {
+  // A new document replaces the one still being built.
+  FinishParsingHTML();
+
+  pending_html_document_ =
+      std::make_unique<PendingHTMLDocument>(PendingHTMLDocument{nullptr, code, dart_handle, result_callback, 0});
+  Element* document_element = context_->IsContextValid() ? context_->document()->documentElement() : nullptr;
+  if (document_element != nullptr) {
+    auto parser = std::make_unique<HTMLDocumentParser>(document_element);
+    if (parser->Parse(code, length)) {
+      pending_html_document_->parser = std::move(parser);
+    }
+  }
+
+  ContinueParsingHTML();
+}
+
+void WebFPage::ContinueParsingHTML() {
+  PendingHTMLDocument* pending = pending_html_document_.get();
+  pending->timer_id = 0;
+
+  if (pending->parser != nullptr &&
+      !pending->parser->Build(HTMLDocumentParser::Clock::now() + HTMLDocumentParser::kSliceBudget)) {
+    // Style and flush what is built so far, so Dart can paint the top of the
+    // page before the rest arrives.
+    context_->DrainMicrotasks();
+    pending->timer_id = context_->looper()->ScheduleTimer(0, [this]() { ContinueParsingHTML(); });
+    return;
+  }
+
+  context_->uiCommandBuffer()->AddCommand(UICommand::kFinishRecordingCommand, nullptr, nullptr, nullptr);
+  FinishParsingHTML();
+}
+
+void WebFPage::FinishParsingHTML() {
+  if (pending_html_document_ == nullptr) {
+    return;
+  }
+
+  std::unique_ptr<PendingHTMLDocument> pending = std::move(pending_html_document_);
+  if (pending->timer_id != 0) {
+    context_->looper()->CancelTimer(pending->timer_id);
+  }
+  // Gumbo points into the source until the parser is gone.
+  pending->parser.reset();
+  dart_free(pending->code);
+
+  dart_isolate_context_->dispatcher()->PostToDart(isDedicated(), ReturnParseHTMLToDart, pending->dart_handle,
+                                                  pending->result_callback);
+}
+
 static void ReturnInvokeEventResultToDart(Dart_Handle persistent_handle,
                                           InvokeModuleEventCallback result_callback,
                                           webf::NativeValue* result) {
@@ -347,6 +411,28 @@ void WebFPage::InvokeModuleEventInternal(void* page_,
                                                  result_callback, result);
 }
 
+static void ReturnDispatchEventBatchResultToDart(Dart_Handle persistent_handle,
+                                                DispatchEventBatchCallback result_callback) {
+  Dart_Handle handle = Dart_HandleFromPersistent_DL(persistent_handle);
+  result_callback(handle);
+  Dart_DeletePersistentHandle_DL(persistent_handle);
+}
+
+void WebFPage::DispatchEventBatchInternal(void* page_,
+                                          NativeDispatchEventItem* items,
+                                          int32_t count,
+                                          Dart_PersistentHandle persistent_handle,
+                                          DispatchEventBatchCallback result_callback) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  auto dart_isolate_context = page->executingContext()->dartIsolateContext();
+  assert(std::this_thread::get_id() == page->currentThread());
+
+  EventTarget::DispatchEventBatchFromDart(page->executingContext(), items, count, persistent_handle);
+
+  dart_isolate_context->dispatcher()->PostToDart(page->isDedicated(), ReturnDispatchEventBatchResultToDart,
+                                                 persistent_handle, result_callback);
+}
+
 static void ReturnDumpByteCodeResultToDart(Dart_Handle persistent_handle, DumpQuickjsByteCodeCallback result_callback) {
   Dart_Handle handle = Dart_HandleFromPersistent_DL(persistent_handle);
   result_callback(handle);
@@ -455,6 +541,36 @@ void WebFPage::OnColorSchemeChangedInternal(void* page_, const std::string& sche
   document->EnsureStyleEngine().MediaQueryAffectingValueChanged(MediaValueChange::kOther);
 }
 
+void WebFPage::PublishLayoutGeometryInternal(void* page_,
+                                             int64_t generation,
+                                             NativeLayoutGeometry* entries,
+                                             int32_t length) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  if (page) {
+    assert(std::this_thread::get_id() == page->currentThread());
+    ExecutingContext* context = page->executingContext();
+    if (context && context->IsContextValid() && generation >= 0) {
+      context->layoutGeometrySnapshot()->Publish(static_cast<uint64_t>(generation), entries, length);
+    }
+  }
+  dart_free(entries);
+}
+
+void WebFPage::ClearLayoutGeometryInternal(void* page_) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  if (!page) {
+    return;
+  }
+
+  assert(std::this_thread::get_id() == page->currentThread());
+
+  ExecutingContext* context = page->executingContext();
+  if (!context || !context->IsContextValid()) {
+    return;
+  }
+  context->layoutGeometrySnapshot()->Clear();
+}
+
 // static
 int WebFPage::MaxNumberOfFrames() {
   return kMaxNumberOfFrames;
@@ -18,6 +18,7 @@
 
 #include "core/executing_context.h"
 #include "foundation/native_string.h"
+#include "multiple_threading/timer_wheel.h"
 
 namespace webf {
 
@@ -25,6 +26,8 @@ class WebFPage;
 class WidgetElementShape;
 class DartContext;
 class HTMLScriptElement;
+class HTMLDocumentParser;
+struct NativeDispatchEventItem;
 
 using JSBridgeDisposeCallback = void (*)(WebFPage* bridge);
 using ConsoleMessageHandler = std::function<void(void* ctx, const std::string& message, int logLevel)>;
@@ -94,6 +97,12 @@ class WebFPage final {
                                         Dart_Handle dart_handle,
                                         InvokeModuleEventCallback result_callback);
 
+  static void DispatchEventBatchInternal(void* page_,
+                                         NativeDispatchEventItem* items,
+                                         int32_t count,
+                                         Dart_PersistentHandle persistent_handle,
+                                         DispatchEventBatchCallback result_callback);
+
   static void DumpQuickJsByteCodeInternal(void* page_,
                                           const char* code,
                                           int32_t code_len,
@@ -110,6 +119,12 @@ class WebFPage final {
   static void OnViewportSizeChangedInternal(void* page_, double inner_width, double inner_height);
   static void OnDevicePixelRatioChangedInternal(void* page_, double device_pixel_ratio);
   static void OnColorSchemeChangedInternal(void* page_, const std::string& scheme);
+  // Layout geometry published by the Dart side after a frame, see LayoutGeometrySnapshot.
+  static void PublishLayoutGeometryInternal(void* page_,
+                                            int64_t generation,
+                                            NativeLayoutGeometry* entries,
+                                            int32_t length);
+  static void ClearLayoutGeometryInternal(void* page_);
 
   // evaluate JavaScript source codes in standard mode.
   bool evaluateScript(const char* script,
@@ -169,6 +184,21 @@ class WebFPage final {
   JSBridgeDisposeCallback disposeCallback{nullptr};
 #endif
  private:
+  // A document parseHTML() is building on a dedicated JS thread. It is built
+  // in slices resumed by a looper timer, so other tasks and Dart frames run
+  // in between.
+  struct PendingHTMLDocument {
+    std::unique_ptr<HTMLDocumentParser> parser;
+    char* code;
+    Dart_PersistentHandle dart_handle;
+    ParseHTMLCallback result_callback;
+    multi_threading::TimerWheel::TimerId timer_id;
+  };
+
+  void StartParsingHTML(char* code, size_t length, Dart_PersistentHandle dart_handle, ParseHTMLCallback result_callback);
+  void ContinueParsingHTML();
+  void FinishParsingHTML();
+
   const std::thread::id ownerThreadId;
   std::atomic<bool> update_style_for_this_document_in_progress_{false};
   // FIXME: we must to use raw pointer instead of unique_ptr because we needs to access context_ when dispose page.
@@ -177,6 +207,7 @@ class WebFPage final {
   DartIsolateContext* dart_isolate_context_;
   ExecutingContext* context_;
   JSExceptionHandler handler_;
+  std::unique_ptr<PendingHTMLDocument> pending_html_document_;
 };
 
 }  // namespace webf
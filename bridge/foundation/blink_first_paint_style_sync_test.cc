@@ -45,6 +45,7 @@ TEST(BlinkFirstPaintStyleSync, EmitsSheetStyleCommandsInFirstBatch) {
   auto* items = static_cast<UICommandItem*>(pack->data);
 
   EXPECT_TRUE(HasCommand(items, pack->length, UICommand::kClearStyle));
-  EXPECT_TRUE(HasCommand(items, pack->length, UICommand::kSetStyleById));
+  EXPECT_TRUE(HasCommand(items, pack->length, UICommand::kSetStyleById) ||
+              HasCommand(items, pack->length, UICommand::kSetStyleByIdTyped));
 }
 
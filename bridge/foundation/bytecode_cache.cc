@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "bytecode_cache.h"
+
+#include <sys/stat.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#if defined(_WIN32)
+#include <direct.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "foundation/logging.h"
+
+namespace webf {
+
+namespace {
+
+constexpr uint32_t kEntryMagic = 0x43424657;  // "WFBC"
+constexpr uint32_t kEntryFormat = 1;
+
+struct EntryHeader {
+  uint32_t magic;
+  uint32_t format;
+  uint64_t key_high;
+  uint64_t key_low;
+  uint64_t length;
+  uint64_t checksum;
+};
+
+inline uint64_t Rotate(uint64_t value, int shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+inline uint64_t Finalize(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+// Two independent 64-bit lanes over |data|, eight bytes at a time. Not
+// cryptographic; entries only need to tell scripts and bit rot apart.
+void HashBytes(const void* data, size_t length, uint64_t& a, uint64_t& b) {
+  const auto* p = static_cast<const uint8_t*>(data);
+  size_t remaining = length;
+  while (remaining >= 8) {
+    uint64_t word;
+    memcpy(&word, p, 8);
+    a = Rotate(a ^ word, 31) * 0x9e3779b97f4a7c15ULL;
+    b = Rotate(b + word, 27) * 0xbf58476d1ce4e5b9ULL;
+    p += 8;
+    remaining -= 8;
+  }
+  uint64_t tail = 0;
+  memcpy(&tail, p, remaining);
+  a = Finalize(a ^ tail ^ length);
+  b = Finalize(b + tail + Rotate(length, 32));
+}
+
+uint64_t Checksum(const uint8_t* data, size_t length) {
+  uint64_t a = 0x243f6a8885a308d3ULL;
+  uint64_t b = 0x13198a2e03707344ULL;
+  HashBytes(data, length, a, b);
+  return a ^ b;
+}
+
+void MakeDirectories(const std::string& path) {
+  for (size_t i = 1; i <= path.size(); i++) {
+    if (i != path.size() && path[i] != '/') {
+      continue;
+    }
+    std::string prefix = path.substr(0, i);
+#if defined(_WIN32)
+    _mkdir(prefix.c_str());
+#else
+    mkdir(prefix.c_str(), 0755);
+#endif
+  }
+}
+
+}  // namespace
+
+BytecodeCache::Entry::~Entry() {
+#if !defined(_WIN32)
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_length_);
+  }
+#endif
+}
+
+std::string BytecodeCache::CurrentEngineVersion() {
+  std::string version;
+#ifdef CONFIG_VERSION
+  version += CONFIG_VERSION;
+#endif
+  version += '/';
+#ifdef APP_REV
+  version += APP_REV;
+#endif
+  version += '/' + std::to_string(sizeof(void*) * 8);
+  return version;
+}
+
+BytecodeCache::BytecodeCache(std::string directory, std::string engine_version)
+    : directory_(std::move(directory)), engine_hash_([&engine_version] {
+        uint64_t a = 0, b = 0;
+        HashBytes(engine_version.data(), engine_version.size(), a, b);
+        return a ^ b;
+      }()) {
+  MakeDirectories(directory_);
+}
+
+BytecodeCache::~BytecodeCache() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_one();
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+}
+
+BytecodeCache::Key BytecodeCache::KeyFor(const char* source, size_t length, const char* url) const {
+  uint64_t a = engine_hash_;
+  uint64_t b = ~engine_hash_;
+  // Stack traces carry the URL the script was compiled with.
+  if (url != nullptr) {
+    HashBytes(url, strlen(url), a, b);
+  }
+  HashBytes(source, length, a, b);
+  return Key{a, b};
+}
+
+std::string BytecodeCache::PathFor(const Key& key) const {
+  char name[48];
+  snprintf(name, sizeof(name), "/%016llx%016llx.qjsbc", static_cast<unsigned long long>(key.high),
+           static_cast<unsigned long long>(key.low));
+  return directory_ + name;
+}
+
+std::unique_ptr<BytecodeCache::Entry> BytecodeCache::Find(const Key& key) const {
+  std::string path = PathFor(key);
+  std::unique_ptr<Entry> entry(new Entry());
+  const uint8_t* bytes;
+  size_t length;
+
+#if defined(_WIN32)
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return nullptr;
+  }
+  entry->buffer_.resize(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char*>(entry->buffer_.data()), entry->buffer_.size())) {
+    return nullptr;
+  }
+  bytes = entry->buffer_.data();
+  length = entry->buffer_.size();
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(EntryHeader))) {
+    close(fd);
+    return nullptr;
+  }
+  length = static_cast<size_t>(st.st_size);
+  void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return nullptr;
+  }
+  entry->mapping_ = mapping;
+  entry->mapping_length_ = length;
+  bytes = static_cast<const uint8_t*>(mapping);
+#endif
+
+  if (length < sizeof(EntryHeader)) {
+    return nullptr;
+  }
+  EntryHeader header;
+  memcpy(&header, bytes, sizeof(header));
+  const uint8_t* bytecode = bytes + sizeof(EntryHeader);
+  if (header.magic != kEntryMagic || header.format != kEntryFormat || header.key_high != key.high ||
+      header.key_low != key.low || header.length != length - sizeof(EntryHeader) ||
+      header.checksum != Checksum(bytecode, header.length)) {
+    WEBF_LOG(WARN) << "Ignoring invalid bytecode cache entry " << path;
+    return nullptr;
+  }
+
+  entry->data_ = bytecode;
+  entry->size_ = header.length;
+  return entry;
+}
+
+void BytecodeCache::Store(const Key& key, const uint8_t* bytecode, size_t length) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(PendingWrite{key, std::vector<uint8_t>(bytecode, bytecode + length)});
+    if (!writer_.joinable()) {
+      writer_ = std::thread(&BytecodeCache::WriterMain, this);
+    }
+  }
+  cv_.notify_one();
+}
+
+void BytecodeCache::Remove(const Key& key) {
+  std::remove(PathFor(key).c_str());
+}
+
+void BytecodeCache::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  flushed_cv_.wait(lock, [this] { return pending_.empty() && !writing_; });
+}
+
+void BytecodeCache::WriteEntry(const PendingWrite& write) const {
+  static std::atomic<uint32_t> temp_counter{0};
+
+  EntryHeader header{kEntryMagic,
+                     kEntryFormat,
+                     write.key.high,
+                     write.key.low,
+                     write.bytecode.size(),
+                     Checksum(write.bytecode.data(), write.bytecode.size())};
+
+  std::string path = PathFor(write.key);
+  std::string temp_path = path + ".tmp" + std::to_string(temp_counter++);
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(write.bytecode.data()), write.bytecode.size());
+    if (!file) {
+      WEBF_LOG(WARN) << "Failed to write bytecode cache entry " << temp_path;
+      file.close();
+      std::remove(temp_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    std::remove(temp_path.c_str());
+  }
+}
+
+void BytecodeCache::WriterMain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+    // Entries queued before shutdown are still written; a cold start pays for
+    // every one that is lost.
+    if (pending_.empty()) {
+      return;
+    }
+    PendingWrite write = std::move(pending_.front());
+    pending_.pop_front();
+    writing_ = true;
+    lock.unlock();
+    WriteEntry(write);
+    lock.lock();
+    writing_ = false;
+    if (pending_.empty()) {
+      flushed_cv_.notify_all();
+    }
+  }
+}
+
+}  // namespace webf
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_FOUNDATION_BYTECODE_CACHE_H_
+#define WEBF_FOUNDATION_BYTECODE_CACHE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace webf {
+
+// Compiled QuickJS bytecode of classic scripts, stored in a directory handed
+// over by Dart when the isolate context is created and shared by every JS
+// thread of the isolate.
+//
+// Entries are addressed by a hash of the engine version, the script URL and
+// the source text, so a changed bundle or an upgraded engine simply misses.
+// Found entries are mapped read-only and their header and checksum validated
+// before the bytes reach JS_ReadObject. New entries are written by a
+// background thread, through a temporary file renamed into place, so a crash
+// never leaves a truncated entry behind.
+class BytecodeCache {
+ public:
+  // Smaller scripts compile about as fast as an entry is read and checked.
+  static constexpr size_t kMinSourceLength = 10 * 1024;
+
+  struct Key {
+    uint64_t high;
+    uint64_t low;
+  };
+
+  // A validated entry. The bytes stay readable until it is destroyed.
+  class Entry {
+   public:
+    ~Entry();
+    Entry(const Entry&) = delete;
+    Entry& operator=(const Entry&) = delete;
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+   private:
+    friend class BytecodeCache;
+    Entry() = default;
+
+    void* mapping_{nullptr};
+    size_t mapping_length_{0};
+    std::vector<uint8_t> buffer_;
+    const uint8_t* data_{nullptr};
+    size_t size_{0};
+  };
+
+  // QuickJS and WebF revision plus pointer width; bytecode from any other
+  // build is not loadable.
+  static std::string CurrentEngineVersion();
+
+  BytecodeCache(std::string directory, std::string engine_version);
+  ~BytecodeCache();
+  BytecodeCache(const BytecodeCache&) = delete;
+  BytecodeCache& operator=(const BytecodeCache&) = delete;
+
+  Key KeyFor(const char* source, size_t length, const char* url) const;
+
+  // Returns nullptr when there is no valid entry for |key|. Any thread.
+  std::unique_ptr<Entry> Find(const Key& key) const;
+
+  // Copies |bytecode| and writes it out in the background. Any thread.
+  void Store(const Key& key, const uint8_t* bytecode, size_t length);
+
+  // Drops an entry the engine refused to load.
+  void Remove(const Key& key);
+
+  // Blocks until every stored entry is on disk.
+  void Flush();
+
+  const std::string& directory() const { return directory_; }
+
+ private:
+  struct PendingWrite {
+    Key key;
+    std::vector<uint8_t> bytecode;
+  };
+
+  std::string PathFor(const Key& key) const;
+  void WriteEntry(const PendingWrite& write) const;
+  void WriterMain();
+
+  const std::string directory_;
+  const uint64_t engine_hash_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable flushed_cv_;
+  std::deque<PendingWrite> pending_;
+  bool writing_{false};
+  bool stopping_{false};
+  std::thread writer_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_FOUNDATION_BYTECODE_CACHE_H_
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "foundation/bytecode_cache.h"
+
+using namespace webf;
+
+namespace {
+
+std::string TempCacheDirectory(const char* name) {
+  return ::testing::TempDir() + "webf_bytecode_cache_" + name;
+}
+
+std::string EntryPath(const std::string& directory, const BytecodeCache::Key& key) {
+  char name[48];
+  snprintf(name, sizeof(name), "/%016llx%016llx.qjsbc", static_cast<unsigned long long>(key.high),
+           static_cast<unsigned long long>(key.low));
+  return directory + name;
+}
+
+const char kSource[] = "function main() { return 42; } main();";
+const std::vector<uint8_t> kBytecode = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+
+}  // namespace
+
+TEST(BytecodeCache, StoredEntryIsFound) {
+  BytecodeCache cache(TempCacheDirectory("round_trip"), "engine-1");
+  auto key = cache.KeyFor(kSource, strlen(kSource), "https://example.com/main.js");
+  cache.Remove(key);
+  EXPECT_EQ(cache.Find(key), nullptr);
+
+  cache.Store(key, kBytecode.data(), kBytecode.size());
+  cache.Flush();
+
+  auto entry = cache.Find(key);
+  ASSERT_NE(entry, nullptr);
+  ASSERT_EQ(entry->size(), kBytecode.size());
+  EXPECT_EQ(memcmp(entry->data(), kBytecode.data(), kBytecode.size()), 0);
+}
+
+TEST(BytecodeCache, KeyCoversUrlSourceAndEngine) {
+  std::string directory = TempCacheDirectory("keys");
+  BytecodeCache cache(directory, "engine-1");
+  BytecodeCache upgraded(directory, "engine-2");
+
+  auto key = cache.KeyFor(kSource, strlen(kSource), "https://example.com/main.js");
+  auto other_url = cache.KeyFor(kSource, strlen(kSource), "https://example.com/other.js");
+  auto other_source = cache.KeyFor(kSource, strlen(kSource) - 1, "https://example.com/main.js");
+  auto other_engine = upgraded.KeyFor(kSource, strlen(kSource), "https://example.com/main.js");
+  EXPECT_FALSE(key.high == other_url.high && key.low == other_url.low);
+  EXPECT_FALSE(key.high == other_source.high && key.low == other_source.low);
+  EXPECT_FALSE(key.high == other_engine.high && key.low == other_engine.low);
+
+  cache.Store(key, kBytecode.data(), kBytecode.size());
+  cache.Flush();
+  EXPECT_NE(cache.Find(key), nullptr);
+  EXPECT_EQ(upgraded.Find(other_engine), nullptr);
+}
+
+TEST(BytecodeCache, CorruptedEntryIsIgnored) {
+  std::string directory = TempCacheDirectory("corrupted");
+  BytecodeCache cache(directory, "engine-1");
+  auto key = cache.KeyFor(kSource, strlen(kSource), nullptr);
+  cache.Store(key, kBytecode.data(), kBytecode.size());
+  cache.Flush();
+  ASSERT_NE(cache.Find(key), nullptr);
+
+  {
+    std::fstream file(EntryPath(directory, key), std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(-1, std::ios::end);
+    file.put('\xff');
+  }
+  EXPECT_EQ(cache.Find(key), nullptr);
+
+  {
+    std::ofstream file(EntryPath(directory, key), std::ios::binary | std::ios::trunc);
+    file.write("WFBC", 4);
+  }
+  EXPECT_EQ(cache.Find(key), nullptr);
+}
+
+TEST(BytecodeCache, RemovedEntryIsGone) {
+  BytecodeCache cache(TempCacheDirectory("remove"), "engine-1");
+  auto key = cache.KeyFor(kSource, strlen(kSource), nullptr);
+  cache.Store(key, kBytecode.data(), kBytecode.size());
+  cache.Flush();
+  ASSERT_NE(cache.Find(key), nullptr);
+
+  cache.Remove(key);
+  EXPECT_EQ(cache.Find(key), nullptr);
+}
@@ -3,22 +3,114 @@
  */
 
 #include "metrics_registry.h"
-#include <sstream>
+#include <algorithm>
+#include <cmath>
 
 namespace webf {
 
+namespace {
+
+// Never 0, so a thread's empty shard cache matches no registry.
+std::atomic<uint64_t> g_next_registry_id{1};
+
+}  // namespace
+
 const char* MetricName(MetricsEnum metric) {
   switch (metric) {
     case MetricsEnum::kTotalGetPropertyValueWithHint:
       return "TotalGetPropertyValueWithHint";
     case MetricsEnum::kGetPropertyValueWithHintWithRawText:
       return "GetPropertyValueWithHintWithRawText";
+    case MetricsEnum::kSyncDartRoundTripStandard:
+      return "SyncDartRoundTripStandard";
+    case MetricsEnum::kSyncDartRoundTripDependentsOnElement:
+      return "SyncDartRoundTripDependentsOnElement";
+    case MetricsEnum::kSyncDartRoundTripDependentsOnLayout:
+      return "SyncDartRoundTripDependentsOnLayout";
+    case MetricsEnum::kSyncDartRoundTripDependentsAll:
+      return "SyncDartRoundTripDependentsAll";
+    case MetricsEnum::kStringCacheHit:
+      return "StringCacheHit";
+    case MetricsEnum::kStringCacheMiss:
+      return "StringCacheMiss";
     case MetricsEnum::kCount:
       return "<COUNT>";
   }
   return "<UNKNOWN_METRIC>";
 }
 
+const char* MetricName(MetricsHistogram metric) {
+  switch (metric) {
+    case MetricsHistogram::kUICommandFlushSize:
+      return "UICommandFlushSize";
+    case MetricsHistogram::kSyncDartRoundTripNanos:
+      return "SyncDartRoundTripNanos";
+    case MetricsHistogram::kRecalcStyleElementCount:
+      return "RecalcStyleElementCount";
+    case MetricsHistogram::kRuleMatchNanos:
+      return "RuleMatchNanos";
+    case MetricsHistogram::kCount:
+      return "<COUNT>";
+  }
+  return "<UNKNOWN_METRIC>";
+}
+
+const char* MetricName(MetricsGauge metric) {
+  switch (metric) {
+    case MetricsGauge::kLiveExecutingContexts:
+      return "LiveExecutingContexts";
+    case MetricsGauge::kCount:
+      return "<COUNT>";
+  }
+  return "<UNKNOWN_METRIC>";
+}
+
+uint64_t MetricsHistogramSnapshot::ValueAtPercentile(double percentile) const {
+  if (count == 0) {
+    return 0;
+  }
+  percentile = std::clamp(percentile, 0.0, 100.0);
+  uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * count)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return MetricsHistogramBucketLowerBound(i);
+    }
+  }
+  return MetricsHistogramBucketLowerBound(buckets.size() - 1);
+}
+
+MetricsRegistry::MetricsRegistry() : id_(g_next_registry_id.fetch_add(1, std::memory_order_relaxed)) {}
+
+MetricsRegistry::~MetricsRegistry() = default;
+
+MetricsRegistry::Shard& MetricsRegistry::AttachShard() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& shard = shard_by_thread_[std::this_thread::get_id()];
+  if (!shard) {
+    shards_.emplace_back(std::make_unique<Shard>());
+    shard = shards_.back().get();
+    shard->epoch.store(epoch_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  return *shard;
+}
+
+void MetricsRegistry::ResetShard(Shard& shard, uint32_t epoch) {
+  for (auto& counter : shard.counters) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+  for (auto& histogram : shard.histograms) {
+    for (auto& bucket : histogram.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+    histogram.count.store(0, std::memory_order_relaxed);
+    histogram.sum.store(0, std::memory_order_relaxed);
+  }
+  // Publish the zeroed values before readers start trusting this shard again.
+  shard.epoch.store(epoch, std::memory_order_release);
+}
+
 void MetricsRegistry::Increment(const std::string& key, uint64_t delta) {
   std::lock_guard<std::mutex> lock(mutex_);
   auto& ref = counters_[key];
@@ -32,17 +124,36 @@ uint64_t MetricsRegistry::Get(const std::string& key) const {
   return it->second;
 }
 
-void MetricsRegistry::Increment(MetricsEnum metric, uint64_t delta) {
+uint64_t MetricsRegistry::Get(MetricsEnum metric) const {
   std::lock_guard<std::mutex> lock(mutex_);
+  uint32_t epoch = epoch_.load(std::memory_order_relaxed);
   size_t idx = static_cast<size_t>(metric);
-  if (idx < enum_counters_.size()) enum_counters_[idx] += delta;
+  uint64_t total = 0;
+  for (const auto& shard : shards_) {
+    if (shard->epoch.load(std::memory_order_acquire) == epoch) {
+      total += shard->counters[idx].load(std::memory_order_relaxed);
+    }
+  }
+  return total;
 }
 
-uint64_t MetricsRegistry::Get(MetricsEnum metric) const {
+MetricsHistogramSnapshot MetricsRegistry::Get(MetricsHistogram metric) const {
   std::lock_guard<std::mutex> lock(mutex_);
+  uint32_t epoch = epoch_.load(std::memory_order_relaxed);
   size_t idx = static_cast<size_t>(metric);
-  if (idx < enum_counters_.size()) return enum_counters_[idx];
-  return 0;
+  MetricsHistogramSnapshot out;
+  for (const auto& shard : shards_) {
+    if (shard->epoch.load(std::memory_order_acquire) != epoch) {
+      continue;
+    }
+    const Shard::Histogram& histogram = shard->histograms[idx];
+    for (size_t i = 0; i < out.buckets.size(); ++i) {
+      out.buckets[i] += histogram.buckets[i].load(std::memory_order_relaxed);
+    }
+    out.count += histogram.count.load(std::memory_order_relaxed);
+    out.sum += histogram.sum.load(std::memory_order_relaxed);
+  }
+  return out;
 }
 
 std::unordered_map<std::string, uint64_t> MetricsRegistry::Snapshot() const {
@@ -51,21 +162,19 @@ std::unordered_map<std::string, uint64_t> MetricsRegistry::Snapshot() const {
 }
 
 std::vector<std::pair<MetricsEnum, uint64_t>> MetricsRegistry::SnapshotEnum() const {
-  std::lock_guard<std::mutex> lock(mutex_);
   std::vector<std::pair<MetricsEnum, uint64_t>> out;
-  out.reserve(enum_counters_.size());
-  for (size_t i = 0; i < enum_counters_.size(); ++i) {
-    out.emplace_back(static_cast<MetricsEnum>(i), enum_counters_[i]);
+  out.reserve(static_cast<size_t>(MetricsEnum::kCount));
+  for (size_t i = 0; i < static_cast<size_t>(MetricsEnum::kCount); ++i) {
+    auto metric = static_cast<MetricsEnum>(i);
+    out.emplace_back(metric, Get(metric));
   }
   return out;
 }
 
 std::unordered_map<std::string, uint64_t> MetricsRegistry::SnapshotAllNamed() const {
-  std::lock_guard<std::mutex> lock(mutex_);
-  std::unordered_map<std::string, uint64_t> out = counters_;
-  for (size_t i = 0; i < enum_counters_.size(); ++i) {
-    auto name = MetricName(static_cast<MetricsEnum>(i));
-    out[name] += enum_counters_[i];
+  std::unordered_map<std::string, uint64_t> out = Snapshot();
+  for (const auto& [metric, value] : SnapshotEnum()) {
+    out[MetricName(metric)] += value;
   }
   return out;
 }
@@ -73,7 +182,7 @@ std::unordered_map<std::string, uint64_t> MetricsRegistry::SnapshotAllNamed() co
 void MetricsRegistry::Clear() {
   std::lock_guard<std::mutex> lock(mutex_);
   counters_.clear();
-  std::fill(enum_counters_.begin(), enum_counters_.end(), 0);
+  epoch_.fetch_add(1, std::memory_order_relaxed);
 }
 
 }  // namespace webf
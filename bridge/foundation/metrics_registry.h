@@ -5,9 +5,15 @@
 #ifndef WEBF_FOUNDATION_METRICS_REGISTRY_H_
 #define WEBF_FOUNDATION_METRICS_REGISTRY_H_
 
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -17,19 +23,92 @@ namespace webf {
 enum class MetricsEnum {
   kTotalGetPropertyValueWithHint = 0,
   kGetPropertyValueWithHintWithRawText = 1,
+  // Synchronous binding calls into Dart, by FlushUICommandReason. A call is
+  // counted under the strongest dependency its reason carries.
+  kSyncDartRoundTripStandard = 2,
+  kSyncDartRoundTripDependentsOnElement = 3,
+  kSyncDartRoundTripDependentsOnLayout = 4,
+  kSyncDartRoundTripDependentsAll = 5,
+  // StringCache lookups of a JSAtom for a native string.
+  kStringCacheHit = 6,
+  kStringCacheMiss = 7,
 
   kCount
 };
 
-// Convert a MetricsEnum to a stable, human-readable name.
+// Distributions recorded into log-scale buckets. Keep contiguous.
+enum class MetricsHistogram {
+  // UI commands in each package Dart reads.
+  kUICommandFlushSize = 0,
+  kSyncDartRoundTripNanos = 1,
+  // Elements styled by one StyleEngine::RecalcStyle pass.
+  kRecalcStyleElementCount = 2,
+  // Time a RecalcStyle pass spent collecting matched rules.
+  kRuleMatchNanos = 3,
+
+  kCount
+};
+
+// Values that go up and down. Keep contiguous.
+enum class MetricsGauge {
+  kLiveExecutingContexts = 0,
+
+  kCount
+};
+
+// Convert a metric to a stable, human-readable name.
 const char* MetricName(MetricsEnum metric);
+const char* MetricName(MetricsHistogram metric);
+const char* MetricName(MetricsGauge metric);
+
+// Buckets are HDR-style: exact below 4, then four linear sub-buckets per power
+// of two, so any recorded value is within 25% of its bucket's lower bound.
+constexpr size_t kMetricsHistogramSubBucketBits = 2;
+constexpr size_t kMetricsHistogramSubBuckets = 1 << kMetricsHistogramSubBucketBits;
+constexpr size_t kMetricsHistogramBucketCount = (64 - kMetricsHistogramSubBucketBits + 1) * kMetricsHistogramSubBuckets;
+
+constexpr size_t MetricsHistogramBucketIndex(uint64_t value) {
+  if (value < kMetricsHistogramSubBuckets) {
+    return static_cast<size_t>(value);
+  }
+  size_t msb = 63 - std::countl_zero(value);
+  size_t shift = msb - kMetricsHistogramSubBucketBits;
+  return (shift + 1) * kMetricsHistogramSubBuckets +
+         static_cast<size_t>((value >> shift) & (kMetricsHistogramSubBuckets - 1));
+}
+
+constexpr uint64_t MetricsHistogramBucketLowerBound(size_t index) {
+  if (index < kMetricsHistogramSubBuckets) {
+    return index;
+  }
+  size_t shift = index / kMetricsHistogramSubBuckets - 1;
+  uint64_t sub = index % kMetricsHistogramSubBuckets;
+  return (kMetricsHistogramSubBuckets + sub) << shift;
+}
+
+struct MetricsHistogramSnapshot {
+  uint64_t count = 0;
+  uint64_t sum = 0;
+  std::array<uint64_t, kMetricsHistogramBucketCount> buckets{};
+
+  // Lower bound of the bucket holding the |percentile| (0-100) value, or 0
+  // when nothing was recorded.
+  uint64_t ValueAtPercentile(double percentile) const;
+  double Mean() const { return count ? static_cast<double>(sum) / count : 0; }
+};
 
-// A simple thread-safe key->counter registry that is shared per DartIsolateContext.
-// - Keys are strings
-// - Values are monotonically increasing counters
+// A thread-safe registry of counters, histograms and gauges that is shared per
+// DartIsolateContext.
+//
+// Enum counters and histograms are written to a per-thread shard without
+// locks or read-modify-write atomics, so instrumented hot paths cost a
+// thread-local lookup and a couple of relaxed stores. Shards are merged when
+// read. String-keyed counters and gauges are not sharded; string keys take
+// the registry mutex and are meant for rare events.
 class MetricsRegistry {
  public:
-  MetricsRegistry() : enum_counters_(static_cast<size_t>(MetricsEnum::kCount), 0) {}
+  MetricsRegistry();
+  ~MetricsRegistry();
 
   // Increment the counter for `key` by `delta` (default 1).
   void Increment(const std::string& key, uint64_t delta = 1);
@@ -38,9 +117,30 @@ class MetricsRegistry {
   uint64_t Get(const std::string& key) const;
 
   // Enum overloads.
-  void Increment(MetricsEnum metric, uint64_t delta = 1);
+  void Increment(MetricsEnum metric, uint64_t delta = 1) {
+    Shard& shard = LocalShard();
+    Bump(shard.counters[static_cast<size_t>(metric)], delta);
+  }
   uint64_t Get(MetricsEnum metric) const;
 
+  void Record(MetricsHistogram metric, uint64_t value) {
+    Shard::Histogram& histogram = LocalShard().histograms[static_cast<size_t>(metric)];
+    Bump(histogram.buckets[MetricsHistogramBucketIndex(value)], 1);
+    Bump(histogram.count, 1);
+    Bump(histogram.sum, value);
+  }
+  MetricsHistogramSnapshot Get(MetricsHistogram metric) const;
+
+  void Set(MetricsGauge metric, int64_t value) {
+    gauges_[static_cast<size_t>(metric)].store(value, std::memory_order_relaxed);
+  }
+  void Add(MetricsGauge metric, int64_t delta) {
+    gauges_[static_cast<size_t>(metric)].fetch_add(delta, std::memory_order_relaxed);
+  }
+  int64_t Get(MetricsGauge metric) const {
+    return gauges_[static_cast<size_t>(metric)].load(std::memory_order_relaxed);
+  }
+
   // Create a point-in-time copy of all counters.
   std::unordered_map<std::string, uint64_t> Snapshot() const;
 
@@ -50,13 +150,84 @@ class MetricsRegistry {
   // Merge string and enum snapshots into a single name->value map.
   std::unordered_map<std::string, uint64_t> SnapshotAllNamed() const;
 
-  // Clear all counters.
+  // Clear all counters and histograms. Gauges describe live state and are
+  // kept.
   void Clear();
 
  private:
+  struct Shard {
+    struct Histogram {
+      std::array<std::atomic<uint64_t>, kMetricsHistogramBucketCount> buckets{};
+      std::atomic<uint64_t> count{0};
+      std::atomic<uint64_t> sum{0};
+    };
+
+    // Clear() bumps the registry epoch; the owning thread zeroes its shard
+    // on its next write, and readers skip shards from an older epoch.
+    std::atomic<uint32_t> epoch{0};
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(MetricsEnum::kCount)> counters{};
+    std::array<Histogram, static_cast<size_t>(MetricsHistogram::kCount)> histograms{};
+  };
+
+  // Only the owning thread writes a shard, so a relaxed load and store is
+  // enough and avoids a locked instruction per increment.
+  static void Bump(std::atomic<uint64_t>& value, uint64_t delta) {
+    value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+  }
+
+  Shard& LocalShard() {
+    thread_local uint64_t cached_registry_id = 0;
+    thread_local Shard* cached_shard = nullptr;
+    Shard* shard = cached_registry_id == id_ ? cached_shard : nullptr;
+    if (!shard) {
+      shard = &AttachShard();
+      cached_registry_id = id_;
+      cached_shard = shard;
+    }
+    uint32_t epoch = epoch_.load(std::memory_order_relaxed);
+    if (shard->epoch.load(std::memory_order_relaxed) != epoch) {
+      ResetShard(*shard, epoch);
+    }
+    return *shard;
+  }
+
+  Shard& AttachShard();
+  static void ResetShard(Shard& shard, uint32_t epoch);
+
+  // Distinguishes registries in the thread-local shard cache, so a registry
+  // allocated at the address of a destroyed one never sees its shard.
+  const uint64_t id_;
+  std::atomic<uint32_t> epoch_{0};
+  std::array<std::atomic<int64_t>, static_cast<size_t>(MetricsGauge::kCount)> gauges_{};
+
   mutable std::mutex mutex_;
   std::unordered_map<std::string, uint64_t> counters_;
-  std::vector<uint64_t> enum_counters_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::unordered_map<std::thread::id, Shard*> shard_by_thread_;
+};
+
+// Records the lifetime of the scope, in nanoseconds, into a histogram. A null
+// registry records nothing.
+class ScopedMetricsTimer {
+ public:
+  ScopedMetricsTimer(MetricsRegistry* registry, MetricsHistogram metric)
+      : registry_(registry), metric_(metric), start_(registry ? std::chrono::steady_clock::now() : TimePoint()) {}
+  ~ScopedMetricsTimer() {
+    if (registry_) {
+      auto elapsed = std::chrono::steady_clock::now() - start_;
+      registry_->Record(metric_, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+  }
+
+  ScopedMetricsTimer(const ScopedMetricsTimer&) = delete;
+  ScopedMetricsTimer& operator=(const ScopedMetricsTimer&) = delete;
+
+ private:
+  using TimePoint = std::chrono::steady_clock::time_point;
+
+  MetricsRegistry* registry_;
+  MetricsHistogram metric_;
+  TimePoint start_;
 };
 
 }  // namespace webf
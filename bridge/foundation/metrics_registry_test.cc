@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+#include "foundation/metrics_registry.h"
+
+using namespace webf;
+
+TEST(MetricsRegistry, MergesIncrementsFromEveryThread) {
+  MetricsRegistry registry;
+  constexpr int kThreads = 4;
+  constexpr int kIncrements = 10000;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&registry]() {
+      for (int j = 0; j < kIncrements; ++j) {
+        registry.Increment(MetricsEnum::kStringCacheHit);
+      }
+      registry.Increment(MetricsEnum::kStringCacheMiss, 2);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(registry.Get(MetricsEnum::kStringCacheHit), kThreads * kIncrements);
+  EXPECT_EQ(registry.Get(MetricsEnum::kStringCacheMiss), kThreads * 2);
+
+  auto named = registry.SnapshotAllNamed();
+  EXPECT_EQ(named["StringCacheHit"], kThreads * kIncrements);
+}
+
+TEST(MetricsRegistry, HistogramBucketsBoundTheirValues) {
+  for (uint64_t value = 0; value < 5000; ++value) {
+    size_t index = MetricsHistogramBucketIndex(value);
+    ASSERT_LE(MetricsHistogramBucketLowerBound(index), value);
+    ASSERT_GT(MetricsHistogramBucketLowerBound(index + 1), value);
+  }
+  EXPECT_EQ(MetricsHistogramBucketIndex(UINT64_MAX), kMetricsHistogramBucketCount - 1);
+}
+
+TEST(MetricsRegistry, HistogramPercentiles) {
+  MetricsRegistry registry;
+  EXPECT_EQ(registry.Get(MetricsHistogram::kUICommandFlushSize).ValueAtPercentile(50), 0u);
+
+  for (uint64_t value = 1; value <= 100; ++value) {
+    registry.Record(MetricsHistogram::kUICommandFlushSize, value);
+  }
+
+  MetricsHistogramSnapshot snapshot = registry.Get(MetricsHistogram::kUICommandFlushSize);
+  EXPECT_EQ(snapshot.count, 100u);
+  EXPECT_EQ(snapshot.sum, 5050u);
+  EXPECT_DOUBLE_EQ(snapshot.Mean(), 50.5);
+  // Bucket lower bounds are within 25% of the exact percentile.
+  EXPECT_EQ(snapshot.ValueAtPercentile(50), 48u);
+  EXPECT_EQ(snapshot.ValueAtPercentile(100), 96u);
+  EXPECT_EQ(snapshot.ValueAtPercentile(0), 1u);
+
+  EXPECT_EQ(registry.Get(MetricsHistogram::kRuleMatchNanos).count, 0u);
+}
+
+TEST(MetricsRegistry, ClearResetsCountersButKeepsGauges) {
+  MetricsRegistry registry;
+  registry.Increment("custom");
+  registry.Increment(MetricsEnum::kStringCacheHit, 3);
+  registry.Record(MetricsHistogram::kRuleMatchNanos, 10);
+  registry.Add(MetricsGauge::kLiveExecutingContexts, 2);
+
+  // Shards owned by other threads are cleared too.
+  std::thread([&registry]() { registry.Increment(MetricsEnum::kStringCacheHit, 5); }).join();
+  EXPECT_EQ(registry.Get(MetricsEnum::kStringCacheHit), 8u);
+
+  registry.Clear();
+  EXPECT_EQ(registry.Get("custom"), 0u);
+  EXPECT_EQ(registry.Get(MetricsEnum::kStringCacheHit), 0u);
+  EXPECT_EQ(registry.Get(MetricsHistogram::kRuleMatchNanos).count, 0u);
+  EXPECT_EQ(registry.Get(MetricsGauge::kLiveExecutingContexts), 2);
+
+  registry.Increment(MetricsEnum::kStringCacheHit);
+  EXPECT_EQ(registry.Get(MetricsEnum::kStringCacheHit), 1u);
+  registry.Add(MetricsGauge::kLiveExecutingContexts, -1);
+  EXPECT_EQ(registry.Get(MetricsGauge::kLiveExecutingContexts), 1);
+}
+
+TEST(MetricsRegistry, RegistriesDoNotShareShards) {
+  MetricsRegistry first;
+  first.Increment(MetricsEnum::kStringCacheMiss);
+  {
+    MetricsRegistry second;
+    second.Increment(MetricsEnum::kStringCacheMiss, 4);
+    EXPECT_EQ(second.Get(MetricsEnum::kStringCacheMiss), 4u);
+  }
+  MetricsRegistry third;
+  EXPECT_EQ(third.Get(MetricsEnum::kStringCacheMiss), 0u);
+  first.Increment(MetricsEnum::kStringCacheMiss);
+  EXPECT_EQ(first.Get(MetricsEnum::kStringCacheMiss), 2u);
+}
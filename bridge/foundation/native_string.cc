@@ -17,6 +17,14 @@ namespace webf {
 
 SharedNativeString::SharedNativeString(const uint16_t* string, uint32_t length) : length_(length), string_(string) {}
 
+std::unique_ptr<SharedNativeString> SharedNativeString::FromLatin1(const uint8_t* string, uint32_t length) {
+  std::unique_ptr<SharedNativeString> native_string(new SharedNativeString());
+  native_string->string_ = reinterpret_cast<const uint16_t*>(string);
+  native_string->length_ = length;
+  native_string->is_8bit_ = 1;
+  return native_string;
+}
+
 std::unique_ptr<SharedNativeString> SharedNativeString::FromTemporaryString(const uint16_t* string, uint32_t length) {
 #if defined(_WIN32)
   const auto* new_str = static_cast<const uint16_t*>(CoTaskMemAlloc(length * sizeof(uint16_t)));
@@ -20,13 +20,21 @@
 namespace webf {
 
 // SharedNativeString is a container class that accepts allocated UTF-16 strings,
-// and users are responsible for freeing their strings
+// and users are responsible for freeing their strings.
+// Strings bound for Dart may instead hold Latin-1 characters, one byte each;
+// Is8Bit() tells them apart. Keep layout in sync with NativeString in
+// ../webf/lib/src/bridge/native_types.dart
 struct SharedNativeString {
   SharedNativeString(const uint16_t* string, uint32_t length);
   static std::unique_ptr<SharedNativeString> FromTemporaryString(const uint16_t* string, uint32_t length);
+  // Takes an allocated Latin-1 buffer, only for strings read by the Dart side.
+  static std::unique_ptr<SharedNativeString> FromLatin1(const uint8_t* string, uint32_t length);
 
+  // UTF-16 code units. Only meaningful when !Is8Bit().
   inline const uint16_t* string() const { return string_; }
+  inline const uint8_t* characters8() const { return reinterpret_cast<const uint8_t*>(string_); }
   inline uint32_t length() const { return length_; }
+  inline bool Is8Bit() const { return is_8bit_ != 0; }
 
   // Dart FFI use ole32 as it's allocator, we need to override the default allocator to compact with Dart FFI.
   static void* operator new(std::size_t size);
@@ -37,6 +45,7 @@ struct SharedNativeString {
   SharedNativeString() = default;
   const uint16_t* string_;
   uint32_t length_;
+  uint32_t is_8bit_{0};
 };
 
 // NativeString is a container class that accepts allocated on Heap UTF-16 strings,
@@ -100,6 +100,63 @@ struct NativeStyleValueIdWithHref : public DartReadable {
   SharedNativeString* href{nullptr};
 };
 
+// Typed style values for UICommand::kSetStyleByIdTyped, so that common lengths,
+// numbers and colors reach Dart without being serialized to CSS text.
+// Both enums are append-only and mirrored in webf/lib/src/bridge/native_types.dart.
+enum class NativeStyleValueType : uint8_t {
+  kNumeric = 1,  // |number| in |unit|.
+  kColor = 2,    // |argb| packed as 0xAARRGGBB.
+  kList = 3,     // Command descriptor only; list items are kNumeric or kColor.
+};
+
+enum class NativeStyleValueUnit : uint8_t {
+  kNumber,
+  kInteger,
+  kPercentage,
+  kPx,
+  kEm,
+  kRem,
+  kEx,
+  kCh,
+  kVw,
+  kVh,
+  kVmin,
+  kVmax,
+  kCm,
+  kMm,
+  kIn,
+  kPt,
+  kPc,
+  kQ,
+  kDeg,
+  kRad,
+  kGrad,
+  kTurn,
+  kMs,
+  kS,
+  kFr,
+};
+
+// One list item of a kList kSetStyleByIdTyped command.
+struct NativeTypedStyleValue : public DartReadable {
+  double number{0};
+  uint32_t argb{0};
+  uint8_t type{0};
+  uint8_t unit{0};
+  uint16_t reserved{0};
+};
+
+// Recorded canvas 2D calls submitted with UICommand::kRequestCanvasPaint.
+// |ops| holds one word per call (CanvasOp in the low byte, argument count
+// above it); |args| holds all their arguments in order. Dart frees |ops|,
+// |args| and the struct after replaying them.
+struct NativeCanvasDisplayList : public DartReadable {
+  uint32_t* ops{nullptr};
+  double* args{nullptr};
+  uint32_t op_count{0};
+  uint32_t arg_count{0};
+};
+
 // Combined pseudo style property (key/value) + base href payload for
 // UICommand::kSetPseudoStyle.
 struct NativePseudoStyleWithHref : public DartReadable {
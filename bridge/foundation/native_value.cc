@@ -121,6 +121,22 @@ NativeValue Native_NewInt64(int64_t value) {
 #endif
 }
 
+NativeValue Native_NewBindingName(int32_t id) {
+#if _MSC_VER
+  NativeValue v{};
+  v.u.int64 = id;
+  v.uint32 = 0;
+  v.tag = NativeTag::TAG_BINDING_NAME;
+  return v;
+#else
+  return (NativeValue){
+      .u = {.int64 = id},
+      .uint32 = 0,
+      .tag = NativeTag::TAG_BINDING_NAME,
+  };
+#endif
+}
+
 NativeValue Native_NewList(uint32_t argc, NativeValue* argv) {
 #if _MSC_VER
   NativeValue v{};
@@ -32,6 +32,8 @@ enum NativeTag {
   TAG_ASYNC_FUNCTION = 9,
   TAG_UINT8_BYTES = 10,
   TAG_UNDEFINED = 11,
+  // A name registered in BindingNameTable, with its id in u.int64.
+  TAG_BINDING_NAME = 12,
 };
 
 enum class JSPointerType {
@@ -74,6 +76,7 @@ NativeValue Native_NewList(uint32_t argc, NativeValue* argv);
 NativeValue Native_NewPtr(JSPointerType pointerType, void* ptr);
 NativeValue Native_NewJSON(JSContext* ctx, const ScriptValue& value, ExceptionState& exception_state);
 NativeValue Native_NewUint8Bytes(uint32_t length, uint8_t* bytes);
+NativeValue Native_NewBindingName(int32_t id);
 
 JSPointerType GetPointerTypeOfNativePointer(NativeValue native_value);
 
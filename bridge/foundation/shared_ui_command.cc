@@ -12,6 +12,7 @@
 #include "core/dart_methods.h"
 #include "core/executing_context.h"
 #include "foundation/logging.h"
+#include "foundation/metrics_registry.h"
 #include "foundation/ui_command_buffer.h"
 #include "foundation/native_type.h"
 #include "foundation/string/atomic_string.h"
@@ -19,6 +20,26 @@
 
 namespace webf {
 
+// Whether Dart may lay the page out differently after running |type|.
+static bool MayAffectLayout(UICommand type) {
+  switch (type) {
+    case UICommand::kStartRecordingCommand:
+    case UICommand::kFinishRecordingCommand:
+    case UICommand::kDisposeBindingObject:
+    case UICommand::kAddEvent:
+    case UICommand::kRemoveEvent:
+    case UICommand::kRequestCanvasPaint:
+    case UICommand::kRequestAnimationFrame:
+    case UICommand::kAddIntersectionObserver:
+    case UICommand::kRemoveIntersectionObserver:
+    case UICommand::kDisconnectIntersectionObserver:
+    case UICommand::kDefineStyleValue:
+      return false;
+    default:
+      return true;
+  }
+}
+
 SharedUICommand::SharedUICommand(ExecutingContext* context)
     : context_(context),
       package_buffer_(std::make_unique<UICommandPackageRingBuffer>(context)),
@@ -40,10 +61,16 @@ void SharedUICommand::AddCommand(UICommand type,
     context_->MaybeUpdateStyleForFirstPaint();
   }
 
+  LayoutGeometrySnapshot* geometry_snapshot = context_->layoutGeometrySnapshot();
+  if (MayAffectLayout(type)) {
+    geometry_snapshot->Invalidate();
+  }
+
   // For non-dedicated contexts, add directly to read buffer
   if (!context_->isDedicated()) {
     std::lock_guard<std::mutex> lock(read_buffer_mutex_);
     read_buffer_->AddCommand(type, args_01.get(), native_binding_object, nativePtr2, request_ui_update);
+    geometry_snapshot->MarkCommandsVisibleToDart();
 
     if (type == UICommand::kFinishRecordingCommand && read_buffer_->size() > 0) {
       context_->dartMethodPtr()->requestBatchUpdate(false, context_->contextId());
@@ -71,6 +98,10 @@ void SharedUICommand::AddCommand(UICommand type,
       package_buffer_->FlushCurrentPackage();
     }
 
+    if (!package_buffer_->HasDeferredPackages()) {
+      geometry_snapshot->MarkCommandsVisibleToDart();
+    }
+
     if (should_request_batch_update) {
       context_->dartMethodPtr()->requestBatchUpdate(true, context_->contextId());
     }
@@ -85,9 +116,12 @@ void SharedUICommand::AddStyleByIdCommand(void* native_binding_object,
                                          int64_t value_slot,
                                          SharedNativeString* base_href,
                                          bool request_ui_update) {
+  context_->layoutGeometrySnapshot()->Invalidate();
+
   if (!context_->isDedicated()) {
     std::lock_guard<std::mutex> lock(read_buffer_mutex_);
     read_buffer_->AddStyleByIdCommand(native_binding_object, property_id, value_slot, base_href, request_ui_update);
+    context_->layoutGeometrySnapshot()->MarkCommandsVisibleToDart();
     return;
   }
 
@@ -100,6 +134,49 @@ void SharedUICommand::AddStyleByIdCommand(void* native_binding_object,
   ui_command_sync_strategy_->RecordStyleByIdCommand(item, request_ui_update);
 }
 
+int64_t SharedUICommand::StyleValueSlot(const String& value) {
+  if (value.IsEmpty()) {
+    return 0;
+  }
+
+  bool needs_definition = false;
+  int64_t handle = style_value_table_.Intern(value, needs_definition);
+  if (handle < 0) {
+    auto* value_ns = stringToNativeString(value).release();
+    return static_cast<int64_t>(reinterpret_cast<intptr_t>(value_ns));
+  }
+
+  if (needs_definition) {
+    AddCommand(UICommand::kDefineStyleValue, stringToNativeString(value), nullptr,
+               reinterpret_cast<void*>(static_cast<intptr_t>(handle)), false);
+  }
+  return (handle << 1) | 1;
+}
+
+void SharedUICommand::AddTypedStyleByIdCommand(void* native_binding_object,
+                                               int32_t property_id,
+                                               int64_t value_bits,
+                                               int64_t descriptor,
+                                               bool request_ui_update) {
+  context_->layoutGeometrySnapshot()->Invalidate();
+
+  if (!context_->isDedicated()) {
+    std::lock_guard<std::mutex> lock(read_buffer_mutex_);
+    read_buffer_->AddTypedStyleByIdCommand(native_binding_object, property_id, value_bits, descriptor,
+                                           request_ui_update);
+    context_->layoutGeometrySnapshot()->MarkCommandsVisibleToDart();
+    return;
+  }
+
+  UICommandItem item{};
+  item.type = static_cast<int32_t>(UICommand::kSetStyleByIdTyped);
+  item.args_01_length = property_id;
+  item.string_01 = value_bits;
+  item.nativePtr = static_cast<int64_t>(reinterpret_cast<intptr_t>(native_binding_object));
+  item.nativePtr2 = descriptor;
+  ui_command_sync_strategy_->RecordStyleByIdCommand(item, request_ui_update);
+}
+
 void* SharedUICommand::data() {
   std::lock_guard<std::mutex> lock(read_buffer_mutex_);
 
@@ -112,6 +189,8 @@ void* SharedUICommand::data() {
   pack->data = read_buffer_->data();
   pack->buffer_head = read_buffer_.release();
 
+  context_->dartIsolateContext()->metrics()->Record(MetricsHistogram::kUICommandFlushSize, pack->length);
+
   // Create new read buffer
   read_buffer_ = std::make_unique<UICommandBuffer>(context_);
 
@@ -122,6 +201,8 @@ void SharedUICommand::clear() {
   std::lock_guard<std::mutex> lock(read_buffer_mutex_);
   read_buffer_->clear();
   package_buffer_->Clear();
+  // Dropped commands may include definitions Dart never saw.
+  style_value_table_.Reset();
 }
 
 bool SharedUICommand::empty() {
@@ -155,6 +236,9 @@ void SharedUICommand::SyncAllPackages() {
   if (!context_->needs_first_paint_style_sync_) {
     package_buffer_->FlushDeferredPackages();
   }
+  if (!package_buffer_->HasDeferredPackages()) {
+    context_->layoutGeometrySnapshot()->MarkCommandsVisibleToDart();
+  }
 }
 
 void SharedUICommand::FillReadBuffer() {
@@ -13,6 +13,7 @@
 #include <memory>
 #include <mutex>
 #include "foundation/native_type.h"
+#include "foundation/style_value_table.h"
 #include "foundation/ui_command_buffer.h"
 #include "foundation/ui_command_ring_buffer.h"
 #include "foundation/ui_command_strategy.h"
@@ -46,6 +47,20 @@ class SharedUICommand : public DartReadable {
                            SharedNativeString* base_href,
                            bool request_ui_update = true);
 
+  // Returns the kSetStyleById value slot for the serialized |value|. Short
+  // values are interned in the style value table, emitting kDefineStyleValue
+  // the first time a handle is bound; other values are copied to a fresh
+  // NativeString that Dart releases. Empty values map to 0.
+  int64_t StyleValueSlot(const String& value);
+
+  // Fast-path for UICommand::kSetStyleByIdTyped.
+  // See UICommandBuffer::AddTypedStyleByIdCommand for the data encoding.
+  void AddTypedStyleByIdCommand(void* native_binding_object,
+                                int32_t property_id,
+                                int64_t value_bits,
+                                int64_t descriptor,
+                                bool request_ui_update = true);
+
   void ConfigureSyncCommandBufferSize(size_t size);
 
   void* data();
@@ -65,6 +80,9 @@ class SharedUICommand : public DartReadable {
   // Buffer for dart-side reading
   std::unique_ptr<UICommandBuffer> read_buffer_;
   std::mutex read_buffer_mutex_;
+
+  // Serialized style values Dart already holds, see StyleValueSlot().
+  StyleValueTable style_value_table_;
   
   // Statistics
   std::atomic<uint64_t> total_commands_{0};
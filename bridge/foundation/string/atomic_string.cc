@@ -12,6 +12,7 @@
 #include "atomic_string_table.h"
 #include "bindings/qjs/native_string_utils.h"
 #include "core/executing_context.h"
+#include "string_utils.h"
 #include "utf8_codecs.h"
 #include "wtf_string.h"
 
@@ -109,6 +110,17 @@ AtomicString AtomicString::CreateFromUTF8(const UTF8String& chars) {
   return CreateFromUTF8(chars.c_str(), chars.length());
 }
 
+AtomicString AtomicString::CreateStatic(const char* chars) {
+  size_t length = strlen(chars);
+  for (size_t i = 0; i < length; i++) {
+    if (!IsASCII(chars[i]))
+      return CreateFromUTF8(chars, length);
+  }
+  AtomicString result;
+  result.string_ = AtomicStringTable::Instance().AddStatic(reinterpret_cast<const LChar*>(chars), length);
+  return result;
+}
+
 AtomicString::AtomicString(const uint16_t* str, size_t length) {
   string_ = AtomicStringTable::Instance().Add((const char16_t*)str, length);
 }
@@ -117,7 +129,7 @@ AtomicString::AtomicString(const UChar* str, size_t length) {
   string_ = AtomicStringTable::Instance().Add((const char16_t*)str, length);
 }
 
-AtomicString::AtomicString(const std::shared_ptr<StringImpl>& string_impl) {
+AtomicString::AtomicString(const scoped_refptr<StringImpl>& string_impl) {
   string_ = AtomicStringTable::Instance().Add(string_impl);
 }
 
@@ -152,10 +164,10 @@ AtomicString::AtomicString(const std::unique_ptr<AutoFreeNativeString>& native_s
 AtomicString AtomicString::LowerASCII(AtomicString source) {
   if (LIKELY(source.IsLowerASCII()))
     return source;
-  std::shared_ptr<StringImpl> impl = source.Impl();
+  scoped_refptr<StringImpl> impl = source.Impl();
   // if impl is null, then IsLowerASCII() should have returned true.
   DCHECK(impl);
-  std::shared_ptr<StringImpl> new_impl = StringImpl::LowerASCII(impl);
+  scoped_refptr<StringImpl> new_impl = StringImpl::LowerASCII(impl);
   return {std::move(new_impl)};
 }
 
@@ -164,7 +176,7 @@ AtomicString AtomicString::LowerASCII() const {
 }
 
 AtomicString AtomicString::UpperASCII() const {
-  std::shared_ptr<StringImpl> impl = Impl();
+  scoped_refptr<StringImpl> impl = Impl();
   if (UNLIKELY(!impl))
     return *this;
   return AtomicString(StringImpl::UpperASCII(impl));
@@ -179,9 +191,7 @@ std::unique_ptr<SharedNativeString> AtomicString::ToNativeString() const {
     const uint8_t* p = reinterpret_cast<const uint8_t*>(string_->Characters8());
     uint32_t len = string_->length();
     uint16_t* u16_buffer = (uint16_t*)dart_malloc(sizeof(uint16_t) * (len + 1));
-    for (size_t i = 0; i < len; i++) {
-      u16_buffer[i] = static_cast<uint8_t>(p[i]);
-    }
+    WidenLatin1ToUTF16(p, u16_buffer, len);
     u16_buffer[len] = 0;  // Null terminate
 
     return std::make_unique<SharedNativeString>(u16_buffer, len);
@@ -196,6 +206,18 @@ std::unique_ptr<SharedNativeString> AtomicString::ToNativeString() const {
   }
 }
 
+std::unique_ptr<SharedNativeString> AtomicString::ToCompactNativeString() const {
+  if (string_ == nullptr || !string_->Is8Bit()) {
+    return ToNativeString();
+  }
+
+  uint32_t len = string_->length();
+  auto* buffer = (uint8_t*)dart_malloc(len + 1);
+  memcpy(buffer, string_->Characters8(), len);
+  buffer[len] = 0;  // Null terminate
+  return SharedNativeString::FromLatin1(buffer, len);
+}
+
 std::unique_ptr<SharedNativeString> AtomicString::ToStylePropertyNameNativeString() const {
   if (string_ == nullptr) {
     return AtomicString::Empty().ToNativeString();
@@ -286,7 +308,7 @@ AtomicString AtomicString::RemoveCharacters(webf::CharacterMatchFunctionPtr ptr)
   return StringImpl::RemoveCharacters(string_, ptr);
 }
 
-std::shared_ptr<StringImpl> AtomicString::AddSlowCase(std::shared_ptr<StringImpl>&& string) {
+scoped_refptr<StringImpl> AtomicString::AddSlowCase(scoped_refptr<StringImpl>&& string) {
   return AtomicStringTable::Instance().Add(std::move(string));
 }
 
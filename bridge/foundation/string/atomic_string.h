@@ -50,9 +50,12 @@ class AtomicString {
   AtomicString(UTF16StringView string_view);
   static AtomicString CreateFromUTF8(const UTF8Char* chars, size_t length);
   static AtomicString CreateFromUTF8(const UTF8String& chars);
+  // Atomizes a generated name. ASCII names become static strings that every
+  // thread shares without reference counting.
+  static AtomicString CreateStatic(const char* chars);
   AtomicString(const uint16_t* str, size_t length);
   AtomicString(const UChar* str, size_t length);
-  AtomicString(const std::shared_ptr<StringImpl>& string_impl);
+  AtomicString(const scoped_refptr<StringImpl>& string_impl);
 
   AtomicString(JSContext* ctx, JSValue qjs_value);
   AtomicString(JSContext* ctx, JSAtom qjs_atom);
@@ -69,6 +72,10 @@ class AtomicString {
   bool IsLowerASCII() const { return string_->IsLowerASCII(); }
 
   std::unique_ptr<SharedNativeString> ToNativeString() const;
+  // Like ToNativeString(), but 8-bit strings stay Latin-1 instead of being
+  // widened. Only for strings the Dart side reads through UICommandItem or
+  // NativeString, which decode both forms.
+  std::unique_ptr<SharedNativeString> ToCompactNativeString() const;
   std::unique_ptr<SharedNativeString> ToStylePropertyNameNativeString() const;
 
   [[nodiscard]] UTF8String ToUTF8String() const;
@@ -95,7 +102,7 @@ class AtomicString {
 
   AtomicString RemoveCharacters(CharacterMatchFunctionPtr);
 
-  std::shared_ptr<StringImpl> Impl() const { return string_; }
+  const scoped_refptr<StringImpl>& Impl() const { return string_; }
 
   // Find characters.
   size_t find(char16_t c, size_t start = 0) const { return string_->Find(c, start); }
@@ -145,15 +152,15 @@ class AtomicString {
   };
 
  private:
-  ALWAYS_INLINE static std::shared_ptr<StringImpl> Add(std::shared_ptr<StringImpl>&& r) {
+  ALWAYS_INLINE static scoped_refptr<StringImpl> Add(scoped_refptr<StringImpl>&& r) {
     if (!r)
       return std::move(r);
     return AddSlowCase(std::move(r));
   }
 
-  static std::shared_ptr<StringImpl> AddSlowCase(std::shared_ptr<StringImpl>&&);
+  static scoped_refptr<StringImpl> AddSlowCase(scoped_refptr<StringImpl>&&);
 
-  std::shared_ptr<StringImpl> string_ = nullptr;
+  scoped_refptr<StringImpl> string_ = nullptr;
 };
 
 // AtomicStringRef is a reference to an AtomicString's string data.
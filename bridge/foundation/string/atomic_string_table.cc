@@ -30,9 +30,9 @@ void AtomicStringTable::Clear() {
   table_.clear();
 }
 
-std::shared_ptr<StringImpl> AtomicStringTable::Add(std::shared_ptr<StringImpl> string) {
+scoped_refptr<StringImpl> AtomicStringTable::Add(scoped_refptr<StringImpl> string) {
   if (!string->length())
-    return StringImpl::empty_shared();
+    return StringImpl::empty_ref();
 
   auto result = table_.insert(string);
   
@@ -50,55 +50,81 @@ static size_t count_ascii(const uint8_t *buf, size_t len)
   return p - buf;
 }
 
-std::shared_ptr<StringImpl> AtomicStringTable::AddLatin1(const LChar* chars, unsigned int length) {
+scoped_refptr<StringImpl> AtomicStringTable::AddLatin1(const LChar* chars, unsigned int length) {
   if (!chars)
     return nullptr;
 
   if (!length)
-    return StringImpl::empty_shared();
+    return StringImpl::empty_ref();
 
-  std::shared_ptr<StringImpl> ptr = StringImpl::Create(chars, length);
+  scoped_refptr<StringImpl> ptr = StringImpl::Create(chars, length);
 
   auto result = table_.insert(ptr);
 
   return *result.first;
 }
 
-std::shared_ptr<StringImpl> AtomicStringTable::AddUTF8(const UTF8Char* chars, size_t length) {
+scoped_refptr<StringImpl> AtomicStringTable::AddUTF8(const UTF8Char* chars, size_t length) {
   if (!chars)
     return nullptr;
 
   if (!length)
-    return StringImpl::empty_shared();
+    return StringImpl::empty_ref();
 
-  std::shared_ptr<StringImpl> ptr = StringImpl::CreateFromUTF8(chars, length);
+  scoped_refptr<StringImpl> ptr = StringImpl::CreateFromUTF8(chars, length);
 
   auto result = table_.insert(ptr);
 
   return *result.first;
 }
 
-std::shared_ptr<StringImpl> AtomicStringTable::Add(const UChar* chars, unsigned int length) {
+scoped_refptr<StringImpl> AtomicStringTable::Add(const UChar* chars, unsigned int length) {
   if (!chars)
     return nullptr;
 
   if (!length)
-    return StringImpl::empty_shared();
+    return StringImpl::empty_ref();
 
-  std::shared_ptr<StringImpl> ptr = StringImpl::Create(chars, length);
+  scoped_refptr<StringImpl> ptr = StringImpl::Create(chars, length);
   auto result = table_.insert(ptr);
 
   return *result.first;
 }
 
-std::shared_ptr<StringImpl> AtomicStringTable::Add(const UTF8StringView& string_view) {
+scoped_refptr<StringImpl> AtomicStringTable::Add(const UTF8StringView& string_view) {
   if (string_view.empty())
-    return StringImpl::empty_shared();
+    return StringImpl::empty_ref();
 
-  std::shared_ptr<StringImpl> ptr = StringImpl::CreateFromUTF8(string_view.data(), string_view.length());
+  scoped_refptr<StringImpl> ptr = StringImpl::CreateFromUTF8(string_view.data(), string_view.length());
   auto result = table_.insert(ptr);
 
   return *result.first;
 }
 
-}  // namespace webf
\ No newline at end of file
+scoped_refptr<StringImpl> AtomicStringTable::AddStatic(const LChar* chars, size_t length) {
+  if (!length)
+    return StringImpl::empty_ref();
+
+  // Static names are cached process-wide and used from every JS thread, so
+  // this must never hand out one of this thread's refcounted strings.
+  auto existing = table_.find(StringImpl::Create(chars, length));
+  if (existing == table_.end()) {
+    scoped_refptr<StringImpl> string(StringImpl::CreateStatic(chars, length));
+    table_.insert(string);
+    return string;
+  }
+  if ((*existing)->IsStatic())
+    return *existing;
+
+  // Promoting this thread's string keeps it identical to what was already
+  // atomized here. If another thread made the static string first, strings
+  // atomized here earlier stay distinct from it; later ones resolve to it.
+  scoped_refptr<StringImpl> string(StringImpl::PromoteToStatic(existing->get()));
+  if (string.get() != existing->get()) {
+    table_.erase(existing);
+    table_.insert(string);
+  }
+  return string;
+}
+
+}  // namespace webf
@@ -41,16 +41,19 @@ class AtomicStringTable final {
   // Inserting strings into the table. Note that the return value from adding
   // a UChar string may be an LChar string as the table will attempt to
   // convert the string to save memory if possible.
-  std::shared_ptr<StringImpl> Add(std::shared_ptr<StringImpl>);
-  std::shared_ptr<StringImpl> AddLatin1(const LChar* chars, unsigned length);
-  std::shared_ptr<StringImpl> AddUTF8(const UTF8Char* chars, size_t length);
-  std::shared_ptr<StringImpl> Add(const char16_t* chars, uint32_t length);
-  std::shared_ptr<StringImpl> Add(const std::string_view& string_view);
+  scoped_refptr<StringImpl> Add(scoped_refptr<StringImpl>);
+  scoped_refptr<StringImpl> AddLatin1(const LChar* chars, unsigned length);
+  scoped_refptr<StringImpl> AddUTF8(const UTF8Char* chars, size_t length);
+  scoped_refptr<StringImpl> Add(const char16_t* chars, uint32_t length);
+  scoped_refptr<StringImpl> Add(const std::string_view& string_view);
+  // Returns the process-wide static string for |chars|, replacing or
+  // promoting a refcounted entry this thread already made for them.
+  scoped_refptr<StringImpl> AddStatic(const LChar* chars, size_t length);
 
   //  // Adding UTF8.
   //  // Returns null if the characters contain invalid utf8 sequences.
   //  // Pass null for the charactersEnd to automatically detect the length.
-  // std::shared_ptr<StringImpl> AddUTF8(const char* characters_start,
+  // scoped_refptr<StringImpl> AddUTF8(const char* characters_start,
   //                                   const char* characters_end);
   //
   //  // Returned as part of the WeakFind*() APIs below. Represents the result of
@@ -84,7 +87,7 @@ class AtomicStringTable final {
   //  bool ReleaseAndRemoveIfNeeded(std::shared_ptr<std::string>);
 
  private:
-  std::unordered_set<std::shared_ptr<StringImpl>, StringImpl::StringImplHasher, StringImpl::StringImplEqual> table_;
+  std::unordered_set<scoped_refptr<StringImpl>, StringImpl::StringImplHasher, StringImpl::StringImplEqual> table_;
 };
 
 }  // namespace webf
@@ -65,10 +65,10 @@ class StringBuffer {
     return Characters()[i];
   }
 
-  std::shared_ptr<StringImpl> Release() { return std::move(data_); }
+  scoped_refptr<StringImpl> Release() { return std::move(data_); }
 
  private:
-  std::shared_ptr<StringImpl> data_;
+  scoped_refptr<StringImpl> data_;
 };
 
 template <typename CharType>
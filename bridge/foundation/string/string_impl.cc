@@ -10,7 +10,10 @@
 #include "string_impl.h"
 #include <algorithm>
 #include <cassert>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include "ascii_fast_path.h"
 #include "bindings/qjs/native_string_utils.h"
 #include "core/base/strings/string_number_conversions.h"
@@ -43,16 +46,6 @@ inline void FreeStringMemory(void* ptr) {
 #endif
 }
 
-// Custom deleter for StringImpl objects allocated with platform-specific allocators
-struct StringImplDeleter {
-  void operator()(StringImpl* ptr) {
-    if (ptr) {
-      ptr->~StringImpl();  // Call destructor
-      FreeStringMemory(ptr);  // Free memory with matching allocator
-    }
-  }
-};
-
 }  // anonymous namespace
 
 DEFINE_GLOBAL(StringImpl, g_global_empty);
@@ -95,6 +88,11 @@ ALWAYS_INLINE bool Equal(const UChar* a, const StringView& b, size_t length) {
 StringImpl* StringImpl::empty_ = const_cast<StringImpl*>(&g_global_empty);
 StringImpl* StringImpl::empty16_bit_ = const_cast<StringImpl*>(&g_global_empty16_bit);
 
+void StringImpl::Destroy() {
+  this->~StringImpl();
+  FreeStringMemory(this);
+}
+
 void StringImpl::InitStatics() {
   new ((void*)empty_) StringImpl(kConstructEmptyString);
   new ((void*)empty16_bit_) StringImpl(kConstructEmptyString16Bit);
@@ -121,12 +119,12 @@ std::string StringImpl::ToUTF8String() {
   return UTF8Codecs::EncodeUTF16({Characters16(), length()});
 }
 
-std::shared_ptr<StringImpl> StringImpl::Create(const LChar* characters, size_t length) {
+scoped_refptr<StringImpl> StringImpl::Create(const LChar* characters, size_t length) {
   if (!characters || !length)
-    return empty_shared();
+    return empty_ref();
 
   LChar* data;
-  std::shared_ptr<StringImpl> string = CreateUninitialized(length, data);
+  scoped_refptr<StringImpl> string = CreateUninitialized(length, data);
   memcpy(data, characters, length * sizeof(char));
   data[length] = '\0';  // Add null termination
   unsigned hash = StringHasher::ComputeHashAndMaskTop8Bits(characters, length);
@@ -134,12 +132,12 @@ std::shared_ptr<StringImpl> StringImpl::Create(const LChar* characters, size_t l
   return string;
 }
 
-std::shared_ptr<StringImpl> StringImpl::Create(const UChar* characters, size_t length) {
+scoped_refptr<StringImpl> StringImpl::Create(const UChar* characters, size_t length) {
   if (!characters || !length)
-    return empty16_shared();
+    return empty16_ref();
 
   char16_t* data;
-  std::shared_ptr<StringImpl> string = CreateUninitialized(length, data);
+  scoped_refptr<StringImpl> string = CreateUninitialized(length, data);
   memcpy(data, characters, length * sizeof(char16_t));
   data[length] = '\0';  // Add null termination
   unsigned hash = StringHasher::ComputeHashForWideString(characters, length);
@@ -147,16 +145,74 @@ std::shared_ptr<StringImpl> StringImpl::Create(const UChar* characters, size_t l
   return string;
 }
 
+namespace {
+
+// Names are installed again each time a JS thread starts a runtime; the
+// strings are made once and leaked on purpose.
+struct StaticStringRegistry {
+  std::mutex mutex;
+  std::unordered_map<std::string_view, StringImpl*> strings;
+};
+
+StaticStringRegistry& GetStaticStringRegistry() {
+  static auto* registry = new StaticStringRegistry();
+  return *registry;
+}
+
+}  // namespace
+
+StringImpl* StringImpl::CreateStatic(const LChar* characters, size_t length) {
+  DCHECK(length);
+  StaticStringRegistry& registry = GetStaticStringRegistry();
+
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto it = registry.strings.find(std::string_view(reinterpret_cast<const char*>(characters), length));
+  if (it != registry.strings.end())
+    return it->second;
+
+  auto* string = static_cast<StringImpl*>(AllocateStringMemory(AllocationSize<LChar>(length) + 1));
+  auto* data = reinterpret_cast<LChar*>(string + 1);
+  memcpy(data, characters, length);
+  data[length] = '\0';
+  new (string) StringImpl(length, StringHasher::ComputeHashAndMaskTop8Bits(characters, length), kStaticString);
+  registry.strings.emplace(std::string_view(reinterpret_cast<const char*>(data), length), string);
+  return string;
+}
+
+StringImpl* StringImpl::PromoteToStatic(StringImpl* string) {
+  DCHECK(string->length());
+  if (string->IsStatic())
+    return string;
+  if (!string->Is8Bit()) {
+    std::string latin1 = string->ToUTF8String();
+    return CreateStatic(reinterpret_cast<const LChar*>(latin1.data()), latin1.size());
+  }
+
+  StaticStringRegistry& registry = GetStaticStringRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  std::string_view key(reinterpret_cast<const char*>(string->Characters8()), string->length());
+  auto it = registry.strings.find(key);
+  if (it != registry.strings.end())
+    return it->second;
+
+  // The caller's thread is the only one that has seen |string|, so nothing
+  // else is touching its refcount. From here on AddRef() and Release() skip
+  // it and it is never freed.
+  string->hash_and_flags_.fetch_or(kIsStatic, std::memory_order_relaxed);
+  registry.strings.emplace(key, string);
+  return string;
+}
+
 size_t StringImpl::GetHash() const {
   if (size_t hash = GetHashRaw())
     return hash;
   return HashSlowCase();
 }
 
-std::shared_ptr<StringImpl> StringImpl::CreateUninitialized(size_t length, LChar*& data) {
+scoped_refptr<StringImpl> StringImpl::CreateUninitialized(size_t length, LChar*& data) {
   if (!length) {
     data = nullptr;
-    return empty_shared();
+    return empty_ref();
   }
 
   // Allocate a single buffer large enough to contain the StringImpl
@@ -164,13 +220,13 @@ std::shared_ptr<StringImpl> StringImpl::CreateUninitialized(size_t length, LChar
   // heap allocation from this call.
   auto* string = static_cast<StringImpl*>(AllocateStringMemory(AllocationSize<LChar>(length) + 1));
   data = reinterpret_cast<LChar*>(string + 1);
-  return std::shared_ptr<StringImpl>(new (string) StringImpl(length, kForce8BitConstructor), StringImplDeleter{});
+  return AdoptRef(new (string) StringImpl(length, kForce8BitConstructor));
 }
 
-std::shared_ptr<StringImpl> StringImpl::CreateUninitialized(size_t length, UChar*& data) {
+scoped_refptr<StringImpl> StringImpl::CreateUninitialized(size_t length, UChar*& data) {
   if (!length) {
     data = nullptr;
-    return empty16_shared();
+    return empty16_ref();
   }
 
   // Allocate a single buffer large enough to contain the StringImpl
@@ -179,21 +235,21 @@ std::shared_ptr<StringImpl> StringImpl::CreateUninitialized(size_t length, UChar
   StringImpl* string = static_cast<StringImpl*>(AllocateStringMemory(AllocationSize<UChar>(length) + sizeof(UChar)));
   data = reinterpret_cast<UChar*>(string + 1);
 
-  return std::shared_ptr<StringImpl>(new (string) StringImpl(length), StringImplDeleter{});
+  return AdoptRef(new (string) StringImpl(length));
 }
 
 class StringImplAllocator {
  public:
-  using ResultStringType = std::shared_ptr<StringImpl>;
+  using ResultStringType = scoped_refptr<StringImpl>;
 
-  StringImplAllocator(const std::shared_ptr<StringImpl>& original) : original_(original) {}
+  StringImplAllocator(const scoped_refptr<StringImpl>& original) : original_(original) {}
 
   template <typename CharType>
-  std::shared_ptr<StringImpl> Alloc(size_t length, CharType*& buffer) {
+  scoped_refptr<StringImpl> Alloc(size_t length, CharType*& buffer) {
     return StringImpl::CreateUninitialized(length, buffer);
   }
 
-  std::shared_ptr<StringImpl> CoerceOriginal(const StringImpl& string) {
+  scoped_refptr<StringImpl> CoerceOriginal(const StringImpl& string) {
     // Return the original shared_ptr if the StringImpl hasn't changed
     if (&string == original_.get()) {
       return original_;
@@ -204,19 +260,19 @@ class StringImplAllocator {
   }
 
  private:
-  std::shared_ptr<StringImpl> original_;
+  scoped_refptr<StringImpl> original_;
 };
 
-std::shared_ptr<StringImpl> StringImpl::LowerASCII(const std::shared_ptr<StringImpl>& str) {
+scoped_refptr<StringImpl> StringImpl::LowerASCII(const scoped_refptr<StringImpl>& str) {
   return ConvertASCIICase(*str, LowerConverter(), StringImplAllocator(str));
 }
 
-std::shared_ptr<StringImpl> StringImpl::UpperASCII(const std::shared_ptr<StringImpl>& str) {
+scoped_refptr<StringImpl> StringImpl::UpperASCII(const scoped_refptr<StringImpl>& str) {
   return ConvertASCIICase(*str, UpperConverter(), StringImplAllocator(str));
 }
 
 template <typename CharType>
-ALWAYS_INLINE std::shared_ptr<StringImpl> StringImpl::RemoveCharacters(const std::shared_ptr<StringImpl>& str,
+ALWAYS_INLINE scoped_refptr<StringImpl> StringImpl::RemoveCharacters(const scoped_refptr<StringImpl>& str,
                                                                        const CharType* characters,
                                                                        CharacterMatchFunctionPtr find_match) {
   const CharType* from = characters;
@@ -251,7 +307,7 @@ ALWAYS_INLINE std::shared_ptr<StringImpl> StringImpl::RemoveCharacters(const std
   return data.Release();
 }
 
-std::shared_ptr<StringImpl> StringImpl::RemoveCharacters(const std::shared_ptr<StringImpl>& str,
+scoped_refptr<StringImpl> StringImpl::RemoveCharacters(const scoped_refptr<StringImpl>& str,
                                                          CharacterMatchFunctionPtr find_match) {
   if (str->Is8Bit())
     return RemoveCharacters(str, str->Characters8(), find_match);
@@ -324,10 +380,10 @@ bool StringImpl::StartsWith(const StringView& prefix) const {
   return Equal(Characters16(), prefix, prefix.length());
 }
 
-std::shared_ptr<StringImpl> StringImpl::Substring(const std::shared_ptr<StringImpl>& str,
+scoped_refptr<StringImpl> StringImpl::Substring(const scoped_refptr<StringImpl>& str,
                                                   size_t start, size_t length) {
   if (start >= str->length_)
-    return empty_shared();
+    return empty_ref();
   size_t max_length = str->length_ - start;
   if (length >= max_length) {
     if (!start) {
@@ -376,7 +432,7 @@ static inline bool IsCSSSpaceChar(char16_t c) {
   }
 }
 
-std::shared_ptr<StringImpl> StringImpl::StripWhiteSpace(const std::shared_ptr<StringImpl>& str) {
+scoped_refptr<StringImpl> StringImpl::StripWhiteSpace(const scoped_refptr<StringImpl>& str) {
   if (!str || !str->length_) {
     return str;
   }
@@ -462,14 +518,14 @@ static inline size_t CountASCII(const uint8_t* p, size_t len) {
   return count;
 }
 
-std::shared_ptr<StringImpl> StringImpl::CreateFromUTF8(const UTF8Char* utf8_data, size_t byte_length) {
+scoped_refptr<StringImpl> StringImpl::CreateFromUTF8(const UTF8Char* utf8_data, size_t byte_length) {
   if (!utf8_data || !byte_length)
-    return empty_shared();
+    return empty_ref();
 
   return CreateFromUTF8({utf8_data, byte_length});
 }
 
-std::shared_ptr<StringImpl> StringImpl::CreateFromUTF8(const UTF8StringView& string_view) {
+scoped_refptr<StringImpl> StringImpl::CreateFromUTF8(const UTF8StringView& string_view) {
   auto byte_length = string_view.length();
 
   const auto* p = reinterpret_cast<const uint8_t*>(string_view.data());
@@ -487,7 +543,7 @@ std::shared_ptr<StringImpl> StringImpl::CreateFromUTF8(const UTF8StringView& str
   if (UTF8Codecs::UTF16IsLatin1(u16)) {
     // All characters fit in 8-bit
     LChar* data;
-    std::shared_ptr<StringImpl> string = CreateUninitialized(u16.length(), data);
+    scoped_refptr<StringImpl> string = CreateUninitialized(u16.length(), data);
 
     // Copy u16 into
     std::ranges::copy(std::as_const(u16), data);
@@ -501,7 +557,7 @@ std::shared_ptr<StringImpl> StringImpl::CreateFromUTF8(const UTF8StringView& str
   } else {
     // Need 16-bit string
     char16_t* data;
-    std::shared_ptr<StringImpl> string = CreateUninitialized(u16.length(), data);
+    scoped_refptr<StringImpl> string = CreateUninitialized(u16.length(), data);
 
     std::memcpy(data, u16.data(), u16.length() * sizeof(UChar));
     data[u16.length()] = '\0';  // Add null termination
@@ -19,6 +19,7 @@
 #include "ascii_fast_path.h"
 #include "core/base/compiler_specific.h"
 #include "core/base/containers/span.h"
+#include "core/base/memory/scoped_refptr.h"
 #include "core/platform/static_constructors.h"
 #include "foundation/macros.h"
 #include "foundation/logging.h"
@@ -88,12 +89,12 @@ inline size_t Find(const UChar* characters,
 class StringImpl {
  public:
   struct StringImplHasher {
-    size_t operator()(const std::shared_ptr<StringImpl>& string_impl) const { return string_impl->GetHash(); }
+    size_t operator()(const scoped_refptr<StringImpl>& string_impl) const { return string_impl->GetHash(); }
   };
 
   // Custom equality function
   struct StringImplEqual {
-    bool operator()(const std::shared_ptr<StringImpl>& lhs, const std::shared_ptr<StringImpl>& rhs) const {
+    bool operator()(const scoped_refptr<StringImpl>& lhs, const scoped_refptr<StringImpl>& rhs) const {
       if (lhs.get() == rhs.get()) return true;
       if (!lhs || !rhs) return false;
       if (lhs->length() != rhs->length()) return false;
@@ -159,38 +160,59 @@ class StringImpl {
       : length_(0), hash_and_flags_(kAsciiPropertyCheckDone | kContainsOnlyAscii | kIsLowerAscii | kIsStatic) {}
 
   enum Force8Bit { kForce8BitConstructor };
-  StringImpl(size_t length, Force8Bit) : length_(length), hash_and_flags_(LengthToAsciiFlags(length) | kIs8Bit) {
+  StringImpl(size_t length, Force8Bit)
+      : length_(static_cast<uint32_t>(length)), hash_and_flags_(LengthToAsciiFlags(length) | kIs8Bit) {
     DCHECK(length_);
   }
 
-  StringImpl(size_t length) : length_(length), hash_and_flags_(LengthToAsciiFlags(length)) {
+  StringImpl(size_t length) : length_(static_cast<uint32_t>(length)), hash_and_flags_(LengthToAsciiFlags(length)) {
     DCHECK(length_);
   }
 
   enum StaticStringTag { kStaticString };
   StringImpl(size_t length, size_t hash, StaticStringTag)
-      : length_(length), hash_and_flags_(hash << kHashShift | LengthToAsciiFlags(length) | kIs8Bit | kIsStatic) {}
+      : length_(static_cast<uint32_t>(length)),
+        hash_and_flags_(hash << kHashShift | LengthToAsciiFlags(length) | kIs8Bit | kIsStatic) {}
 
   static StringImpl* empty_;
   static StringImpl* empty16_bit_;
 
-  ALWAYS_INLINE static std::shared_ptr<StringImpl> empty_shared() {
-    return std::shared_ptr<StringImpl>(empty_, [](StringImpl*) {});
+  ALWAYS_INLINE static scoped_refptr<StringImpl> empty_ref() { return scoped_refptr<StringImpl>(empty_); }
+  ALWAYS_INLINE static scoped_refptr<StringImpl> empty16_ref() { return scoped_refptr<StringImpl>(empty16_bit_); }
+
+  // Strings are confined to the thread whose AtomicStringTable made them, so
+  // the count is a plain integer. Static strings are shared by every thread
+  // and never counted or freed.
+  ALWAYS_INLINE void AddRef() const {
+    if (!IsStatic())
+      ++ref_count_;
   }
-  ALWAYS_INLINE static std::shared_ptr<StringImpl> empty16_shared() {
-    return std::shared_ptr<StringImpl>(empty16_bit_, [](StringImpl*) {});
+  ALWAYS_INLINE void Release() const {
+    if (!IsStatic() && --ref_count_ == 0)
+      const_cast<StringImpl*>(this)->Destroy();
   }
+  bool HasOneRef() const { return ref_count_ == 1; }
 
   size_t length() const { return length_; }
   bool Is8Bit() const { return hash_and_flags_.load(std::memory_order_relaxed) & kIs8Bit; }
+  bool IsStatic() const { return hash_and_flags_.load(std::memory_order_relaxed) & kIsStatic; }
 
-  static std::shared_ptr<StringImpl> Create(const LChar*, size_t length);
-  static std::shared_ptr<StringImpl> Create(const UChar*, size_t length);
+  static scoped_refptr<StringImpl> Create(const LChar*, size_t length);
+  static scoped_refptr<StringImpl> Create(const UChar*, size_t length);
   
   // Create a StringImpl from UTF-8 encoded data, converting to UTF-16 if necessary
   // Similar to QuickJS's JS_NewStringLen function
-  static std::shared_ptr<StringImpl> CreateFromUTF8(const UTF8Char* utf8_data, size_t byte_length);
-  static std::shared_ptr<StringImpl> CreateFromUTF8(const UTF8StringView& utf8_data);
+  static scoped_refptr<StringImpl> CreateFromUTF8(const UTF8Char* utf8_data, size_t byte_length);
+  static scoped_refptr<StringImpl> CreateFromUTF8(const UTF8StringView& utf8_data);
+
+  // Returns the process-wide static string with these characters, creating
+  // it on first use. Used for generated names, which every JS thread shares.
+  // Callers must pass ASCII.
+  static StringImpl* CreateStatic(const LChar*, size_t length);
+  // Makes |string|, a table entry owned by the calling thread, the static
+  // string for its characters, or returns the static string if one exists.
+  // Callers must pass ASCII.
+  static StringImpl* PromoteToStatic(StringImpl* string);
 
   static void InitStatics();
 
@@ -279,15 +301,15 @@ class StringImpl {
   template <typename CharType>
   ALWAYS_INLINE const CharType* GetCharacters() const;
 
-  static std::shared_ptr<StringImpl> CreateUninitialized(size_t length, LChar*& data);
-  static std::shared_ptr<StringImpl> CreateUninitialized(size_t length, UChar*& data);
+  static scoped_refptr<StringImpl> CreateUninitialized(size_t length, LChar*& data);
+  static scoped_refptr<StringImpl> CreateUninitialized(size_t length, UChar*& data);
 
-  static std::shared_ptr<StringImpl> LowerASCII(const std::shared_ptr<StringImpl>& str);
-  static std::shared_ptr<StringImpl> UpperASCII(const std::shared_ptr<StringImpl>& str);
-  static std::shared_ptr<StringImpl> RemoveCharacters(const std::shared_ptr<StringImpl>& str, CharacterMatchFunctionPtr);
+  static scoped_refptr<StringImpl> LowerASCII(const scoped_refptr<StringImpl>& str);
+  static scoped_refptr<StringImpl> UpperASCII(const scoped_refptr<StringImpl>& str);
+  static scoped_refptr<StringImpl> RemoveCharacters(const scoped_refptr<StringImpl>& str, CharacterMatchFunctionPtr);
   template <typename CharType>
-  ALWAYS_INLINE static std::shared_ptr<StringImpl> RemoveCharacters(const std::shared_ptr<StringImpl>& str, const CharType* characters, CharacterMatchFunctionPtr);
-  static std::shared_ptr<StringImpl> StripWhiteSpace(const std::shared_ptr<StringImpl>& str);
+  ALWAYS_INLINE static scoped_refptr<StringImpl> RemoveCharacters(const scoped_refptr<StringImpl>& str, const CharType* characters, CharacterMatchFunctionPtr);
+  static scoped_refptr<StringImpl> StripWhiteSpace(const scoped_refptr<StringImpl>& str);
 
   bool ContainsOnlyASCIIOrEmpty() const;
 
@@ -312,7 +334,7 @@ class StringImpl {
   bool StartsWith(char) const;
   bool StartsWith(const StringView& prefix) const;
 
-  static std::shared_ptr<StringImpl> Substring(const std::shared_ptr<StringImpl>& str, size_t pos, size_t len = UINT_MAX);
+  static scoped_refptr<StringImpl> Substring(const scoped_refptr<StringImpl>& str, size_t pos, size_t len = UINT_MAX);
 
   // The high bits of 'hash' are always empty, but we prefer to store our
   // flags in the low bits because it makes them slightly more efficient to
@@ -385,8 +407,11 @@ class StringImpl {
     // storing the same bits again with a bitwise or is idempotent.
   };
 
+  void Destroy();
+
+  mutable uint32_t ref_count_{1};
+  uint32_t length_;
   // 64-bit storage: low bits keep flags, higher bits store the full 32-bit hash
-  size_t length_;
   mutable std::atomic<uint64_t> hash_and_flags_;
 };
 
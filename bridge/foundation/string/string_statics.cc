@@ -50,16 +50,16 @@ DEFINE_GLOBAL(std::string, g_empty_string);
 void StringStatics::Init() {
   new ((void*)&g_empty_string) std::string();
   new ((void*)&g_null_atom) AtomicString(AtomicString::Null());
-  new ((void*)&g_empty_atom) AtomicString(AtomicString::CreateFromUTF8(""));
-  new ((void*)&g_star_atom) AtomicString(AtomicString::CreateFromUTF8("*"));
-  new ((void*)&g_xml_atom) AtomicString(AtomicString::CreateFromUTF8("xml"));
-  new ((void*)&g_xmlns_atom) AtomicString(AtomicString::CreateFromUTF8("xmlns"));
-  new ((void*)&g_xlink_atom) AtomicString(AtomicString::CreateFromUTF8("xlink"));
-  new ((void*)&g_http_atom) AtomicString(AtomicString::CreateFromUTF8("http"));
-  new ((void*)&g_https_atom) AtomicString(AtomicString::CreateFromUTF8("https"));
-  new ((void*)&g_class_atom) AtomicString(AtomicString::CreateFromUTF8("class"));
-  new ((void*)&g_style_atom) AtomicString(AtomicString::CreateFromUTF8("style"));
-  new ((void*)&g_id_atom) AtomicString(AtomicString::CreateFromUTF8("id"));
+  new ((void*)&g_empty_atom) AtomicString(AtomicString::CreateStatic(""));
+  new ((void*)&g_star_atom) AtomicString(AtomicString::CreateStatic("*"));
+  new ((void*)&g_xml_atom) AtomicString(AtomicString::CreateStatic("xml"));
+  new ((void*)&g_xmlns_atom) AtomicString(AtomicString::CreateStatic("xmlns"));
+  new ((void*)&g_xlink_atom) AtomicString(AtomicString::CreateStatic("xlink"));
+  new ((void*)&g_http_atom) AtomicString(AtomicString::CreateStatic("http"));
+  new ((void*)&g_https_atom) AtomicString(AtomicString::CreateStatic("https"));
+  new ((void*)&g_class_atom) AtomicString(AtomicString::CreateStatic("class"));
+  new ((void*)&g_style_atom) AtomicString(AtomicString::CreateStatic("style"));
+  new ((void*)&g_id_atom) AtomicString(AtomicString::CreateStatic("id"));
 }
 
 }  // namespace webf
\ No newline at end of file
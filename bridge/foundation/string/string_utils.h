@@ -10,8 +10,15 @@
 #define WEBF_FOUNDATION_STRING_UTILS_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace webf {
 
 static inline int _CodeUnitCompare(size_t l1, size_t l2, const char* c1, const char* c2) {
@@ -50,6 +57,29 @@ inline bool CodeUnitCompareLessThan(const std::string& a, const std::string& b)
   return CodeUnitCompare(a, b) < 0;
 }
 
+// Zero-extends |length| Latin-1 characters into UTF-16 code units, 16 at a
+// time where SSE2 or NEON is available.
+inline void WidenLatin1ToUTF16(const uint8_t* source, uint16_t* destination, size_t length) {
+  size_t i = 0;
+#ifdef __SSE2__
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= length; i += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_unpacklo_epi8(chunk, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 8), _mm_unpackhi_epi8(chunk, zero));
+  }
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+  for (; i + 16 <= length; i += 16) {
+    uint8x16_t chunk = vld1q_u8(source + i);
+    vst1q_u16(destination + i, vmovl_u8(vget_low_u8(chunk)));
+    vst1q_u16(destination + i + 8, vmovl_u8(vget_high_u8(chunk)));
+  }
+#endif
+  for (; i < length; i++) {
+    destination[i] = source[i];
+  }
+}
+
 }  // namespace webf
 
 #endif  // WEBF_FOUNDATION_STRING_UTILS_H_
@@ -23,7 +23,7 @@ static const String* g_null_string = nullptr;
 
 const String& String::EmptyString() {
   if (!g_empty_string) {
-    static String empty_string(StringImpl::empty_shared());
+    static String empty_string(StringImpl::empty_ref());
     g_empty_string = &empty_string;
   }
   return *g_empty_string;
@@ -31,7 +31,7 @@ const String& String::EmptyString() {
 
 const String& String::NullString() {
   if (!g_null_string) {
-    static String null_string(static_cast<std::shared_ptr<StringImpl>>(nullptr));
+    static String null_string(static_cast<scoped_refptr<StringImpl>>(nullptr));
     g_null_string = &null_string;
   }
   return *g_null_string;
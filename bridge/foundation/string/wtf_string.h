@@ -39,7 +39,7 @@ class String {
   String(const std::string&);
 
   // Construct a string referencing an existing StringImpl.
-  explicit String(std::shared_ptr<StringImpl> impl) : impl_(std::move(impl)) {}
+  explicit String(scoped_refptr<StringImpl> impl) : impl_(std::move(impl)) {}
   
   // Construct from StringView
   explicit String(const StringView& view);
@@ -129,7 +129,7 @@ class String {
 
   // Get the underlying implementation
   StringImpl* Impl() const { return impl_.get(); }
-  std::shared_ptr<StringImpl> ReleaseImpl() { return std::move(impl_); }
+  scoped_refptr<StringImpl> ReleaseImpl() { return std::move(impl_); }
 
   // Static empty string
   static const String& EmptyString();
@@ -156,7 +156,7 @@ class String {
 
 
  private:
-  std::shared_ptr<StringImpl> impl_;
+  scoped_refptr<StringImpl> impl_;
 };
 
 // Free functions
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "style_value_table.h"
+
+namespace webf {
+
+int64_t StyleValueTable::Intern(const String& value, bool& needs_definition) {
+  needs_definition = false;
+  if (value.IsEmpty() || value.length() > kMaxValueLength) {
+    return -1;
+  }
+
+  auto it = handles_.find(value);
+  if (it != handles_.end()) {
+    slots_[it->second].referenced = true;
+    return it->second;
+  }
+
+  uint32_t handle;
+  if (slots_.size() < kCapacity) {
+    handle = static_cast<uint32_t>(slots_.size());
+    slots_.push_back(Slot{value, false});
+  } else {
+    while (slots_[clock_hand_].referenced) {
+      slots_[clock_hand_].referenced = false;
+      clock_hand_ = (clock_hand_ + 1) % kCapacity;
+    }
+    handle = clock_hand_;
+    clock_hand_ = (clock_hand_ + 1) % kCapacity;
+    handles_.erase(slots_[handle].value);
+    slots_[handle] = Slot{value, false};
+  }
+
+  handles_.emplace(value, handle);
+  needs_definition = true;
+  return handle;
+}
+
+void StyleValueTable::Reset() {
+  handles_.clear();
+  slots_.clear();
+  clock_hand_ = 0;
+}
+
+}  // namespace webf
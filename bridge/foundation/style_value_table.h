@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_FOUNDATION_STYLE_VALUE_TABLE_H_
+#define BRIDGE_FOUNDATION_STYLE_VALUE_TABLE_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "foundation/string/wtf_string.h"
+
+namespace webf {
+
+// Interns serialized CSS values sent with UICommand::kSetStyleById, so that a
+// value shared by many elements ("1px solid #ccc", a font stack, a gradient)
+// crosses the bridge once per context instead of once per element.
+//
+// The Dart side keeps a mirror of the table which is only updated by
+// UICommand::kDefineStyleValue commands, so definitions travel in the same
+// ordered command stream as the commands that reference them. The table is
+// bounded; when full, handles are recycled with a second-chance clock.
+class StyleValueTable {
+ public:
+  static constexpr uint32_t kCapacity = 4096;
+  // Longer values are rarely shared and are sent inline.
+  static constexpr uint32_t kMaxValueLength = 512;
+
+  // Returns the handle of |value|, or -1 when it should be sent inline.
+  // |needs_definition| is set when the handle was (re)assigned to |value| and
+  // Dart has to receive a kDefineStyleValue before the handle is used.
+  int64_t Intern(const String& value, bool& needs_definition);
+
+  // Forgets every handle. Used when pending commands (and with them possibly
+  // some definitions) are dropped before reaching Dart.
+  void Reset();
+
+  size_t size() const { return slots_.size(); }
+
+ private:
+  struct Slot {
+    String value;
+    bool referenced{false};
+  };
+
+  std::unordered_map<String, uint32_t> handles_;
+  std::vector<Slot> slots_;
+  uint32_t clock_hand_{0};
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_FOUNDATION_STYLE_VALUE_TABLE_H_
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <vector>
+
+#include "bindings/qjs/cppgc/mutation_scope.h"
+#include "code_gen/css_property_names.h"
+#include "foundation/style_value_table.h"
+#include "foundation/ui_command_buffer.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+TEST(StyleValueTable, RepeatedValueIsDefinedOnce) {
+  StyleValueTable table;
+  bool needs_definition = false;
+
+  int64_t first = table.Intern(String::FromUTF8("1px solid #ccc"), needs_definition);
+  EXPECT_GE(first, 0);
+  EXPECT_TRUE(needs_definition);
+
+  int64_t second = table.Intern(String::FromUTF8("1px solid #ccc"), needs_definition);
+  EXPECT_EQ(first, second);
+  EXPECT_FALSE(needs_definition);
+
+  EXPECT_NE(table.Intern(String::FromUTF8("2px solid #ccc"), needs_definition), first);
+  EXPECT_TRUE(needs_definition);
+}
+
+TEST(StyleValueTable, LongAndEmptyValuesAreNotInterned) {
+  StyleValueTable table;
+  bool needs_definition = true;
+
+  EXPECT_EQ(table.Intern(String(), needs_definition), -1);
+  EXPECT_FALSE(needs_definition);
+
+  std::string long_value(StyleValueTable::kMaxValueLength + 1, 'a');
+  EXPECT_EQ(table.Intern(String::FromUTF8(long_value.c_str()), needs_definition), -1);
+  EXPECT_EQ(table.size(), 0u);
+}
+
+TEST(StyleValueTable, FullTableRecyclesUnreferencedHandles) {
+  StyleValueTable table;
+  bool needs_definition = false;
+  for (uint32_t i = 0; i < StyleValueTable::kCapacity; ++i) {
+    table.Intern(String::Number(i), needs_definition);
+  }
+  // Touch handle 0 so the clock skips it once.
+  EXPECT_EQ(table.Intern(String::Number(0), needs_definition), 0);
+
+  EXPECT_EQ(table.Intern(String::FromUTF8("fresh"), needs_definition), 1);
+  EXPECT_TRUE(needs_definition);
+  EXPECT_EQ(table.size(), StyleValueTable::kCapacity);
+
+  // The evicted value has to be defined again.
+  table.Intern(String::Number(1), needs_definition);
+  EXPECT_TRUE(needs_definition);
+  // The referenced one survived.
+  EXPECT_EQ(table.Intern(String::Number(0), needs_definition), 0);
+  EXPECT_FALSE(needs_definition);
+}
+
+TEST(StyleValueTable, SharedValueCrossesBridgeOncePerContext) {
+  auto env = TEST_init(nullptr, nullptr, 0, /*enable_blink=*/1);
+  auto* context = env->page()->executingContext();
+  TEST_runLoop(context);
+  context->uiCommandBuffer()->clear();
+
+  const char* script = R"JS(
+    const style = document.createElement('style');
+    style.textContent = `.item { font-family: Avenir, Helvetica, sans-serif; }`;
+    document.body.appendChild(style);
+    for (let i = 0; i < 8; i++) {
+      const div = document.createElement('div');
+      div.className = 'item';
+      document.body.appendChild(div);
+    }
+  )JS";
+  env->page()->evaluateScript(script, strlen(script), "vm://", 0);
+  TEST_runLoop(context);
+  {
+    MemberMutationScope scope{context};
+    context->document()->UpdateStyleForThisDocument();
+  }
+  context->uiCommandBuffer()->SyncAllPackages();
+
+  auto* pack = static_cast<UICommandBufferPack*>(context->uiCommandBuffer()->data());
+  auto* items = static_cast<UICommandItem*>(pack->data);
+  std::vector<UICommandItem> commands(items, items + pack->length);
+
+  int64_t font_family_commands = 0;
+  int64_t font_family_slot = 0;
+  for (const auto& item : commands) {
+    if (item.type == static_cast<int32_t>(UICommand::kSetStyleById) &&
+        item.args_01_length == static_cast<int32_t>(CSSPropertyID::kFontFamily)) {
+      font_family_commands++;
+      // Every element references the same interned handle.
+      EXPECT_EQ(item.string_01 & 1, 1);
+      if (font_family_slot == 0) {
+        font_family_slot = item.string_01;
+      }
+      EXPECT_EQ(item.string_01, font_family_slot);
+    }
+  }
+
+  EXPECT_EQ(font_family_commands, 8);
+
+  int64_t defines = 0;
+  for (const auto& item : commands) {
+    if (item.type == static_cast<int32_t>(UICommand::kDefineStyleValue) && item.nativePtr2 == font_family_slot >> 1) {
+      defines++;
+    }
+  }
+  EXPECT_EQ(defines, 1);
+}
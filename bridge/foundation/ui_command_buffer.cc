@@ -36,6 +36,8 @@ UICommandKind GetKindFromUICommand(UICommand command) {
       return UICommandKind::kEvent;
     case UICommand::kSetStyle:
     case UICommand::kSetStyleById:
+    case UICommand::kSetStyleByIdTyped:
+    case UICommand::kDefineStyleValue:
     case UICommand::kSetPseudoStyle:
     case UICommand::kRemovePseudoStyle:
     case UICommand::kClearPseudoStyle:
@@ -96,6 +98,21 @@ void UICommandBuffer::AddStyleByIdCommand(void* nativePtr,
   addCommand(item, request_ui_update);
 }
 
+void UICommandBuffer::AddTypedStyleByIdCommand(void* nativePtr,
+                                               int32_t property_id,
+                                               int64_t value_bits,
+                                               int64_t descriptor,
+                                               bool request_ui_update) {
+  UICommandItem item{};
+  item.type = static_cast<int32_t>(UICommand::kSetStyleByIdTyped);
+  item.args_01_length = property_id;
+  item.string_01 = value_bits;
+  item.nativePtr = static_cast<int64_t>(reinterpret_cast<intptr_t>(nativePtr));
+  item.nativePtr2 = descriptor;
+  updateFlags(UICommand::kSetStyleByIdTyped);
+  addCommand(item, request_ui_update);
+}
+
 void UICommandBuffer::updateFlags(UICommand command) {
   UICommandKind type = GetKindFromUICommand(command);
   kind_flag = kind_flag | type;
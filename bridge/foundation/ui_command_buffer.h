@@ -65,17 +65,27 @@ enum class UICommand {
   kRemoveIntersectionObserver,
   kDisconnectIntersectionObserver,
   // Append-only: set inline style using CSSPropertyID/CSSValueID integers (Blink mode fast-path).
-  kSetStyleById
+  kSetStyleById,
+  // Append-only: set inline style using a CSSPropertyID and a typed numeric/color value.
+  kSetStyleByIdTyped,
+  // Append-only: bind a serialized style value to a StyleValueTable handle on the Dart side.
+  kDefineStyleValue
 };
 
 #define MAXIMUM_UI_COMMAND_SIZE 2048
 
 struct UICommandItem {
+  // Set in args_01_length when string_01 holds Latin-1 characters rather than
+  // UTF-16 code units. QuickJS strings are shorter than 2^30, so the bit is free.
+  static constexpr int32_t kArgs01Latin1Flag = 1 << 30;
+
   UICommandItem() = default;
   explicit UICommandItem(int32_t type, SharedNativeString* args_01, void* nativePtr, void* nativePtr2)
       : type(type),
         string_01(reinterpret_cast<int64_t>(args_01 != nullptr ? args_01->string() : nullptr)),
-        args_01_length(args_01 != nullptr ? args_01->length() : 0),
+        args_01_length(args_01 != nullptr
+                           ? static_cast<int32_t>(args_01->length()) | (args_01->Is8Bit() ? kArgs01Latin1Flag : 0)
+                           : 0),
         nativePtr(reinterpret_cast<int64_t>(nativePtr)),
         nativePtr2(reinterpret_cast<int64_t>(nativePtr2)){};
   int32_t type{0};
@@ -100,14 +110,28 @@ class UICommandBuffer {
   // Fast-path for UICommand::kSetStyleById without allocating a payload struct.
   // Encoding:
   // - args_01_length: property id (CSSPropertyID integer value)
-  // - string_01: either a pointer to a NativeString (SharedNativeString*) holding the value (>= 0),
-  //              or a negative immediate CSSValueID: -(value_id + 1).
+  // - string_01: either a pointer to a NativeString (SharedNativeString*) holding the value (> 0, even),
+  //              a StyleValueTable handle defined by an earlier kDefineStyleValue: (handle << 1) | 1,
+  //              a negative immediate CSSValueID: -(value_id + 1), or 0 for an empty value.
   // - nativePtr2: optional base href NativeString (SharedNativeString*) pointer (may be nullptr).
   virtual void AddStyleByIdCommand(void* nativePtr,
                                   int32_t property_id,
                                   int64_t value_slot,
                                   SharedNativeString* base_href,
                                   bool request_ui_update = true);
+  // Fast-path for UICommand::kSetStyleByIdTyped.
+  // Encoding:
+  // - args_01_length: property id (CSSPropertyID integer value)
+  // - nativePtr2: descriptor. Bits 0-7 hold the NativeStyleValueType. For kNumeric bits 8-15 hold the
+  //               NativeStyleValueUnit; for kList bits 8-15 hold the CSSValue::ValueListSeparator and
+  //               bits 16-31 the item count.
+  // - string_01: kNumeric: IEEE-754 bits of the double value; kColor: 0xAARRGGBB;
+  //              kList: pointer to a dart_malloc'd NativeTypedStyleValue[count], released by Dart.
+  virtual void AddTypedStyleByIdCommand(void* nativePtr,
+                                        int32_t property_id,
+                                        int64_t value_bits,
+                                        int64_t descriptor,
+                                        bool request_ui_update = true);
   UICommandItem* data();
   uint32_t kindFlag();
   int64_t size();
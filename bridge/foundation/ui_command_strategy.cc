@@ -100,6 +100,8 @@ void UICommandSyncStrategy::RecordUICommand(UICommand type,
     }
     case UICommand::kSetStyle:
     case UICommand::kSetStyleById:
+    case UICommand::kSetStyleByIdTyped:
+    case UICommand::kDefineStyleValue:
     case UICommand::kSetPseudoStyle:
     case UICommand::kRemovePseudoStyle:
     case UICommand::kClearPseudoStyle:
@@ -30,6 +30,7 @@ typedef std::function<void(bool)> DartWork;
 typedef void (*AllocateNewPageCallback)(Dart_Handle dart_handle, void*);
 typedef void (*DisposePageCallback)(Dart_Handle dart_handle);
 typedef void (*InvokeModuleEventCallback)(Dart_Handle dart_handle, void*);
+typedef void (*DispatchEventBatchCallback)(Dart_Handle dart_handle);
 typedef void (*EvaluateQuickjsByteCodeCallback)(Dart_Handle dart_handle, int8_t);
 typedef void (*DumpQuickjsByteCodeCallback)(Dart_Handle);
 typedef void (*ParseHTMLCallback)(Dart_Handle);
@@ -39,7 +40,8 @@ typedef void (*InvokeJSFunctionRefCallback)(void* resolver, NativeValue* success
 WEBF_EXPORT_C
 void* initDartIsolateContextSync(int64_t dart_port,
                                  uint64_t* dart_methods,
-                                 int32_t dart_methods_len);
+                                 int32_t dart_methods_len,
+                                 const char* bytecode_cache_directory);
 
 WEBF_EXPORT_C
 void allocateNewPage(double thread_identity,
@@ -62,6 +64,11 @@ void* allocateNewPageSync(double thread_identity,
 WEBF_EXPORT_C
 int64_t newPageIdSync();
 
+// Number of fully initialized pages each dedicated JS thread keeps ready for
+// allocateNewPage. 0 disables prewarming.
+WEBF_EXPORT_C
+void setPrewarmedPageCount(void* dart_isolate_context, int32_t count);
+
 WEBF_EXPORT_C
 void disposePage(double dedicated_thread,
                  void* dart_isolate_context,
@@ -146,6 +153,18 @@ void onColorSchemeChanged(void* page, const char* scheme, int32_t length);
 WEBF_EXPORT_C
 int8_t updateStyleForThisDocument(void* page);
 
+// Layout geometry snapshot, see core/dom/layout_geometry_snapshot.h.
+// getLayoutGeometryGeneration() is read on the Dart thread before flushing UI
+// commands; publishLayoutGeometry() hands over the rects laid out from them and
+// takes ownership of the dart-allocated |entries|. clearLayoutGeometry() drops
+// the current table after a layout change JS did not cause, such as scrolling.
+WEBF_EXPORT_C
+int64_t getLayoutGeometryGeneration(void* page);
+WEBF_EXPORT_C
+void publishLayoutGeometry(void* page, int64_t generation, void* entries, int32_t length);
+WEBF_EXPORT_C
+void clearLayoutGeometry(void* page);
+
 WEBF_EXPORT_C
 void* parseSVGResult(const char* code, int32_t length);
 WEBF_EXPORT_C
@@ -158,6 +177,14 @@ void invokeModuleEvent(void* page,
                        NativeValue* extra,
                        Dart_Handle dart_handle,
                        InvokeModuleEventCallback result_callback);
+// Dispatches |count| NativeDispatchEventItems to JS in one task and calls back
+// once every item carries its result.
+WEBF_EXPORT_C
+void dispatchEventBatch(void* page,
+                        void* items,
+                        int32_t count,
+                        Dart_Handle dart_handle,
+                        DispatchEventBatchCallback result_callback);
 
 WEBF_EXPORT_C
 void* allocateNativeBindingObject();
@@ -170,6 +197,9 @@ void batchFreeNativeBindingObjects(void** pointers, int32_t count);
 
 WEBF_EXPORT_C
 WebFInfo* getWebFInfo();
+// Names Dart may receive as TAG_BINDING_NAME, indexed by id. See BindingNameTable.
+WEBF_EXPORT_C
+const char* const* getBindingNameTable(int32_t* count);
 WEBF_EXPORT_C
 void dispatchUITask(void* page, void* context, void* callback);
 WEBF_EXPORT_C
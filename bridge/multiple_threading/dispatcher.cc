@@ -7,6 +7,7 @@
 #include "core/dart_isolate_context.h"
 #include "core/page.h"
 #include "foundation/logging.h"
+#include <algorithm>
 #include <vector>
 
 using namespace webf;
@@ -15,14 +16,25 @@ namespace webf {
 
 namespace multi_threading {
 
-Dispatcher::Dispatcher(Dart_Port dart_port) : dart_port_(dart_port) {}
+Dispatcher::Dispatcher(Dart_Port dart_port)
+    : dart_port_(dart_port), max_js_threads_(std::max(2u, std::thread::hardware_concurrency())) {}
 
 Dispatcher::~Dispatcher() {}
 
 void Dispatcher::AllocateNewJSThread(int32_t js_context_id) {
   assert(js_threads_.count(js_context_id) == 0);
-  js_threads_[js_context_id] = std::make_unique<Looper>(js_context_id);
-  js_threads_[js_context_id]->Start();
+  JSWorker* worker;
+  if (workers_.size() < max_js_threads_) {
+    workers_.push_back(JSWorker{std::make_shared<Looper>(next_worker_id_++), 0});
+    worker = &workers_.back();
+    worker->looper->Start();
+  } else {
+    worker = &*std::min_element(workers_.begin(), workers_.end(), [](const JSWorker& a, const JSWorker& b) {
+      return a.thread_groups < b.thread_groups;
+    });
+  }
+  worker->thread_groups++;
+  js_threads_[js_context_id] = worker->looper;
 }
 
 bool Dispatcher::IsThreadGroupExist(int32_t js_context_id) {
@@ -37,24 +49,47 @@ bool Dispatcher::IsThreadBlocked(int32_t js_context_id) {
   return loop->isBlocked();
 }
 
-void Dispatcher::KillJSThreadSync(int32_t js_context_id) {
+void Dispatcher::KillJSThread(int32_t js_context_id) {
   assert(js_threads_.count(js_context_id) > 0);
-  auto& looper = js_threads_[js_context_id];
-  PostToJsSync(
-      true, js_context_id, [](bool cancel, Looper* looper) { looper->ExecuteOpaqueFinalizer(); },
-      js_threads_[js_context_id].get());
-  looper->Stop();
+  std::shared_ptr<Looper> looper = js_threads_[js_context_id];
+  auto worker = std::find_if(workers_.begin(), workers_.end(),
+                             [&looper](const JSWorker& worker) { return worker.looper == looper; });
+  assert(worker != workers_.end());
+  bool last_group = --worker->thread_groups == 0;
+
+  auto opaque = opaques_.find(js_context_id);
+  if (opaque != opaques_.end()) {
+    ThreadGroupOpaque group = opaque->second;
+    opaques_.erase(opaque);
+    if (last_group) {
+      looper->PostMessageSync([](bool cancel, ThreadGroupOpaque group) { group.finalizer(group.opaque); }, group);
+    } else {
+      // Another group on this worker may be blocked in a sync call waiting
+      // for the Dart thread, so the finalizer is only queued behind it.
+      looper->PostMessage([](ThreadGroupOpaque group) { group.finalizer(group.opaque); }, group);
+    }
+  }
   js_threads_.erase(js_context_id);
+
+  if (last_group) {
+    looper->Stop();
+    workers_.erase(worker);
+  }
 }
 
 void Dispatcher::SetOpaqueForJSThread(int32_t js_context_id, void* opaque, OpaqueFinalizer finalizer) {
   assert(js_threads_.count(js_context_id) > 0);
-  js_threads_[js_context_id]->SetOpaque(opaque, finalizer);
+  opaques_[js_context_id] = ThreadGroupOpaque{opaque, finalizer};
 }
 
 void* Dispatcher::GetOpaque(int32_t js_context_id) {
   assert(js_threads_.count(js_context_id) > 0);
-  return js_threads_[js_context_id]->opaque();
+  auto opaque = opaques_.find(js_context_id);
+  return opaque != opaques_.end() ? opaque->second.opaque : nullptr;
+}
+
+void Dispatcher::SetMaxJSThreads(size_t count) {
+  max_js_threads_ = std::max<size_t>(count, 1);
 }
 
 void Dispatcher::Dispose(webf::multi_threading::Callback callback) {
@@ -62,8 +97,8 @@ void Dispatcher::Dispose(webf::multi_threading::Callback callback) {
   WEBF_LOG(VERBOSE) << "[Dispatcher]: BEGIN EXE OPAQUE FINALIZER ";
 #endif
 
-  for (auto&& thread : js_threads_) {
-    auto* page_group = static_cast<PageGroup*>(thread.second->opaque());
+  for (auto&& group : opaques_) {
+    auto* page_group = static_cast<PageGroup*>(group.second.opaque);
     for (auto& page : (*page_group->pages())) {
       page->executingContext()->SetContextInValid();
     }
@@ -108,7 +143,7 @@ void Dispatcher::Dispose(webf::multi_threading::Callback callback) {
   });
 }
 
-std::unique_ptr<Looper>& Dispatcher::looper(int32_t js_context_id) {
+std::shared_ptr<Looper>& Dispatcher::looper(int32_t js_context_id) {
   assert(js_threads_.count(js_context_id) > 0);
   return js_threads_[js_context_id];
 }
@@ -157,7 +192,7 @@ bool Dispatcher::NotifyDart(const DartWork* work_ptr, bool is_sync) {
 }
 
 void Dispatcher::FinalizeAllJSThreads(webf::multi_threading::Callback callback) {
-  std::atomic<size_t> unfinished_thread = js_threads_.size();
+  std::atomic<size_t> unfinished_thread = opaques_.size();
 
   std::atomic<bool> is_final_async_dart_task_complete{false};
 
@@ -165,14 +200,14 @@ void Dispatcher::FinalizeAllJSThreads(webf::multi_threading::Callback callback)
     is_final_async_dart_task_complete = true;
   }
 
-  for (auto&& thread : js_threads_) {
+  for (auto&& group : opaques_) {
     PostToJs(
-        true, thread.first,
-        [&unfinished_thread, &thread, &is_final_async_dart_task_complete](Looper* looper) {
+        true, group.first,
+        [&unfinished_thread, &group, &is_final_async_dart_task_complete]() {
 #if ENABLE_LOG
-          WEBF_LOG(VERBOSE) << "[Dispatcher]: RUN JS FINALIZER, context_id: " << thread.first;
+          WEBF_LOG(VERBOSE) << "[Dispatcher]: RUN JS FINALIZER, context_id: " << group.first;
 #endif
-          looper->ExecuteOpaqueFinalizer();
+          group.second.finalizer(group.second.opaque);
           unfinished_thread--;
 
 #if ENABLE_LOG
@@ -182,8 +217,7 @@ void Dispatcher::FinalizeAllJSThreads(webf::multi_threading::Callback callback)
             is_final_async_dart_task_complete = true;
             return;
           }
-        },
-        thread.second.get());
+        });
 #if ENABLE_LOG
     WEBF_LOG(VERBOSE) << "[Dispatcher]: POST TO JS THREAD";
 #endif
@@ -206,8 +240,8 @@ void Dispatcher::StopAllJSThreads() {
 #if ENABLE_LOG
   WEBF_LOG(VERBOSE) << "[Dispatcher]: FINISH EXEC OPAQUE FINALIZER ";
 #endif
-  for (auto&& thread : js_threads_) {
-    thread.second->Stop();
+  for (auto&& worker : workers_) {
+    worker.looper->Stop();
   }
 #if ENABLE_LOG
   WEBF_LOG(VERBOSE) << "[Dispatcher]: ALL THREAD STOPPED";
@@ -12,6 +12,7 @@
 #include <memory>
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 #include <mutex>
 #include <atomic>
 
@@ -31,9 +32,24 @@ namespace webf {
 
 namespace multi_threading {
 
+// Spare pages prewarmed on a JS thread run under ids at or below this one
+// until they are reassigned to a page Dart allocated. No thread group or Dart
+// controller answers to these ids, so nothing may be sent to Dart for them.
+constexpr double kFirstPrewarmedContextId = -1e12;
+
+inline bool IsPrewarmedContextId(double js_context_id) {
+  return js_context_id <= kFirstPrewarmedContextId;
+}
+
 /**
  * @brief thread dispatcher, used to dispatch tasks to dart thread or js thread.
  *
+ * JS thread groups run on a bounded set of worker threads. Each group gets a
+ * worker of its own until the limit is reached; further groups share the
+ * worker hosting the fewest groups, exactly like pages of a
+ * DedicatedThreadGroup share one thread. A group stays on its worker for its
+ * whole life, since QuickJS runtimes and the bindings' per-thread state cannot
+ * move between threads. A worker stops when its last group is killed.
  */
 class Dispatcher {
  public:
@@ -43,12 +59,22 @@ class Dispatcher {
   void AllocateNewJSThread(int32_t js_context_id);
   bool IsThreadGroupExist(int32_t js_context_id);
   bool IsThreadBlocked(int32_t js_context_id);
-  void KillJSThreadSync(int32_t js_context_id);
+  // Finalizes the group on its worker. Only the last group of a worker is
+  // waited for, before the worker stops; a shared worker gets the finalizer
+  // queued, since another group on it may be blocked on the Dart thread.
+  void KillJSThread(int32_t js_context_id);
+  // |finalizer| runs on the group's worker when the group is killed or the
+  // dispatcher disposed.
   void SetOpaqueForJSThread(int32_t js_context_id, void* opaque, OpaqueFinalizer finalizer);
   void* GetOpaque(int32_t js_context_id);
   void Dispose(Callback callback);
 
-  std::unique_ptr<Looper>& looper(int32_t js_context_id);
+  // Upper bound of worker threads; defaults to the number of cores. Only
+  // affects groups allocated afterwards.
+  void SetMaxJSThreads(size_t count);
+  size_t JSThreadCount() const { return workers_.size(); }
+
+  std::shared_ptr<Looper>& looper(int32_t js_context_id);
 
   template <typename Func, typename... Args>
   void PostToDart(bool dedicated_thread, Func&& func, Args&&... args) {
@@ -90,6 +116,9 @@ class Dispatcher {
     if (!dedicated_thread) {
       return std::invoke(std::forward<Func>(func), false, std::forward<Args>(args)...);
     }
+    if (IsPrewarmedContextId(js_context_id)) {
+      return std::invoke(std::forward<Func>(func), true, std::forward<Args>(args)...);
+    }
 
     auto task =
         std::make_shared<ConcreteSyncTask<Func, Args...>>(std::forward<Func>(func), std::forward<Args>(args)...);
@@ -202,8 +231,23 @@ class Dispatcher {
   void StopAllJSThreads();
 
  private:
+  struct JSWorker {
+    std::shared_ptr<Looper> looper;
+    size_t thread_groups;
+  };
+
+  struct ThreadGroupOpaque {
+    void* opaque;
+    OpaqueFinalizer finalizer;
+  };
+
   Dart_Port dart_port_;
-  std::unordered_map<int32_t, std::unique_ptr<Looper>> js_threads_;
+  // Thread group id -> the worker running it. Several ids may share a worker.
+  std::unordered_map<int32_t, std::shared_ptr<Looper>> js_threads_;
+  std::unordered_map<int32_t, ThreadGroupOpaque> opaques_;
+  std::vector<JSWorker> workers_;
+  size_t max_js_threads_;
+  int32_t next_worker_id_{0};
   std::unordered_set<DartWork*> pending_dart_tasks_;
   std::mutex pending_dart_tasks_mutex_;
   friend Looper;
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <future>
+#include <set>
+#include <thread>
+
+#include "multiple_threading/dispatcher.h"
+
+using namespace webf::multi_threading;
+
+namespace {
+
+std::thread::id ThreadOf(Dispatcher& dispatcher, int32_t js_context_id) {
+  return dispatcher.PostToJsSync(true, js_context_id, [](bool cancel) { return std::this_thread::get_id(); });
+}
+
+void CountFinalized(void* p) {
+  (*static_cast<int*>(p))++;
+}
+
+}  // namespace
+
+TEST(Dispatcher, ThreadGroupsShareBoundedWorkers) {
+  Dispatcher dispatcher(ILLEGAL_PORT);
+  dispatcher.SetMaxJSThreads(2);
+
+  for (int32_t id = 1; id <= 5; id++) {
+    dispatcher.AllocateNewJSThread(id);
+  }
+  EXPECT_EQ(dispatcher.JSThreadCount(), 2u);
+
+  std::set<std::thread::id> threads;
+  for (int32_t id = 1; id <= 5; id++) {
+    std::thread::id thread = ThreadOf(dispatcher, id);
+    // A group never moves between workers.
+    EXPECT_EQ(ThreadOf(dispatcher, id), thread);
+    EXPECT_NE(thread, std::this_thread::get_id());
+    threads.insert(thread);
+  }
+  EXPECT_EQ(threads.size(), 2u);
+  EXPECT_EQ(dispatcher.looper(1), dispatcher.looper(3));
+  EXPECT_EQ(dispatcher.looper(2), dispatcher.looper(4));
+
+  for (int32_t id = 1; id <= 5; id++) {
+    dispatcher.KillJSThread(id);
+  }
+  EXPECT_EQ(dispatcher.JSThreadCount(), 0u);
+}
+
+TEST(Dispatcher, WorkerStopsWithItsLastGroup) {
+  Dispatcher dispatcher(ILLEGAL_PORT);
+  dispatcher.SetMaxJSThreads(1);
+  int finalized_1 = 0;
+  int finalized_2 = 0;
+
+  dispatcher.AllocateNewJSThread(1);
+  dispatcher.SetOpaqueForJSThread(1, &finalized_1, CountFinalized);
+  dispatcher.AllocateNewJSThread(2);
+  dispatcher.SetOpaqueForJSThread(2, &finalized_2, CountFinalized);
+  EXPECT_EQ(dispatcher.GetOpaque(2), &finalized_2);
+
+  dispatcher.KillJSThread(1);
+  EXPECT_EQ(dispatcher.JSThreadCount(), 1u);
+  EXPECT_FALSE(dispatcher.IsThreadGroupExist(1));
+
+  // The surviving group keeps running on the shared worker, behind the
+  // finalizer of the killed one.
+  EXPECT_NE(ThreadOf(dispatcher, 2), std::this_thread::get_id());
+  EXPECT_EQ(finalized_1, 1);
+  EXPECT_EQ(finalized_2, 0);
+
+  dispatcher.KillJSThread(2);
+  EXPECT_EQ(finalized_2, 1);
+  EXPECT_EQ(dispatcher.JSThreadCount(), 0u);
+}
+
+TEST(Dispatcher, KillsGroupWhileWorkerWaitsOnDartThread) {
+  Dispatcher dispatcher(ILLEGAL_PORT);
+  dispatcher.SetMaxJSThreads(1);
+  int finalized_1 = 0;
+  int finalized_2 = 0;
+
+  dispatcher.AllocateNewJSThread(1);
+  dispatcher.SetOpaqueForJSThread(1, &finalized_1, CountFinalized);
+  dispatcher.AllocateNewJSThread(2);
+  dispatcher.SetOpaqueForJSThread(2, &finalized_2, CountFinalized);
+
+  // Group 2 holds the shared worker the way a sync Dart call does: until the
+  // Dart thread, here the test thread, answers.
+  std::promise<void> dart_answer;
+  std::shared_future<void> answered = dart_answer.get_future().share();
+  std::atomic<bool> waiting{false};
+  dispatcher.PostToJs(true, 2, [&waiting, answered]() {
+    waiting = true;
+    answered.wait();
+  });
+  while (!waiting) {
+    std::this_thread::yield();
+  }
+
+  // Must return without the worker, or neither thread could go on.
+  dispatcher.KillJSThread(1);
+  EXPECT_FALSE(dispatcher.IsThreadGroupExist(1));
+  EXPECT_EQ(dispatcher.JSThreadCount(), 1u);
+
+  dart_answer.set_value();
+  ThreadOf(dispatcher, 2);
+  EXPECT_EQ(finalized_1, 1);
+  EXPECT_EQ(finalized_2, 0);
+
+  dispatcher.KillJSThread(2);
+  EXPECT_EQ(finalized_2, 1);
+  EXPECT_EQ(dispatcher.JSThreadCount(), 0u);
+}
@@ -5,6 +5,8 @@
 #include "looper.h"
 #include <pthread.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <memory>
 
@@ -22,6 +24,13 @@ static void setThreadName(const std::string& name) {
 #endif
 }
 
+static int64_t NowInMilliseconds() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+thread_local Looper* current_looper = nullptr;
+
 // Helper struct to pass data to pthread
 struct ThreadData {
   Looper* looper;
@@ -36,9 +45,14 @@ static void* threadFunc(void* arg) {
   return nullptr;
 }
 
-Looper::Looper(int32_t js_id) : js_id_(js_id), running_(false), paused_(false) {}
+Looper::Looper(int32_t js_id)
+    : js_id_(js_id), running_(false), paused_(false), timer_wheel_(NowInMilliseconds()) {}
 
-Looper::~Looper() {}
+Looper::~Looper() {
+  while (Task* task = tasks_.Pop()) {
+    task->Release();
+  }
+}
 
 void Looper::Start() {
   std::lock_guard<std::mutex> lock(mutex_);
@@ -93,48 +107,94 @@ void Looper::Stop() {
   }
 }
 
+Looper* Looper::Current() {
+  return current_looper;
+}
+
 void Looper::ThreadMain() {
+  current_looper = this;
   Run();
+  current_looper = nullptr;
+}
+
+void Looper::Enqueue(Task* task) {
+  tasks_.Push(task);
+  if (sleeping_.load(std::memory_order_seq_cst)) {
+    // The looper set |sleeping_| under the mutex and only releases it by
+    // waiting, so taking it here guarantees the notification is not lost.
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    cv_.notify_one();
+  }
 }
 
 // private methods
+void Looper::WaitForTasks() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  sleeping_.store(true, std::memory_order_seq_cst);
+  auto ready = [this] { return !running_ || (!paused_ && !tasks_.Empty()); };
+  // The wheel is only touched from this thread, so reading it under the lock is safe.
+  int64_t next_deadline = timer_wheel_.NextDeadline();
+  if (next_deadline < 0) {
+    cv_.wait(lock, ready);
+  } else {
+    cv_.wait_until(lock, std::chrono::steady_clock::time_point(std::chrono::milliseconds(next_deadline)), ready);
+  }
+  sleeping_.store(false, std::memory_order_relaxed);
+}
+
 void Looper::Run() {
   while (true) {
-    std::shared_ptr<Task> task = nullptr;
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-      cv_.wait(lock, [this] { return !running_ || (!tasks_.empty() && !paused_); });
-
-      if (!running_) {
-        return;
+    Task* task = paused_ ? nullptr : tasks_.Pop();
+    if (task == nullptr) {
+      if (paused_ || tasks_.Empty()) {
+        WaitForTasks();
+      } else {
+        // A producer is halfway through linking its task.
+        std::this_thread::yield();
       }
+    }
 
-      if (!paused_ && !tasks_.empty()) {
-        task = std::move(tasks_.front());
-        tasks_.pop();
-      }
+    if (!running_) {
+      if (task != nullptr)
+        task->Release();
+      return;
     }
-    if (task != nullptr && running_) {
+
+    if (task != nullptr) {
       (*task)(false);
+      task->Release();
     }
+    RunExpiredTimers();
+  }
+}
+
+void Looper::RunExpiredTimers() {
+  if (paused_ || timer_wheel_.empty())
+    return;
+
+  std::vector<Callback> expired;
+  timer_wheel_.Advance(NowInMilliseconds(), expired);
+  for (auto& callback : expired) {
+    if (!running_)
+      return;
+    callback();
   }
 }
 
-void Looper::SetOpaque(void* p, OpaqueFinalizer finalizer) {
-  opaque_ = p;
-  opaque_finalizer_ = finalizer;
+TimerWheel::TimerId Looper::ScheduleTimer(int64_t delay_ms, Callback callback) {
+  return timer_wheel_.Schedule(NowInMilliseconds() + std::max<int64_t>(delay_ms, 0), std::move(callback));
 }
 
-bool Looper::isBlocked() {
-  return is_blocked_;
+void Looper::CancelTimer(TimerWheel::TimerId id) {
+  timer_wheel_.Cancel(id);
 }
 
-void* Looper::opaque() {
-  return opaque_;
+bool Looper::HasPendingTasks() {
+  return !tasks_.Empty();
 }
 
-void Looper::ExecuteOpaqueFinalizer() {
-  opaque_finalizer_(opaque_);
+bool Looper::isBlocked() {
+  return is_blocked_;
 }
 
 }  // namespace multi_threading
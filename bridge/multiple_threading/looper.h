@@ -6,14 +6,18 @@
 #define MULTI_THREADING_LOOPER_H_
 
 #include <pthread.h>
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <future>
-#include <queue>
+#include <memory>
+#include <mutex>
 #include <thread>
 
 #include "foundation/logging.h"
 #include "task.h"
+#include "task_queue.h"
+#include "timer_wheel.h"
 
 namespace webf {
 
@@ -36,65 +40,65 @@ class Looper {
 
   template <typename Func, typename... Args>
   void PostMessage(Func&& func, Args&&... args) {
-    auto task = std::make_shared<ConcreteTask<Func, Args...>>(std::forward<Func>(func), std::forward<Args>(args)...);
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-      tasks_.emplace(std::move(task));
-    }
-    cv_.notify_one();
+    Enqueue(new ConcreteTask<Func, Args...>(std::forward<Func>(func), std::forward<Args>(args)...));
   }
 
   template <typename Func, typename... Args>
   void PostMessageAndCallback(Func&& func, Callback&& callback, Args&&... args) {
-    auto task = std::make_shared<ConcreteCallbackTask<Func, Args...>>(
-        std::forward<Func>(func), std::forward<Args>(args)..., std::forward<Callback>(callback));
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-      tasks_.emplace(std::move(task));
-    }
-    cv_.notify_one();
+    Enqueue(new ConcreteCallbackTask<Func, Args...>(std::forward<Func>(func), std::forward<Args>(args)...,
+                                                    std::forward<Callback>(callback)));
   }
 
   template <typename Func, typename... Args>
   auto PostMessageSync(Func&& func, Args&&... args) -> std::invoke_result_t<Func, bool, Args...> {
-    auto task =
-        std::make_shared<ConcreteSyncTask<Func, Args...>>(std::forward<Func>(func), std::forward<Args>(args)...);
-    auto task_copy = task;
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-      tasks_.emplace(std::move(task));
-    }
-    cv_.notify_one();
-    task_copy->wait();
-
-    return task_copy->getResult();
+    auto* task = new ConcreteSyncTask<Func, Args...>(std::forward<Func>(func), std::forward<Args>(args)...);
+    // Drops this thread's reference once the result has been read.
+    std::unique_ptr<SyncTask, void (*)(SyncTask*)> reference(task, [](SyncTask* t) { t->Release(); });
+    Enqueue(task);
+    task->wait();
+
+    return task->getResult();
   }
 
   void Stop();
 
-  void SetOpaque(void* p, OpaqueFinalizer finalizer);
-  void* opaque();
+  // Runs |callback| on this looper's thread once |delay_ms| has elapsed.
+  // Timers are kept in a TimerWheel that only this thread touches, so both
+  // calls must be made from code already running on the looper.
+  TimerWheel::TimerId ScheduleTimer(int64_t delay_ms, Callback callback);
+  void CancelTimer(TimerWheel::TimerId id);
+
+  // Whether tasks are queued behind the one running now. Lets deferrable work
+  // scheduled on a timer wait for an idle looper. Looper thread only.
+  bool HasPendingTasks();
 
   bool isBlocked();
 
-  void ExecuteOpaqueFinalizer();
-  
+  // The looper running on the calling thread, or nullptr on threads that no
+  // looper owns, such as the Dart UI thread.
+  static Looper* Current();
+
   // Public method for pthread to run the looper
   void ThreadMain();
 
  private:
+  void Enqueue(Task* task);
+  void WaitForTasks();
   void Run();
+  void RunExpiredTimers();
 
+  // Posting never takes |mutex_| unless the looper is asleep; the mutex and
+  // |cv_| only serve to park and wake the looper thread.
+  TaskQueue tasks_;
+  std::atomic<bool> sleeping_{false};
   std::condition_variable cv_;
   std::mutex mutex_;
-  std::queue<std::shared_ptr<Task>> tasks_;
+  TimerWheel timer_wheel_;
   std::thread worker_;
   pthread_t pthread_worker_;
   bool has_pthread_ = false;
   bool paused_;
-  bool running_;
-  void* opaque_;
-  OpaqueFinalizer opaque_finalizer_;
+  std::atomic<bool> running_;
   int32_t js_id_;
   std::atomic<bool> is_blocked_;
   friend Dispatcher;
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "multiple_threading/looper.h"
+
+using namespace webf::multi_threading;
+
+TEST(Looper, RunsTasksFromManyProducersInPostOrder) {
+  constexpr int kProducers = 4;
+  constexpr int kTasksPerProducer = 20000;
+
+  Looper looper(0);
+  looper.Start();
+
+  std::vector<int> last_seen(kProducers, -1);
+  std::atomic<int> out_of_order{0};
+  std::atomic<int> ran{0};
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; p++) {
+    producers.emplace_back([&, p]() {
+      for (int i = 0; i < kTasksPerProducer; i++) {
+        looper.PostMessage(
+            [&](int producer, int index) {
+              if (last_seen[producer] + 1 != index)
+                out_of_order++;
+              last_seen[producer] = index;
+              ran++;
+            },
+            p, i);
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  // Sync tasks queue behind everything posted before them.
+  int total = looper.PostMessageSync([&](bool cancel) { return ran.load(); });
+  EXPECT_EQ(total, kProducers * kTasksPerProducer);
+  EXPECT_EQ(out_of_order, 0);
+  looper.Stop();
+}
+
+TEST(Looper, WakesUpForTasksPostedWhileAsleep) {
+  Looper looper(0);
+  looper.Start();
+
+  for (int i = 0; i < 100; i++) {
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    std::string result = looper.PostMessageSync([](bool cancel, int value) { return std::to_string(value); }, i);
+    EXPECT_EQ(result, std::to_string(i));
+  }
+  looper.Stop();
+}
+
+TEST(Looper, CallbackRunsAfterTask) {
+  Looper looper(0);
+  looper.Start();
+
+  std::vector<int> order;
+  looper.PostMessageAndCallback([&]() { order.emplace_back(1); }, [&]() { order.emplace_back(2); });
+  looper.PostMessageSync([](bool cancel) {});
+  EXPECT_EQ(order, (std::vector<int>{1, 2}));
+  looper.Stop();
+}
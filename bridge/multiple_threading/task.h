@@ -6,9 +6,12 @@
 #define MULTI_THREADING_TASK_H
 
 #include <any>
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <future>
+#include <tuple>
+#include <type_traits>
 
 #include "foundation/logging.h"
 
@@ -18,52 +21,68 @@ namespace multi_threading {
 
 using Callback = std::function<void()>;
 
+class TaskQueue;
+
 class Task {
  public:
   virtual ~Task() = default;
   virtual void operator()(bool cancel = false) = 0;
+  // Called by the looper once the task ran or was dropped.
+  virtual void Release() { delete this; }
+
+ private:
+  friend class TaskQueue;
+  std::atomic<Task*> next_{nullptr};
 };
 
+// The callable and its arguments are stored inline, so a posted task costs a
+// single allocation.
 template <typename Func, typename... Args>
 class ConcreteTask : public Task {
  public:
-  ConcreteTask(Func&& f, Args&&... args) : func_(std::bind(std::forward<Func>(f), std::forward<Args>(args)...)) {}
+  ConcreteTask(Func&& f, Args&&... args) : func_(std::forward<Func>(f)), args_(std::forward<Args>(args)...) {}
 
-  void operator()(bool cancel = false) override {
-    if (func_) {
-      func_();
-    }
-  }
+  void operator()(bool cancel = false) override { std::apply(func_, args_); }
 
  private:
-  std::function<void()> func_;
+  std::decay_t<Func> func_;
+  std::tuple<std::decay_t<Args>...> args_;
 };
 
 template <typename Func, typename... Args>
 class ConcreteCallbackTask : public Task {
  public:
   ConcreteCallbackTask(Func&& f, Args&&... args, Callback&& callback)
-      : func_(std::bind(std::forward<Func>(f), std::forward<Args>(args)...)),
-        callback_(std::forward<Callback>(callback)) {}
+      : func_(std::forward<Func>(f)), args_(std::forward<Args>(args)...), callback_(std::forward<Callback>(callback)) {}
 
   void operator()(bool cancel = false) override {
-    if (func_) {
-      func_();
-    }
+    std::apply(func_, args_);
     if (callback_) {
       callback_();
     }
   }
 
  private:
-  std::function<void()> func_;
+  std::decay_t<Func> func_;
+  std::tuple<std::decay_t<Args>...> args_;
   Callback callback_;
 };
 
+// Shared by the looper that runs it and the thread waiting for its result;
+// whichever calls Release() last frees it.
 class SyncTask : public Task {
  public:
   virtual ~SyncTask() = default;
   virtual void wait() = 0;
+
+  void Release() override {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+ private:
+  std::atomic<int> refs_{2};
 };
 
 template <typename Func, typename... Args>
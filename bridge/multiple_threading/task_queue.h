@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#ifndef MULTI_THREADING_TASK_QUEUE_H_
+#define MULTI_THREADING_TASK_QUEUE_H_
+
+#include <atomic>
+
+#include "task.h"
+
+namespace webf {
+
+namespace multi_threading {
+
+// Intrusive multi-producer single-consumer queue of tasks (Vyukov's design).
+// Push() is wait-free and may be called from any thread; Pop() and Empty()
+// belong to the consumer. Tasks are linked through Task::next_, so queueing
+// allocates nothing.
+class TaskQueue {
+ public:
+  TaskQueue() : head_(&stub_), tail_(&stub_) {}
+  TaskQueue(const TaskQueue&) = delete;
+  TaskQueue& operator=(const TaskQueue&) = delete;
+
+  void Push(Task* task) {
+    task->next_.store(nullptr, std::memory_order_relaxed);
+    // Sequentially consistent, so that a consumer going to sleep after this
+    // exchange either sees the task or is seen as sleeping by the producer.
+    Task* prev = head_.exchange(task, std::memory_order_seq_cst);
+    prev->next_.store(task, std::memory_order_release);
+  }
+
+  // Returns nullptr when the queue is empty, or while a producer is between
+  // the two steps of Push(); Empty() tells the two apart.
+  Task* Pop() {
+    Task* tail = tail_;
+    Task* next = tail->next_.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (next == nullptr)
+        return nullptr;
+      tail_ = next;
+      tail = next;
+      next = next->next_.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+      tail_ = next;
+      return tail;
+    }
+    if (tail != head_.load(std::memory_order_acquire))
+      return nullptr;
+    // |tail| is the last task; park the stub behind it so it can be unlinked.
+    Push(&stub_);
+    next = tail->next_.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      tail_ = next;
+      return tail;
+    }
+    return nullptr;
+  }
+
+  bool Empty() const { return tail_ == &stub_ && head_.load(std::memory_order_seq_cst) == &stub_; }
+
+ private:
+  class StubTask : public Task {
+   public:
+    void operator()(bool cancel = false) override {}
+    void Release() override {}
+  };
+
+  std::atomic<Task*> head_;
+  Task* tail_;
+  StubTask stub_;
+};
+
+}  // namespace multi_threading
+
+}  // namespace webf
+
+#endif  // MULTI_THREADING_TASK_QUEUE_H_
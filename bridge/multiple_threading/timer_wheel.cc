@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "timer_wheel.h"
+
+#include <algorithm>
+
+namespace webf {
+
+namespace multi_threading {
+
+TimerWheel::TimerWheel(int64_t now_ms) : current_ms_(now_ms) {}
+
+TimerWheel::TimerId TimerWheel::Schedule(int64_t deadline_ms, Callback callback) {
+  TimerId id = next_id_++;
+  timers_.emplace(id, Timer{deadline_ms, std::move(callback)});
+  Place(id, deadline_ms);
+  return id;
+}
+
+bool TimerWheel::Cancel(TimerId id) {
+  // The slot entry is left behind and skipped when its slot is reached.
+  return timers_.erase(id) > 0;
+}
+
+void TimerWheel::Advance(int64_t now_ms, std::vector<Callback>& expired) {
+  if (timers_.empty()) {
+    // Nothing can expire, so skip the ticks and drop stale slot entries.
+    for (auto& level : levels_) {
+      for (auto& slot : level) {
+        slot.clear();
+      }
+    }
+    due_.clear();
+    overflow_.clear();
+    current_ms_ = std::max(current_ms_, now_ms);
+    return;
+  }
+
+  Expire(due_, expired);
+
+  while (current_ms_ < now_ms && !timers_.empty()) {
+    current_ms_++;
+    for (int level = kLevelCount - 1; level > 0; level--) {
+      if ((current_ms_ & ((int64_t(1) << (kSlotBits * level)) - 1)) == 0) {
+        Cascade(level);
+      }
+    }
+    Slot& slot = levels_[0][current_ms_ & (kSlotCount - 1)];
+    // Cascading may have made timers due at exactly this tick.
+    slot.insert(slot.end(), due_.begin(), due_.end());
+    due_.clear();
+    Expire(slot, expired);
+  }
+
+  if (current_ms_ < now_ms) {
+    current_ms_ = now_ms;
+  }
+}
+
+int64_t TimerWheel::NextDeadline() const {
+  if (timers_.empty())
+    return -1;
+
+  int64_t next = -1;
+  auto consider = [this, &next](const Slot& slot) {
+    bool found = false;
+    for (TimerId id : slot) {
+      auto it = timers_.find(id);
+      if (it == timers_.end())
+        continue;
+      found = true;
+      if (next < 0 || it->second.deadline < next) {
+        next = it->second.deadline;
+      }
+    }
+    return found;
+  };
+
+  if (consider(due_))
+    return current_ms_;
+
+  // Within a level, slots after the current one are in deadline order, so
+  // only the first slot holding a live timer matters.
+  for (int level = 0; level < kLevelCount; level++) {
+    int64_t current_index = current_ms_ >> (kSlotBits * level);
+    for (int i = 1; i <= kSlotCount; i++) {
+      if (consider(levels_[level][(current_index + i) & (kSlotCount - 1)]))
+        break;
+    }
+  }
+  consider(overflow_);
+
+  return std::max(next, current_ms_);
+}
+
+void TimerWheel::Place(TimerId id, int64_t deadline) {
+  if (deadline <= current_ms_) {
+    due_.emplace_back(id);
+    return;
+  }
+
+  int64_t delta = deadline - current_ms_;
+  for (int level = 0; level < kLevelCount; level++) {
+    if (delta < (int64_t(1) << (kSlotBits * (level + 1)))) {
+      levels_[level][(deadline >> (kSlotBits * level)) & (kSlotCount - 1)].emplace_back(id);
+      return;
+    }
+  }
+  overflow_.emplace_back(id);
+}
+
+void TimerWheel::Cascade(int level) {
+  Slot slot;
+  slot.swap(levels_[level][(current_ms_ >> (kSlotBits * level)) & (kSlotCount - 1)]);
+  if (level == kLevelCount - 1) {
+    slot.insert(slot.end(), overflow_.begin(), overflow_.end());
+    overflow_.clear();
+  }
+  for (TimerId id : slot) {
+    auto it = timers_.find(id);
+    if (it != timers_.end()) {
+      Place(id, it->second.deadline);
+    }
+  }
+}
+
+void TimerWheel::Expire(Slot& slot, std::vector<Callback>& expired) {
+  if (slot.empty())
+    return;
+
+  Slot ids;
+  ids.swap(slot);
+  // Ids grow in scheduling order, so this keeps equal deadlines stable.
+  std::sort(ids.begin(), ids.end(), [this](TimerId a, TimerId b) {
+    auto a_it = timers_.find(a);
+    auto b_it = timers_.find(b);
+    int64_t a_deadline = a_it == timers_.end() ? 0 : a_it->second.deadline;
+    int64_t b_deadline = b_it == timers_.end() ? 0 : b_it->second.deadline;
+    return a_deadline != b_deadline ? a_deadline < b_deadline : a < b;
+  });
+
+  for (TimerId id : ids) {
+    auto it = timers_.find(id);
+    if (it == timers_.end())
+      continue;
+    expired.emplace_back(std::move(it->second.callback));
+    timers_.erase(it);
+  }
+}
+
+}  // namespace multi_threading
+
+}  // namespace webf
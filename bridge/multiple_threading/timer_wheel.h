@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#ifndef MULTI_THREADING_TIMER_WHEEL_H_
+#define MULTI_THREADING_TIMER_WHEEL_H_
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "task.h"
+
+namespace webf {
+
+namespace multi_threading {
+
+/**
+ * @brief hierarchical timing wheel with millisecond ticks.
+ *
+ * Level 0 has one slot per millisecond for the next 64ms; each higher level
+ * covers 64 times the span of the one below and is cascaded down as time
+ * reaches it. Scheduling and cancelling are O(1). Timers further out than the
+ * top level wait in an overflow list until they come within range.
+ *
+ * Not thread safe: a Looper only touches its wheel from its own thread.
+ */
+class TimerWheel {
+ public:
+  using TimerId = uint64_t;
+
+  explicit TimerWheel(int64_t now_ms);
+
+  // Timers whose deadline is not after the current time fire on the next Advance().
+  TimerId Schedule(int64_t deadline_ms, Callback callback);
+  bool Cancel(TimerId id);
+
+  // Moves the wheel to |now_ms| and appends the callbacks of every timer that
+  // expired, in deadline order. Timers with equal deadlines keep scheduling order.
+  void Advance(int64_t now_ms, std::vector<Callback>& expired);
+
+  // The time the next timer may fire, or -1 when no timer is pending. May be
+  // earlier than any live deadline when timers were cancelled.
+  int64_t NextDeadline() const;
+
+  bool empty() const { return timers_.empty(); }
+  size_t size() const { return timers_.size(); }
+
+ private:
+  static constexpr int kSlotBits = 6;
+  static constexpr int kSlotCount = 1 << kSlotBits;
+  static constexpr int kLevelCount = 4;
+
+  struct Timer {
+    int64_t deadline;
+    Callback callback;
+  };
+
+  using Slot = std::vector<TimerId>;
+
+  void Place(TimerId id, int64_t deadline);
+  void Cascade(int level);
+  void Expire(Slot& slot, std::vector<Callback>& expired);
+
+  int64_t current_ms_;
+  TimerId next_id_ = 1;
+  std::unordered_map<TimerId, Timer> timers_;
+  std::array<std::array<Slot, kSlotCount>, kLevelCount> levels_;
+  // Timers already due when scheduled.
+  Slot due_;
+  Slot overflow_;
+};
+
+}  // namespace multi_threading
+
+}  // namespace webf
+
+#endif  // MULTI_THREADING_TIMER_WHEEL_H_
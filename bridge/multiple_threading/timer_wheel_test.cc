@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "multiple_threading/timer_wheel.h"
+
+using namespace webf::multi_threading;
+
+namespace {
+
+void RunUntil(TimerWheel& wheel, int64_t now_ms) {
+  std::vector<Callback> expired;
+  wheel.Advance(now_ms, expired);
+  for (auto& callback : expired) {
+    callback();
+  }
+}
+
+}  // namespace
+
+TEST(TimerWheel, FiresInDeadlineOrder) {
+  TimerWheel wheel(1000);
+  std::vector<int> fired;
+  wheel.Schedule(1030, [&]() { fired.emplace_back(3); });
+  wheel.Schedule(1010, [&]() { fired.emplace_back(1); });
+  wheel.Schedule(1020, [&]() { fired.emplace_back(2); });
+  wheel.Schedule(1020, [&]() { fired.emplace_back(22); });
+
+  RunUntil(wheel, 1015);
+  EXPECT_EQ(fired, std::vector<int>({1}));
+  RunUntil(wheel, 1100);
+  EXPECT_EQ(fired, std::vector<int>({1, 2, 22, 3}));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, DueTimersFireOnNextAdvance) {
+  TimerWheel wheel(500);
+  int fired = 0;
+  wheel.Schedule(500, [&]() { fired++; });
+  wheel.Schedule(100, [&]() { fired++; });
+  EXPECT_EQ(wheel.NextDeadline(), 500);
+
+  RunUntil(wheel, 500);
+  EXPECT_EQ(fired, 2);
+}
+
+TEST(TimerWheel, CancelledTimersDoNotFire) {
+  TimerWheel wheel(0);
+  int fired = 0;
+  TimerWheel::TimerId id = wheel.Schedule(10, [&]() { fired++; });
+  wheel.Schedule(20, [&]() { fired += 10; });
+
+  EXPECT_TRUE(wheel.Cancel(id));
+  EXPECT_FALSE(wheel.Cancel(id));
+  EXPECT_EQ(wheel.NextDeadline(), 20);
+
+  RunUntil(wheel, 50);
+  EXPECT_EQ(fired, 10);
+  EXPECT_EQ(wheel.NextDeadline(), -1);
+}
+
+TEST(TimerWheel, CascadesLongTimersThroughLevels) {
+  TimerWheel wheel(7);
+  std::vector<int64_t> fired;
+  const std::vector<int64_t> deadlines = {70, 4100, 300000, 20000000};
+  for (int64_t deadline : deadlines) {
+    wheel.Schedule(deadline, [&fired, deadline]() { fired.emplace_back(deadline); });
+  }
+
+  EXPECT_EQ(wheel.NextDeadline(), 70);
+  RunUntil(wheel, 4099);
+  EXPECT_EQ(fired, std::vector<int64_t>({70}));
+  EXPECT_EQ(wheel.NextDeadline(), 4100);
+
+  RunUntil(wheel, 4100);
+  EXPECT_EQ(fired, std::vector<int64_t>({70, 4100}));
+
+  RunUntil(wheel, 20000000);
+  EXPECT_EQ(fired, deadlines);
+}
+
+TEST(TimerWheel, CallbacksMayScheduleNewTimers) {
+  TimerWheel wheel(0);
+  int fired = 0;
+  wheel.Schedule(5, [&]() {
+    fired++;
+    wheel.Schedule(9, [&]() { fired++; });
+  });
+
+  RunUntil(wheel, 5);
+  EXPECT_EQ(fired, 1);
+  EXPECT_EQ(wheel.NextDeadline(), 9);
+  RunUntil(wheel, 9);
+  EXPECT_EQ(fired, 2);
+}
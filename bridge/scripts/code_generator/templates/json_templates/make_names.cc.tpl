@@ -34,43 +34,68 @@ thread_local const AtomicString& k<%= options.camelCase ? upperCamelCase(name) :
   <% }) %>
 <% } %>
 
-void Init() {
-  struct NameEntry {
-    <% if (options.add_atom_prefix) { %>
-      JSAtom atom;
-    <% } else { %>
-      const char* str;
-    <% } %>
-   };
-
-  static const NameEntry kNames[] = {
-      <% _.forEach(data, function(name) { %>
-        <% if (options.add_atom_prefix) { %>
-          { JS_ATOM_<%= name %> },
-        <% } else if (Array.isArray(name)) { %>
-          { "<%= name[1] %>" },
-        <% } else if(_.isObject(name)) { %>
-          { "<%= name.name %>" },
-        <% } else { %>
-          { "<%= name %>" },
-        <% } %>
-      <% }); %>
-  };
+namespace {
 
-  <% if (deps && deps.html_attribute_names) { %>
-    static const NameEntry kHtmlAttributeNames[] = {
-      <% _.forEach(deps.html_attribute_names.data, function(name) { %>
-        { "<%= name %>" },
-      <% }); %>
-     };
+struct NameEntry {
+  <% if (options.add_atom_prefix) { %>
+    JSAtom atom;
+  <% } else { %>
+    const char* str;
   <% } %>
+ };
+
+const NameEntry kNames[] = {
+    <% _.forEach(data, function(name) { %>
+      <% if (options.add_atom_prefix) { %>
+        { JS_ATOM_<%= name %> },
+      <% } else if (Array.isArray(name)) { %>
+        { "<%= name[1] %>" },
+      <% } else if(_.isObject(name)) { %>
+        { "<%= name.name %>" },
+      <% } else { %>
+        { "<%= name %>" },
+      <% } %>
+    <% }); %>
+};
+
+<% if (deps && deps.html_attribute_names) { %>
+const NameEntry kHtmlAttributeNames[] = {
+  <% _.forEach(deps.html_attribute_names.data, function(name) { %>
+    { "<%= name %>" },
+  <% }); %>
+};
+<% } %>
+
+}  // namespace
+
+const AtomicString& NameAt(unsigned index) {
+  return reinterpret_cast<const AtomicString*>(&names_storage)[index];
+}
+
+<% if (!options.add_atom_prefix) { %>
+const char* NameStringAt(unsigned index) {
+  return kNames[index].str;
+}
+<% } %>
+
+<% if (deps && deps.html_attribute_names) { %>
+const AtomicString& HtmlAttributeNameAt(unsigned index) {
+  return reinterpret_cast<const AtomicString*>(&html_attribute_names_storage)[index];
+}
+
+const char* HtmlAttributeNameStringAt(unsigned index) {
+  return kHtmlAttributeNames[index].str;
+}
+<% } %>
+
+void Init() {
 
   for(size_t i = 0; i < std::size(kNames); i ++) {
     void* address = reinterpret_cast<AtomicString*>(&names_storage) + i;
     <% if (options.add_atom_prefix) { %>
       new (address) AtomicString(kNames[i].atom);
     <% } else { %>
-      new (address) AtomicString(AtomicString::CreateFromUTF8(kNames[i].str));
+      new (address) AtomicString(AtomicString::CreateStatic(kNames[i].str));
     <% } %>
 
   }
@@ -78,7 +103,7 @@ void Init() {
   <% if (deps && deps.html_attribute_names) { %>
     for(size_t i = 0; i < std::size(kHtmlAttributeNames); i ++) {
       void* address = reinterpret_cast<AtomicString*>(&html_attribute_names_storage) + i;
-      new (address) AtomicString(AtomicString::CreateFromUTF8(kHtmlAttributeNames[i].str));
+      new (address) AtomicString(AtomicString::CreateStatic(kHtmlAttributeNames[i].str));
     }
   <% } %>
   
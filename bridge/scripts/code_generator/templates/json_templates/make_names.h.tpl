@@ -30,10 +30,21 @@ namespace <%= name %> {
   <% _.forEach(deps.html_attribute_names.data, function(name, index) { %>
     extern thread_local const AtomicString& k<%= upperCamelCase(name) %>Attr;
   <% }) %>
+
+  // Attribute atoms by index, with their UTF-8 spelling, as NameAt() and NameStringAt() below.
+  const AtomicString& HtmlAttributeNameAt(unsigned index);
+  const char* HtmlAttributeNameStringAt(unsigned index);
 <% } %>
 
 constexpr unsigned kNamesCount = <%= data.length %>;
 
+// The name at |index| in declaration order. Only valid between Init() and Dispose().
+const AtomicString& NameAt(unsigned index);
+<% if (!options.add_atom_prefix) { %>
+// UTF-8 spelling of NameAt(|index|). Static storage, readable from any thread.
+const char* NameStringAt(unsigned index);
+<% } %>
+
 void Init();
 void Dispose();
 
@@ -0,0 +1,41 @@
+# Microbenchmarks for WebF
+# Each file under test/benchmark defines its own BENCHMARK_MAIN(), so every
+# source is built into a standalone executable. Enable with -DENABLE_BENCHMARK=ON.
+
+set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+
+add_subdirectory(./third_party/benchmark)
+
+list(APPEND WEBF_BENCHMARK_SOURCE
+  ./test/benchmark/atomic_string.cc
+  ./test/benchmark/create_element.cc
+  ./test/benchmark/element_lookup.cc
+  ./test/benchmark/looper_post.cc
+  ./test/benchmark/parse_html.cc
+)
+
+foreach(_benchmark_source ${WEBF_BENCHMARK_SOURCE})
+  get_filename_component(_benchmark_name ${_benchmark_source} NAME_WE)
+  set(_benchmark_target webf_benchmark_${_benchmark_name})
+
+  add_executable(${_benchmark_target}
+    ${_benchmark_source}
+    include/webf_bridge_test.h
+    webf_bridge_test.cc
+    ./test/test_framework_polyfill.c
+    test/webf_test_context.cc
+    test/webf_test_context.h
+    ./test/webf_test_env.cc
+    ./test/webf_test_env.h
+  )
+  target_compile_definitions(${_benchmark_target} PUBLIC -DSPEC_FILE_PATH="${CMAKE_CURRENT_SOURCE_DIR}")
+  target_include_directories(${_benchmark_target} PUBLIC
+    ./third_party/googletest/googletest/include
+    ${BRIDGE_INCLUDE}
+    ./test
+    ${CMAKE_CURRENT_SOURCE_DIR}
+    ${CMAKE_CURRENT_SOURCE_DIR}/include)
+  target_link_libraries(${_benchmark_target} webf_core GTest::gtest benchmark::benchmark)
+endforeach()
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "foundation/string/atomic_string.h"
+#include "html_names.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+auto env = TEST_init();
+
+namespace {
+
+constexpr int kBatch = 1000;
+
+// StringImpl as it was held before the intrusive refcount: a shared_ptr with
+// its own control block, so every copy is an atomic increment and decrement.
+std::shared_ptr<StringImpl> SharedPtrReplica(const AtomicString& string) {
+  return std::shared_ptr<StringImpl>(string.Impl().get(), [](StringImpl*) {});
+}
+
+std::vector<AtomicString> DynamicAtoms() {
+  std::vector<AtomicString> atoms;
+  for (int i = 0; i < 64; i++) {
+    atoms.emplace_back(AtomicString::CreateFromUTF8("class-name-" + std::to_string(i)));
+  }
+  return atoms;
+}
+
+}  // namespace
+
+static void AtomicStringCopy(benchmark::State& state) {
+  AtomicString atom = AtomicString::CreateFromUTF8("row-item");
+  for (auto _ : state) {
+    for (int i = 0; i < kBatch; i++) {
+      AtomicString copy = atom;
+      benchmark::DoNotOptimize(copy);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+static void AtomicStringCopyStaticName(benchmark::State& state) {
+  const AtomicString& atom = html_names::kDiv;
+  for (auto _ : state) {
+    for (int i = 0; i < kBatch; i++) {
+      AtomicString copy = atom;
+      benchmark::DoNotOptimize(copy);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+static void SharedPtrStringImplCopy(benchmark::State& state) {
+  AtomicString atom = AtomicString::CreateFromUTF8("row-item");
+  std::shared_ptr<StringImpl> impl = SharedPtrReplica(atom);
+  for (auto _ : state) {
+    for (int i = 0; i < kBatch; i++) {
+      std::shared_ptr<StringImpl> copy = impl;
+      benchmark::DoNotOptimize(copy);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+static void AtomicStringHash(benchmark::State& state) {
+  std::vector<AtomicString> atoms = DynamicAtoms();
+  for (auto _ : state) {
+    for (int i = 0; i < kBatch; i++) {
+      benchmark::DoNotOptimize(atoms[i % atoms.size()].Hash());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+static void AtomicStringCompare(benchmark::State& state) {
+  std::vector<AtomicString> atoms = DynamicAtoms();
+  std::vector<AtomicString> lookups = DynamicAtoms();
+  for (auto _ : state) {
+    for (int i = 0; i < kBatch; i++) {
+      benchmark::DoNotOptimize(atoms[i % atoms.size()] == lookups[(i * 7) % lookups.size()]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+// Copies into and out of a hash set, the way selector and attribute maps key
+// on atoms.
+static void AtomicStringSetInsertErase(benchmark::State& state) {
+  std::vector<AtomicString> atoms = DynamicAtoms();
+  std::unordered_set<AtomicString, AtomicString::KeyHasher> set;
+  for (auto _ : state) {
+    for (auto& atom : atoms) {
+      set.insert(atom);
+    }
+    set.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * atoms.size());
+}
+
+static void AtomicStringTableLookup(benchmark::State& state) {
+  std::vector<AtomicString> atoms = DynamicAtoms();
+  std::string name = "class-name-7";
+  for (auto _ : state) {
+    for (int i = 0; i < kBatch; i++) {
+      benchmark::DoNotOptimize(AtomicString::CreateFromUTF8(name));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+BENCHMARK(AtomicStringCopy);
+BENCHMARK(AtomicStringCopyStaticName);
+BENCHMARK(SharedPtrStringImplCopy);
+BENCHMARK(AtomicStringHash);
+BENCHMARK(AtomicStringCompare);
+BENCHMARK(AtomicStringSetInsertErase);
+BENCHMARK(AtomicStringTableLookup);
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "webf_test_env.h"
+
+using namespace webf;
+
+auto env = TEST_init();
+
+// Builds a 10k-element tree under <body> with repeated classes and a few
+// unique ids. getElementById/getElementsBy* used to be answered by Dart via a
+// synchronous binding call that flushed the whole UI command queue; they are
+// now served by the tree scope indexes on the JS thread.
+static void SetupDocument(ExecutingContext* context) {
+  static bool initialized = false;
+  if (initialized) {
+    return;
+  }
+  initialized = true;
+  std::string code = R"(
+(() => {
+let container = document.createElement('div');
+for (let i = 0; i < 1000; i ++) {
+  let row = document.createElement('div');
+  row.className = 'row ' + (i % 2 ? 'odd' : 'even');
+  row.id = 'row-' + i;
+  for (let j = 0; j < 9; j ++) {
+    let cell = document.createElement('span');
+    cell.className = 'cell';
+    row.appendChild(cell);
+  }
+  container.appendChild(row);
+}
+let last = document.createElement('p');
+last.className = 'rare';
+container.appendChild(last);
+document.body.appendChild(container);
+})();
+)";
+  context->EvaluateJavaScript(code.c_str(), code.size(), "internal://", 0);
+}
+
+static void GetElementById(benchmark::State& state) {
+  auto context = env->page()->executingContext();
+  SetupDocument(context);
+  std::string code = R"(
+(() => {
+for (let i = 0; i < 1000; i ++) {
+  document.getElementById('row-' + i);
+}
+})();
+)";
+  for (auto _ : state) {
+    context->EvaluateJavaScript(code.c_str(), code.size(), "internal://", 0);
+  }
+}
+
+static void GetElementsByClassNameRare(benchmark::State& state) {
+  auto context = env->page()->executingContext();
+  SetupDocument(context);
+  std::string code = R"(
+(() => {
+for (let i = 0; i < 100; i ++) {
+  document.getElementsByClassName('rare');
+  document.getElementsByClassName('missing');
+}
+})();
+)";
+  for (auto _ : state) {
+    context->EvaluateJavaScript(code.c_str(), code.size(), "internal://", 0);
+  }
+}
+
+static void GetElementsByClassNameCommon(benchmark::State& state) {
+  auto context = env->page()->executingContext();
+  SetupDocument(context);
+  std::string code = R"(
+(() => {
+for (let i = 0; i < 10; i ++) {
+  document.getElementsByClassName('row odd');
+}
+})();
+)";
+  for (auto _ : state) {
+    context->EvaluateJavaScript(code.c_str(), code.size(), "internal://", 0);
+  }
+}
+
+static void GetElementsByTagName(benchmark::State& state) {
+  auto context = env->page()->executingContext();
+  SetupDocument(context);
+  std::string code = R"(
+(() => {
+for (let i = 0; i < 10; i ++) {
+  document.getElementsByTagName('p');
+  document.getElementsByTagName('section');
+}
+})();
+)";
+  for (auto _ : state) {
+    context->EvaluateJavaScript(code.c_str(), code.size(), "internal://", 0);
+  }
+}
+
+static void IdMutation(benchmark::State& state) {
+  auto context = env->page()->executingContext();
+  SetupDocument(context);
+  std::string code = R"(
+(() => {
+let row = document.getElementById('row-500');
+for (let i = 0; i < 1000; i ++) {
+  row.id = 'moved-' + i;
+  document.getElementById('moved-' + i);
+}
+row.id = 'row-500';
+})();
+)";
+  for (auto _ : state) {
+    context->EvaluateJavaScript(code.c_str(), code.size(), "internal://", 0);
+  }
+}
+
+BENCHMARK(GetElementById)->Threads(1);
+BENCHMARK(GetElementsByClassNameRare)->Threads(1);
+BENCHMARK(GetElementsByClassNameCommon)->Threads(1);
+BENCHMARK(GetElementsByTagName)->Threads(1);
+BENCHMARK(IdMutation)->Threads(1);
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include "multiple_threading/looper.h"
+
+using namespace webf::multi_threading;
+
+namespace {
+
+// The looper as it was before tasks moved to the lock-free queue: every post
+// takes the mutex, allocates a shared_ptr task holding a std::function over a
+// std::bind, and notifies the condition variable.
+class MutexLooper {
+ public:
+  MutexLooper() : thread_([this] { Run(); }) {}
+  ~MutexLooper() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+    }
+    cv_.notify_one();
+    thread_.join();
+  }
+
+  template <typename Func, typename... Args>
+  void PostMessage(Func&& func, Args&&... args) {
+    auto task = std::make_shared<std::function<void()>>(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      tasks_.emplace(std::move(task));
+    }
+    cv_.notify_one();
+  }
+
+ private:
+  void Run() {
+    while (true) {
+      std::shared_ptr<std::function<void()>> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !running_ || !tasks_.empty(); });
+        if (!running_ && tasks_.empty())
+          return;
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      (*task)();
+    }
+  }
+
+  std::condition_variable cv_;
+  std::mutex mutex_;
+  std::queue<std::shared_ptr<std::function<void()>>> tasks_;
+  bool running_{true};
+  std::thread thread_;
+};
+
+Looper& SharedLooper() {
+  static Looper* looper = [] {
+    auto* looper = new Looper(0);
+    looper->Start();
+    return looper;
+  }();
+  return *looper;
+}
+
+MutexLooper& SharedMutexLooper() {
+  static auto* looper = new MutexLooper();
+  return *looper;
+}
+
+// What Dart sends most: a static function plus a handful of pointer-sized
+// arguments.
+void Handle(std::atomic<int64_t>* counter, void* page, const char* data, int64_t length) {
+  counter->fetch_add(length, std::memory_order_relaxed);
+}
+
+constexpr int kBatch = 1000;
+
+template <typename L>
+void PostThroughput(benchmark::State& state, L& looper) {
+  std::atomic<int64_t> counter{0};
+  for (auto _ : state) {
+    for (int i = 0; i < kBatch; i++) {
+      looper.PostMessage(Handle, &counter, nullptr, "", 1);
+    }
+  }
+  // Wait until every task posted by this thread has run.
+  while (counter.load() != static_cast<int64_t>(state.iterations()) * kBatch) {
+    std::this_thread::yield();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+// One task in flight at a time, so each post finds the looper asleep and the
+// time includes the wakeup.
+template <typename L>
+void PostToRunLatency(benchmark::State& state, L& looper) {
+  std::atomic<bool> ran{false};
+  for (auto _ : state) {
+    ran.store(false);
+    looper.PostMessage([](std::atomic<bool>* flag) { flag->store(true); }, &ran);
+    while (!ran.load()) {
+    }
+  }
+}
+
+}  // namespace
+
+static void LooperPostThroughput(benchmark::State& state) {
+  PostThroughput(state, SharedLooper());
+}
+
+static void MutexLooperPostThroughput(benchmark::State& state) {
+  PostThroughput(state, SharedMutexLooper());
+}
+
+static void LooperPostToRunLatency(benchmark::State& state) {
+  PostToRunLatency(state, SharedLooper());
+}
+
+static void MutexLooperPostToRunLatency(benchmark::State& state) {
+  PostToRunLatency(state, SharedMutexLooper());
+}
+
+BENCHMARK(LooperPostThroughput)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(MutexLooperPostThroughput)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(LooperPostToRunLatency)->Unit(benchmark::kMicrosecond);
+BENCHMARK(MutexLooperPostToRunLatency)->Unit(benchmark::kMicrosecond);
+
+// Run the benchmark
+BENCHMARK_MAIN();
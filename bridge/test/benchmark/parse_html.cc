@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2024-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "core/html/parser/html_document_parser.h"
+#include "core/html/parser/html_parser.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+auto env = TEST_init();
+
+// About 1 MB of server-rendered markup: nested cards with classes, data-*
+// and aria attributes, inline styles, entities and long paragraphs, the shape
+// of what React/Vue SSR hands to parseHTML().
+static const std::string& SSRDocument() {
+  static const std::string html = [] {
+    std::string result =
+        "<!DOCTYPE html><html lang=\"en\"><head><meta charset=\"utf-8\"><title>SSR</title>"
+        "<style>.card{display:flex}.title{font-weight:bold}</style></head><body><div id=\"app\">";
+    for (int i = 0; result.size() < 1024 * 1024; i++) {
+      std::string index = std::to_string(i);
+      result += "<section class=\"card card-" + index + "\" data-index=\"" + index +
+                "\" aria-label=\"Card\" style=\"padding: 8px; margin: 4px\">"
+                "<h2 class=\"title\">Item " +
+                index +
+                " &amp; more</h2>"
+                "<p class=\"body\">Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor "
+                "incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation "
+                "ullamco laboris nisi ut aliquip ex ea commodo consequat.</p>"
+                "<ul><li><a href=\"/items/" +
+                index +
+                "\" title=\"Open\">Open</a></li><li><span>Tag</span></li></ul>"
+                "<img src=\"/img/" +
+                index + ".png\" alt=\"\" width=\"32\" height=\"32\"><!--/card--></section>";
+    }
+    result += "</div></body></html>";
+    return result;
+  }();
+  return html;
+}
+
+static void ParseSSRDocument(benchmark::State& state) {
+  auto context = env->page()->executingContext();
+  const std::string& html = SSRDocument();
+  for (auto _ : state) {
+    HTMLParser::parseHTML(html.c_str(), html.size(), context->document()->documentElement());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * html.size());
+}
+
+// The same document built in 8ms slices, as a dedicated JS thread does.
+static void ParseSSRDocumentInSlices(benchmark::State& state) {
+  auto context = env->page()->executingContext();
+  const std::string& html = SSRDocument();
+  for (auto _ : state) {
+    HTMLDocumentParser parser(context->document()->documentElement());
+    parser.Parse(html.c_str(), html.size());
+    while (!parser.Build(HTMLDocumentParser::Clock::now() + HTMLDocumentParser::kSliceBudget)) {
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * html.size());
+}
+
+BENCHMARK(ParseSSRDocument)->Unit(benchmark::kMillisecond)->Threads(1);
+BENCHMARK(ParseSSRDocumentInSlices)->Unit(benchmark::kMillisecond)->Threads(1);
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -4,6 +4,7 @@
 list(APPEND WEBF_CSS_UNIT_TEST_SOURCE
   # CSS Core Tests
   ./core/css/style_engine_test.cc
+  ./core/css/shared_style_sheet_cache_test.cc
   ./core/css/resolver/style_resolver_test.cc
   ./core/css/resolver/style_resolver_simple_test.cc
   ./core/css/resolver/style_builder_test.cc
@@ -12,6 +13,7 @@ list(APPEND WEBF_CSS_UNIT_TEST_SOURCE
   ./core/css/resolver/selector_specificity_test.cc
   ./core/css/inline_style_test.cc
   ./core/css/selector_test.cc
+  ./core/css/selector_query_test.cc
   ./core/css/css_initial_test.cc
   ./core/css/css_selector_test.cc
   ./core/css/css_value_clamping_utils_test.cc
@@ -18,6 +18,7 @@ list(APPEND WEBF_TEST_SOURCE
   ./bindings/qjs/script_value_test.cc
   ./core/dom/events/custom_event_test.cc
   ./core/executing_context_test.cc
+  ./core/binding_name_table_test.cc
   ./core/frame/console_test.cc
   ./core/frame/module_manager_test.cc
   ./core/dom/events/event_target_test.cc
@@ -27,6 +28,9 @@ list(APPEND WEBF_TEST_SOURCE
   ./core/html/html_collection_test.cc
   ./core/dom/element_test.cc
   ./core/frame/dom_timer_test.cc
+  ./multiple_threading/timer_wheel_test.cc
+  ./multiple_threading/dispatcher_test.cc
+  ./multiple_threading/looper_test.cc
   ./core/frame/queue_microtask_test.cc
   ./core/frame/window_test.cc
   ./core/html/html_element_test.cc
@@ -34,9 +38,15 @@ list(APPEND WEBF_TEST_SOURCE
   ./core/html/html_style_element_test.cc
   ./core/html/html_meta_element_test.cc
   ./core/html/html_link_element_rel_list_test.cc
+  ./core/html/parser/html_document_parser_test.cc
   ./core/timing/performance_test.cc
+  ./foundation/bytecode_cache_test.cc
   ./foundation/shared_ui_command_test.cc
   ./foundation/blink_first_paint_style_sync_test.cc
+  ./foundation/style_value_table_test.cc
+  ./foundation/metrics_registry_test.cc
+  ./core/css/exported_style_snapshot_test.cc
+  ./core/html/canvas/canvas_display_list_test.cc
   ./foundation/ui_command_ring_buffer_test.cc
   ./foundation/ui_command_strategy_test.cc
   ./foundation/string/string_impl_unittest.cc
@@ -250,7 +250,7 @@ std::unique_ptr<WebFTestEnv> TEST_init(OnJSError onJsError,
                                        size_t shape_len,
                                        uint8_t enable_blink) {
   auto mockedDartMethods = TEST_getMockDartMethods(onJsError);
-  auto* dart_isolate_context = initDartIsolateContextSync(0, mockedDartMethods.data(), mockedDartMethods.size());
+  auto* dart_isolate_context = initDartIsolateContextSync(0, mockedDartMethods.data(), mockedDartMethods.size(), nullptr);
   double pageContextId = contextId -= 1;
   auto* page = allocateNewPageSync(pageContextId, dart_isolate_context, shape, shape_len, enable_blink);
   void* testContext = initTestFramework(page);
@@ -270,7 +270,7 @@ std::unique_ptr<WebFTestEnv> TEST_init() {
 std::unique_ptr<webf::WebFPage> TEST_allocateNewPage(OnJSError onJsError) {
   auto mockedDartMethods = TEST_getMockDartMethods(onJsError);
   auto dart_isolate_context = std::unique_ptr<DartIsolateContext>(
-      (DartIsolateContext*)initDartIsolateContextSync(0, mockedDartMethods.data(), mockedDartMethods.size()));
+      (DartIsolateContext*)initDartIsolateContextSync(0, mockedDartMethods.data(), mockedDartMethods.size(), nullptr));
   int pageContextId = contextId -= 1;
   auto* page = allocateNewPageSync(pageContextId, dart_isolate_context.get(), nullptr, 0, /*enable_blink=*/kEnableBlink);
   void* testContext = initTestFramework(page);
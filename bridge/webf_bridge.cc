@@ -7,6 +7,7 @@
 
 #include "bindings/qjs/cppgc/mutation_scope.h"
 #include "bindings/qjs/script_value.h"
+#include "core/binding_name_table.h"
 #include "core/dart_isolate_context.h"
 #include "core/dom/document.h"
 #include "core/html/html_script_element.h"
@@ -49,7 +50,8 @@ int64_t newPageIdSync() {
 
 void* initDartIsolateContextSync(int64_t dart_port,
                                  uint64_t* dart_methods,
-                                 int32_t dart_methods_len) {
+                                 int32_t dart_methods_len,
+                                 const char* bytecode_cache_directory) {
   auto dispatcher = std::make_unique<webf::multi_threading::Dispatcher>(dart_port);
 
 #if ENABLE_LOG
@@ -57,6 +59,10 @@ void* initDartIsolateContextSync(int64_t dart_port,
 #endif
   auto* dart_isolate_context = new webf::DartIsolateContext(dart_methods, dart_methods_len);
   dart_isolate_context->SetDispatcher(std::move(dispatcher));
+  if (bytecode_cache_directory != nullptr) {
+    dart_isolate_context->SetBytecodeCache(
+        std::make_unique<webf::BytecodeCache>(bytecode_cache_directory, webf::BytecodeCache::CurrentEngineVersion()));
+  }
 
 #if ENABLE_LOG
   WEBF_LOG(VERBOSE) << "[Dispatcher]: initDartIsolateContextSync Call END";
@@ -81,6 +87,12 @@ void* allocateNewPageSync(double thread_identity, void* ptr, void* native_widget
   return result;
 }
 
+void setPrewarmedPageCount(void* ptr, int32_t count) {
+  auto* dart_isolate_context = (webf::DartIsolateContext*)ptr;
+  assert(dart_isolate_context != nullptr);
+  dart_isolate_context->SetPrewarmedPageCount(count);
+}
+
 void allocateNewPage(double thread_identity,
                      int32_t sync_buffer_size,
                      int8_t use_legacy_ui_command,
@@ -310,6 +322,38 @@ void onColorSchemeChanged(void* page_, const char* scheme, int32_t length) {
       scheme_copy);
 }
 
+int64_t getLayoutGeometryGeneration(void* page_) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  if (!page || !page->executingContext()) {
+    return -1;
+  }
+  return static_cast<int64_t>(page->executingContext()->layoutGeometrySnapshot()->VisibleGeneration());
+}
+
+void publishLayoutGeometry(void* page_, int64_t generation, void* entries, int32_t length) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  auto* dart_isolate_context = page ? page->dartIsolateContext() : nullptr;
+  if (!dart_isolate_context || !dart_isolate_context->dispatcher()) {
+    webf::dart_free(entries);
+    return;
+  }
+
+  dart_isolate_context->dispatcher()->PostToJs(page->isDedicated(), static_cast<int32_t>(page->contextId()),
+                                               webf::WebFPage::PublishLayoutGeometryInternal, page_, generation,
+                                               static_cast<webf::NativeLayoutGeometry*>(entries), length);
+}
+
+void clearLayoutGeometry(void* page_) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  auto* dart_isolate_context = page ? page->dartIsolateContext() : nullptr;
+  if (!dart_isolate_context || !dart_isolate_context->dispatcher()) {
+    return;
+  }
+
+  dart_isolate_context->dispatcher()->PostToJs(page->isDedicated(), static_cast<int32_t>(page->contextId()),
+                                               webf::WebFPage::ClearLayoutGeometryInternal, page_);
+}
+
 int8_t updateStyleForThisDocument(void* page_) {
   auto page = reinterpret_cast<webf::WebFPage*>(page_);
   if (!page) {
@@ -388,6 +432,11 @@ WebFInfo* getWebFInfo() {
   return webfInfo;
 }
 
+const char* const* getBindingNameTable(int32_t* count) {
+  *count = webf::BindingNameTable::Count();
+  return webf::BindingNameTable::Strings();
+}
+
 void* parseSVGResult(const char* code, int32_t length) {
   auto* result = webf::HTMLParser::parseSVGResult(code, length);
   return result;
@@ -414,6 +463,18 @@ void invokeModuleEvent(void* page_,
                                                event, extra, persistent_handle, result_callback);
 }
 
+void dispatchEventBatch(void* page_,
+                        void* items,
+                        int32_t count,
+                        Dart_Handle dart_handle,
+                        DispatchEventBatchCallback result_callback) {
+  Dart_PersistentHandle persistent_handle = Dart_NewPersistentHandle_DL(dart_handle);
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  page->dartIsolateContext()->dispatcher()->PostToJs(
+      page->isDedicated(), static_cast<int32_t>(page->contextId()), webf::WebFPage::DispatchEventBatchInternal, page_,
+      static_cast<webf::NativeDispatchEventItem*>(items), count, persistent_handle, result_callback);
+}
+
 void* allocateNativeBindingObject() {
   return new webf::NativeBindingObject(nullptr);
 }
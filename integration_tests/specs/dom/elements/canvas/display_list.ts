@@ -0,0 +1,76 @@
+describe('Canvas 2D display list', () => {
+  it('recorded path calls are visible to isPointInPath', () => {
+    const canvas = document.createElement('canvas');
+    canvas.width = 100;
+    canvas.height = 100;
+    document.body.appendChild(canvas);
+
+    const ctx = canvas.getContext('2d') as CanvasRenderingContext2D;
+    ctx.beginPath();
+    ctx.moveTo(10, 10);
+    ctx.lineTo(90, 10);
+    ctx.lineTo(90, 90);
+    ctx.closePath();
+
+    expect(ctx.isPointInPath(80, 20)).toBeTrue();
+    expect(ctx.isPointInPath(20, 80)).toBeFalse();
+  });
+
+  it('keeps call order when recorded calls mix with style changes', async () => {
+    const canvas = document.createElement('canvas');
+    canvas.width = 120;
+    canvas.height = 40;
+    document.body.appendChild(canvas);
+
+    const ctx = canvas.getContext('2d')!;
+    ctx.fillStyle = 'red';
+    ctx.fillRect(0, 0, 40, 40);
+    ctx.fillStyle = 'green';
+    ctx.fillRect(40, 0, 40, 40);
+    ctx.globalAlpha = 0.5;
+    ctx.fillStyle = 'blue';
+    ctx.save();
+    ctx.translate(80, 0);
+    ctx.fillRect(0, 0, 40, 40);
+    ctx.restore();
+
+    await snapshot(canvas);
+  });
+
+  it('draws many calls within one frame', async () => {
+    const canvas = document.createElement('canvas');
+    canvas.width = 100;
+    canvas.height = 100;
+    document.body.appendChild(canvas);
+
+    const ctx = canvas.getContext('2d')!;
+    ctx.fillStyle = '#333';
+    for (let i = 0; i < 10000; i++) {
+      ctx.fillRect(i % 100, Math.floor(i / 100), 1, 1);
+    }
+
+    await snapshot(canvas);
+  });
+
+  it('createPattern sees calls drawn into the source canvas in the same task', async () => {
+    const source = document.createElement('canvas');
+    source.width = 20;
+    source.height = 20;
+    document.body.appendChild(source);
+    const target = document.createElement('canvas');
+    target.width = 60;
+    target.height = 60;
+    document.body.appendChild(target);
+
+    const sourceCtx = source.getContext('2d')!;
+    sourceCtx.fillStyle = 'green';
+    sourceCtx.fillRect(0, 0, 20, 20);
+
+    const targetCtx = target.getContext('2d')!;
+    const pattern = targetCtx.createPattern(source, 'repeat')!;
+    targetCtx.fillStyle = pattern;
+    targetCtx.fillRect(0, 0, 60, 60);
+
+    await snapshot(target);
+  });
+});
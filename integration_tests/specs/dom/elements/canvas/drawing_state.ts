@@ -0,0 +1,112 @@
+describe('Canvas 2D drawing state', () => {
+  it('should report default values', () => {
+    const canvas = document.createElement('canvas');
+    const ctx = canvas.getContext('2d')!;
+
+    expect(ctx.globalAlpha).toBe(1);
+    expect(ctx.globalCompositeOperation).toBe('source-over');
+    expect(ctx.font).toBe('10px sans-serif');
+    expect(ctx.lineCap).toBe('butt');
+    expect(ctx.lineJoin).toBe('miter');
+    expect(ctx.lineWidth).toBe(1);
+    expect(ctx.miterLimit).toBe(10);
+    expect(ctx.textAlign).toBe('start');
+    expect(ctx.textBaseline).toBe('alphabetic');
+    expect(ctx.fillStyle).toBe('#000000');
+    expect(ctx.getLineDash()).toEqual([]);
+  });
+
+  it('should restore values saved with save()', () => {
+    const canvas = document.createElement('canvas');
+    const ctx = canvas.getContext('2d')!;
+
+    ctx.lineWidth = 2;
+    ctx.textAlign = 'center';
+    ctx.save();
+    ctx.lineWidth = 8;
+    ctx.textAlign = 'right';
+    ctx.globalAlpha = 0.5;
+    ctx.setLineDash([4, 2]);
+    expect(ctx.lineWidth).toBe(8);
+
+    ctx.restore();
+    expect(ctx.lineWidth).toBe(2);
+    expect(ctx.textAlign).toBe('center');
+    expect(ctx.globalAlpha).toBe(1);
+    expect(ctx.getLineDash()).toEqual([]);
+
+    // Unbalanced restore() is a no-op.
+    ctx.restore();
+    expect(ctx.lineWidth).toBe(2);
+  });
+
+  it('should draw with the line dash and text baseline restored by restore()', async (done) => {
+    const canvas = document.createElement('canvas');
+    canvas.width = 320;
+    canvas.height = 120;
+    document.body.appendChild(canvas);
+
+    const ctx = canvas.getContext('2d')!;
+    ctx.strokeStyle = 'black';
+    ctx.fillStyle = 'black';
+    ctx.lineWidth = 4;
+    ctx.font = '20px sans-serif';
+
+    ctx.setLineDash([5]);
+    ctx.textBaseline = 'top';
+    ctx.save();
+    ctx.setLineDash([]);
+    ctx.textBaseline = 'bottom';
+    ctx.restore();
+
+    expect(ctx.getLineDash()).toEqual([5, 5]);
+    expect(ctx.textBaseline).toBe('top');
+
+    // Both the dashed stroke and the text hanging from y=60 must use the restored state.
+    ctx.beginPath();
+    ctx.moveTo(10, 30);
+    ctx.lineTo(310, 30);
+    ctx.stroke();
+    ctx.fillText('restored', 10, 60);
+
+    await snapshot(canvas);
+    done();
+  });
+
+  it('should ignore invalid values', () => {
+    const canvas = document.createElement('canvas');
+    const ctx = canvas.getContext('2d')!;
+
+    ctx.lineWidth = 3;
+    ctx.lineWidth = 0;
+    ctx.lineWidth = -1;
+    ctx.lineWidth = NaN;
+    expect(ctx.lineWidth).toBe(3);
+
+    ctx.globalAlpha = 2;
+    expect(ctx.globalAlpha).toBe(1);
+
+    ctx.lineCap = 'invalid';
+    expect(ctx.lineCap).toBe('butt');
+
+    ctx.setLineDash([1, -1]);
+    expect(ctx.getLineDash()).toEqual([]);
+    ctx.setLineDash([1, 2, 3]);
+    expect(ctx.getLineDash()).toEqual([1, 2, 3, 1, 2, 3]);
+  });
+
+  it('should reset state when the canvas is resized', () => {
+    const canvas = document.createElement('canvas');
+    const ctx = canvas.getContext('2d')!;
+    expect(canvas.getContext('2d')).toBe(ctx);
+
+    ctx.lineWidth = 6;
+    ctx.save();
+    canvas.width = 200;
+    expect(ctx.lineWidth).toBe(1);
+
+    ctx.lineWidth = 6;
+    ctx.reset();
+    expect(ctx.lineWidth).toBe(1);
+  });
+});
@@ -31,6 +31,7 @@ enum BindingMethodCallOperations {
   hasProperty,
   // 0 = none, 1 = sync, 2 = async
   getMethodType,
+  getProperties,
 }
 
 typedef NativeAsyncAnonymousFunctionCallback = Void Function(
@@ -45,6 +46,7 @@ List<BindingCallFunc> bindingCallMethodDispatchTable = [
   setterBindingCall,
   hasPropertyBindingCall,
   getMethodTypeBindingCall,
+  gettersBindingCall,
 ];
 
 // Dispatch the event to the binding side.
@@ -55,50 +57,100 @@ Future<void> _dispatchCaptureEventToNative(Event event) async {
   await _dispatchEventToNative(event, true);
 }
 
-void _handleDispatchResult(Object contextHandle, Pointer<NativeValue> returnValue) {
-  _DispatchEventResultContext context = contextHandle as _DispatchEventResultContext;
-  Pointer<EventDispatchResult> dispatchResult = fromNativeValue(context.controller.view, returnValue).cast<EventDispatchResult>();
-  Event event = context.event;
-  event.cancelable = dispatchResult.ref.canceled;
-  event.propagationStopped = dispatchResult.ref.propagationStopped;
-  event.defaultPrevented = dispatchResult.ref.preventDefaulted;
-  event.sharedJSProps = Pointer.fromAddress((context.rawEvent.ref.bytes + 8).value);
-  event.propLen = (context.rawEvent.ref.bytes + 9).value;
-  event.allocateLen = (context.rawEvent.ref.bytes + 10).value;
+class _PendingNativeEvent {
+  final Event event;
+  final Pointer<NativeBindingObject> currentTarget;
+  final bool isCapture;
+  final Completer<void> completer = Completer();
 
-  if (enableWebFCommandLog && context.stopwatch != null) {
-    bridgeLogger.fine('dispatch event to native side: target: ${event.target} arguments: ${context.dispatchEventArguments} time: ${context.stopwatch!.elapsedMicroseconds}us');
+  _PendingNativeEvent(this.event, this.currentTarget, this.isCapture);
+}
+
+class _DispatchEventBatchContext {
+  final List<_PendingNativeEvent> events;
+  final Pointer<NativeDispatchEventItem> items;
+  final Stopwatch? stopwatch;
+
+  _DispatchEventBatchContext(this.events, this.items, this.stopwatch);
+}
+
+// Events waiting to be sent to JS, per JS context. Everything dispatched in the same turn of the Dart event loop,
+// such as the pointer and scroll events of one frame, reaches JS in one hop.
+final Map<double, List<_PendingNativeEvent>> _pendingNativeEvents = {};
+
+void _handleDispatchEventBatchResult(Object contextHandle) {
+  _DispatchEventBatchContext context = contextHandle as _DispatchEventBatchContext;
+
+  for (int i = 0; i < context.events.length; i++) {
+    NativeDispatchEventItem item = (context.items + i).ref;
+    Event event = context.events[i].event;
+    if (item.dispatchedIndex >= 0) {
+      event.cancelable = item.canceled != 0;
+      event.propagationStopped = item.propagationStopped != 0;
+      event.defaultPrevented = item.preventDefaulted != 0;
+    }
+    Pointer<RawEvent> rawEvent = item.rawEvent;
+    event.sharedJSProps = Pointer.fromAddress((rawEvent.ref.bytes + 8).value);
+    event.propLen = (rawEvent.ref.bytes + 9).value;
+    event.allocateLen = (rawEvent.ref.bytes + 10).value;
+    malloc.free(rawEvent);
   }
 
-  // Free the allocated arguments.
-  malloc.free(context.rawEvent);
-  malloc.free(context.method);
-  malloc.free(context.allocatedNativeArguments);
-  malloc.free(dispatchResult);
-  malloc.free(returnValue);
+  if (enableWebFCommandLog && context.stopwatch != null) {
+    bridgeLogger.fine('dispatch ${context.events.length} events to native side: '
+        '${context.events.map((pending) => pending.event.type).join(', ')} time: ${context.stopwatch!.elapsedMicroseconds}us');
+  }
 
-  context.completer.complete();
+  malloc.free(context.items);
+  for (_PendingNativeEvent pending in context.events) {
+    pending.completer.complete();
+  }
 }
 
-class _DispatchEventResultContext {
-  Completer completer;
+void _flushPendingNativeEvents(double contextId) {
+  List<_PendingNativeEvent>? pendingEvents = _pendingNativeEvents.remove(contextId);
+  if (pendingEvents == null) return;
+
+  WebFController? controller = WebFController.getControllerOfJSContextId(contextId);
+  if (controller == null || controller.view.disposed || !isPageAlive(contextId)) {
+    for (_PendingNativeEvent pending in pendingEvents) {
+      pending.completer.complete();
+    }
+    return;
+  }
+
+  List<_PendingNativeEvent> events = [];
+  for (_PendingNativeEvent pending in pendingEvents) {
+    if (isBindingObjectDisposed(pending.currentTarget)) {
+      pending.completer.complete();
+    } else {
+      events.add(pending);
+    }
+  }
+  if (events.isEmpty) return;
+
   Stopwatch? stopwatch;
-  Event event;
-  Pointer<NativeValue> method;
-  Pointer<NativeValue> allocatedNativeArguments;
-  Pointer<RawEvent> rawEvent;
-  List<dynamic> dispatchEventArguments;
-  WebFController controller;
-  _DispatchEventResultContext(
-    this.completer,
-    this.event,
-    this.method,
-    this.allocatedNativeArguments,
-    this.rawEvent,
-    this.controller,
-    this.dispatchEventArguments,
-    this.stopwatch,
-  );
+  if (enableWebFCommandLog) {
+    stopwatch = Stopwatch()..start();
+  }
+
+  Pointer<NativeDispatchEventItem> items = malloc.allocate(sizeOf<NativeDispatchEventItem>() * events.length);
+  for (int i = 0; i < events.length; i++) {
+    _PendingNativeEvent pending = events[i];
+    NativeDispatchEventItem item = (items + i).ref;
+    item.currentTarget = pending.currentTarget;
+    item.type = stringToNativeString(pending.event.type);
+    item.rawEvent = pending.event.toRaw().cast<RawEvent>();
+    item.isCapture = pending.isCapture ? 1 : 0;
+    item.dispatchedIndex = -1;
+    item.canceled = 0;
+    item.propagationStopped = 0;
+    item.preventDefaulted = 0;
+  }
+
+  Pointer<NativeFunction<NativeDispatchEventBatchCallback>> resultCallback =
+      Pointer.fromFunction(_handleDispatchEventBatchResult);
+  dispatchEventBatch(contextId, items, events.length, _DispatchEventBatchContext(events, items, stopwatch), resultCallback);
 }
 
 Future<void> _dispatchEventToNative(Event event, bool isCapture) async {
@@ -114,42 +166,15 @@ Future<void> _dispatchEventToNative(Event event, bool isCapture) async {
       !isBindingObjectDisposed(event.target?.pointer) &&
       !isBindingObjectDisposed(event.currentTarget?.pointer)
   ) {
-    Completer completer = Completer();
-
-    BindingObject bindingObject = controller.view.getBindingObject(pointer);
-    // Call methods implements at C++ side.
-    DartInvokeBindingMethodsFromDart f = pointer.ref.invokeBindingMethodFromDart.asFunction();
-
-    Pointer<RawEvent> rawEvent = event.toRaw().cast<RawEvent>();
-    List<dynamic> dispatchEventArguments = [event.type, rawEvent, isCapture];
-
-    Stopwatch? stopwatch;
-    if (enableWebFCommandLog) {
-      stopwatch = Stopwatch()..start();
+    _PendingNativeEvent pending = _PendingNativeEvent(event, pointer, isCapture);
+    List<_PendingNativeEvent>? pendingEvents = _pendingNativeEvents[contextId];
+    if (pendingEvents == null) {
+      pendingEvents = _pendingNativeEvents[contextId] = [];
+      scheduleMicrotask(() => _flushPendingNativeEvents(contextId));
     }
+    pendingEvents.add(pending);
 
-    Pointer<NativeValue> method = malloc.allocate(sizeOf<NativeValue>());
-    toNativeValue(method, 'dispatchEvent');
-    Pointer<NativeValue> allocatedNativeArguments = makeNativeValueArguments(bindingObject, dispatchEventArguments);
-
-    _DispatchEventResultContext context = _DispatchEventResultContext(
-      completer,
-      event,
-      method,
-      allocatedNativeArguments,
-      rawEvent,
-      controller,
-      dispatchEventArguments,
-      stopwatch,
-    );
-
-    Pointer<NativeFunction<NativeInvokeResultCallback>> resultCallback = Pointer.fromFunction(_handleDispatchResult);
-
-    Future.microtask(() {
-      f(pointer, contextId, method, dispatchEventArguments.length, allocatedNativeArguments, context, resultCallback);
-    });
-
-    return completer.future;
+    return pending.completer.future;
   }
 }
 
@@ -374,6 +374,23 @@ dynamic getterBindingCall(BindingObject bindingObject, List<dynamic> args) {
   return result;
 }
 
+// Answers several getters in one call from native, so a run of layout reads
+// costs a single round trip.
+dynamic gettersBindingCall(BindingObject bindingObject, List<dynamic> args) {
+  Stopwatch? stopwatch;
+  if (enableWebFCommandLog) {
+    stopwatch = Stopwatch()..start();
+  }
+
+  List<dynamic> result = List.generate(args.length, (i) => _getBindingObjectProperty(bindingObject, args[i]));
+
+  if (enableWebFCommandLog && stopwatch != null) {
+    bridgeLogger.fine('$bindingObject getBindingProperties keys: $args result: $result time: ${stopwatch.elapsedMicroseconds}us');
+  }
+
+  return result;
+}
+
 dynamic _setBindingObjectProperty(BindingObject bindingObject, String key, value) {
   dynamic originalValue;
 
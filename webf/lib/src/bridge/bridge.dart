@@ -10,6 +10,7 @@
 import 'dart:async';
 import 'dart:ffi';
 import 'package:ffi/ffi.dart';
+import 'package:path/path.dart' as path;
 import 'package:webf/dom.dart';
 import 'package:webf/bridge.dart';
 import 'package:webf/foundation.dart';
@@ -26,11 +27,23 @@ final _initDartDynamicLinking =
 class DartContext implements Finalizable {
   static final _finalizer = NativeFinalizer(_initDartDynamicLinking);
 
-  DartContext() : pointer = initDartIsolateContext(makeDartMethodsData()) {
+  DartContext({String? bytecodeCacheDirectory})
+      : pointer = initDartIsolateContext(makeDartMethodsData(), bytecodeCacheDirectory: bytecodeCacheDirectory),
+        nativeByteCodeCacheEnabled = bytecodeCacheDirectory != null {
     initDartDynamicLinking();
+    setPrewarmedPageCount(pointer, WebFControllerManager.instance.prewarmedPagesPerThread);
     _finalizer.attach(this, pointer);
   }
   final Pointer<Void> pointer;
+
+  // Classic scripts are compiled and cached on disk by the bridge itself.
+  final bool nativeByteCodeCacheEnabled;
+}
+
+Future<String?> _nativeByteCodeCacheDirectory() async {
+  if (QuickJSByteCodeCacheObject.cacheMode != ByteCodeCacheMode.DEFAULT) return null;
+  final String appTemporaryPath = await getWebFTemporaryPath();
+  return path.join(appTemporaryPath, 'ByteCodeCaches_${QuickJSByteCodeCache.bytecodeVersion}', 'native');
 }
 
 DartContext? dartContext;
@@ -91,7 +104,10 @@ FutureOr<double> initBridge(WebFViewController view, WebFThread runningThread, b
   BindingBridge.setup();
   defineBuiltInElements();
 
-  dartContext ??= DartContext();
+  if (dartContext == null) {
+    final String? bytecodeCacheDirectory = await _nativeByteCodeCacheDirectory();
+    dartContext ??= DartContext(bytecodeCacheDirectory: bytecodeCacheDirectory);
+  }
 
   // Initialize remote object service
   _initRemoteObjectService();
@@ -28,6 +28,10 @@ String uint16ToString(Pointer<Uint16> pointer, int length) {
   return String.fromCharCodes(pointer.asTypedList(length));
 }
 
+String latin1ToString(Pointer<Uint8> pointer, int length) {
+  return String.fromCharCodes(pointer.asTypedList(length));
+}
+
 Pointer<Uint16> _stringToUint16(String string) {
   final units = string.codeUnits;
   final Pointer<Uint16> result = malloc.allocate<Uint16>(units.length * sizeOf<Uint16>());
@@ -40,6 +44,7 @@ Pointer<NativeString> stringToNativeString(String string) {
   Pointer<NativeString> nativeString = malloc.allocate<NativeString>(sizeOf<NativeString>());
   nativeString.ref.string = _stringToUint16(string);
   nativeString.ref.length = string.length;
+  nativeString.ref.is8Bit = 0;
   return nativeString;
 }
 
@@ -78,6 +83,9 @@ String nativeStringToString(Pointer<NativeString> pointer) {
   if (ptr == nullptr) {
     return '';
   }
+  if (pointer.ref.is8Bit != 0) {
+    return latin1ToString(ptr.cast<Uint8>(), len);
+  }
   return uint16ToString(ptr, len);
 }
 
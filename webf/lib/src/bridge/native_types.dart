@@ -26,10 +26,14 @@ final class NativeWebFInfo extends Struct {
 
 // An native struct can be directly convert to javaScript String without any conversion cost.
 final class NativeString extends Struct {
+  // UTF-16 code units, or Latin-1 characters when [is8Bit] is non-zero.
   external Pointer<Uint16> string;
 
   @Uint32()
   external int length;
+
+  @Uint32()
+  external int is8Bit;
 }
 
 // Key-Value type, both key and value can be directly convert to javaScript String without any conversion cost.
@@ -71,6 +75,49 @@ final class NativeStyleValueIdWithHref extends Struct {
   external Pointer<NativeString> href;
 }
 
+// Typed style values for UICommandType.setStyleByIdTyped. Mirrors
+// NativeStyleValueType / NativeStyleValueUnit in bridge/foundation/native_type.h.
+const int kNativeStyleValueTypeNumeric = 1;
+const int kNativeStyleValueTypeColor = 2;
+const int kNativeStyleValueTypeList = 3;
+
+// Indexed by NativeStyleValueUnit.
+const List<String> nativeStyleValueUnitSuffixes = [
+  '', '', '%', 'px', 'em', 'rem', 'ex', 'ch', 'vw', 'vh', 'vmin', 'vmax', //
+  'cm', 'mm', 'in', 'pt', 'pc', 'q', 'deg', 'rad', 'grad', 'turn', 'ms', 's', 'fr',
+];
+
+// One list item of a setStyleByIdTyped command.
+final class NativeTypedStyleValue extends Struct {
+  @Double()
+  external double number;
+
+  @Uint32()
+  external int argb;
+
+  @Uint8()
+  external int type;
+
+  @Uint8()
+  external int unit;
+
+  @Uint16()
+  external int reserved;
+}
+
+// Recorded canvas 2D calls submitted with UICommandType.requestCanvasPaint.
+// Each ops word is a CanvasOp in the low byte and its argument count above it.
+final class NativeCanvasDisplayList extends Struct {
+  external Pointer<Uint32> ops;
+  external Pointer<Double> args;
+
+  @Uint32()
+  external int opCount;
+
+  @Uint32()
+  external int argCount;
+}
+
 // Combined pseudo style property (key/value) + base href payload for
 // UICommandType.setPseudoStyle.
 final class NativePseudoStyleWithHref extends Struct {
@@ -103,6 +150,33 @@ final class EventDispatchResult extends Struct {
   external bool preventDefaulted;
 }
 
+// One event of a batch sent with dispatchEventBatch().
+// Keep in sync with NativeDispatchEventItem in bridge/core/dom/events/event_target.h
+final class NativeDispatchEventItem extends Struct {
+  external Pointer<NativeBindingObject> currentTarget;
+
+  // Owned by the JS thread once sent.
+  external Pointer<NativeString> type;
+
+  external Pointer<RawEvent> rawEvent;
+
+  @Int32()
+  external int isCapture;
+
+  // Written by the JS thread: the item whose result this one reports, or -1 if it was not dispatched.
+  @Int32()
+  external int dispatchedIndex;
+
+  @Int8()
+  external int canceled;
+
+  @Int8()
+  external int propagationStopped;
+
+  @Int8()
+  external int preventDefaulted;
+}
+
 final class AddEventListenerOptions extends Struct {
   @Bool()
   external bool capture;
@@ -222,6 +296,28 @@ bool isBindingObjectDisposed(Pointer<NativeBindingObject>? nativeBindingObject)
   return _isNativeBindingObjectDisposed(nativeBindingObject);
 }
 
+// Layout geometry of one element after a frame, see bridge/core/dom/layout_geometry_snapshot.h.
+final class NativeLayoutGeometry extends Struct {
+  external Pointer<NativeBindingObject> target;
+
+  @Double()
+  external double x;
+  @Double()
+  external double y;
+  @Double()
+  external double width;
+  @Double()
+  external double height;
+  @Double()
+  external double offsetLeft;
+  @Double()
+  external double offsetTop;
+  @Double()
+  external double offsetWidth;
+  @Double()
+  external double offsetHeight;
+}
+
 final class NativePerformanceEntry extends Struct {
   external Pointer<Utf8> name;
   external Pointer<Utf8> entryType;
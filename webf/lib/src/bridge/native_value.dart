@@ -42,7 +42,9 @@ enum JSValueType {
   tagFunction,
   tagAsyncFunction,
   tagUint8Bytes,
-  tagUndefined
+  tagUndefined,
+  // An id into bindingNames.
+  tagBindingName
 }
 
 enum JSPointerType {
@@ -243,6 +245,8 @@ dynamic fromNativeValue(WebFViewController view, Pointer<NativeValue> nativeValu
       return null;
     case JSValueType.tagUndefined:
       return null; // Dart doesn't have undefined, so we return null but the caller can check the tag
+    case JSValueType.tagBindingName:
+      return bindingNames[nativeValue.ref.u];
     case JSValueType.tagFloat64:
       return uInt64ToDouble(nativeValue.ref.u);
     case JSValueType.tagPointer:
@@ -287,6 +291,18 @@ String _encodeEnumForBridge(Enum value) {
   return value.name;
 }
 
+// Writes a method or property name, as an id when the bridge registered it.
+void toNativeBindingName(Pointer<NativeValue> target, String name) {
+  int? id = bindingNameIdOf(name);
+  if (id == null) {
+    toNativeValue(target, name);
+    return;
+  }
+  target.ref.tag = JSValueType.tagBindingName.index;
+  target.ref.uint32 = 0;
+  target.ref.u = id;
+}
+
 void toNativeValue(Pointer<NativeValue> target, value, [BindingObject? ownerBindingObject]) {
   if (value == null) {
     target.ref.tag = JSValueType.tagNull.index;
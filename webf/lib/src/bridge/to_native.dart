@@ -73,6 +73,37 @@ WebFInfo getWebFInfo() {
   return _cachedInfo;
 }
 
+typedef NativeGetBindingNameTable = Pointer<Pointer<Utf8>> Function(Pointer<Int32> count);
+typedef DartGetBindingNameTable = Pointer<Pointer<Utf8>> Function(Pointer<Int32> count);
+
+final DartGetBindingNameTable _getBindingNameTable = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeGetBindingNameTable>>('getBindingNameTable')
+    .asFunction();
+
+List<String> _readBindingNames() {
+  Pointer<Int32> count = malloc.allocate(sizeOf<Int32>());
+  Pointer<Pointer<Utf8>> names = _getBindingNameTable(count);
+  List<String> result = List.generate(count.value, (i) => names[i].toDartString(), growable: false);
+  malloc.free(count);
+  return result;
+}
+
+// Property and method names the bridge sends as ids (JSValueType.tagBindingName), indexed by id.
+// The table is fixed at build time, so it is read once per isolate.
+final List<String> bindingNames = _readBindingNames();
+
+final Map<String, int> _bindingNameIds = () {
+  Map<String, int> ids = {};
+  for (int i = 0; i < bindingNames.length; i++) {
+    ids.putIfAbsent(bindingNames[i], () => i);
+  }
+  return ids;
+}();
+
+int? bindingNameIdOf(String name) {
+  return _bindingNameIds[name];
+}
+
 // Register Native Callback Port
 final interactiveCppRequests = RawReceivePort((message) {
   requestExecuteCallback(message);
@@ -193,6 +224,22 @@ dynamic invokeModuleEvent(double contextId, String moduleName, Event? event, ext
   return completer.future;
 }
 
+typedef NativeDispatchEventBatch = Void Function(Pointer<Void> page, Pointer<NativeDispatchEventItem> items, Int32 count,
+    Handle object, Pointer<NativeFunction<NativeDispatchEventBatchCallback>> callback);
+typedef DartDispatchEventBatch = void Function(Pointer<Void> page, Pointer<NativeDispatchEventItem> items, int count,
+    Object object, Pointer<NativeFunction<NativeDispatchEventBatchCallback>> callback);
+typedef NativeDispatchEventBatchCallback = Void Function(Handle object);
+
+final DartDispatchEventBatch _dispatchEventBatch =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeDispatchEventBatch>>('dispatchEventBatch').asFunction();
+
+// Sends |count| events to JS in one hop. |callback| runs with |context| once every item carries its result.
+void dispatchEventBatch(double contextId, Pointer<NativeDispatchEventItem> items, int count, Object context,
+    Pointer<NativeFunction<NativeDispatchEventBatchCallback>> callback) {
+  assert(_allocatedPages.containsKey(contextId));
+  _dispatchEventBatch(_allocatedPages[contextId]!, items, count, context, callback);
+}
+
 typedef DartDispatchEvent = int Function(double contextId, Pointer<NativeBindingObject> nativeBindingObject,
     Pointer<NativeString> eventType, Pointer<Void> nativeEvent, int isCustomEvent);
 
@@ -315,6 +362,42 @@ bool updateStyleForThisDocument(Pointer<Void> page) {
   return _updateStyleForThisDocument(page) == 1;
 }
 
+// Layout geometry snapshot, see bridge/core/dom/layout_geometry_snapshot.h.
+typedef NativeGetLayoutGeometryGeneration = Int64 Function(Pointer<Void> page);
+typedef DartGetLayoutGeometryGeneration = int Function(Pointer<Void> page);
+typedef NativePublishLayoutGeometry = Void Function(
+    Pointer<Void> page, Int64 generation, Pointer<NativeLayoutGeometry> entries, Int32 length);
+typedef DartPublishLayoutGeometry = void Function(
+    Pointer<Void> page, int generation, Pointer<NativeLayoutGeometry> entries, int length);
+typedef NativeClearLayoutGeometry = Void Function(Pointer<Void> page);
+typedef DartClearLayoutGeometry = void Function(Pointer<Void> page);
+
+final DartGetLayoutGeometryGeneration _getLayoutGeometryGeneration = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeGetLayoutGeometryGeneration>>('getLayoutGeometryGeneration')
+    .asFunction();
+
+final DartPublishLayoutGeometry _publishLayoutGeometry = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativePublishLayoutGeometry>>('publishLayoutGeometry')
+    .asFunction();
+
+final DartClearLayoutGeometry _clearLayoutGeometry = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeClearLayoutGeometry>>('clearLayoutGeometry')
+    .asFunction();
+
+// The generation to tag geometry laid out from the UI commands flushed next.
+int getLayoutGeometryGeneration(Pointer<Void> page) {
+  return _getLayoutGeometryGeneration(page);
+}
+
+// Takes ownership of |entries|.
+void publishLayoutGeometry(Pointer<Void> page, int generation, Pointer<NativeLayoutGeometry> entries, int length) {
+  _publishLayoutGeometry(page, generation, entries, length);
+}
+
+void clearLayoutGeometry(Pointer<Void> page) {
+  _clearLayoutGeometry(page);
+}
+
 typedef NativeParseSVGResult = Pointer<NativeGumboOutput> Function(Pointer<Utf8> code, Int32 length);
 typedef DartParseSVGResult = Pointer<NativeGumboOutput> Function(Pointer<Utf8> code, int length);
 
@@ -386,9 +469,14 @@ Future<bool> evaluateScripts(double contextId, Uint8List codeBytes,
     _anonymousScriptEvaluationId++;
   }
 
-  QuickJSByteCodeCacheObject cacheObject =
-      await QuickJSByteCodeCache.getCacheObject(codeBytes, cacheKey: cacheKey, loadedFromCache: loadedFromCache);
-  if (QuickJSByteCodeCacheObject.cacheMode == ByteCodeCacheMode.DEFAULT &&
+  // When the bridge caches bytecode itself, hand it the source and let it
+  // look up, compile and store on the JS thread.
+  bool nativeByteCodeCache = dartContext?.nativeByteCodeCacheEnabled ?? false;
+  QuickJSByteCodeCacheObject? cacheObject = nativeByteCodeCache
+      ? null
+      : await QuickJSByteCodeCache.getCacheObject(codeBytes, cacheKey: cacheKey, loadedFromCache: loadedFromCache);
+  if (cacheObject != null &&
+      QuickJSByteCodeCacheObject.cacheMode == ByteCodeCacheMode.DEFAULT &&
       cacheObject.valid &&
       cacheObject.bytes != null) {
     bool result =
@@ -413,7 +501,7 @@ Future<bool> evaluateScripts(double contextId, Uint8List codeBytes,
 
     try {
       assert(_allocatedPages.containsKey(contextId));
-      if (QuickJSByteCodeCache.isCodeNeedCache(codeBytes)) {
+      if (!nativeByteCodeCache && QuickJSByteCodeCache.isCodeNeedCache(codeBytes)) {
         // Export the bytecode from scripts
         Pointer<Pointer<Uint8>> bytecodes = malloc.allocate(sizeOf<Pointer<Uint8>>());
         Pointer<Uint64> bytecodeLen = malloc.allocate(sizeOf<Uint64>());
@@ -684,19 +772,24 @@ Future<Uint8List> dumpQuickjsByteCode(double contextId, Uint8List code, {String?
 
 // Register initJsEngine
 typedef NativeInitDartIsolateContext = Pointer<Void> Function(
-    Int64 sendPort, Pointer<Uint64> dartMethods, Int32 methodsLength);
+    Int64 sendPort, Pointer<Uint64> dartMethods, Int32 methodsLength, Pointer<Utf8> bytecodeCacheDirectory);
 typedef DartInitDartIsolateContext = Pointer<Void> Function(
-    int sendPort, Pointer<Uint64> dartMethods, int methodsLength);
+    int sendPort, Pointer<Uint64> dartMethods, int methodsLength, Pointer<Utf8> bytecodeCacheDirectory);
 
 final DartInitDartIsolateContext _initDartIsolateContext = WebFDynamicLibrary.ref
     .lookup<NativeFunction<NativeInitDartIsolateContext>>('initDartIsolateContextSync')
     .asFunction();
 
-Pointer<Void> initDartIsolateContext(List<int> dartMethods) {
+Pointer<Void> initDartIsolateContext(List<int> dartMethods, {String? bytecodeCacheDirectory}) {
   Pointer<Uint64> bytes = malloc.allocate<Uint64>(sizeOf<Uint64>() * dartMethods.length);
   Uint64List nativeMethodList = bytes.asTypedList(dartMethods.length);
   nativeMethodList.setAll(0, dartMethods);
-  return _initDartIsolateContext(nativePort, bytes, dartMethods.length);
+  Pointer<Utf8> directory = bytecodeCacheDirectory?.toNativeUtf8() ?? nullptr;
+  Pointer<Void> context = _initDartIsolateContext(nativePort, bytes, dartMethods.length, directory);
+  if (directory != nullptr) {
+    malloc.free(directory);
+  }
+  return context;
 }
 
 typedef HandleDisposePageResult = Void Function(Handle context);
@@ -751,6 +844,17 @@ int newPageId() {
   return _newPageId();
 }
 
+typedef NativeSetPrewarmedPageCount = Void Function(Pointer<Void>, Int32);
+typedef DartSetPrewarmedPageCount = void Function(Pointer<Void>, int);
+
+final DartSetPrewarmedPageCount _setPrewarmedPageCount = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeSetPrewarmedPageCount>>('setPrewarmedPageCount')
+    .asFunction();
+
+void setPrewarmedPageCount(Pointer<Void> dartContext, int count) {
+  _setPrewarmedPageCount(dartContext, count);
+}
+
 typedef NativeAllocateNewPageSync = Pointer<Void> Function(
     Double, Pointer<Void>, Pointer<WidgetElementShape>, Int32, Int8);
 typedef DartAllocateNewPageSync = Pointer<Void> Function(double, Pointer<Void>, Pointer<WidgetElementShape>, int, int);
@@ -869,6 +973,10 @@ enum UICommandType {
   disconnectIntersectionObserver,
   // Append-only: set inline style using Blink CSSPropertyID/CSSValueID ints.
   setStyleById,
+  // Append-only: set inline style using a Blink CSSPropertyID and a typed numeric/color value.
+  setStyleByIdTyped,
+  // Append-only: bind a serialized style value to a handle referenced by setStyleById.
+  defineStyleValue,
 }
 
 final class UICommandItem extends Struct {
@@ -936,16 +1044,17 @@ void flushUICommandWithContextId(double contextId, Pointer<NativeBindingObject>
   }
 }
 
-void flushUICommand(WebFViewController view, Pointer<NativeBindingObject> selfPointer) {
-  if (view.disposed) return;
-  if (view.isFlushingUICommands) return;
+// Returns false when the commands were left for a later flush.
+bool flushUICommand(WebFViewController view, Pointer<NativeBindingObject> selfPointer) {
+  if (view.disposed) return false;
+  if (view.isFlushingUICommands) return false;
   assert(_allocatedPages.containsKey(view.contextId));
 
   if (view.rootController.isFontsLoading) {
     SchedulerBinding.instance.scheduleFrameCallback((timeStamp) {
       flushUICommand(view, selfPointer);
     });
-    return;
+    return false;
   }
 
   view.isFlushingUICommands = true;
@@ -956,4 +1065,5 @@ void flushUICommand(WebFViewController view, Pointer<NativeBindingObject> selfPo
     view.isFlushingUICommands = false;
   }
   SchedulerBinding.instance.scheduleFrame();
+  return true;
 }
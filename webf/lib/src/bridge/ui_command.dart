@@ -8,6 +8,7 @@
 
 import 'dart:io';
 import 'dart:ffi';
+import 'dart:typed_data';
 import 'package:ffi/ffi.dart';
 import 'package:flutter/foundation.dart';
 import 'package:webf/bridge.dart';
@@ -25,11 +26,17 @@ class UICommand {
 
   // Inline payload for UICommandType.setStyleById.
   // - stylePropertyId: native (Blink) CSSPropertyID integer value.
-  // - styleValueSlot: either a pointer to NativeString (>= 0) holding the value,
-  //   or a negative immediate CSSValueID: -(valueId + 1).
+  // - styleValueSlot: a pointer to NativeString (> 0, even) holding the value,
+  //   an interned value handle defined by defineStyleValue: (handle << 1) | 1,
+  //   a negative immediate CSSValueID: -(valueId + 1), or 0 for an empty value.
   int stylePropertyId = 0;
   int styleValueSlot = 0;
 
+  // Inline payload for UICommandType.setStyleByIdTyped: stylePropertyId as
+  // above, styleValueSlot holds the value bits and styleValueDescriptor the
+  // value type/unit/list layout (see nativeTypedStyleValueToCss).
+  int styleValueDescriptor = 0;
+
   UICommand();
   UICommand.from(this.type, this.args, this.nativePtr, this.nativePtr2);
 
@@ -65,6 +72,9 @@ final class UICommandItemFFI extends Struct {
   external int nativePtr2;
 }
 
+// Matches UICommandItem::kArgs01Latin1Flag: string_01 holds Latin-1 characters.
+const int _args01Latin1Flag = 1 << 30;
+
 bool enableWebFCommandLog = !kReleaseMode && Platform.environment['ENABLE_WEBF_JS_LOG'] == 'true';
 
 typedef NativeFreeActiveCommandBuffer = Void Function(Pointer<Void>);
@@ -87,6 +97,16 @@ List<UICommand> nativeUICommandToDartFFI(double contextId) {
     // Extract type
     command.type = UICommandType.values[commandItem.type];
 
+    if (command.type == UICommandType.setStyleByIdTyped) {
+      command.args = '';
+      command.nativePtr = commandItem.nativePtr != 0 ? Pointer.fromAddress(commandItem.nativePtr) : nullptr;
+      command.nativePtr2 = nullptr;
+      command.stylePropertyId = commandItem.args01Length;
+      command.styleValueSlot = commandItem.string_01;
+      command.styleValueDescriptor = commandItem.nativePtr2;
+      return command;
+    }
+
     if (command.type == UICommandType.setStyleById) {
       command.args = '';
       command.nativePtr = commandItem.nativePtr != 0 ? Pointer.fromAddress(commandItem.nativePtr) : nullptr;
@@ -99,7 +119,10 @@ List<UICommand> nativeUICommandToDartFFI(double contextId) {
     // Extract args string
     if (commandItem.string_01 != 0) {
       Pointer<Uint16> args_01 = Pointer.fromAddress(commandItem.string_01);
-      command.args = uint16ToString(args_01, commandItem.args01Length);
+      final int length = commandItem.args01Length & ~_args01Latin1Flag;
+      command.args = (commandItem.args01Length & _args01Latin1Flag) != 0
+          ? latin1ToString(args_01.cast<Uint8>(), length)
+          : uint16ToString(args_01, length);
       malloc.free(args_01);
     } else {
       command.args = '';
@@ -117,6 +140,64 @@ List<UICommand> nativeUICommandToDartFFI(double contextId) {
   return results;
 }
 
+// Formats like CSSNumericLiteralValue::CustomCSSText on the C++ side: small
+// integers as-is, everything else as printf's %.6g.
+String _formatCssNumber(double value) {
+  if (value == value.truncateToDouble() && value.abs() <= 999999) {
+    return value.toInt().toString();
+  }
+  if (!value.isFinite) return value.toString();
+
+  final String exponential = value.toStringAsExponential(5);
+  final int e = exponential.indexOf('e');
+  final int exponent = int.parse(exponential.substring(e + 1));
+  if (exponent < -4 || exponent >= 6) {
+    final String mantissa = _stripTrailingZeros(exponential.substring(0, e));
+    final String digits = exponent.abs().toString().padLeft(2, '0');
+    return '${mantissa}e${exponent < 0 ? '-' : '+'}$digits';
+  }
+  return _stripTrailingZeros(value.toStringAsFixed(5 - exponent));
+}
+
+String _stripTrailingZeros(String text) {
+  if (!text.contains('.')) return text;
+  text = text.replaceFirst(RegExp(r'0+$'), '');
+  return text.endsWith('.') ? text.substring(0, text.length - 1) : text;
+}
+
+String _typedStyleItemToCss(int type, int unit, double number, int argb) {
+  if (type == kNativeStyleValueTypeColor) {
+    final String rgb = (argb & 0xFFFFFF).toRadixString(16).padLeft(6, '0');
+    final int alpha = (argb >> 24) & 0xFF;
+    return alpha == 0xFF ? '#$rgb' : '#$rgb${alpha.toRadixString(16).padLeft(2, '0')}';
+  }
+  if (type == kNativeStyleValueTypeNumeric && unit < nativeStyleValueUnitSuffixes.length) {
+    return _formatCssNumber(number) + nativeStyleValueUnitSuffixes[unit];
+  }
+  return '';
+}
+
+// Converts a setStyleByIdTyped payload into canonical CSS text and releases
+// the list item array for list values.
+String nativeTypedStyleValueToCss(int valueBits, int descriptor) {
+  final int type = descriptor & 0xFF;
+  if (type == kNativeStyleValueTypeList) {
+    final int separator = (descriptor >> 8) & 0xFF;
+    final int count = (descriptor >> 16) & 0xFFFF;
+    final Pointer<NativeTypedStyleValue> items = Pointer<NativeTypedStyleValue>.fromAddress(valueBits);
+    final List<String> parts = List.generate(count, (int i) {
+      final NativeTypedStyleValue item = items[i];
+      return _typedStyleItemToCss(item.type, item.unit, item.number, item.argb);
+    }, growable: false);
+    malloc.free(items);
+    // CSSValue::ValueListSeparator: 0 = space, 1 = comma.
+    return parts.join(separator == 1 ? ', ' : ' ');
+  }
+
+  final ByteData bits = ByteData(8)..setInt64(0, valueBits, Endian.host);
+  return _typedStyleItemToCss(type, (descriptor >> 8) & 0xFF, bits.getFloat64(0, Endian.host), valueBits & 0xFFFFFFFF);
+}
+
 void execUICommands(WebFViewController view, List<UICommand> commands) {
   Map<int, bool> pendingStylePropertiesTargets = {};
 
@@ -159,6 +240,15 @@ void execUICommands(WebFViewController view, List<UICommand> commands) {
           printMsg =
               'nativePtr: ${command.nativePtr} type: ${command.type} key: ${command.args} value: $valueLog baseHref: ${baseHrefLog ?? 'null'}';
           break;
+        case UICommandType.setStyleByIdTyped:
+          final int descriptor = command.styleValueDescriptor;
+          // List payloads are released when decoded, so only single values are rendered here.
+          final String valueLog = (descriptor & 0xFF) == kNativeStyleValueTypeList
+              ? '<list of ${(descriptor >> 16) & 0xFFFF}>'
+              : nativeTypedStyleValueToCss(command.styleValueSlot, descriptor);
+          printMsg =
+              'nativePtr: ${command.nativePtr} type: ${command.type} propertyId: ${command.stylePropertyId} key: ${blinkStylePropertyNameFromId(command.stylePropertyId)} value: $valueLog';
+          break;
         case UICommandType.setStyleById:
           final String keyLog = blinkStylePropertyNameFromId(command.stylePropertyId);
           String? valueLog;
@@ -166,6 +256,8 @@ void execUICommands(WebFViewController view, List<UICommand> commands) {
           final int slot = command.styleValueSlot;
           if (slot < 0) {
             valueLog = blinkKeywordFromValueId(-slot - 1);
+          } else if (slot & 1 == 1) {
+            valueLog = view.styleValueForHandle(slot >> 1);
           } else if (slot > 0) {
             try {
               valueLog = nativeStringToString(Pointer<NativeString>.fromAddress(slot));
@@ -324,6 +416,19 @@ void execUICommands(WebFViewController view, List<UICommand> commands) {
           view.recordBlinkStyleSyncProperty(nativePtr, command.args);
           pendingStylePropertiesTargets[nativePtr.address] = true;
           break;
+        case UICommandType.defineStyleValue:
+          view.defineStyleValue(command.nativePtr2.address, command.args);
+          break;
+        case UICommandType.setStyleByIdTyped:
+          // Decode first: it also releases list payloads.
+          final String value = nativeTypedStyleValueToCss(command.styleValueSlot, command.styleValueDescriptor);
+          final String key = blinkStylePropertyNameFromId(command.stylePropertyId);
+          if (key.isEmpty) break;
+
+          view.setInlineStyle(nativePtr, key, value);
+          view.recordBlinkStyleSyncProperty(nativePtr, key);
+          pendingStylePropertiesTargets[nativePtr.address] = true;
+          break;
         case UICommandType.setStyleById:
           final String key = blinkStylePropertyNameFromId(command.stylePropertyId);
           if (key.isEmpty) break;
@@ -334,6 +439,8 @@ void execUICommands(WebFViewController view, List<UICommand> commands) {
           final int slot = command.styleValueSlot;
           if (slot < 0) {
             value = blinkKeywordFromValueId(-slot - 1);
+          } else if (slot & 1 == 1) {
+            value = view.styleValueForHandle(slot >> 1);
           } else if (slot > 0) {
             final Pointer<NativeString> nativeValue = Pointer<NativeString>.fromAddress(slot);
             value = nativeStringToString(nativeValue);
@@ -462,7 +569,8 @@ void execUICommands(WebFViewController view, List<UICommand> commands) {
           );
           break;
         case UICommandType.requestCanvasPaint:
-          view.requestCanvasPaint(nativePtr.cast<NativeBindingObject>());
+          view.requestCanvasPaint(
+              nativePtr.cast<NativeBindingObject>(), command.nativePtr2.cast<NativeCanvasDisplayList>());
           break;
         case UICommandType.addIntersectionObserver:
           view.addIntersectionObserver(
@@ -565,13 +565,13 @@ abstract class Element extends ContainerNode
   // https://www.w3.org/TR/cssom-view-1/#extension-to-the-element-interface
   static final StaticDefinedBindingPropertyMap _elementProperties = {
     'offsetTop': StaticDefinedBindingProperty(
-        getter: (element) => castToType<Element>(element).offsetTop),
+        getter: (element) => castToType<Element>(element)._measuredFromJS().offsetTop),
     'offsetLeft': StaticDefinedBindingProperty(
-        getter: (element) => castToType<Element>(element).offsetLeft),
+        getter: (element) => castToType<Element>(element)._measuredFromJS().offsetLeft),
     'offsetWidth': StaticDefinedBindingProperty(
-        getter: (element) => castToType<Element>(element).offsetWidth),
+        getter: (element) => castToType<Element>(element)._measuredFromJS().offsetWidth),
     'offsetHeight': StaticDefinedBindingProperty(
-        getter: (element) => castToType<Element>(element).offsetHeight),
+        getter: (element) => castToType<Element>(element)._measuredFromJS().offsetHeight),
     'scrollTop': StaticDefinedBindingProperty(
         getter: (element) => castToType<Element>(element).scrollTop,
         setter: (element, value) =>
@@ -621,9 +621,9 @@ abstract class Element extends ContainerNode
   static final StaticDefinedSyncBindingObjectMethodMap _elementSyncMethods = {
     'getBoundingClientRect': StaticDefinedSyncBindingObjectMethod(
         call: (element, _) =>
-            castToType<Element>(element).getBoundingClientRect()),
+            castToType<Element>(element)._measuredFromJS().getBoundingClientRect()),
     'getClientRects': StaticDefinedSyncBindingObjectMethod(
-        call: (element, _) => castToType<Element>(element).getClientRects()),
+        call: (element, _) => castToType<Element>(element)._measuredFromJS().getClientRects()),
     'scroll': StaticDefinedSyncBindingObjectMethod(
         call: (element, args) => castToType<Element>(element)
             .scroll(castToType<double>(args[0]), castToType<double>(args[1]))),
@@ -785,6 +785,13 @@ abstract class Element extends ContainerNode
     }
   }
 
+  // JS measured this element synchronously; keep its geometry in the native
+  // layout geometry snapshot so the next reads are answered there.
+  Element _measuredFromJS() {
+    ownerView.trackLayoutGeometry(this);
+    return this;
+  }
+
   BoundingClientRect getBoundingClientRect() => boundingClientRect;
 
   List<BoundingClientRect> getClientRects() {
@@ -807,6 +814,7 @@ abstract class Element extends ContainerNode
 
   void handleScroll(double scrollOffset, AxisDirection axisDirection) {
     if (!renderStyle.hasRenderBox()) return;
+    ownerView.invalidateLayoutGeometry();
     _applyFixedChildrenOffset(scrollOffset, axisDirection);
 
     // Update sticky descendants' paint offsets when this element scrolls.
@@ -2564,13 +2572,27 @@ abstract class Element extends ContainerNode
   // about the size of an element and its position relative to the viewport.
   // https://drafts.csswg.org/cssom-view/#dom-element-getboundingclientrect
   BoundingClientRect get boundingClientRect {
-    BoundingClientRect boundingClientRect = BoundingClientRect.zero(
-        BindingContext(
-            ownerView, ownerView.contextId, allocateNewBindingObject()));
+    final Rect rect = boundingClientRectBounds;
+    return BoundingClientRect(
+        context: BindingContext(
+            ownerView, ownerView.contextId, allocateNewBindingObject()),
+        x: rect.left,
+        y: rect.top,
+        width: rect.width,
+        height: rect.height,
+        top: rect.top,
+        right: rect.right,
+        bottom: rect.bottom,
+        left: rect.left);
+  }
+
+  // The viewport-relative bounds behind [boundingClientRect], without
+  // allocating a binding object for them.
+  Rect get boundingClientRectBounds {
     if (isRendererAttached) {
       // RenderBoxModel sizedBox = renderBoxModel!;
       if (!renderStyle.isBoxModelHaveSize()) {
-        return boundingClientRect;
+        return Rect.zero;
       }
 
       // Special handling for inline elements that participate in inline formatting context
@@ -2605,18 +2627,7 @@ abstract class Element extends ContainerNode
               final absoluteOffset =
                   containerOffset + contentOffset + ifcBounds.topLeft;
 
-              boundingClientRect = BoundingClientRect(
-                  context: BindingContext(ownerView, ownerView.contextId,
-                      allocateNewBindingObject()),
-                  x: absoluteOffset.dx,
-                  y: absoluteOffset.dy,
-                  width: ifcBounds.width,
-                  height: ifcBounds.height,
-                  top: absoluteOffset.dy,
-                  right: absoluteOffset.dx + ifcBounds.width,
-                  bottom: absoluteOffset.dy + ifcBounds.height,
-                  left: absoluteOffset.dx);
-              return boundingClientRect;
+              return absoluteOffset & ifcBounds.size;
             }
             break;
           }
@@ -2648,22 +2659,11 @@ abstract class Element extends ContainerNode
           }
         }
 
-        Size size = renderStyle.boxSize()!;
-        boundingClientRect = BoundingClientRect(
-            context: BindingContext(
-                ownerView, ownerView.contextId, allocateNewBindingObject()),
-            x: offset.dx,
-            y: offset.dy,
-            width: size.width,
-            height: size.height,
-            top: offset.dy,
-            right: offset.dx + size.width,
-            bottom: offset.dy + size.height,
-            left: offset.dx);
+        return offset & renderStyle.boxSize()!;
       }
     }
 
-    return boundingClientRect;
+    return Rect.zero;
   }
 
   // The HTMLElement.offsetLeft read-only property returns the number of pixels that the upper left corner
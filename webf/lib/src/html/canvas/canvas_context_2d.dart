@@ -43,6 +43,40 @@ const String SQUARE = 'square';
 const String MITER = 'miter';
 const String BEVEL = 'bevel';
 
+// Mirrors CanvasOp in bridge/core/html/canvas/canvas_display_list.h.
+const int _canvasOpFillRect = 1;
+const int _canvasOpStrokeRect = 2;
+const int _canvasOpClearRect = 3;
+const int _canvasOpBeginPath = 4;
+const int _canvasOpClosePath = 5;
+const int _canvasOpMoveTo = 6;
+const int _canvasOpLineTo = 7;
+const int _canvasOpBezierCurveTo = 8;
+const int _canvasOpQuadraticCurveTo = 9;
+const int _canvasOpArc = 10;
+const int _canvasOpArcTo = 11;
+const int _canvasOpEllipse = 12;
+const int _canvasOpRect = 13;
+const int _canvasOpRoundRect = 14;
+const int _canvasOpFill = 15;
+const int _canvasOpStroke = 16;
+const int _canvasOpClip = 17;
+const int _canvasOpSave = 18;
+const int _canvasOpRestore = 19;
+const int _canvasOpTranslate = 20;
+const int _canvasOpRotate = 21;
+const int _canvasOpScale = 22;
+const int _canvasOpTransform = 23;
+const int _canvasOpSetTransform = 24;
+const int _canvasOpResetTransform = 25;
+const int _canvasOpSetGlobalAlpha = 26;
+const int _canvasOpSetLineWidth = 27;
+const int _canvasOpSetMiterLimit = 28;
+const int _canvasOpSetLineDashOffset = 29;
+const int _canvasOpSetShadowOffsetX = 30;
+const int _canvasOpSetShadowOffsetY = 31;
+const int _canvasOpSetShadowBlur = 32;
+
 class CanvasRenderingContext2DSettings {
   bool alpha = true;
   bool desynchronized = false;
@@ -640,6 +674,117 @@ class CanvasRenderingContext2D extends DynamicBindingObject with StaticDefinedBi
     canvas.notifyRepaint();
   }
 
+  // Replays the numeric-only calls recorded natively since the last submit.
+  void applyDisplayList(ffi.Pointer<NativeCanvasDisplayList> displayList) {
+    final NativeCanvasDisplayList list = displayList.ref;
+    final ffi.Pointer<ffi.Double> args = list.args;
+    int a = 0;
+    for (int i = 0; i < list.opCount; i++) {
+      final int word = list.ops[i];
+      final int argc = word >> 8;
+      double arg(int index) => args[a + index];
+      switch (word & 0xff) {
+        case _canvasOpFillRect:
+          fillRect(arg(0), arg(1), arg(2), arg(3));
+          break;
+        case _canvasOpStrokeRect:
+          strokeRect(arg(0), arg(1), arg(2), arg(3));
+          break;
+        case _canvasOpClearRect:
+          clearRect(arg(0), arg(1), arg(2), arg(3));
+          break;
+        case _canvasOpBeginPath:
+          beginPath();
+          break;
+        case _canvasOpClosePath:
+          closePath();
+          break;
+        case _canvasOpMoveTo:
+          moveTo(arg(0), arg(1));
+          break;
+        case _canvasOpLineTo:
+          lineTo(arg(0), arg(1));
+          break;
+        case _canvasOpBezierCurveTo:
+          bezierCurveTo(arg(0), arg(1), arg(2), arg(3), arg(4), arg(5));
+          break;
+        case _canvasOpQuadraticCurveTo:
+          quadraticCurveTo(arg(0), arg(1), arg(2), arg(3));
+          break;
+        case _canvasOpArc:
+          arc(arg(0), arg(1), arg(2), arg(3), arg(4), anticlockwise: argc > 5 && arg(5) != 0);
+          break;
+        case _canvasOpArcTo:
+          arcTo(arg(0), arg(1), arg(2), arg(3), arg(4));
+          break;
+        case _canvasOpEllipse:
+          ellipse(arg(0), arg(1), arg(2), arg(3), arg(4), arg(5), arg(6), anticlockwise: argc > 7 && arg(7) != 0);
+          break;
+        case _canvasOpRect:
+          rect(arg(0), arg(1), arg(2), arg(3));
+          break;
+        case _canvasOpRoundRect:
+          roundRect(arg(0), arg(1), arg(2), arg(3), [for (int r = 4; r < argc; r++) arg(r)]);
+          break;
+        case _canvasOpFill:
+          fill(PathFillType.nonZero);
+          break;
+        case _canvasOpStroke:
+          stroke();
+          break;
+        case _canvasOpClip:
+          clip(PathFillType.nonZero);
+          break;
+        case _canvasOpSave:
+          save();
+          break;
+        case _canvasOpRestore:
+          restore();
+          break;
+        case _canvasOpTranslate:
+          translate(arg(0), arg(1));
+          break;
+        case _canvasOpRotate:
+          rotate(arg(0));
+          break;
+        case _canvasOpScale:
+          scale(arg(0), arg(1));
+          break;
+        case _canvasOpTransform:
+          transform(arg(0), arg(1), arg(2), arg(3), arg(4), arg(5));
+          break;
+        case _canvasOpSetTransform:
+          setTransform(arg(0), arg(1), arg(2), arg(3), arg(4), arg(5));
+          break;
+        case _canvasOpResetTransform:
+          resetTransform();
+          break;
+        case _canvasOpSetGlobalAlpha:
+          globalAlpha = arg(0);
+          break;
+        case _canvasOpSetLineWidth:
+          lineWidth = arg(0);
+          break;
+        case _canvasOpSetMiterLimit:
+          miterLimit = arg(0);
+          break;
+        case _canvasOpSetLineDashOffset:
+          lineDashOffset = arg(0);
+          break;
+        case _canvasOpSetShadowOffsetX:
+          _shadowOffsetX = arg(0);
+          break;
+        case _canvasOpSetShadowOffsetY:
+          _shadowOffsetY = arg(0);
+          break;
+        case _canvasOpSetShadowBlur:
+          shadowBlur = arg(0);
+          break;
+      }
+      a += argc;
+    }
+  }
+
   // Perform canvas drawing.
   List<CanvasAction> performActions(Canvas canvas, Size size) {
     if (needsPaintIndexes.isEmpty) {
@@ -961,6 +1106,8 @@ class CanvasRenderingContext2D extends DynamicBindingObject with StaticDefinedBi
       _globalAlpha = state[14] as double;
       _globalCompositeOperation = state[15] as String;
       _globalBlendMode = _parseCompositeOperation(_globalCompositeOperation) ?? BlendMode.srcOver;
+      _lineDash = state[16] as List<double>;
+      _textBaseline = state[17] as CanvasTextBaseline;
 
       canvas.restore();
     }, CanvasActionType.execute, {
@@ -988,6 +1135,8 @@ class CanvasRenderingContext2D extends DynamicBindingObject with StaticDefinedBi
         _shadowOffsetY,
         _globalAlpha,
         _globalCompositeOperation,
+        _lineDash,
+        _textBaseline,
       ]);
       canvas.save();
     }, CanvasActionType.execute, {
@@ -1415,7 +1564,9 @@ class CanvasRenderingContext2D extends DynamicBindingObject with StaticDefinedBi
   }
 
   void setLineDash(List<double> segments) {
-    _lineDash = segments;
+    addAction('setLineDash', (Canvas canvas, Size size) {
+      _lineDash = segments;
+    });
   }
 
   bool get _shouldPaintShadow =>
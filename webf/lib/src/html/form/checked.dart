@@ -33,7 +33,7 @@ mixin BaseCheckedElement on BaseInputElement {
         nativePtr.ref.invokeBindingMethodFromDart.asFunction();
 
     final Pointer<NativeValue> method = malloc.allocate(sizeOf<NativeValue>());
-    toNativeValue(method, '__syncCheckedState', this);
+    toNativeBindingName(method, '__syncCheckedState');
     final Pointer<NativeValue> args = makeNativeValueArguments(this, [checked]);
 
     final _SyncCheckedStateContext context = _SyncCheckedStateContext(method, args);
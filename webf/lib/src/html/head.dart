@@ -542,7 +542,7 @@ class LinkElement extends Element {
 
     // Prepare method name and arguments
     final Pointer<NativeValue> method = malloc.allocate(sizeOf<NativeValue>());
-    toNativeValue(method, 'parseAuthorStyleSheet');
+    toNativeBindingName(method, 'parseAuthorStyleSheet');
     final Pointer<NativeValue> argv = makeNativeValueArguments(bindingObject, <dynamic>[cssText, href ?? '']);
 
     final ctx = _ParseStyleSheetContext(completer, method, argv);
@@ -6,6 +6,7 @@ import 'dart:async';
 import 'dart:collection';
 import 'package:flutter/foundation.dart';
 import 'package:flutter/widgets.dart';
+import 'package:webf/bridge.dart';
 import 'package:webf/foundation.dart';
 import 'package:webf/launcher.dart';
 import 'package:webf/devtools.dart';
@@ -104,6 +105,13 @@ class WebFControllerManagerConfig {
   /// and HTTP cache behavior.
   final bool useDioForNetwork;
 
+  /// Number of fully initialized JavaScript contexts each dedicated thread keeps
+  /// on standby, so creating a controller on that thread skips context setup.
+  ///
+  /// Spares are built while the thread is idle after a page was created on it.
+  /// Each one costs the memory of an empty page. Default is 0 (disabled).
+  final int prewarmedPagesPerThread;
+
   /// Creates a new configuration object for WebFControllerManager.
   ///
   /// All parameters have reasonable defaults suitable for most applications.
@@ -117,6 +125,7 @@ class WebFControllerManagerConfig {
     this.devToolsPort = 9222,
     this.devToolsAddress = '0.0.0.0',
     this.useDioForNetwork = true,
+    this.prewarmedPagesPerThread = 0,
   });
 }
 
@@ -276,6 +285,10 @@ class WebFControllerManager {
   void initialize(WebFControllerManagerConfig config) {
     _config = config;
 
+    if (dartContext != null) {
+      setPrewarmedPageCount(dartContext!.pointer, config.prewarmedPagesPerThread);
+    }
+
     // Start DevTools if enabled in config
     if (config.enableDevTools && !_devToolsEnabled) {
       startDevTools(
@@ -293,6 +306,9 @@ class WebFControllerManager {
   /// Whether Dio-backed networking is enabled globally.
   bool get useDioForNetwork => _config.useDioForNetwork;
 
+  /// Spare JavaScript contexts kept ready on each dedicated thread.
+  int get prewarmedPagesPerThread => _config.prewarmedPagesPerThread;
+
   /// Gets the count of currently attached controllers.
   int get attachedControllersCount => _attachedControllers.length;
 
@@ -171,13 +171,91 @@ class WebFViewController with Diagnosticable implements WidgetsBindingObserver {
     _flushPendingCommandsPerFrameLoop();
   }
 
+  // Elements JS has measured. Their geometry is published to the native
+  // layout geometry snapshot after every frame, so that further
+  // getBoundingClientRect()/offset* reads don't block on this thread.
+  // See bridge/core/dom/layout_geometry_snapshot.h.
+  static const int _maxLayoutGeometryElements = 1024;
+  final Set<Element> _layoutGeometryElements = {};
+  // The snapshot generation of the UI commands the pending frame lays out, or
+  // -1 when that frame can not be published.
+  int _layoutGeometryGeneration = -1;
+  // Whether boxes were laid out since the last publish. Animations, loaded
+  // images and the like move measured elements without any UI command.
+  bool _layoutGeometryRelaidOut = false;
+
+  void trackLayoutGeometry(Element element) {
+    if (_layoutGeometryElements.length >= _maxLayoutGeometryElements) return;
+    _layoutGeometryElements.add(element);
+  }
+
+  // Called from RenderBoxModel.didLayout().
+  void markLayoutGeometryRelaidOut() {
+    if (_layoutGeometryElements.isEmpty) return;
+    _layoutGeometryRelaidOut = true;
+  }
+
+  // Drops the published geometry after a layout change JS did not cause,
+  // e.g. scrolling, until the next frame publishes it again.
+  void invalidateLayoutGeometry() {
+    if (_layoutGeometryElements.isEmpty) return;
+    final page = getAllocatedPage(contextId);
+    if (page == null) return;
+    clearLayoutGeometry(page);
+  }
+
+  void _publishLayoutGeometry() {
+    final int generation = _layoutGeometryGeneration;
+    final bool relaidOut = _layoutGeometryRelaidOut;
+    _layoutGeometryGeneration = -1;
+    _layoutGeometryRelaidOut = false;
+    _layoutGeometryElements.removeWhere((element) => !element.isConnected || element.pointer == null);
+    if (_layoutGeometryElements.isEmpty) return;
+
+    final page = getAllocatedPage(contextId);
+    if (page == null) return;
+    // Either no commands were flushed for this frame, or JS changed layout
+    // after the commands it was laid out from. The frame can not be
+    // published, and if it moved boxes the table it would replace is stale.
+    if (generation < 0 || getLayoutGeometryGeneration(page) != generation) {
+      if (relaidOut) clearLayoutGeometry(page);
+      return;
+    }
+
+    final int length = _layoutGeometryElements.length;
+    final Pointer<NativeLayoutGeometry> entries = malloc.allocate(sizeOf<NativeLayoutGeometry>() * length);
+    int i = 0;
+    for (final Element element in _layoutGeometryElements) {
+      final Rect rect = element.boundingClientRectBounds;
+      final NativeLayoutGeometry entry = (entries + i++).ref;
+      entry.target = element.pointer!;
+      entry.x = rect.left;
+      entry.y = rect.top;
+      entry.width = rect.width;
+      entry.height = rect.height;
+      entry.offsetLeft = element.offsetLeft;
+      entry.offsetTop = element.offsetTop;
+      entry.offsetWidth = element.offsetWidth;
+      entry.offsetHeight = element.offsetHeight;
+    }
+    // Freed on the JS thread.
+    publishLayoutGeometry(page, generation, entries, length);
+  }
+
   void _flushPendingCommandsPerFrameLoop() {
     if (!_canScheduleFrames) {
       _isFrameBindingAttached = false;
       return;
     }
 
-    flushUICommand(this, window.pointer!);
+    // This runs after the frame's layout: publish what it laid out, then tag
+    // the next frame with the commands about to be flushed.
+    _publishLayoutGeometry();
+    final page = _layoutGeometryElements.isEmpty ? null : getAllocatedPage(contextId);
+    final int generation = page != null ? getLayoutGeometryGeneration(page) : -1;
+    if (flushUICommand(this, window.pointer!)) {
+      _layoutGeometryGeneration = generation;
+    }
     _scheduleBlinkStyleUpdateForNextFrame();
     // Deliver pending IntersectionObserver entries to JS side.
     // Safe to call every frame; it will no-op when there are no entries.
@@ -377,6 +455,7 @@ class WebFViewController with Diagnosticable implements WidgetsBindingObserver {
 
   void notifyViewportSizeChangedFromLayout() {
     if (!_inited || _disposed) return;
+    invalidateLayoutGeometry();
 
     // This method can be invoked from RenderViewportBox.performLayout(). We
     // must not mutate descendants (e.g. markNeedsLayout) during layout, so
@@ -488,6 +567,7 @@ class WebFViewController with Diagnosticable implements WidgetsBindingObserver {
     if (!_inited) return;
     _disposing = true;
     _frameFlushLoopEnabled = false;
+    _layoutGeometryElements.clear();
     _cancelBlinkStyleUpdateForNextFrame();
     _isFrameBindingAttached = false;
     _nativeMediaQueryAffectingValueDebounceTimer?.cancel();
@@ -943,9 +1023,15 @@ class WebFViewController with Diagnosticable implements WidgetsBindingObserver {
     }
   }
 
-  void requestCanvasPaint(Pointer selfPtr) {
+  void requestCanvasPaint(Pointer selfPtr, Pointer<NativeCanvasDisplayList> displayList) {
     CanvasRenderingContext2D? context2d =
         getBindingObject<CanvasRenderingContext2D>(selfPtr);
+    if (displayList != nullptr) {
+      context2d?.applyDisplayList(displayList);
+      malloc.free(displayList.ref.ops);
+      malloc.free(displayList.ref.args);
+      malloc.free(displayList);
+    }
     context2d?.requestPaint();
   }
 
@@ -1013,6 +1099,26 @@ class WebFViewController with Diagnosticable implements WidgetsBindingObserver {
     _blinkStyleSyncUpdatedProperties.clear();
   }
 
+  // Mirror of the bridge's StyleValueTable: serialized style values referenced
+  // by handle from setStyleById commands. Only defineStyleValue writes to it.
+  final List<String> _styleValueTable = [];
+
+  void defineStyleValue(int handle, String value) {
+    if (handle == _styleValueTable.length) {
+      _styleValueTable.add(value);
+    } else if (handle < _styleValueTable.length) {
+      _styleValueTable[handle] = value;
+    } else {
+      // Handles are assigned densely on the native side; pad defensively.
+      _styleValueTable.addAll(List<String>.filled(handle - _styleValueTable.length, ''));
+      _styleValueTable.add(value);
+    }
+  }
+
+  String styleValueForHandle(int handle) {
+    return handle < _styleValueTable.length ? _styleValueTable[handle] : '';
+  }
+
   void setPseudoStyle(Pointer selfPtr, String args, String key, String value,
       {String? baseHref}) {
     Node? target = getBindingObject<Node>(selfPtr);
@@ -1417,6 +1417,8 @@ abstract class RenderBoxModel extends RenderBox
 
     dispatchResize(contentSize, boxSize ?? Size.zero);
 
+    renderStyle.target.ownerView.markLayoutGeometryRelaidOut();
+
     if (isSelfSizeChanged) {
       renderStyle.markTransformMatrixNeedsUpdate();
       // Rebuild box decoration when size changes so percentage-based border-radius